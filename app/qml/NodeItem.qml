@@ -409,7 +409,7 @@ Rectangle {
         border.color: Theme.border
         border.width: 1
 
-        // Use FramePreviewItem for C++ QPainter rendering
+        // Use FramePreviewItem for C++ scene graph rendering
         // FramePreviewItem observes the node directly (no Frame* passed from QML)
         FramePreviewItem {
             id: inputFramePreview
@@ -486,6 +486,17 @@ Rectangle {
             currentTime: root.currentTime
             resolution: 32
         }
+
+        // Coarser heatmap while scrubbing or editing
+        Text {
+            anchors.right: parent.right
+            anchors.bottom: parent.bottom
+            anchors.margins: 3
+            visible: nodePreview.qualityLevel > 0
+            text: nodePreview.qualityLevel > 1 ? "1/4" : "1/2"
+            color: Theme.textMuted
+            font.pixelSize: 8
+        }
     }
 
     // Icon on the RIGHT of preview for Shape, Utility, and Tweak nodes
@@ -15,6 +15,7 @@ Rectangle {
     property bool isLooping: true
     property int playLocatorMs: 0
     property int animationDurationMs: 10000
+    property bool followingScheduler: false  // Play head being updated by the output scheduler
 
     // Grid toggle
     property bool showGrid: true
@@ -86,7 +87,8 @@ Rectangle {
                 gridColor: Theme.previewGrid
                 backgroundColor: Theme.previewBackground
                 lineWidth: 2.0
-                laserEngine: laserEngine
+                // While playing, the output scheduler feeds the laser
+                laserEngine: root.isPlaying ? null : laserEngine
                 zoneIndex: root.currentZoneIndex
             }
 
@@ -165,6 +167,18 @@ Rectangle {
                 ToolTip.text: root.showGrid ? qsTr("Hide grid") : qsTr("Show grid")
                 ToolTip.delay: 500
             }
+
+            // Preview quality lowered under load (laser output is not affected)
+            Label {
+                anchors.right: parent.right
+                anchors.top: parent.top
+                anchors.margins: 6
+                visible: framePreview.qualityLevel > 0
+                text: framePreview.qualityLevel > 1 ? qsTr("Draft") : qsTr("Reduced")
+                color: Theme.textMuted
+                font.pixelSize: Theme.fontSizeSmall
+                font.italic: true
+            }
         }
 
         // Separator
@@ -349,24 +363,36 @@ Rectangle {
         }
     }
 
-    // Animation timer
-    Timer {
-        id: animationTimer
-        interval: 40  // 25 FPS
-        running: root.isPlaying
-        repeat: true
-
-        onTriggered: {
-            root.playLocatorMs += interval
-            if (root.playLocatorMs >= root.animationDurationMs) {
-                if (root.isLooping) {
-                    root.playLocatorMs = 0
-                } else {
-                    root.isPlaying = false
-                    root.playLocatorMs = root.animationDurationMs
-                }
-            }
-            root.playLocatorChanged(root.playLocatorMs)
+    // Playback clock and laser output, paced on a dedicated thread
+    OutputScheduler {
+        id: outputScheduler
+        graph: root.graph
+        laserEngine: laserEngine
+        zoneIndex: root.currentZoneIndex
+        durationMs: root.animationDurationMs
+        loop: root.isLooping
+
+        onPlayheadMsChanged: {
+            if (root.playLocatorMs === playheadMs)
+                return
+            root.followingScheduler = true
+            root.playLocatorMs = playheadMs
+            root.followingScheduler = false
+            root.playLocatorChanged(playheadMs)
+        }
+
+        // Non-looping playback stopped by itself at the end
+        onPlayingChanged: {
+            if (!playing && root.isPlaying)
+                root.isPlaying = false
         }
     }
+
+    onIsPlayingChanged: outputScheduler.playing = root.isPlaying
+
+    // Seeks from the timeline or the transport restart the clock from there
+    onPlayLocatorMsChanged: {
+        if (!root.followingScheduler)
+            outputScheduler.playheadMs = root.playLocatorMs
+    }
 }
@@ -1,6 +1,9 @@
 #include "ExcaliburEngine.h"
 
 #include <QDebug>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVariantMap>
 
 namespace gizmotweak2
 {
@@ -61,7 +64,10 @@ bool ExcaliburEngine::connect()
 
     if (success)
     {
-        _connected = true;
+        {
+            QMutexLocker locker(&_outputMutex);
+            _connected = true;
+        }
         _reconnectAttempts = 0;
         discoverZones();
         setConnectionStatus(ConnectionStatus::Connected);
@@ -94,9 +100,12 @@ void ExcaliburEngine::disconnect()
     }
 
     // TODO: Actual Excalibur SDK disconnection
-    _connected = false;
-    _zones.clear();
-    _laserEnabled.clear();
+    {
+        QMutexLocker locker(&_outputMutex);
+        _connected = false;
+        _zones.clear();
+        _laserEnabled.clear();
+    }
 
     setConnectionStatus(ConnectionStatus::Disconnected);
     setLastError(QString());
@@ -116,6 +125,7 @@ void ExcaliburEngine::reconnect()
 
 void ExcaliburEngine::discoverZones()
 {
+    QMutexLocker locker(&_outputMutex);
     _zones.clear();
     _laserEnabled.clear();
 
@@ -130,6 +140,7 @@ void ExcaliburEngine::discoverZones()
     {
         _laserEnabled.append(false);
     }
+    locker.unlock();
 
     emit zonesChanged();
 }
@@ -144,8 +155,11 @@ int ExcaliburEngine::zoneCount() const
     return _zones.size();
 }
 
-bool ExcaliburEngine::sendFrame(int zoneIndex, const QVariantList& points)
+bool ExcaliburEngine::sendFrame(int zoneIndex, const PointBuffer& points)
 {
+    // May run on the output scheduler thread: zone state is read under the lock
+    QMutexLocker locker(&_outputMutex);
+
     // Validate connection
     if (!_connected)
     {
@@ -173,22 +187,55 @@ bool ExcaliburEngine::sendFrame(int zoneIndex, const QVariantList& points)
     }
 
     // TODO: Convert points to Excalibur format and send
-    // Points format: [{x, y, r, g, b}, ...]
-    // x, y in [-1, +1], r, g, b in [0, 1]
+    // Channels are contiguous arrays: points.xs()/ys() in [-1, +1],
+    // points.rs()/gs()/bs() in [0, 1], points.repeats() per sample
 
     // Simulate frame sending - in real implementation this would call Excalibur API
-    // bool success = excaliburSendFrame(zoneIndex, convertedPoints);
+    // bool success = excaliburSendFrame(zoneIndex, points.xs(), points.ys(), ...);
     bool success = true;
 
     if (!success)
     {
-        setLastError(tr("Failed to send frame to zone %1").arg(zoneIndex + 1));
+        locker.unlock();
+        const QString error = tr("Failed to send frame to zone %1").arg(zoneIndex + 1);
+        if (QThread::currentThread() == thread())
+        {
+            setLastError(error);
+        }
+        else
+        {
+            QMetaObject::invokeMethod(this, [this, error]() { setLastError(error); }, Qt::QueuedConnection);
+        }
         return false;
     }
 
     return true;
 }
 
+bool ExcaliburEngine::sendFrame(int zoneIndex, const QVariantList& points)
+{
+    // Nothing would be sent: skip unpacking
+    if (!_connected)
+    {
+        return false;
+    }
+
+    _variantPoints.clear();
+    _variantPoints.reserve(points.size());
+    for (const auto& pointVar : points)
+    {
+        QVariantMap point = pointVar.toMap();
+        _variantPoints.append(point.value(QStringLiteral("x"), 0.0).toReal(),
+                              point.value(QStringLiteral("y"), 0.0).toReal(),
+                              point.value(QStringLiteral("r"), 0.0).toReal(),
+                              point.value(QStringLiteral("g"), 0.0).toReal(),
+                              point.value(QStringLiteral("b"), 0.0).toReal(),
+                              1);
+    }
+
+    return sendFrame(zoneIndex, _variantPoints);
+}
+
 void ExcaliburEngine::setLaserEnabled(int zoneIndex, bool enabled)
 {
     if (zoneIndex < 0 || zoneIndex >= _laserEnabled.size())
@@ -199,7 +246,10 @@ void ExcaliburEngine::setLaserEnabled(int zoneIndex, bool enabled)
 
     if (_laserEnabled.at(zoneIndex) != enabled)
     {
-        _laserEnabled[zoneIndex] = enabled;
+        {
+            QMutexLocker locker(&_outputMutex);
+            _laserEnabled[zoneIndex] = enabled;
+        }
 
         // If disabling, ensure we send a blank frame to stop output
         if (!enabled && _connected)
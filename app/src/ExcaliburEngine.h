@@ -1,11 +1,14 @@
 #pragma once
 
 #include <QObject>
+#include <QMutex>
 #include <QStringList>
 #include <QVariantList>
 #include <QTimer>
 #include <QtQml/qqmlregistration.h>
 
+#include "core/PointBuffer.h"
+
 namespace gizmotweak2
 {
 
@@ -51,6 +54,11 @@ public:
     QStringList zones() const;
     Q_INVOKABLE int zoneCount() const;
 
+    // Send packed points (x, y in [-1, +1], r, g, b in [0, 1]); read in place, not copied
+    // Safe to call from a non-GUI thread (output scheduler)
+    bool sendFrame(int zoneIndex, const PointBuffer& points);
+
+    // QML convenience: points as [{x, y, r, g, b}, ...], unpacked then sent as above
     Q_INVOKABLE bool sendFrame(int zoneIndex, const QVariantList& points);
 
     Q_INVOKABLE void setLaserEnabled(int zoneIndex, bool enabled);
@@ -76,6 +84,13 @@ private:
     QTimer _reconnectTimer;
     int _reconnectAttempts{0};
     static constexpr int MaxReconnectAttempts = 3;
+
+    // Guards connection and zone state against sendFrame() from another thread
+    // (written on the GUI thread only, so GUI-thread reads go without it)
+    QMutex _outputMutex;
+
+    // Unpacked QVariantList frame, reused across sendFrame() calls
+    PointBuffer _variantPoints;
 };
 
 } // namespace gizmotweak2
@@ -1,24 +1,42 @@
 #include "FramePreviewItem.h"
 
 #include <QPainter>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <QSGRectangleNode>
+#include <QSGRendererInterface>
+#include <QSGVertexColorMaterial>
+
+#include <cmath>
+#include <cstring>
 
 #include "core/Node.h"
 #include "core/NodeGraph.h"
+#include "core/GraphEvaluator.h"
 #include "nodes/InputNode.h"
 #include "ExcaliburEngine.h"
 
 using namespace gizmotweak2;
 
 FramePreviewItem::FramePreviewItem(QQuickItem* parent)
-    : QQuickPaintedItem(parent)
+    : QQuickItem(parent)
 {
-    setRenderTarget(QQuickPaintedItem::FramebufferObject);
+    setFlag(ItemHasContents);
+
+    // Emitted from the worker thread, delivered queued on the GUI thread
+    connect(&_worker, &EvaluationWorker::resultReady,
+            this, &FramePreviewItem::onEvaluationReady);
+
+    _clock.start();
+    _throttleTimer.setSingleShot(true);
+    connect(&_throttleTimer, &QTimer::timeout, this, &FramePreviewItem::evaluateGraph);
+    _idleTimer.setSingleShot(true);
+    _idleTimer.setInterval(PreviewQuality::IDLE_MS);
+    connect(&_idleTimer, &QTimer::timeout, this, &FramePreviewItem::onIdle);
 }
 
-FramePreviewItem::~FramePreviewItem()
-{
-    delete _evaluatedFrame;
-}
+FramePreviewItem::~FramePreviewItem() = default;
 
 // ============================================================================
 // Node mode (for InputNode mini-preview)
@@ -30,9 +48,10 @@ void FramePreviewItem::setNode(gizmotweak2::Node* node)
     {
         disconnectFromNode();
         _node = node;
+        _nodePointsValid = false;
         connectToNode();
         emit nodeChanged();
-        update();
+        markPointsDirty();
     }
 }
 
@@ -67,7 +86,8 @@ void FramePreviewItem::disconnectFromNode()
 
 void FramePreviewItem::onNodeFrameChanged()
 {
-    update();
+    _nodePointsValid = false;
+    markPointsDirty();
 }
 
 // ============================================================================
@@ -82,8 +102,8 @@ void FramePreviewItem::setGraph(gizmotweak2::NodeGraph* graph)
         _graph = graph;
         connectToGraph();
         emit graphChanged();
-        evaluateGraph();  // Evaluate on main thread
-        update();
+        evaluateGraph();
+        markPointsDirty();
     }
 }
 
@@ -93,8 +113,8 @@ void FramePreviewItem::setTime(qreal time)
     {
         _time = time;
         emit timeChanged();
-        evaluateGraph();  // Evaluate on main thread, not in paint()
-        update();
+        noteActivity();
+        evaluateGraph();  // Queued on the worker, not in paint()
     }
 }
 
@@ -103,6 +123,9 @@ void FramePreviewItem::connectToGraph()
     if (!_graph)
         return;
 
+    // Scrubbing and loops revisit the same frames: let the evaluator keep them
+    _graph->evaluator()->setFrameCacheBudget(FRAME_CACHE_BYTES);
+
     // Connect to graph changes
     connect(_graph, &NodeGraph::rowsInserted, this, &FramePreviewItem::onGraphChanged);
     connect(_graph, &NodeGraph::rowsRemoved, this, &FramePreviewItem::onGraphChanged);
@@ -121,8 +144,8 @@ void FramePreviewItem::disconnectFromGraph()
 
 void FramePreviewItem::onGraphChanged()
 {
-    evaluateGraph();  // Evaluate on main thread
-    update();
+    noteActivity();
+    evaluateGraph();
 }
 
 void FramePreviewItem::evaluateGraph()
@@ -132,42 +155,74 @@ void FramePreviewItem::evaluateGraph()
         return;
 
     // Find InputNode to get source frame
-    auto* inputNodeBase = findInputNode();
-    if (!inputNodeBase)
+    auto* inputNode = qobject_cast<InputNode*>(findInputNode());
+    auto* sourceFrame = inputNode ? inputNode->currentFrame() : nullptr;
+    if (!sourceFrame)
     {
-        delete _evaluatedFrame;
-        _evaluatedFrame = nullptr;
+        // Results still in flight are for a graph that no longer has an input
+        _requestedSequence = 0;
+        _hasEvaluatedFrame = false;
+        markPointsDirty();
         return;
     }
 
-    auto* inputNode = qobject_cast<InputNode*>(inputNodeBase);
-    if (!inputNode)
+    // Reduced frame rate: the newest state goes out at the end of the interval
+    const qint64 now = _clock.elapsed();
+    const int interval = PreviewQuality::frameIntervalMs(_quality.level());
+    if (_lastRequestMs >= 0 && now - _lastRequestMs < interval)
     {
-        delete _evaluatedFrame;
-        _evaluatedFrame = nullptr;
+        if (!_throttleTimer.isActive())
+        {
+            _throttleTimer.start(static_cast<int>(interval - (now - _lastRequestMs)));
+        }
         return;
     }
+    _throttleTimer.stop();
 
-    auto* sourceFrame = inputNode->currentFrame();
-    if (!sourceFrame)
-    {
-        delete _evaluatedFrame;
-        _evaluatedFrame = nullptr;
+    // Frames this item sends to the laser keep every input point
+    const int stride = _laserEngine ? 1 : PreviewQuality::pointStride(_quality.level());
+
+    // Capture on this thread, compute on the worker; a newer request replaces an unstarted one
+    QElapsedTimer timer;
+    timer.start();
+    _requestedSequence = _worker.request(_graph, *sourceFrame, _time, stride);
+    _captureMs = timer.nsecsElapsed() / 1e6;
+    _lastRequestMs = now;
+}
+
+void FramePreviewItem::noteActivity()
+{
+    _quality.touch(_clock.elapsed());
+    _idleTimer.start();
+}
+
+void FramePreviewItem::onIdle()
+{
+    if (!_quality.settle(_clock.elapsed()))
         return;
-    }
 
-    // Evaluate graph and store result
-    auto* result = _graph->evaluate(sourceFrame, _time);
+    emit qualityLevelChanged();
+
+    // What is on screen may be a reduced frame: evaluate it again with every point
+    evaluateGraph();
+}
 
-    // Replace the stored frame
-    if (_evaluatedFrame != result)
+void FramePreviewItem::onEvaluationReady()
+{
+    if (!_worker.acquireLatest() || _requestedSequence == 0)
+        return;
+
+    _hasEvaluatedFrame = true;
+
+    // One preview frame: capture here, compute on the worker, last scene graph update
+    if (_quality.report(_captureMs + _worker.latest().costMs + _syncMs, _clock.elapsed()))
     {
-        delete _evaluatedFrame;
-        _evaluatedFrame = result;
+        emit qualityLevelChanged();
     }
 
     // Send to laser engine
     sendFrameToZone();
+    markPointsDirty();
 }
 
 Node* FramePreviewItem::findInputNode() const
@@ -210,55 +265,62 @@ void FramePreviewItem::setZoneIndex(int index)
 
 void FramePreviewItem::sendFrameToZone()
 {
-    if (!_laserEngine || !_evaluatedFrame)
+    if (!_laserEngine || !_hasEvaluatedFrame)
         return;
 
-    QVariantList points;
-    for (int i = 0; i < _evaluatedFrame->size(); ++i)
-    {
-        const auto& sample = _evaluatedFrame->at(i);
-        QVariantMap point;
-        point[QStringLiteral("x")] = sample.getX();
-        point[QStringLiteral("y")] = sample.getY();
-        point[QStringLiteral("r")] = sample.getR();
-        point[QStringLiteral("g")] = sample.getG();
-        point[QStringLiteral("b")] = sample.getB();
-        points.append(point);
-    }
+    // Reduced frames are for the screen only (the engine was attached after the request)
+    if (_worker.latest().stride > 1)
+        return;
 
-    _laserEngine->sendFrame(_zoneIndex, points);
+    // Packed points straight from the worker result, no per-sample conversion
+    _laserEngine->sendFrame(_zoneIndex, _worker.latest().points);
 }
 
 // ============================================================================
 // Frame retrieval (handles both modes)
 // ============================================================================
 
-xengine::Frame* FramePreviewItem::getCurrentFrame()
+const PointBuffer* FramePreviewItem::currentPoints()
 {
-    // Mode 1: Node mode - get frame directly from InputNode
+    // Mode 1: Node mode - the InputNode frame, converted once per change
     if (_node)
     {
-        if (_node->type() == QStringLiteral("Input"))
+        auto* inputNode = qobject_cast<InputNode*>(_node);
+        auto* frame = inputNode ? inputNode->currentFrame() : nullptr;
+        if (!frame)
+            return nullptr;
+
+        if (!_nodePointsValid)
         {
-            auto* inputNode = qobject_cast<InputNode*>(_node);
-            if (inputNode)
-            {
-                return inputNode->currentFrame();
-            }
+            _nodePoints.fromFrame(*frame);
+            _nodePointsValid = true;
         }
-        return nullptr;
+        return _nodePoints.isEmpty() ? nullptr : &_nodePoints;
     }
 
-    // Mode 2: Graph mode - return cached evaluated frame
-    // (evaluation is done on main thread in evaluateGraph())
-    if (_graph)
+    // Mode 2: Graph mode - the last frame computed by the worker
+    // (only the GUI thread acquires new results, and it is blocked while we sync)
+    if (_graph && _hasEvaluatedFrame)
     {
-        return _evaluatedFrame;
+        const PointBuffer& points = _worker.latest().points;
+        return points.isEmpty() ? nullptr : &points;
     }
 
     return nullptr;
 }
 
+void FramePreviewItem::markPointsDirty()
+{
+    _pointsDirty = true;
+    update();
+}
+
+void FramePreviewItem::markDecorDirty()
+{
+    _decorDirty = true;
+    update();
+}
+
 // ============================================================================
 // Visual properties
 // ============================================================================
@@ -269,7 +331,7 @@ void FramePreviewItem::setShowGrid(bool show)
     {
         _showGrid = show;
         emit showGridChanged();
-        update();
+        markDecorDirty();
     }
 }
 
@@ -279,7 +341,7 @@ void FramePreviewItem::setGridColor(const QColor& color)
     {
         _gridColor = color;
         emit gridColorChanged();
-        update();
+        markDecorDirty();
     }
 }
 
@@ -289,7 +351,7 @@ void FramePreviewItem::setBackgroundColor(const QColor& color)
     {
         _backgroundColor = color;
         emit backgroundColorChanged();
-        update();
+        markDecorDirty();
     }
 }
 
@@ -299,65 +361,390 @@ void FramePreviewItem::setLineWidth(qreal width)
     {
         _lineWidth = width;
         emit lineWidthChanged();
-        update();
+        markPointsDirty();
+    }
+}
+
+void FramePreviewItem::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+
+    // Every vertex is in item pixels
+    if (newGeometry.size() != oldGeometry.size())
+    {
+        markDecorDirty();
     }
 }
 
 // ============================================================================
-// Painting
+// Scene graph
 // ============================================================================
 
-void FramePreviewItem::drawGrid(QPainter* painter)
+// Root of the item's subtree, children drawn in this order
+class FramePreviewNode : public QSGNode
+{
+public:
+    QSGRectangleNode* background{nullptr};
+    QSGGeometryNode* grid{nullptr};         // Not on the software backend
+    QSGGeometryNode* lines{nullptr};        // Not on the software backend
+    QSGImageNode* image{nullptr};           // "No data", or the whole picture on the software backend
+    int lineVertices{0};                    // Vertices of lines holding segments, the rest is degenerate
+};
+
+// Geometry node of per-vertex coloured primitives
+static QSGGeometryNode* createColoredNode(QSGGeometry::DrawingMode mode)
 {
-    int w = static_cast<int>(width());
-    int h = static_cast<int>(height());
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+    geometry->setDrawingMode(mode);
+
+    auto* node = new QSGGeometryNode;
+    node->setGeometry(geometry);
+    node->setMaterial(new QSGVertexColorMaterial);
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
 
-    painter->setPen(QPen(_gridColor, 1));
+// Frame color channel (0..1) to a vertex byte
+static uchar colorByte(qreal value)
+{
+    return static_cast<uchar>(qBound(0.0, value, 1.0) * 255.0 + 0.5);
+}
 
-    // Draw 4x4 grid lines
-    for (int i = 1; i < 4; ++i)
+// Vertex colors are premultiplied
+static void setVertex(QSGGeometry::ColoredPoint2D& vertex, float x, float y, const QColor& color)
+{
+    const int a = color.alpha();
+    vertex.set(x, y,
+               static_cast<uchar>(color.red() * a / 255),
+               static_cast<uchar>(color.green() * a / 255),
+               static_cast<uchar>(color.blue() * a / 255),
+               static_cast<uchar>(a));
+}
+
+static void drawNoData(QPainter& painter, const QRectF& rect)
+{
+    painter.setPen(QColor(100, 100, 100));
+    painter.setFont(QFont("sans-serif", 12));
+    painter.drawText(rect, Qt::AlignCenter, "No data");
+}
+
+QSGNode* FramePreviewItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*)
+{
+    auto* root = static_cast<FramePreviewNode*>(oldNode);
+    if (width() <= 0 || height() <= 0)
+    {
+        delete root;
+        return nullptr;
+    }
+
+    // The software renderer skips custom geometry, it gets a painted image instead
+    const bool software = window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software;
+
+    if (!root)
+    {
+        root = new FramePreviewNode;
+        root->background = window()->createRectangleNode();
+        root->appendChildNode(root->background);
+        if (!software)
+        {
+            root->grid = createColoredNode(QSGGeometry::DrawLines);
+            root->grid->geometry()->setLineWidth(1.0f);
+            root->appendChildNode(root->grid);
+
+            // Rewritten in place frame after frame
+            root->lines = createColoredNode(QSGGeometry::DrawTriangles);
+            root->lines->geometry()->setVertexDataPattern(QSGGeometry::DynamicPattern);
+            root->appendChildNode(root->lines);
+        }
+        _pointsDirty = true;
+        _decorDirty = true;
+    }
+
+    if (!_pointsDirty && !_decorDirty)
+        return root;
+
+    QElapsedTimer timer;
+    timer.start();
+    const PointBuffer* points = currentPoints();
+    if (_decorDirty)
+    {
+        updateBackground(root);
+    }
+
+    if (software)
     {
-        int x = w * i / 4;
-        int y = h * i / 4;
-        painter->drawLine(x, 0, x, h);
-        painter->drawLine(0, y, w, y);
+        updateSoftware(root, points);
     }
+    else
+    {
+        if (_decorDirty)
+        {
+            updateGrid(root);
+        }
+        updateLines(root, points);
+        updateMessage(root, !points);
+    }
+
+    _pointsDirty = false;
+    _decorDirty = false;
+    _syncMs = timer.nsecsElapsed() / 1e6;
+    return root;
+}
 
-    // Draw center cross (brighter)
-    painter->setPen(QPen(_gridColor.lighter(150), 1));
-    int cx = w / 2;
-    int cy = h / 2;
-    painter->drawLine(cx - 5, cy, cx + 5, cy);
-    painter->drawLine(cx, cy - 5, cx, cy + 5);
+void FramePreviewItem::updateBackground(FramePreviewNode* root)
+{
+    root->background->setRect(boundingRect());
+    root->background->setColor(_backgroundColor);
 }
 
-void FramePreviewItem::paint(QPainter* painter)
+void FramePreviewItem::updateGrid(FramePreviewNode* root)
 {
-    int w = static_cast<int>(width());
-    int h = static_cast<int>(height());
+    QSGGeometry* geometry = root->grid->geometry();
+    if (!_showGrid)
+    {
+        geometry->allocate(0);
+        root->grid->markDirty(QSGNode::DirtyGeometry);
+        return;
+    }
 
-    // Background
-    painter->fillRect(0, 0, w, h, _backgroundColor);
+    // 4x4 grid lines, then the brighter center cross; on pixel centers for crisp 1 px lines
+    geometry->allocate(16);
+    auto* v = geometry->vertexDataAsColoredPoint2D();
+    const int w = static_cast<int>(width());
+    const int h = static_cast<int>(height());
+    for (int i = 1; i < 4; ++i)
+    {
+        const float x = w * i / 4 + 0.5f;
+        const float y = h * i / 4 + 0.5f;
+        setVertex(*v++, x, 0.0f, _gridColor);
+        setVertex(*v++, x, h, _gridColor);
+        setVertex(*v++, 0.0f, y, _gridColor);
+        setVertex(*v++, w, y, _gridColor);
+    }
+
+    const QColor center = _gridColor.lighter(150);
+    const float cx = w / 2 + 0.5f;
+    const float cy = h / 2 + 0.5f;
+    setVertex(*v++, cx - 5.0f, cy, center);
+    setVertex(*v++, cx + 5.0f, cy, center);
+    setVertex(*v++, cx, cy - 5.0f, center);
+    setVertex(*v++, cx, cy + 5.0f, center);
+    root->grid->markDirty(QSGNode::DirtyGeometry);
+}
 
-    // Grid
-    if (_showGrid)
+void FramePreviewItem::updateLines(FramePreviewNode* root, const PointBuffer* points)
+{
+    // Segment i-1 -> i takes the color of sample i, blank samples are moves.
+    // Each segment is a lineWidth wide quad with square caps (two triangles);
+    // a zero-length one, a repeated or isolated point, is a lineWidth square.
+    _vertices.clear();
+    if (points)
     {
-        drawGrid(painter);
+        const int count = points->size();
+        const qreal* xs = points->xs();
+        const qreal* ys = points->ys();
+        const float w = static_cast<float>(width());
+        const float h = static_cast<float>(height());
+        const float half = static_cast<float>(_lineWidth) * 0.5f;
+
+        for (int i = 1; i < count; ++i)
+        {
+            if (!points->isColored(i))
+                continue;
+
+            const float x0 = static_cast<float>((xs[i - 1] + 1.0) * 0.5) * w;
+            const float y0 = static_cast<float>((ys[i - 1] + 1.0) * 0.5) * h;
+            const float x1 = static_cast<float>((xs[i] + 1.0) * 0.5) * w;
+            const float y1 = static_cast<float>((ys[i] + 1.0) * 0.5) * h;
+
+            // Along (ux, uy) and across (nx, ny) the segment, half a line width long
+            float ux = x1 - x0;
+            float uy = y1 - y0;
+            const float length = std::sqrt(ux * ux + uy * uy);
+            if (length > 1e-4f)
+            {
+                ux *= half / length;
+                uy *= half / length;
+            }
+            else
+            {
+                ux = half;
+                uy = 0.0f;
+            }
+            const float nx = -uy;
+            const float ny = ux;
+
+            const uchar r = colorByte(points->rs()[i]);
+            const uchar g = colorByte(points->gs()[i]);
+            const uchar b = colorByte(points->bs()[i]);
+
+            QSGGeometry::ColoredPoint2D corners[4];
+            corners[0].set(x0 - ux + nx, y0 - uy + ny, r, g, b, 255);
+            corners[1].set(x0 - ux - nx, y0 - uy - ny, r, g, b, 255);
+            corners[2].set(x1 + ux + nx, y1 + uy + ny, r, g, b, 255);
+            corners[3].set(x1 + ux - nx, y1 + uy - ny, r, g, b, 255);
+
+            _vertices.append(corners[0]);
+            _vertices.append(corners[1]);
+            _vertices.append(corners[2]);
+            _vertices.append(corners[2]);
+            _vertices.append(corners[1]);
+            _vertices.append(corners[3]);
+        }
     }
 
-    // Get frame (from node or graph evaluation)
-    auto* frame = getCurrentFrame();
+    QSGGeometry* geometry = root->lines->geometry();
+    const int used = _vertices.size();
+    const int capacity = geometry->vertexCount();
+    const int bytes = used * static_cast<int>(sizeof(QSGGeometry::ColoredPoint2D));
 
-    // Frame rendering - fills 100% of the square
-    if (frame && frame->size() > 0)
+    // The buffer only grows, with headroom, or shrinks once it is mostly unused;
+    // in between the vertices past the frame are degenerate (zero area)
+    if (used > capacity || (capacity > MIN_LINE_VERTICES && used < capacity / 4))
     {
-        frame->render(painter, 0, 0, w, h, _lineWidth);
+        geometry->allocate(qMax(MIN_LINE_VERTICES, used + used / 2));
+        auto* data = geometry->vertexDataAsColoredPoint2D();
+        if (used > 0)
+        {
+            std::memcpy(data, _vertices.constData(), bytes);
+        }
+        std::memset(data + used, 0, (geometry->vertexCount() - used) * sizeof(QSGGeometry::ColoredPoint2D));
     }
     else
     {
-        // No data message
-        painter->setPen(QColor(100, 100, 100));
-        painter->setFont(QFont("sans-serif", 12));
-        painter->drawText(QRect(0, 0, w, h), Qt::AlignCenter, "No data");
+        // Same frame at the same size and width: nothing to upload
+        auto* data = geometry->vertexDataAsColoredPoint2D();
+        if (used == root->lineVertices && (used == 0 || std::memcmp(data, _vertices.constData(), bytes) == 0))
+            return;
+
+        if (used > 0)
+        {
+            std::memcpy(data, _vertices.constData(), bytes);
+        }
+        if (root->lineVertices > used)
+        {
+            std::memset(data + used, 0, (root->lineVertices - used) * sizeof(QSGGeometry::ColoredPoint2D));
+        }
+    }
+
+    root->lineVertices = used;
+    geometry->markVertexDataDirty();
+    root->lines->markDirty(QSGNode::DirtyGeometry);
+}
+
+void FramePreviewItem::updateMessage(FramePreviewNode* root, bool visible)
+{
+    if (!visible)
+    {
+        if (root->image)
+        {
+            root->removeChildNode(root->image);
+            delete root->image;
+            root->image = nullptr;
+        }
+        return;
+    }
+
+    // Text only changes with the size
+    if (root->image && !_decorDirty)
+        return;
+
+    const qreal dpr = window()->effectiveDevicePixelRatio();
+    QImage image((size() * dpr).toSize(), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        drawNoData(painter, boundingRect());
+    }
+
+    if (!root->image)
+    {
+        root->image = window()->createImageNode();
+        root->image->setOwnsTexture(true);
+        root->appendChildNode(root->image);
+    }
+    root->image->setTexture(window()->createTextureFromImage(image));
+    root->image->setRect(boundingRect());
+}
+
+void FramePreviewItem::updateSoftware(FramePreviewNode* root, const PointBuffer* points)
+{
+    // Same picture as the geometry nodes, painted into one reused image
+    const qreal dpr = window()->effectiveDevicePixelRatio();
+    const QSize pixels = (size() * dpr).toSize();
+    if (_softwareImage.size() != pixels)
+    {
+        _softwareImage = QImage(pixels, QImage::Format_ARGB32_Premultiplied);
+    }
+    _softwareImage.setDevicePixelRatio(dpr);
+    _softwareImage.fill(Qt::transparent);
+
+    {
+        QPainter painter(&_softwareImage);
+        const int w = static_cast<int>(width());
+        const int h = static_cast<int>(height());
+
+        if (_showGrid)
+        {
+            painter.setPen(QPen(_gridColor, 1));
+            for (int i = 1; i < 4; ++i)
+            {
+                painter.drawLine(w * i / 4, 0, w * i / 4, h);
+                painter.drawLine(0, h * i / 4, w, h * i / 4);
+            }
+            painter.setPen(QPen(_gridColor.lighter(150), 1));
+            painter.drawLine(w / 2 - 5, h / 2, w / 2 + 5, h / 2);
+            painter.drawLine(w / 2, h / 2 - 5, w / 2, h / 2 + 5);
+        }
+
+        if (points)
+        {
+            // One drawLines() per run of same-colored segments
+            painter.setRenderHint(QPainter::Antialiasing);
+            QPen pen(Qt::white, _lineWidth, Qt::SolidLine, Qt::SquareCap);
+            QVector<QLineF> run;
+            QRgb runColor = 0;
+            auto flush = [&]()
+            {
+                if (run.isEmpty())
+                    return;
+                pen.setColor(QColor::fromRgb(runColor));
+                painter.setPen(pen);
+                painter.drawLines(run);
+                run.clear();
+            };
+
+            const qreal* xs = points->xs();
+            const qreal* ys = points->ys();
+            for (int i = 1; i < points->size(); ++i)
+            {
+                if (!points->isColored(i))
+                    continue;
+
+                const QRgb color = qRgb(colorByte(points->rs()[i]), colorByte(points->gs()[i]), colorByte(points->bs()[i]));
+                if (color != runColor)
+                {
+                    flush();
+                    runColor = color;
+                }
+                run.append(QLineF((xs[i - 1] + 1.0) * 0.5 * w, (ys[i - 1] + 1.0) * 0.5 * h,
+                                  (xs[i] + 1.0) * 0.5 * w, (ys[i] + 1.0) * 0.5 * h));
+            }
+            flush();
+        }
+        else
+        {
+            drawNoData(painter, boundingRect());
+        }
+    }
+
+    if (!root->image)
+    {
+        root->image = window()->createImageNode();
+        root->image->setOwnsTexture(true);
+        root->appendChildNode(root->image);
     }
+    root->image->setTexture(window()->createTextureFromImage(_softwareImage));
+    root->image->setRect(boundingRect());
 }
@@ -1,15 +1,32 @@
 #pragma once
 
-#include <QQuickPaintedItem>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QQuickItem>
+#include <QSGGeometry>
+#include <QTimer>
+#include <QVector>
 #include <QtQml/qqmlregistration.h>
 
 #include <frame.h>
 #include "core/Node.h"
 #include "core/NodeGraph.h"
+#include "core/EvaluationWorker.h"
+#include "core/PointBuffer.h"
+#include "core/PreviewQuality.h"
 
 namespace gizmotweak2 { class ExcaliburEngine; }
 
-class FramePreviewItem : public QQuickPaintedItem
+class FramePreviewNode;
+
+// Laser frame preview, drawn by the scene graph: the frame is one geometry node of
+// per-vertex coloured triangles (lineWidth wide segments), rebuilt only when the
+// frame, the size or the line width changed. The software backend, which has no
+// custom geometry, gets the same picture painted into an image node.
+// In graph mode the preview measures its own cost and, over budget while the
+// user scrubs or plays, evaluates fewer input points less often (PreviewQuality);
+// frames sent to the laser always keep every point.
+class FramePreviewItem : public QQuickItem
 {
     Q_OBJECT
     QML_ELEMENT
@@ -31,12 +48,13 @@ class FramePreviewItem : public QQuickPaintedItem
     Q_PROPERTY(QColor backgroundColor READ backgroundColor WRITE setBackgroundColor NOTIFY backgroundColorChanged)
     Q_PROPERTY(qreal lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
 
+    // Adaptive quality in graph mode: 0 = full, 1 = reduced, 2 = draft (PreviewQuality::Level)
+    Q_PROPERTY(int qualityLevel READ qualityLevel NOTIFY qualityLevelChanged)
+
 public:
     explicit FramePreviewItem(QQuickItem* parent = nullptr);
     ~FramePreviewItem() override;
 
-    void paint(QPainter* painter) override;
-
     // Node mode - observe a single node
     gizmotweak2::Node* node() const { return _node; }
     void setNode(gizmotweak2::Node* node);
@@ -68,6 +86,8 @@ public:
     qreal lineWidth() const { return _lineWidth; }
     void setLineWidth(qreal width);
 
+    int qualityLevel() const { return _quality.level(); }
+
 signals:
     void nodeChanged();
     void graphChanged();
@@ -78,24 +98,46 @@ signals:
     void gridColorChanged();
     void backgroundColorChanged();
     void lineWidthChanged();
+    void qualityLevelChanged();
+
+protected:
+    // Render thread, GUI thread blocked
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
 
 private slots:
     void onNodeFrameChanged();
     void onGraphChanged();
+    void onEvaluationReady();
+    void onIdle();
 
 private:
     void connectToNode();
     void disconnectFromNode();
     void connectToGraph();
     void disconnectFromGraph();
-    void drawGrid(QPainter* painter);
 
-    // Get frame depending on mode (node or graph)
-    xengine::Frame* getCurrentFrame();
+    // Points to draw depending on mode (node or graph), nullptr = no data
+    const gizmotweak2::PointBuffer* currentPoints();
 
-    // Evaluate graph on main thread (called when graph or time changes)
+    // Something drawn changed: frame points, or grid and background
+    void markPointsDirty();
+    void markDecorDirty();
+
+    // Scene graph updates (render thread)
+    void updateBackground(FramePreviewNode* root);
+    void updateGrid(FramePreviewNode* root);
+    void updateLines(FramePreviewNode* root, const gizmotweak2::PointBuffer* points);
+    void updateMessage(FramePreviewNode* root, bool visible);
+    void updateSoftware(FramePreviewNode* root, const gizmotweak2::PointBuffer* points);
+
+    // Queue a graph evaluation on the worker (called when graph or time changes)
+    // At reduced quality, requests closer than the level's interval are coalesced
     void evaluateGraph();
 
+    // The user scrubbed, played or edited: quality may drop until idle again
+    void noteActivity();
+
     // Send evaluated frame to laser engine
     void sendFrameToZone();
 
@@ -104,11 +146,25 @@ private:
 
     // Node mode
     gizmotweak2::Node* _node{nullptr};
+    gizmotweak2::PointBuffer _nodePoints;   // Input frame of the node, converted when it changes
+    bool _nodePointsValid{false};
 
     // Graph mode
     gizmotweak2::NodeGraph* _graph{nullptr};
     qreal _time{0.0};
-    xengine::Frame* _evaluatedFrame{nullptr};  // Owned by this class when in graph mode
+    gizmotweak2::EvaluationWorker _worker;  // Evaluates off the GUI thread, newest request wins
+    quint64 _requestedSequence{0};          // Last request made, 0 = nothing to show
+    bool _hasEvaluatedFrame{false};
+    static constexpr qint64 FRAME_CACHE_BYTES = 64 * 1024 * 1024;
+
+    // Adaptive quality (graph mode)
+    gizmotweak2::PreviewQuality _quality;
+    QElapsedTimer _clock;                   // Time base of _quality
+    QTimer _throttleTimer;                  // Deferred request at reduced frame rate
+    QTimer _idleTimer;                      // Full quality after PreviewQuality::IDLE_MS
+    qint64 _lastRequestMs{-1};
+    qreal _captureMs{0.0};                  // Last request() on the GUI thread
+    qreal _syncMs{0.0};                     // Last updatePaintNode() that rebuilt something
 
     // Laser engine
     gizmotweak2::ExcaliburEngine* _laserEngine{nullptr};
@@ -119,4 +175,11 @@ private:
     QColor _gridColor{40, 40, 40};
     QColor _backgroundColor{0, 0, 0};
     qreal _lineWidth{2.0};
+
+    // Scene graph state: what must be rebuilt on the next updatePaintNode()
+    bool _pointsDirty{true};
+    bool _decorDirty{true};
+    QVector<QSGGeometry::ColoredPoint2D> _vertices;     // Segments of the frame, reused
+    static constexpr int MIN_LINE_VERTICES = 6 * 256;   // Line buffer never shrinks below this
+    QImage _softwareImage;                              // Software backend picture, reused
 };
@@ -0,0 +1,43 @@
+#include "HeatmapJob.h"
+
+#include <utility>
+
+#include "core/RatioHeatmap.h"
+
+using namespace gizmotweak2;
+
+HeatmapJob::HeatmapJob(EvaluationSnapshot snapshot, int op, int resolution, quint64 generation,
+                       std::shared_ptr<std::atomic<quint64>> latest)
+    : _snapshot(std::move(snapshot))
+    , _op(op)
+    , _resolution(resolution)
+    , _generation(generation)
+    , _latest(std::move(latest))
+{
+    // Deleted on the GUI thread it belongs to, after its last signal
+    setAutoDelete(false);
+}
+
+void HeatmapJob::run()
+{
+    RatioHeatmap heatmap;
+    const auto passes = RatioHeatmap::passResolutions(_resolution);
+
+    for (int i = 0; i < passes.size(); ++i)
+    {
+        if (isStale()) break;
+
+        // Every pass gets its own image: the previous one may still be on screen
+        const bool final = i == passes.size() - 1;
+        QImage image;
+        QVector<qreal> ratios;
+        if (!heatmap.render(_snapshot, _op, passes[i], image, final ? &ratios : nullptr,
+                            [this]() { return isStale(); }))
+        {
+            break;
+        }
+        emit passReady(_generation, image, final, ratios);
+    }
+
+    deleteLater();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QImage>
+#include <QObject>
+#include <QRunnable>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+
+#include "core/ParamSnapshot.h"
+
+// One node preview heatmap rendered on QThreadPool::globalInstance(), coarse to fine
+// (see RatioHeatmap::passResolutions). Each pass is delivered as soon as it is done.
+// The job stops as soon as latest no longer holds its generation: the preview asked
+// for a newer heatmap (time, parameters or resolution changed) or went away.
+class HeatmapJob : public QObject, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    HeatmapJob(gizmotweak2::EvaluationSnapshot snapshot, int op, int resolution, quint64 generation,
+               std::shared_ptr<std::atomic<quint64>> latest);
+
+    void run() override;
+
+signals:
+    // Emitted from the pool thread; ratios are only filled for the final, full resolution pass
+    void passReady(quint64 generation, const QImage& image, bool final, const QVector<qreal>& ratios);
+
+private:
+    bool isStale() const { return _latest->load() != _generation; }
+
+    gizmotweak2::EvaluationSnapshot _snapshot;
+    int _op{-1};
+    int _resolution{0};
+    quint64 _generation{0};
+    std::shared_ptr<std::atomic<quint64>> _latest;
+};
@@ -2,33 +2,59 @@
 
 #include <QPainter>
 #include <QPainterPath>
+#include <QThread>
+#include <QThreadPool>
 #include <QtMath>
 #include <cmath>
+#include <utility>
 
 #include "core/Node.h"
 #include "core/NodeGraph.h"
 #include "core/Port.h"
-#include "core/Connection.h"
-#include "nodes/GizmoNode.h"
-#include "nodes/GroupNode.h"
+#include "core/GraphEvaluator.h"
+#include "core/RatioHeatmap.h"
 #include "nodes/SurfaceFactoryNode.h"
-#include "nodes/TimeShiftNode.h"
-#include "nodes/MirrorNode.h"
 #include "nodes/InputNode.h"
+#include "HeatmapJob.h"
 
 using namespace gizmotweak2;
 
 // Static cache definition
 RatioGridCache NodePreviewItem::s_cache;
 
+QVariantMap NodePreviewItem::gridCacheStats() const
+{
+    const auto stats = s_cache.stats();
+    const quint64 lookups = stats.hits + stats.misses;
+
+    QVariantMap result;
+    result[QStringLiteral("hits")] = stats.hits;
+    result[QStringLiteral("misses")] = stats.misses;
+    result[QStringLiteral("hitRate")] = lookups > 0 ? qreal(stats.hits) / lookups : 0.0;
+    result[QStringLiteral("evictions")] = stats.evictions;
+    result[QStringLiteral("entries")] = stats.entries;
+    result[QStringLiteral("bytes")] = stats.bytes;
+    result[QStringLiteral("budgetBytes")] = stats.budgetBytes;
+    return result;
+}
+
 NodePreviewItem::NodePreviewItem(QQuickItem* parent)
     : QQuickPaintedItem(parent)
 {
     setRenderTarget(QQuickPaintedItem::FramebufferObject);
+
+    _clock.start();
+    _throttleTimer.setSingleShot(true);
+    connect(&_throttleTimer, &QTimer::timeout, this, &NodePreviewItem::refreshHeatmap);
+    _idleTimer.setSingleShot(true);
+    _idleTimer.setInterval(PreviewQuality::IDLE_MS);
+    connect(&_idleTimer, &QTimer::timeout, this, &NodePreviewItem::onIdle);
 }
 
 NodePreviewItem::~NodePreviewItem()
 {
+    // Stops the running heatmap job, if any
+    _heatmapGeneration->fetch_add(1);
     delete _tweakFrame;
 }
 
@@ -42,13 +68,15 @@ void NodePreviewItem::setNode(Node* node)
         }
 
         _node = node;
+        _heatmap = QImage();
+        invalidateHeatmap();
 
         if (_node)
         {
             connect(_node, &Node::propertyChanged, this, [this]() {
-                // Invalidate cache for this node when its properties change
-                s_cache.invalidate(_node);
-                update();
+                // Cached grids of older revisions are simply not hit again
+                noteActivity();
+                refreshHeatmap();
             });
         }
 
@@ -67,22 +95,22 @@ void NodePreviewItem::setGraph(NodeGraph* graph)
         }
 
         _graph = graph;
+        invalidateHeatmap();
 
         if (_graph)
         {
-            // Clear cache when connections change (affects recursive evaluation)
+            // Connections and upstream nodes affect the grid; the revision tells whether they did
             connect(_graph, &NodeGraph::connectionAdded, this, [this]() {
-                s_cache.clear();
+                invalidateHeatmap();
                 update();
             });
             connect(_graph, &NodeGraph::connectionRemoved, this, [this]() {
-                s_cache.clear();
+                invalidateHeatmap();
                 update();
             });
-            // Update when any node's properties change (connected nodes might affect this preview)
             connect(_graph, &NodeGraph::nodePropertyChanged, this, [this]() {
-                s_cache.clear();
-                update();
+                noteActivity();
+                refreshHeatmap();
             });
         }
 
@@ -96,10 +124,10 @@ void NodePreviewItem::setCurrentTime(qreal time)
     if (!qFuzzyCompare(_currentTime, time))
     {
         _currentTime = time;
-        // Clear entire cache when time changes - all grids need recomputation
-        s_cache.clear();
+        // Grids of other times stay cached: looping playback finds them again
+        noteActivity();
+        refreshHeatmap();
         emit currentTimeChanged();
-        update();
     }
 }
 
@@ -109,295 +137,185 @@ void NodePreviewItem::setResolution(int res)
     if (_resolution != res)
     {
         _resolution = res;
+        invalidateHeatmap();
         emit resolutionChanged();
         update();
     }
 }
 
-Node* NodePreviewItem::getConnectedNode(Port* port) const
+void NodePreviewItem::invalidateHeatmap()
 {
-    if (!port || !_graph) return nullptr;
+    _heatmapDirty = true;
 
-    const auto& connections = _graph->connections();
-    for (auto* conn : connections)
-    {
-        if (port->direction() == Port::Direction::In)
-        {
-            if (conn->targetPort() == port)
-            {
-                return conn->sourcePort()->node();
-            }
-        }
-        else
-        {
-            if (conn->sourcePort() == port)
-            {
-                return conn->targetPort()->node();
-            }
-        }
-    }
-    return nullptr;
+    // A running job sees the new generation and stops
+    _heatmapGeneration->fetch_add(1);
+    polish();
 }
 
-qreal NodePreviewItem::evaluatePort(Port* port, qreal x, qreal y, qreal time,
-                                     int pointIndex, int totalPoints) const
+void NodePreviewItem::updatePolish()
 {
-    if (!port) return 1.0;
-
-    Node* sourceNode = getConnectedNode(port);
-    if (!sourceNode) return 1.0;
-
-    return evaluateNode(sourceNode, x, y, time, pointIndex, totalPoints);
+    requestHeatmap();
 }
 
-qreal NodePreviewItem::evaluateNode(Node* node, qreal x, qreal y, qreal time,
-                                     int pointIndex, int totalPoints) const
+void NodePreviewItem::refreshHeatmap()
 {
-    if (!node) return 0.0;
-
-    QString nodeType = node->type();
-
-    // Gizmo - direct evaluation
-    if (nodeType == QStringLiteral("Gizmo"))
+    // Reduced rate: the newest state is rendered at the end of the interval
+    const qint64 now = _clock.elapsed();
+    const int interval = PreviewQuality::frameIntervalMs(_quality.level());
+    if (_lastRefreshMs >= 0 && now - _lastRefreshMs < interval)
     {
-        auto* gizmo = qobject_cast<GizmoNode*>(node);
-        if (gizmo)
+        if (!_throttleTimer.isActive())
         {
-            // Sync automation values to the given time before computing ratio
-            int timeMs = static_cast<int>(time * 1000.0);
-            gizmo->syncToAnimatedValues(timeMs);
-            return gizmo->computeRatio(x, y, time);
+            _throttleTimer.start(static_cast<int>(interval - (now - _lastRefreshMs)));
         }
+        return;
     }
 
-    // Transform - combine connected inputs with geometric transformation
-    if (nodeType == QStringLiteral("Transform"))
-    {
-        auto* group = qobject_cast<GroupNode*>(node);
-        if (group)
-        {
-            // Sync automation values to the given time before transforming coordinates
-            int timeMs = static_cast<int>(time * 1000.0);
-            group->syncToAnimatedValues(timeMs);
-
-            // Transform coordinates using GroupNode method
-            qreal x1, y1;
-            group->transformCoordinates(x, y, x1, y1);
+    _throttleTimer.stop();
+    _lastRefreshMs = now;
+    invalidateHeatmap();
+    update();
+}
 
-            // Collect ratios from connected inputs using transformed coordinates
-            QList<qreal> ratios;
-            for (auto* input : node->inputs())
-            {
-                if (input->dataType() == Port::DataType::Ratio2D ||
-                    input->dataType() == Port::DataType::Ratio1D ||
-                    input->dataType() == Port::DataType::RatioAny)
-                {
-                    if (input->isConnected())
-                    {
-                        ratios.append(evaluatePort(input, x1, y1, time, pointIndex, totalPoints));
-                    }
-                }
-            }
+void NodePreviewItem::noteActivity()
+{
+    _quality.touch(_clock.elapsed());
+    _idleTimer.start();
+}
 
-            // Combine using GroupNode method (exact formulas from GizmoTweak)
-            return group->combine(ratios);
-        }
-    }
+int NodePreviewItem::effectiveResolution() const
+{
+    return qMax(4, _resolution / PreviewQuality::heatmapDivisor(_quality.level()));
+}
 
-    // SurfaceFactory - uses normalized point index
-    if (nodeType == QStringLiteral("SurfaceFactory"))
+void NodePreviewItem::reportHeatmapCost()
+{
+    // qualityLevel is bound in QML: it may only change on the GUI thread
+    Q_ASSERT(QThread::currentThread() == thread());
+    if (_quality.report(_heatmapTimer.nsecsElapsed() / 1e6 + _paintMs, _clock.elapsed()))
     {
-        auto* surface = qobject_cast<SurfaceFactoryNode*>(node);
-        if (surface)
-        {
-            qreal t = (totalPoints > 1) ? qreal(pointIndex) / qreal(totalPoints - 1) : 0.0;
-            return surface->computeRatio(t);
-        }
+        emit qualityLevelChanged();
     }
+}
 
-    // TimeShift - shift time and evaluate input
-    if (nodeType == QStringLiteral("TimeShift"))
-    {
-        auto* timeShift = qobject_cast<TimeShiftNode*>(node);
-        if (timeShift)
-        {
-            // Sync TimeShift's own automation (delay, scale, loopDuration) at current time
-            int timeMs = static_cast<int>(time * 1000.0);
-            timeShift->syncToAnimatedValues(timeMs);
-
-            qreal shiftedTime = timeShift->shiftTime(time);
+void NodePreviewItem::onIdle()
+{
+    if (!_quality.settle(_clock.elapsed()))
+        return;
 
-            for (auto* input : node->inputs())
-            {
-                if (input->dataType() == Port::DataType::RatioAny ||
-                    input->dataType() == Port::DataType::Ratio1D ||
-                    input->dataType() == Port::DataType::Ratio2D)
-                {
-                    if (input->isConnected())
-                    {
-                        return evaluatePort(input, x, y, shiftedTime, pointIndex, totalPoints);
-                    }
-                }
-            }
-        }
-    }
+    emit qualityLevelChanged();
 
-    // Mirror - evaluate input at mirrored coordinates
-    if (nodeType == QStringLiteral("Mirror"))
+    // The heatmap on screen may be a coarse one
+    if (_heatmapKey.resolution != _resolution)
     {
-        auto* mirror = qobject_cast<MirrorNode*>(node);
-        if (mirror)
-        {
-            // Sync automation values to the given time before mirroring coordinates
-            int timeMs = static_cast<int>(time * 1000.0);
-            mirror->syncToAnimatedValues(timeMs);
-
-            // Get mirrored coordinates
-            QPointF mirrored = mirror->mirror(x, y);
-
-            // Evaluate input at mirrored position
-            for (auto* input : node->inputs())
-            {
-                if (input->dataType() == Port::DataType::Ratio2D)
-                {
-                    if (input->isConnected())
-                    {
-                        return evaluatePort(input, mirrored.x(), mirrored.y(), time, pointIndex, totalPoints);
-                    }
-                }
-            }
-        }
+        invalidateHeatmap();
+        update();
     }
-
-    return 0.0;
 }
 
-const QVector<qreal>& NodePreviewItem::getOrComputeRatioGrid(Node* node, int resolution, qreal time) const
+bool NodePreviewItem::isRatioInputMissing() const
 {
-    if (!node)
-    {
-        static QVector<qreal> empty;
-        return empty;
-    }
+    const QString nodeType = _node->type();
+    if (nodeType != QStringLiteral("Mirror") && nodeType != QStringLiteral("TimeShift")) return false;
 
-    // Check if cached entry is valid
-    auto it = s_cache.entries.find(node);
-    if (it != s_cache.entries.end())
+    for (auto* input : _node->inputs())
     {
-        const auto& entry = it.value();
-        if (entry.valid && entry.resolution == resolution && qFuzzyCompare(entry.time, time))
+        if ((input->dataType() == Port::DataType::Ratio2D ||
+             input->dataType() == Port::DataType::Ratio1D ||
+             input->dataType() == Port::DataType::RatioAny) && input->isConnected())
         {
-            return entry.ratios;
+            return false;
         }
     }
+    return true;
+}
 
-    // Compute and cache the grid
-    auto grid = computeRatioGrid(node, resolution, time);
-
-    RatioGridCache::CacheEntry entry;
-    entry.ratios = std::move(grid);
-    entry.resolution = resolution;
-    entry.time = time;
-    entry.valid = true;
+bool NodePreviewItem::showsHeatmap() const
+{
+    // Same dispatch as paint(): shape and utility nodes, SurfaceFactory draws a curve
+    if (!_node || _node->type() == QStringLiteral("SurfaceFactory")) return false;
 
-    s_cache.entries[node] = std::move(entry);
-    return s_cache.entries[node].ratios;
+    const Node::Category cat = _node->category();
+    return cat == Node::Category::Shape || cat == Node::Category::Utility;
 }
 
-QVector<qreal> NodePreviewItem::computeRatioGrid(Node* node, int resolution, qreal time) const
+void NodePreviewItem::requestHeatmap()
 {
-    QVector<qreal> grid(resolution * resolution);
+    if (!_heatmapDirty || !_graph || !showsHeatmap()) return;
+    _heatmapDirty = false;
+    _heatmapTimer.start();
 
-    for (int iy = 0; iy < resolution; ++iy)
+    if (isRatioInputMissing())
     {
-        for (int ix = 0; ix < resolution; ++ix)
-        {
-            // Map to normalized coordinates [-1, +1]
-            qreal nx = (qreal(ix) / (resolution - 1)) * 2.0 - 1.0;
-            qreal ny = 1.0 - (qreal(iy) / (resolution - 1)) * 2.0;  // Y inverted
-
-            grid[iy * resolution + ix] = evaluateNode(node, nx, ny, time, 0, 1);
-        }
+        _heatmap = QImage();
+        return;
     }
 
-    return grid;
-}
+    // Node state is read here, on the GUI thread; the job only sees the snapshot
+    auto* evaluator = _graph->evaluator();
+    EvaluationSnapshot snapshot;
+    const int op = evaluator->captureRatioSnapshot(snapshot, _node, _currentTime);
+    if (op < 0) return;
 
-QColor NodePreviewItem::ratioToColor(qreal ratio) const
-{
-    // Near-zero values are black
-    if (qAbs(ratio) < 0.004)  // ~1/255
-    {
-        return Qt::black;
-    }
+    // Grid already computed from the same parameters: no job at all
+    _heatmapKey.uuid = _node->uuid();
+    _heatmapKey.revision = evaluator->snapshotRevision(snapshot);
+    _heatmapKey.timeMs = static_cast<qint64>(_currentTime * 1000.0);
+    const int resolution = effectiveResolution();
+    _heatmapKey.resolution = resolution;
 
-    if (ratio >= 0.0)
+    QVector<qreal> ratios;
+    if (s_cache.find(_heatmapKey, ratios))
     {
-        // Positive: Blue → Cyan → Green
-        int pixValue = qMin(qMax(0, int(ratio * 255.0)), 255);
-
-        if (pixValue >= 128)
-        {
-            // 128-255: Cyan (0,255,255) → Green (0,255,0)
-            // Blue component decreases from 255 to 0
-            int blue = int((1.0 - (pixValue - 128) / 127.0) * 255.0);
-            return QColor(0, 255, blue);
-        }
-        else
+        _heatmap = QImage(resolution, resolution, QImage::Format_RGB32);
+        for (int iy = 0; iy < resolution; ++iy)
         {
-            // 0-127: Blue (0,0,255) → Cyan (0,255,255)
-            // Green component increases from 0 to 255
-            int green = int((pixValue / 127.0) * 255.0);
-            return QColor(0, green, 255);
+            auto* line = reinterpret_cast<QRgb*>(_heatmap.scanLine(iy));
+            for (int ix = 0; ix < resolution; ++ix)
+            {
+                line[ix] = RatioHeatmap::colorOf(ratios[iy * resolution + ix]);
+            }
         }
+        reportHeatmapCost();
+        update();
+        return;
     }
-    else
-    {
-        // Negative: Red → Magenta
-        int pixValue = qMin(qMax(0, int(-ratio * 255.0)), 255);
 
-        if (pixValue >= 128)
-        {
-            // 128-255: Magenta (255,0,255) → Red (255,0,0)
-            // Blue component decreases from 255 to 0
-            int blue = int((1.0 - (pixValue - 128) / 127.0) * 255.0);
-            return QColor(255, 0, blue);
-        }
-        else
-        {
-            // 0-127: Red (255,0,0) → Magenta (255,0,255)
-            // Blue component increases from 0 to 255
-            int blue = int((pixValue / 127.0) * 255.0);
-            return QColor(255, 0, blue);
-        }
-    }
+    const quint64 generation = _heatmapGeneration->fetch_add(1) + 1;
+    auto* job = new HeatmapJob(std::move(snapshot), op, resolution, generation, _heatmapGeneration);
+    connect(job, &HeatmapJob::passReady, this, &NodePreviewItem::heatmapPassReady);
+    QThreadPool::globalInstance()->start(job);
 }
 
-void NodePreviewItem::paintShapeHeatmap(QPainter* painter)
+void NodePreviewItem::heatmapPassReady(quint64 generation, const QImage& image, bool final,
+                                       const QVector<qreal>& ratios)
 {
-    int res = _resolution;
-    qreal cellW = width() / res;
-    qreal cellH = height() / res;
+    // Queued before a newer request: what it shows is out of date
+    if (generation != _heatmapGeneration->load()) return;
 
-    // Use cached grid for performance
-    const auto& grid = getOrComputeRatioGrid(_node, res, _currentTime);
-
-    if (grid.isEmpty())
+    _heatmap = image;
+    if (final)
     {
-        painter->fillRect(boundingRect(), Qt::black);
-        return;
+        s_cache.insert(_heatmapKey, ratios);
+        reportHeatmapCost();
     }
+    update();
+}
 
-    for (int iy = 0; iy < res; ++iy)
-    {
-        for (int ix = 0; ix < res; ++ix)
-        {
-            qreal ratio = grid[iy * res + ix];
-            QColor color = ratioToColor(ratio);
+void NodePreviewItem::paintShapeHeatmap(QPainter* painter)
+{
+    painter->fillRect(boundingRect(), Qt::black);
 
-            painter->fillRect(QRectF(ix * cellW, iy * cellH, cellW + 0.5, cellH + 0.5), color);
-        }
-    }
+    // Until the first pass arrives, the previous heatmap stays on screen
+    // (requested in updatePolish(), on the GUI thread)
+    if (_heatmap.isNull()) return;
+
+    // One pixel per cell, scaled without smoothing: cells keep sharp edges
+    QElapsedTimer timer;
+    timer.start();
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter->drawImage(boundingRect(), _heatmap);
+    _paintMs = timer.nsecsElapsed() / 1e6;
 }
 
 void NodePreviewItem::paintSurfaceCurve(QPainter* painter)
@@ -785,7 +703,7 @@ void NodePreviewItem::paintTweakFrame(QPainter* painter)
     auto* sourceFrame = inputNode->currentFrame();
     if (!sourceFrame || sourceFrame->size() == 0) return;
 
-    // Evaluate up to this tweak node
+    // Points after this tweak; the other previews of this tick share the same pass
     delete _tweakFrame;
     _tweakFrame = _graph->evaluateUpTo(sourceFrame, _node, _currentTime);
 
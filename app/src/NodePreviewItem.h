@@ -2,31 +2,20 @@
 
 #include <QQuickPaintedItem>
 #include <QtQml/qqmlregistration.h>
-#include <QHash>
+#include <QElapsedTimer>
 #include <QImage>
+#include <QTimer>
+#include <QVariantMap>
+
+#include <atomic>
+#include <memory>
 
 #include <frame.h>
 #include "core/Node.h"
 #include "core/NodeGraph.h"
 #include "core/Port.h"
-
-// Cache for computed ratio grids - shared across all NodePreviewItem instances
-// Key: node pointer, Value: cached grid data with metadata
-struct RatioGridCache
-{
-    struct CacheEntry
-    {
-        QVector<qreal> ratios;  // resolution x resolution grid
-        int resolution{0};
-        qreal time{0.0};
-        bool valid{false};
-    };
-
-    QHash<gizmotweak2::Node*, CacheEntry> entries;
-
-    void clear() { entries.clear(); }
-    void invalidate(gizmotweak2::Node* node) { entries.remove(node); }
-};
+#include "core/PreviewQuality.h"
+#include "core/RatioGridCache.h"
 
 class NodePreviewItem : public QQuickPaintedItem
 {
@@ -38,6 +27,9 @@ class NodePreviewItem : public QQuickPaintedItem
     Q_PROPERTY(qreal currentTime READ currentTime WRITE setCurrentTime NOTIFY currentTimeChanged)
     Q_PROPERTY(int resolution READ resolution WRITE setResolution NOTIFY resolutionChanged)
 
+    // Heatmap quality while the user scrubs or edits: 0 = full, 1 = reduced, 2 = draft
+    Q_PROPERTY(int qualityLevel READ qualityLevel NOTIFY qualityLevelChanged)
+
 public:
     explicit NodePreviewItem(QQuickItem* parent = nullptr);
     ~NodePreviewItem() override;
@@ -56,29 +48,58 @@ public:
     int resolution() const { return _resolution; }
     void setResolution(int res);
 
+    int qualityLevel() const { return _quality.level(); }
+
+    // Ratio grid cache shared by every preview: {hits, misses, hitRate, evictions, entries, bytes, budgetBytes}
+    Q_INVOKABLE QVariantMap gridCacheStats() const;
+
 signals:
     void nodeChanged();
     void graphChanged();
     void currentTimeChanged();
     void resolutionChanged();
+    void qualityLevelChanged();
+
+protected:
+    // GUI thread, before the scene graph syncs: heatmap requests start here
+    void updatePolish() override;
 
 private:
-    // Evaluate a node's ratio output at position (x, y) with time
-    qreal evaluateNode(gizmotweak2::Node* node, qreal x, qreal y, qreal time,
-                       int pointIndex = 0, int totalPoints = 1) const;
+    // Draw shape heatmap (the latest pass delivered for it)
+    void paintShapeHeatmap(QPainter* painter);
 
-    // Follow a port connection and evaluate the source node
-    qreal evaluatePort(gizmotweak2::Port* port, qreal x, qreal y, qreal time,
-                       int pointIndex, int totalPoints) const;
+    // Time, parameters or resolution changed: cancel the running job, request again on next polish
+    void invalidateHeatmap();
 
-    // Get the node connected to an input port
-    gizmotweak2::Node* getConnectedNode(gizmotweak2::Port* port) const;
+    // Time or parameters changed under the user's hands: invalidate, at most once per
+    // interval of the current quality level
+    void refreshHeatmap();
 
-    // Convert ratio value to color (blue-cyan-green for positive, red-magenta for negative)
-    QColor ratioToColor(qreal ratio) const;
+    // Start a background render of the heatmap if it is out of date (GUI thread only:
+    // paint() runs on the render thread and must not create jobs or read the graph)
+    void requestHeatmap();
 
-    // Draw shape heatmap
-    void paintShapeHeatmap(QPainter* painter);
+    // Node types whose preview is a ratio heatmap
+    bool showsHeatmap() const;
+
+    // The user scrubbed or edited: quality may drop until idle again
+    void noteActivity();
+
+    // Cells per side at the current quality level
+    int effectiveResolution() const;
+
+    // A heatmap was delivered (job or cache): feed its cost to the quality governor.
+    // GUI thread only (updatePolish() or heatmapPassReady()), never from paint()
+    void reportHeatmapCost();
+
+    // No activity for a while: back to full resolution
+    void onIdle();
+
+    // A pass of the running job is done
+    void heatmapPassReady(quint64 generation, const QImage& image, bool final, const QVector<qreal>& ratios);
+
+    // True if a Mirror/TimeShift has nothing on its ratio input (black heatmap)
+    bool isRatioInputMissing() const;
 
     // Draw SurfaceFactory curve
     void paintSurfaceCurve(QPainter* painter);
@@ -90,12 +111,6 @@ private:
     void paintTimeShiftIcon(QPainter* painter);
     void paintTweakIcon(QPainter* painter);
 
-    // Compute or retrieve cached ratio grid for a shape node
-    const QVector<qreal>& getOrComputeRatioGrid(gizmotweak2::Node* node, int resolution, qreal time) const;
-
-    // Compute full ratio grid for a node
-    QVector<qreal> computeRatioGrid(gizmotweak2::Node* node, int resolution, qreal time) const;
-
     // Draw tweak output frame
     void paintTweakFrame(QPainter* painter);
 
@@ -110,6 +125,21 @@ private:
     // Cached tweak frame (owned)
     xengine::Frame* _tweakFrame{nullptr};
 
+    // Heatmap on screen (any resolution, drawn scaled) and the job refining it
+    QImage _heatmap;
+    bool _heatmapDirty{true};
+    gizmotweak2::RatioGridCache::Key _heatmapKey;     // Grid the running job computes
+    std::shared_ptr<std::atomic<quint64>> _heatmapGeneration{std::make_shared<std::atomic<quint64>>(0)};
+
+    // Adaptive quality: request to delivery of a heatmap, plus its last paint
+    gizmotweak2::PreviewQuality _quality;
+    QElapsedTimer _clock;                   // Time base of _quality
+    QElapsedTimer _heatmapTimer;            // Started when a heatmap is requested
+    QTimer _throttleTimer;                  // Deferred refresh at reduced rate
+    QTimer _idleTimer;                      // Full quality after PreviewQuality::IDLE_MS
+    qint64 _lastRefreshMs{-1};
+    qreal _paintMs{0.0};                    // Written by paint() while the GUI thread is blocked
+
     // Static cache shared by all NodePreviewItem instances
-    static RatioGridCache s_cache;
+    static gizmotweak2::RatioGridCache s_cache;
 };
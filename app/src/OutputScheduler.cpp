@@ -0,0 +1,366 @@
+#include "OutputScheduler.h"
+
+#include <QMutexLocker>
+#include <QThread>
+
+#include <cmath>
+#include <thread>
+#include <utility>
+
+#include "core/FramePacer.h"
+#include "core/GraphEvaluator.h"
+#include "nodes/InputNode.h"
+#include "ExcaliburEngine.h"
+
+using namespace gizmotweak2;
+
+// First InputNode of the graph, source of the frames to evaluate
+static InputNode* findInputNode(NodeGraph* graph)
+{
+    for (int i = 0; i < graph->rowCount(); ++i)
+    {
+        auto* node = graph->nodeAt(i);
+        if (node && node->type() == QStringLiteral("Input"))
+        {
+            return qobject_cast<InputNode*>(node);
+        }
+    }
+    return nullptr;
+}
+
+OutputScheduler::OutputScheduler(QObject* parent)
+    : QObject(parent)
+{
+}
+
+OutputScheduler::~OutputScheduler()
+{
+    stop();
+}
+
+// ============================================================================
+// Properties
+// ============================================================================
+
+void OutputScheduler::setGraph(gizmotweak2::NodeGraph* graph)
+{
+    if (_graph != graph)
+    {
+        // Only read on the GUI thread (captures), the next one picks it up;
+        // baked automation reads move to the new graph while playing
+        if (_thread && _graph)
+        {
+            _graph->setBakedAutomationReads(false);
+        }
+        _graph = graph;
+        if (_thread && _graph)
+        {
+            _graph->setAutomationBakePeriodMs(1000.0 / _fps);
+            _graph->setBakedAutomationReads(true);
+        }
+        emit graphChanged();
+    }
+}
+
+void OutputScheduler::setLaserEngine(gizmotweak2::ExcaliburEngine* engine)
+{
+    if (_laserEngine.load() != engine)
+    {
+        _laserEngine.store(engine);
+        emit laserEngineChanged();
+    }
+}
+
+void OutputScheduler::setZoneIndex(int index)
+{
+    if (_zoneIndex.load() != index)
+    {
+        _zoneIndex.store(index);
+        emit zoneIndexChanged();
+    }
+}
+
+void OutputScheduler::setPlaying(bool playing)
+{
+    if (isPlaying() == playing)
+        return;
+
+    if (playing)
+    {
+        // Playing again from the end of a non-looping run starts over
+        if (!_loop.load() && _playheadMs.load() >= _durationMs.load())
+        {
+            _playheadMs.store(0);
+            emit playheadMsChanged();
+        }
+        start();
+    }
+    else
+    {
+        stop();
+    }
+    emit playingChanged();
+}
+
+void OutputScheduler::setPlayheadMs(int ms)
+{
+    if (_playheadMs.load() == ms)
+        return;
+
+    // The clock restarts from the new position
+    const bool wasPlaying = isPlaying();
+    stop();
+    _playheadMs.store(ms);
+    if (wasPlaying)
+    {
+        start();
+    }
+    emit playheadMsChanged();
+}
+
+void OutputScheduler::setDurationMs(int ms)
+{
+    if (_durationMs.load() != ms)
+    {
+        _durationMs.store(ms);
+        emit durationMsChanged();
+    }
+}
+
+void OutputScheduler::setLoop(bool loop)
+{
+    if (_loop.load() != loop)
+    {
+        _loop.store(loop);
+        emit loopChanged();
+    }
+}
+
+void OutputScheduler::setFps(qreal fps)
+{
+    fps = qBound(1.0, fps, 120.0);
+    if (qFuzzyCompare(_fps, fps))
+        return;
+
+    // The thread reads the rate once: restart it from the current play head
+    const bool wasPlaying = isPlaying();
+    stop();
+    _fps = fps;
+    if (wasPlaying)
+    {
+        start();
+    }
+    emit fpsChanged();
+}
+
+// ============================================================================
+// Thread control
+// ============================================================================
+
+void OutputScheduler::start()
+{
+    if (_thread)
+        return;
+
+    // Cached frames are quantized to the output period, and automation is
+    // read from samples baked at that period
+    if (_graph)
+    {
+        _graph->evaluator()->setFramePeriodMs(1000.0 / _fps);
+        _graph->setAutomationBakePeriodMs(1000.0 / _fps);
+        _graph->setBakedAutomationReads(true);
+    }
+
+    // First frame is captured here, the thread then asks one frame ahead
+    captureInto(_current, _playheadMs.load());
+    {
+        QMutexLocker locker(&_mutex);
+        _hasPending = false;
+    }
+
+    _stopping.store(false);
+    _missedDeadlines.store(0);
+    _actualFps.store(0.0);
+    emit statsChanged();
+
+    _thread = QThread::create([this]() { run(); });
+    _thread->setObjectName(QStringLiteral("OutputScheduler"));
+    _thread->start(QThread::TimeCriticalPriority);
+}
+
+void OutputScheduler::stop()
+{
+    if (!_thread)
+        return;
+
+    // The thread checks the flag at least once per frame period
+    _stopping.store(true);
+    _thread->wait();
+    delete _thread;
+    _thread = nullptr;
+
+    // Scrubbing reads keyframes exactly; the samples stay for the next playback
+    if (_graph)
+    {
+        _graph->setBakedAutomationReads(false);
+    }
+}
+
+void OutputScheduler::playbackFinished()
+{
+    if (!_thread)
+        return;
+
+    stop();
+    emit playingChanged();
+}
+
+// ============================================================================
+// Captures (GUI thread)
+// ============================================================================
+
+void OutputScheduler::requestCapture(qreal ms)
+{
+    _captureMs.store(ms);
+
+    // One queued call at a time: a slow GUI thread captures the newest time only
+    if (!_captureQueued.exchange(true))
+    {
+        QMetaObject::invokeMethod(this, &OutputScheduler::captureRequested, Qt::QueuedConnection);
+    }
+}
+
+void OutputScheduler::captureRequested()
+{
+    _captureQueued.store(false);
+    if (!_thread)
+        return;
+
+    captureInto(_staging, _captureMs.load());
+
+    QMutexLocker locker(&_mutex);
+    std::swap(_staging, _pending);
+    _hasPending = true;
+}
+
+void OutputScheduler::captureInto(Capture& capture, qreal ms)
+{
+    auto* inputNode = _graph ? findInputNode(_graph) : nullptr;
+    auto* sourceFrame = inputNode ? inputNode->currentFrame() : nullptr;
+    if (!sourceFrame)
+    {
+        // Nothing to output until the graph has an input again
+        capture.snapshot.clear();
+        return;
+    }
+
+    auto* evaluator = _graph->evaluator();
+    qreal time = ms / 1000.0;
+    const bool cacheable = evaluator->frameCacheKey(*sourceFrame, time, capture.cacheKey);
+    capture.cache = nullptr;
+    if (!evaluator->captureSnapshot(capture.snapshot, time)) return;
+    capture.cache = cacheable && !capture.snapshot.random ? evaluator->frameCache() : nullptr;
+    capture.input.fromFrame(*sourceFrame);
+}
+
+// ============================================================================
+// Output thread
+// ============================================================================
+
+void OutputScheduler::run()
+{
+    using Clock = FramePacer::Clock;
+
+    FramePacer pacer;
+    pacer.start(Clock::now(), _fps);
+    const qreal startMs = _playheadMs.load();
+    const qreal periodMs = 1000.0 / pacer.fps();
+
+    // Position in the animation, looped or clamped; returns false past the end
+    auto wrap = [this](qreal& ms)
+    {
+        const int duration = _durationMs.load();
+        if (duration <= 0 || ms < duration) return true;
+        if (_loop.load())
+        {
+            ms = std::fmod(ms, duration);
+            return true;
+        }
+        ms = duration;
+        return false;
+    };
+
+    auto statsStart = Clock::now();
+    int statsFrames = 0;
+
+    while (!_stopping.load())
+    {
+        std::this_thread::sleep_until(pacer.deadline());
+        if (_stopping.load()) break;
+
+        // Play head from the frame number, never accumulated
+        qreal ms = startMs + pacer.elapsedMs();
+        const bool playing = wrap(ms);
+
+        // Newest capture; when the GUI thread fell behind, the previous one goes out again
+        {
+            QMutexLocker locker(&_mutex);
+            if (_hasPending)
+            {
+                std::swap(_pending, _current);
+                _hasPending = false;
+            }
+        }
+        if (playing)
+        {
+            qreal nextMs = ms + periodMs;
+            wrap(nextMs);
+            requestCapture(nextMs);
+        }
+
+        auto* engine = _laserEngine.load();
+        if (engine && _current.snapshot.valid)
+        {
+            if (_current.cache && _current.cache->find(_current.cacheKey, _cachedPoints))
+            {
+                engine->sendFrame(_zoneIndex.load(), _cachedPoints);
+            }
+            else
+            {
+                _compute.input().copyFrom(_current.input);
+                const PointBuffer& output = _compute.run(_current.snapshot);
+                if (_current.cache)
+                {
+                    _current.cache->insert(_current.cacheKey, output);
+                }
+                engine->sendFrame(_zoneIndex.load(), output);
+            }
+        }
+        ++statsFrames;
+
+        _playheadMs.store(qRound(ms));
+        emit playheadMsChanged();
+
+        if (!playing)
+        {
+            QMetaObject::invokeMethod(this, &OutputScheduler::playbackFinished, Qt::QueuedConnection);
+            break;
+        }
+
+        const int missed = pacer.advance(Clock::now());
+        if (missed > 0)
+        {
+            _missedDeadlines.fetch_add(missed);
+        }
+
+        const auto now = Clock::now();
+        const std::chrono::duration<double> window = now - statsStart;
+        if (window.count() >= 1.0)
+        {
+            _actualFps.store(statsFrames / window.count());
+            statsStart = now;
+            statsFrames = 0;
+            emit statsChanged();
+        }
+    }
+}
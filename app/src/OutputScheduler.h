@@ -0,0 +1,146 @@
+#pragma once
+
+#include <QObject>
+#include <QMutex>
+#include <QPointer>
+#include <QtQml/qqmlregistration.h>
+
+#include <atomic>
+#include <memory>
+
+#include "core/FrameCache.h"
+#include "core/NodeGraph.h"
+#include "core/ParamSnapshot.h"
+#include "core/PointBuffer.h"
+#include "core/SnapshotEvaluator.h"
+
+class QThread;
+
+namespace gizmotweak2 { class ExcaliburEngine; }
+
+// Real-time playback: owns the play head and drives laser output from its own thread.
+// Frames are paced on std::chrono::steady_clock (see FramePacer), so a busy GUI
+// neither drifts the timeline nor delays output. The graph is still captured on
+// the GUI thread, one frame ahead; if a capture is late the previous one is
+// output again at the right time rather than waiting for it.
+class OutputScheduler : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(gizmotweak2::NodeGraph* graph READ graph WRITE setGraph NOTIFY graphChanged)
+    Q_PROPERTY(gizmotweak2::ExcaliburEngine* laserEngine READ laserEngine WRITE setLaserEngine NOTIFY laserEngineChanged)
+    Q_PROPERTY(int zoneIndex READ zoneIndex WRITE setZoneIndex NOTIFY zoneIndexChanged)
+
+    // Transport
+    Q_PROPERTY(bool playing READ isPlaying WRITE setPlaying NOTIFY playingChanged)
+    Q_PROPERTY(int playheadMs READ playheadMs WRITE setPlayheadMs NOTIFY playheadMsChanged)
+    Q_PROPERTY(int durationMs READ durationMs WRITE setDurationMs NOTIFY durationMsChanged)
+    Q_PROPERTY(bool loop READ loop WRITE setLoop NOTIFY loopChanged)
+    Q_PROPERTY(qreal fps READ fps WRITE setFps NOTIFY fpsChanged)
+
+    // Output statistics, refreshed about once per second while playing
+    Q_PROPERTY(int missedDeadlines READ missedDeadlines NOTIFY statsChanged)
+    Q_PROPERTY(qreal actualFps READ actualFps NOTIFY statsChanged)
+
+public:
+    explicit OutputScheduler(QObject* parent = nullptr);
+    ~OutputScheduler() override;
+
+    gizmotweak2::NodeGraph* graph() const { return _graph; }
+    void setGraph(gizmotweak2::NodeGraph* graph);
+
+    gizmotweak2::ExcaliburEngine* laserEngine() const { return _laserEngine.load(); }
+    void setLaserEngine(gizmotweak2::ExcaliburEngine* engine);
+
+    int zoneIndex() const { return _zoneIndex.load(); }
+    void setZoneIndex(int index);
+
+    bool isPlaying() const { return _thread != nullptr; }
+    void setPlaying(bool playing);
+
+    // Seeking while playing restarts the clock from the new position
+    int playheadMs() const { return _playheadMs.load(); }
+    void setPlayheadMs(int ms);
+
+    int durationMs() const { return _durationMs.load(); }
+    void setDurationMs(int ms);
+
+    bool loop() const { return _loop.load(); }
+    void setLoop(bool loop);
+
+    // Output frame rate, takes effect from the current play head
+    qreal fps() const { return _fps; }
+    void setFps(qreal fps);
+
+    // Deadlines missed since playback started, and frames actually sent per second
+    int missedDeadlines() const { return _missedDeadlines.load(); }
+    qreal actualFps() const { return _actualFps.load(); }
+
+signals:
+    void graphChanged();
+    void laserEngineChanged();
+    void zoneIndexChanged();
+    void playingChanged();
+    void playheadMsChanged();     // Emitted from the output thread while playing
+    void durationMsChanged();
+    void loopChanged();
+    void fpsChanged();
+    void statsChanged();          // Emitted from the output thread while playing
+
+private:
+    // Graph state for one frame, detached from the nodes
+    struct Capture
+    {
+        gizmotweak2::EvaluationSnapshot snapshot;
+        gizmotweak2::PointBuffer input;
+
+        // Set when the graph's frame cache applies
+        std::shared_ptr<gizmotweak2::FrameCache> cache;
+        gizmotweak2::FrameCache::Key cacheKey;
+    };
+
+    void start();
+    void stop();
+
+    // Output thread loop: wait for the deadline, evaluate, send, repeat
+    void run();
+
+    // Output thread: ask the GUI thread for a capture at ms (coalesced)
+    void requestCapture(qreal ms);
+
+    // GUI thread: capture the graph for the time the output thread asked for
+    void captureRequested();
+    void captureInto(Capture& capture, qreal ms);
+
+    // GUI thread: non-looping playback reached the end
+    void playbackFinished();
+
+    QPointer<gizmotweak2::NodeGraph> _graph;    // Cleared if the graph goes first (QML teardown)
+    std::atomic<gizmotweak2::ExcaliburEngine*> _laserEngine{nullptr};
+    std::atomic<int> _zoneIndex{0};
+
+    std::atomic<int> _playheadMs{0};
+    std::atomic<int> _durationMs{10000};
+    std::atomic<bool> _loop{true};
+    qreal _fps{25.0};                       // Read by the thread only when it starts
+
+    QThread* _thread{nullptr};
+    std::atomic<bool> _stopping{false};
+
+    // Capture hand-off: the GUI fills _staging and swaps it with _pending under
+    // the lock; the output thread swaps _pending with _current when it is fresh
+    Capture _staging;
+    Capture _pending;
+    Capture _current;                       // Output thread only
+    bool _hasPending{false};
+    QMutex _mutex;
+    std::atomic<qreal> _captureMs{0.0};     // Time the next capture is for
+    std::atomic<bool> _captureQueued{false};
+
+    gizmotweak2::SnapshotEvaluator _compute;   // Output thread only
+    gizmotweak2::PointBuffer _cachedPoints;    // Output thread only, frame read back on a cache hit
+
+    std::atomic<int> _missedDeadlines{0};
+    std::atomic<qreal> _actualFps{0.0};
+};
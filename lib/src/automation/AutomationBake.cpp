@@ -0,0 +1,126 @@
+#include "AutomationBake.h"
+#include "AutomationTrack.h"
+
+#include <QDebug>
+#include <QVarLengthArray>
+#include <QtMath>
+
+namespace gizmotweak2
+{
+
+// ============================================================================
+// AutomationBake
+// ============================================================================
+
+AutomationBake::AutomationBake(const AutomationTrack& track, qreal periodMs, quint64 revision)
+    : _periodMs(periodMs)
+    , _revision(revision)
+    , _nbParams(track.paramCount())
+{
+    const QList<int> times = track.keyFrameTimes();
+    if (times.isEmpty() || periodMs < 1.0 || _nbParams <= 0) return;
+
+    const qint64 count = qCeil(times.last() / periodMs) + 1;
+    if (count * _nbParams * static_cast<qint64>(sizeof(float)) > MAX_BYTES)
+    {
+        qWarning() << "AutomationBake: track" << track.trackName() << "too long to bake, played exactly";
+        return;
+    }
+
+    // In time order: each lookup finds its segment through the track's cursor
+    _values.resize(count * _nbParams);
+    QVarLengthArray<double, 16> row(_nbParams);
+    for (int k = 0; k < count; ++k)
+    {
+        track.timedValues(sampleTime(k), row.data());
+        float* samples = _values.data() + k * _nbParams;
+        for (int i = 0; i < _nbParams; ++i)
+        {
+            samples[i] = static_cast<float>(row[i]);
+        }
+    }
+    _sampleCount = static_cast<int>(count);
+}
+
+const float* AutomationBake::rowAt(int timeMs, double& blend) const
+{
+    // The period gives the row to within one; the rounded sample times settle it
+    const int last = _sampleCount - 1;
+    int row = qMin(static_cast<int>(timeMs / _periodMs), last);
+    while (row > 0 && sampleTime(row) > timeMs)
+    {
+        --row;
+    }
+    while (row < last && sampleTime(row + 1) <= timeMs)
+    {
+        ++row;
+    }
+
+    if (row == last)
+    {
+        blend = 0.0;
+    }
+    else
+    {
+        const int from = sampleTime(row);
+        blend = static_cast<double>(timeMs - from) / (sampleTime(row + 1) - from);
+    }
+    return _values.constData() + row * _nbParams;
+}
+
+void AutomationBake::valuesAt(int timeMs, double* out) const
+{
+    double blend = 0.0;
+    const float* a = rowAt(timeMs, blend);
+    if (blend == 0.0)
+    {
+        for (int i = 0; i < _nbParams; ++i)
+        {
+            out[i] = a[i];
+        }
+        return;
+    }
+
+    const float* b = a + _nbParams;
+    for (int i = 0; i < _nbParams; ++i)
+    {
+        out[i] = a[i] + (b[i] - a[i]) * blend;
+    }
+}
+
+double AutomationBake::valueAt(int timeMs, int paramIndex) const
+{
+    double blend = 0.0;
+    const float* a = rowAt(timeMs, blend);
+    if (blend == 0.0)
+    {
+        return a[paramIndex];
+    }
+    return a[paramIndex] + (a[paramIndex + _nbParams] - a[paramIndex]) * blend;
+}
+
+// ============================================================================
+// AutomationBakeJob
+// ============================================================================
+
+AutomationBakeJob::AutomationBakeJob(const AutomationTrack& track, qreal periodMs, quint64 revision)
+    : _source(std::make_unique<AutomationTrack>(track))
+    , _periodMs(periodMs)
+    , _revision(revision)
+{
+    // Detached: the copy must not become a child of the track's node
+    _source->setParent(nullptr);
+
+    // Deleted on the thread that created it, with the copy
+    setAutoDelete(false);
+}
+
+AutomationBakeJob::~AutomationBakeJob() = default;
+
+void AutomationBakeJob::run()
+{
+    emit baked(std::make_shared<const AutomationBake>(*_source, _periodMs, _revision));
+    deleteLater();
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QObject>
+#include <QRunnable>
+#include <QVector>
+
+#include <memory>
+
+namespace gizmotweak2
+{
+
+class AutomationTrack;
+
+// An automation track sampled every periodMs, for playback.
+// Samples run from 0 to the first one at or after the last keyframe (the track
+// holds its value past it), one row of paramCount floats each. Sample k is taken
+// at the whole millisecond qRound(k * periodMs), and reads find their two rows by
+// those same times: reading is an index computation and a blend of two rows
+// instead of a keyframe search and an easing evaluation. Between samples the
+// blend is linear, so values match the keyframes exactly on the sample times
+// only. Immutable once built.
+class AutomationBake
+{
+public:
+    static constexpr qsizetype MAX_BYTES = 16 * 1024 * 1024;   // Per track; longer tracks are not baked
+
+    // Sample track, as it is now, every periodMs >= 1 (see sampleTime())
+    AutomationBake(const AutomationTrack& track, qreal periodMs, quint64 revision);
+
+    // False if the track had no keyframes, the period was under a millisecond
+    // (sample times would repeat) or its samples would exceed MAX_BYTES
+    bool isValid() const { return _sampleCount > 0; }
+
+    qreal periodMs() const { return _periodMs; }
+    quint64 revision() const { return _revision; }     // Track revision it was sampled at
+    int sampleCount() const { return _sampleCount; }
+    int sampleTime(int sample) const { return qRound(sample * _periodMs); }
+    qsizetype memoryBytes() const { return _values.size() * static_cast<qsizetype>(sizeof(float)); }
+
+    // Values at timeMs >= 0, as AutomationTrack::timedValues() / timedValue()
+    void valuesAt(int timeMs, double* out) const;
+    double valueAt(int timeMs, int paramIndex) const;
+
+private:
+    // First sample row for timeMs and the blend toward the next one
+    const float* rowAt(int timeMs, double& blend) const;
+
+    qreal _periodMs;
+    quint64 _revision;
+    int _nbParams;
+    int _sampleCount{0};
+    QVector<float> _values;                 // _sampleCount x _nbParams
+};
+
+// Bakes a track on QThreadPool::globalInstance() and hands the result back
+// through baked(). Works on a copy of the track taken when the job is created
+// (keyframe arrays are implicitly shared, so copying is cheap), so the track
+// can be edited meanwhile; the revision tells whether the result still applies.
+class AutomationBakeJob : public QObject, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    AutomationBakeJob(const AutomationTrack& track, qreal periodMs, quint64 revision);
+    ~AutomationBakeJob() override;
+
+    void run() override;
+
+signals:
+    // Emitted from the pool thread
+    void baked(std::shared_ptr<const gizmotweak2::AutomationBake> bake);
+
+private:
+    std::unique_ptr<AutomationTrack> _source;
+    qreal _periodMs;
+    quint64 _revision;
+};
+
+} // namespace gizmotweak2
@@ -1,6 +1,10 @@
 #include "AutomationTrack.h"
 #include "core/Node.h"
 #include <QDebug>
+#include <QThreadPool>
+#include <QVarLengthArray>
+
+#include <algorithm>
 
 namespace gizmotweak2
 {
@@ -13,6 +17,7 @@ AutomationTrack::AutomationTrack(int nbParams, const QString& trackName,
     , _color(color)
 {
     _parameters.resize(nbParams);
+    initBaking();
 }
 
 AutomationTrack::AutomationTrack(const AutomationTrack& other)
@@ -24,17 +29,16 @@ AutomationTrack::AutomationTrack(const AutomationTrack& other)
 {
     _parameters = other._parameters;
 
-    // Deep copy keyframes
-    for (auto it = other._keyFrames.constBegin(); it != other._keyFrames.constEnd(); ++it)
-    {
-        _keyFrames.insert(it.key(), new KeyFrame(*it.value()));
-    }
+    // Keyframes are plain arrays; views are not shared
+    _keyTimes = other._keyTimes;
+    _keyValues = other._keyValues;
+    _keyCurves = other._keyCurves;
+    initBaking();
 }
 
 AutomationTrack::~AutomationTrack()
 {
-    qDeleteAll(_keyFrames);
-    _keyFrames.clear();
+    qDeleteAll(_views);
 }
 
 bool AutomationTrack::save(QDataStream& out) const
@@ -53,11 +57,11 @@ bool AutomationTrack::save(QDataStream& out) const
         out << _parameters[i].suffix;
     }
 
-    out << static_cast<int>(_keyFrames.count());
-    for (auto it = _keyFrames.constBegin(); it != _keyFrames.constEnd(); ++it)
+    out << static_cast<int>(_keyTimes.size());
+    for (int k = 0; k < _keyTimes.size(); ++k)
     {
-        out << it.key();
-        if (!it.value()->save(out))
+        out << _keyTimes[k];
+        if (!KeyFrame(keyRow(k), _nbParams, _keyCurves[k]).save(out))
         {
             return false;
         }
@@ -98,20 +102,18 @@ bool AutomationTrack::load(QDataStream& in)
         return false;
     }
 
-    qDeleteAll(_keyFrames);
-    _keyFrames.clear();
+    clearKeyFrames();
 
     for (int i = 0; i < keyFrameCount; ++i)
     {
         int timeMs = 0;
         in >> timeMs;
-        auto* kf = new KeyFrame(_nbParams);
-        if (!kf->load(in))
+        KeyFrame kf(_nbParams);
+        if (!kf.load(in))
         {
-            delete kf;
             return false;
         }
-        _keyFrames.insert(timeMs, kf);
+        addLoadedKeyFrame(timeMs, kf);
     }
 
     QChar marker;
@@ -151,11 +153,11 @@ QJsonObject AutomationTrack::toJson() const
 
     // Save keyframes
     QJsonArray keyFramesArray;
-    for (auto it = _keyFrames.constBegin(); it != _keyFrames.constEnd(); ++it)
+    for (int k = 0; k < _keyTimes.size(); ++k)
     {
         QJsonObject kfObj;
-        kfObj["time"] = it.key();
-        kfObj["data"] = it.value()->toJson();
+        kfObj["time"] = _keyTimes[k];
+        kfObj["data"] = KeyFrame(keyRow(k), _nbParams, _keyCurves[k]).toJson();
         keyFramesArray.append(kfObj);
     }
     obj["keyFrames"] = keyFramesArray;
@@ -190,22 +192,17 @@ bool AutomationTrack::fromJson(const QJsonObject& json)
     }
 
     // Load keyframes
-    qDeleteAll(_keyFrames);
-    _keyFrames.clear();
+    clearKeyFrames();
 
     auto keyFramesArray = json["keyFrames"].toArray();
     for (const auto& kfVal : keyFramesArray)
     {
         auto kfObj = kfVal.toObject();
         int timeMs = kfObj["time"].toInt();
-        auto* kf = new KeyFrame(_nbParams);
-        if (kf->fromJson(kfObj["data"].toObject()))
-        {
-            _keyFrames.insert(timeMs, kf);
-        }
-        else
+        KeyFrame kf(_nbParams);
+        if (kf.fromJson(kfObj["data"].toObject()))
         {
-            delete kf;
+            addLoadedKeyFrame(timeMs, kf);
         }
     }
 
@@ -232,22 +229,17 @@ void AutomationTrack::keyframesFromJson(const QJsonObject& json)
     }
 
     // Clear and reload keyframes
-    qDeleteAll(_keyFrames);
-    _keyFrames.clear();
+    clearKeyFrames();
 
     auto keyFramesArray = json["keyFrames"].toArray();
     for (const auto& kfVal : keyFramesArray)
     {
         auto kfObj = kfVal.toObject();
         int timeMs = kfObj["time"].toInt();
-        auto* kf = new KeyFrame(_nbParams);
-        if (kf->fromJson(kfObj["data"].toObject()))
+        KeyFrame kf(_nbParams);
+        if (kf.fromJson(kfObj["data"].toObject()))
         {
-            _keyFrames.insert(timeMs, kf);
-        }
-        else
-        {
-            delete kf;
+            addLoadedKeyFrame(timeMs, kf);
         }
     }
 
@@ -265,6 +257,7 @@ void AutomationTrack::setupParameter(int paramIndex, double minValue, double max
     _parameters[paramIndex].paramName = paramName;
     _parameters[paramIndex].displayRatio = displayRatio;
     _parameters[paramIndex].suffix = suffix;
+    valuesEdited();
 }
 
 void AutomationTrack::setTrackName(const QString& name)
@@ -283,8 +276,7 @@ void AutomationTrack::setAutomated(bool automated)
         _automated = automated;
         if (!_automated)
         {
-            qDeleteAll(_keyFrames);
-            _keyFrames.clear();
+            clearKeyFrames();
             emit keyFrameCountChanged();
         }
         emit automatedChanged();
@@ -334,6 +326,7 @@ void AutomationTrack::setInitialValue(int index, double value)
 {
     if (index < 0 || index >= _nbParams) return;
     _parameters[index].initialValue = value;
+    valuesEdited();
 }
 
 QString AutomationTrack::parameterName(int index) const
@@ -356,45 +349,60 @@ QString AutomationTrack::suffix(int index) const
 
 KeyFrame* AutomationTrack::createKeyFrame(int timeMs)
 {
-    if (_keyFrames.contains(timeMs))
+    if (indexOf(timeMs) >= 0)
     {
-        return _keyFrames.value(timeMs);
+        return keyFrame(timeMs);
     }
 
-    auto* kf = new KeyFrame(_nbParams);
+    // Values at this time: initial values for a first keyframe, interpolated otherwise
+    // (from the keyframes, not from playback samples)
+    QVarLengthArray<double, 16> values(_nbParams);
+    keyFrameValues(timeMs, values.data());
 
-    if (_keyFrames.isEmpty())
+    const int index = insertKeyFrame(timeMs);
+    std::copy_n(values.constData(), _nbParams, keyRow(index));
+    emit keyFrameCountChanged();
+    emit keyFrameModified(timeMs);
+    return keyFrame(timeMs);
+}
+
+KeyFrame* AutomationTrack::keyFrame(int timeMs)
+{
+    if (indexOf(timeMs) < 0)
     {
-        // First keyframe: use initial values
-        for (int i = 0; i < _nbParams; ++i)
-        {
-            kf->setValue(i, _parameters[i].initialValue);
-        }
+        return nullptr;
     }
-    else
+
+    KeyFrame*& view = _views[timeMs];
+    if (!view)
     {
-        // Interpolate values at this time
-        for (int i = 0; i < _nbParams; ++i)
-        {
-            kf->setValue(i, timedValue(timeMs, i));
-        }
+        view = new KeyFrame(this, timeMs);
     }
-
-    _keyFrames.insert(timeMs, kf);
-    emit keyFrameCountChanged();
-    emit keyFrameModified(timeMs);
-    return kf;
+    return view;
 }
 
 void AutomationTrack::moveKeyFrame(int oldTimeMs, int newTimeMs)
 {
-    if (!_keyFrames.contains(oldTimeMs) || _keyFrames.contains(newTimeMs))
+    const int from = indexOf(oldTimeMs);
+    if (from < 0 || indexOf(newTimeMs) >= 0)
     {
         return;
     }
 
-    auto* kf = _keyFrames.take(oldTimeMs);
-    _keyFrames.insert(newTimeMs, kf);
+    // Values, curve and view go with the keyframe
+    QVarLengthArray<double, 16> values(keyRow(from), keyRow(from) + _nbParams);
+    const KeyCurve curve = _keyCurves[from];
+    KeyFrame* view = _views.take(oldTimeMs);
+    removeKeyFrameAt(from);
+
+    const int to = insertKeyFrame(newTimeMs);
+    std::copy_n(values.constData(), _nbParams, keyRow(to));
+    _keyCurves[to] = curve;
+    if (view)
+    {
+        view->_timeMs = newTimeMs;
+        _views.insert(newTimeMs, view);
+    }
     emit keyFrameModified(newTimeMs);
 }
 
@@ -402,26 +410,27 @@ void AutomationTrack::updateKeyFrameValue(int timeMs, int paramIndex, double val
 {
     if (paramIndex < 0 || paramIndex >= _nbParams) return;
 
-    auto it = _keyFrames.find(timeMs);
-    if (it != _keyFrames.end())
+    const int index = indexOf(timeMs);
+    if (index >= 0)
     {
-        it.value()->setValue(paramIndex, value);
+        keyRow(index)[paramIndex] = value;
         emit keyFrameModified(timeMs);
     }
 }
 
 void AutomationTrack::deleteKeyFrame(int timeMs)
 {
-    if (_keyFrames.contains(timeMs))
+    const int index = indexOf(timeMs);
+    if (index >= 0)
     {
-        delete _keyFrames.take(timeMs);
+        removeKeyFrameAt(index);
         emit keyFrameCountChanged();
     }
 }
 
 bool AutomationTrack::hasKeyFrameAt(int timeMs) const
 {
-    return _keyFrames.contains(timeMs);
+    return indexOf(timeMs) >= 0;
 }
 
 double AutomationTrack::timedValue(int timeMs, int paramIndex) const
@@ -434,150 +443,312 @@ double AutomationTrack::timedValue(int timeMs, int paramIndex) const
 
     // Handle negative time (e.g., from TimeShift with delay) - return initial value
     // because at t<0, no animation has started yet
-    if (timeMs < 0)
+    if (timeMs < 0 || _keyTimes.isEmpty())
     {
         return _parameters[paramIndex].initialValue;
     }
 
-    if (_keyFrames.isEmpty())
+    if (_bakedReads && _bake)
     {
-        return _parameters[paramIndex].initialValue;
+        return _bake->valueAt(timeMs, paramIndex);
     }
+    return valueIn(segmentAt(timeMs), paramIndex);
+}
 
-    // Find surrounding keyframes
-    int prevTime = 0;
-    KeyFrame* prevKf = nullptr;
-    KeyFrame* nextKf = nullptr;
-    int nextTime = 0;
-
-    for (auto it = _keyFrames.constBegin(); it != _keyFrames.constEnd(); ++it)
+void AutomationTrack::timedValues(int timeMs, double* out) const
+{
+    // Samples only exist for a track with keyframes
+    if (_bakedReads && _bake && timeMs >= 0)
     {
-        if (it.key() <= timeMs)
-        {
-            prevTime = it.key();
-            prevKf = it.value();
-        }
-        if (it.key() >= timeMs && !nextKf)
-        {
-            nextTime = it.key();
-            nextKf = it.value();
-            break;
-        }
+        _bake->valuesAt(timeMs, out);
+        return;
     }
+    keyFrameValues(timeMs, out);
+}
 
-    // Before first keyframe
-    if (!prevKf && nextKf)
+void AutomationTrack::keyFrameValues(int timeMs, double* out) const
+{
+    if (timeMs < 0 || _keyTimes.isEmpty())
     {
-        if (timeMs >= nextTime)
+        for (int i = 0; i < _nbParams; ++i)
         {
-            return nextKf->value(paramIndex);
+            out[i] = _parameters[i].initialValue;
         }
-        double alpha = static_cast<double>(timeMs) / static_cast<double>(nextTime);
-        double progress = nextKf->valueForProgress(alpha);
-        return (1.0 - progress) * _parameters[paramIndex].initialValue
-             + progress * nextKf->value(paramIndex);
+        return;
     }
 
-    // After last keyframe
-    if (prevKf && !nextKf)
+    // One lookup and one easing evaluation for the whole track
+    const Segment segment = segmentAt(timeMs);
+    for (int i = 0; i < _nbParams; ++i)
     {
-        return prevKf->value(paramIndex);
+        out[i] = valueIn(segment, i);
     }
+}
 
-    // Between two keyframes
-    if (prevKf && nextKf)
+AutomationTrack::Segment AutomationTrack::segmentAt(int timeMs) const
+{
+    Segment segment;
+    const int next = upperIndex(timeMs);
+
+    // On or after a keyframe: exactly on it, or past the last one
+    if (next > 0 && (_keyTimes[next - 1] == timeMs || next == _keyTimes.size()))
     {
-        if (prevTime == nextTime)
-        {
-            return prevKf->value(paramIndex);
-        }
-        double alpha = static_cast<double>(timeMs - prevTime)
-                     / static_cast<double>(nextTime - prevTime);
-        double progress = nextKf->valueForProgress(alpha);
-        return (1.0 - progress) * prevKf->value(paramIndex)
-             + progress * nextKf->value(paramIndex);
+        segment.prev = keyRow(next - 1);
+        return segment;
     }
 
-    return _parameters[paramIndex].initialValue;
+    // Before the first keyframe, the animation starts from the initial values at 0
+    const int prevTime = next > 0 ? _keyTimes[next - 1] : 0;
+    const int nextTime = _keyTimes[next];
+    segment.prev = next > 0 ? keyRow(next - 1) : nullptr;
+    segment.next = keyRow(next);
+
+    const double alpha = static_cast<double>(timeMs - prevTime)
+                       / static_cast<double>(nextTime - prevTime);
+    segment.progress = _keyCurves[next].valueForProgress(alpha);
+    return segment;
 }
 
-void AutomationTrack::resizeAllKeyFrames(double factor)
+double AutomationTrack::valueIn(const Segment& segment, int paramIndex) const
 {
-    if (_keyFrames.isEmpty() || factor <= 0.0)
+    const double from = segment.prev ? segment.prev[paramIndex]
+                                     : _parameters[paramIndex].initialValue;
+    if (!segment.next)
     {
-        return;
+        return from;
     }
+    return (1.0 - segment.progress) * from + segment.progress * segment.next[paramIndex];
+}
 
-    QMap<int, KeyFrame*> newKeyFrames;
-    for (auto it = _keyFrames.constBegin(); it != _keyFrames.constEnd(); ++it)
+int AutomationTrack::upperIndex(int timeMs) const
+{
+    const int count = _keyTimes.size();
+    auto contains = [&](int index)
     {
-        int newTime = static_cast<int>(0.5 + it.key() * factor);
-        if (!newKeyFrames.contains(newTime))
-        {
-            newKeyFrames.insert(newTime, it.value());
-        }
-        else
-        {
-            delete it.value();
-        }
+        return index >= 0 && index <= count
+            && (index == 0 || _keyTimes[index - 1] <= timeMs)
+            && (index == count || timeMs < _keyTimes[index]);
+    };
+
+    // Same segment as last time, or the next one during playback
+    const int cursor = _cursor.load(std::memory_order_relaxed);
+    if (contains(cursor)) return cursor;
+    if (contains(cursor + 1))
+    {
+        _cursor.store(cursor + 1, std::memory_order_relaxed);
+        return cursor + 1;
     }
-    _keyFrames = newKeyFrames;
-    emit keyFrameCountChanged();
+
+    const int index = static_cast<int>(std::upper_bound(_keyTimes.constBegin(), _keyTimes.constEnd(), timeMs)
+                                       - _keyTimes.constBegin());
+    _cursor.store(index, std::memory_order_relaxed);
+    return index;
 }
 
-void AutomationTrack::removeKeyFramesAfter(int timeMs)
+// ============================================================================
+// Baked playback
+// ============================================================================
+
+void AutomationTrack::initBaking()
+{
+    _rebakeTimer.setSingleShot(true);
+    _rebakeTimer.setInterval(REBAKE_DELAY_MS);
+    connect(&_rebakeTimer, &QTimer::timeout, this, &AutomationTrack::startBake);
+
+    // Every keyframe edit notifies one of these
+    connect(this, &AutomationTrack::keyFrameCountChanged, this, &AutomationTrack::valuesEdited);
+    connect(this, &AutomationTrack::keyFrameModified, this, &AutomationTrack::valuesEdited);
+    connect(this, &AutomationTrack::automatedChanged, this, &AutomationTrack::valuesEdited);
+}
+
+void AutomationTrack::setBakePeriodMs(qreal periodMs)
+{
+    periodMs = qMax(0.0, periodMs);
+    if (periodMs == _bakePeriodMs) return;
+
+    _bakePeriodMs = periodMs;
+    if (_bake)
+    {
+        _bake.reset();
+        emit bakeChanged();
+    }
+
+    if (_bakePeriodMs > 0.0)
+        startBake();
+    else
+        _rebakeTimer.stop();
+}
+
+void AutomationTrack::valuesEdited()
 {
-    QList<int> toRemove;
-    for (auto it = _keyFrames.constBegin(); it != _keyFrames.constEnd(); ++it)
+    ++_revision;
+    if (_bake)
     {
-        if (it.key() >= timeMs)
-        {
-            toRemove.append(it.key());
-        }
+        _bake.reset();
+        emit bakeChanged();
     }
-    for (int t : toRemove)
+
+    // Until the new samples arrive, reads are exact
+    if (_bakePeriodMs > 0.0)
     {
-        delete _keyFrames.take(t);
+        _rebakeTimer.start();
     }
-    if (!toRemove.isEmpty())
+}
+
+void AutomationTrack::startBake()
+{
+    _rebakeTimer.stop();
+
+    // Only automated tracks are read, and without keyframes values are constant
+    if (_bakePeriodMs <= 0.0 || !_automated || _keyTimes.isEmpty()) return;
+
+    auto* job = new AutomationBakeJob(*this, _bakePeriodMs, _revision);
+    connect(job, &AutomationBakeJob::baked, this, &AutomationTrack::bakeFinished);
+    QThreadPool::globalInstance()->start(job);
+}
+
+void AutomationTrack::bakeFinished(std::shared_ptr<const AutomationBake> bake)
+{
+    // Edited, or baked at another period, since the job started
+    if (!bake->isValid() || bake->revision() != _revision || bake->periodMs() != _bakePeriodMs) return;
+
+    _bake = std::move(bake);
+    emit bakeChanged();
+}
+
+// ============================================================================
+// Flat keyframe storage
+// ============================================================================
+
+int AutomationTrack::indexOf(int timeMs) const
+{
+    auto it = std::lower_bound(_keyTimes.constBegin(), _keyTimes.constEnd(), timeMs);
+    if (it == _keyTimes.constEnd() || *it != timeMs)
     {
-        emit keyFrameCountChanged();
+        return -1;
     }
+    return static_cast<int>(it - _keyTimes.constBegin());
 }
 
-void AutomationTrack::translateKeyFrames(int deltaMs)
+int AutomationTrack::insertKeyFrame(int timeMs)
 {
-    QList<int> toRemove;
-    QMap<int, KeyFrame*> toAdd;
+    auto it = std::lower_bound(_keyTimes.constBegin(), _keyTimes.constEnd(), timeMs);
+    const int index = static_cast<int>(it - _keyTimes.constBegin());
+    if (it != _keyTimes.constEnd() && *it == timeMs)
+    {
+        return index;
+    }
+
+    // Keyframes are mostly added in time order (loading, recording): appends
+    _keyTimes.insert(index, timeMs);
+    _keyValues.insert(index * _nbParams, _nbParams, 0.0);
+    _keyCurves.insert(index, KeyCurve());
+    return index;
+}
 
-    for (auto it = _keyFrames.constBegin(); it != _keyFrames.constEnd(); ++it)
+void AutomationTrack::removeKeyFrameAt(int index)
+{
+    delete _views.take(_keyTimes[index]);
+    _keyTimes.remove(index);
+    _keyValues.remove(index * _nbParams, _nbParams);
+    _keyCurves.remove(index);
+}
+
+void AutomationTrack::clearKeyFrames()
+{
+    _keyTimes.clear();
+    _keyValues.clear();
+    _keyCurves.clear();
+    qDeleteAll(_views);
+    _views.clear();
+}
+
+void AutomationTrack::addLoadedKeyFrame(int timeMs, const KeyFrame& keyFrame)
+{
+    const int index = insertKeyFrame(timeMs);
+
+    // The file may hold another parameter count: extra values are dropped, missing ones are 0
+    double* row = keyRow(index);
+    std::fill_n(row, _nbParams, 0.0);
+    const int count = qMin(_nbParams, keyFrame.paramCount());
+    for (int i = 0; i < count; ++i)
+    {
+        row[i] = keyFrame.value(i);
+    }
+    _keyCurves[index] = keyFrame.curve();
+}
+
+void AutomationTrack::remapKeyFrames(const std::function<int(int)>& mapTime)
+{
+    // Compacted in place; views follow their keyframe or go with it
+    QHash<int, KeyFrame*> views;
+    int kept = 0;
+    for (int k = 0; k < _keyTimes.size(); ++k)
     {
-        int newTime = it.key() + deltaMs;
-        if (newTime < 0)
+        const int newTime = mapTime(_keyTimes[k]);
+        KeyFrame* view = _views.take(_keyTimes[k]);
+        if (newTime < 0 || (kept > 0 && _keyTimes[kept - 1] == newTime))
+        {
+            delete view;
+            continue;
+        }
+
+        if (kept != k)
         {
-            toRemove.append(it.key());
+            std::copy_n(keyRow(k), _nbParams, keyRow(kept));
+            _keyCurves[kept] = _keyCurves[k];
         }
-        else
+        _keyTimes[kept] = newTime;
+        if (view)
         {
-            toAdd.insert(newTime, it.value());
-            toRemove.append(it.key());
+            view->_timeMs = newTime;
+            views.insert(newTime, view);
         }
+        ++kept;
+    }
+
+    _keyTimes.resize(kept);
+    _keyValues.resize(kept * _nbParams);
+    _keyCurves.resize(kept);
+    _views = views;
+}
+
+void AutomationTrack::resizeAllKeyFrames(double factor)
+{
+    if (_keyTimes.isEmpty() || factor <= 0.0)
+    {
+        return;
     }
 
-    for (int t : toRemove)
+    // Scaling keeps the order; a keyframe landing on an earlier one's time is dropped
+    remapKeyFrames([factor](int timeMs) { return static_cast<int>(0.5 + timeMs * factor); });
+    emit keyFrameCountChanged();
+}
+
+void AutomationTrack::removeKeyFramesAfter(int timeMs)
+{
+    // A tail of the sorted arrays
+    auto it = std::lower_bound(_keyTimes.constBegin(), _keyTimes.constEnd(), timeMs);
+    const int first = static_cast<int>(it - _keyTimes.constBegin());
+    if (first == _keyTimes.size())
     {
-        if (!toAdd.values().contains(_keyFrames.value(t)))
-        {
-            delete _keyFrames.value(t);
-        }
-        _keyFrames.remove(t);
+        return;
     }
 
-    for (auto it = toAdd.constBegin(); it != toAdd.constEnd(); ++it)
+    for (int k = first; k < _keyTimes.size(); ++k)
     {
-        _keyFrames.insert(it.key(), it.value());
+        delete _views.take(_keyTimes[k]);
     }
+    _keyTimes.resize(first);
+    _keyValues.resize(first * _nbParams);
+    _keyCurves.resize(first);
+    emit keyFrameCountChanged();
+}
 
+void AutomationTrack::translateKeyFrames(int deltaMs)
+{
+    // Keyframes moved before 0 are dropped
+    remapKeyFrames([deltaMs](int timeMs) { return timeMs + deltaMs; });
     emit keyFrameCountChanged();
 }
 
@@ -599,18 +770,18 @@ QString AutomationTrack::toolTipText(int timeMs) const
 
 int AutomationTrack::keyFrameCurveType(int timeMs) const
 {
-    auto it = _keyFrames.find(timeMs);
-    if (it != _keyFrames.end())
-        return static_cast<int>(it.value()->curveType());
+    const int index = indexOf(timeMs);
+    if (index >= 0)
+        return _keyCurves[index].type;
     return 0; // Linear
 }
 
 void AutomationTrack::setKeyFrameCurveType(int timeMs, int curveType)
 {
-    auto it = _keyFrames.find(timeMs);
-    if (it != _keyFrames.end())
+    const int index = indexOf(timeMs);
+    if (index >= 0)
     {
-        it.value()->setCurveType(static_cast<QEasingCurve::Type>(curveType));
+        _keyCurves[index].type = static_cast<quint8>(curveType);
         emit keyFrameModified(timeMs);
     }
 }
@@ -1,14 +1,20 @@
 #pragma once
 
 #include <QObject>
-#include <QMap>
+#include <QHash>
 #include <QColor>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QTimer>
 #include <QtQml/qqmlregistration.h>
 
+#include <atomic>
+#include <functional>
+#include <memory>
+
 #include "Param.h"
 #include "KeyFrame.h"
+#include "AutomationBake.h"
 
 namespace gizmotweak2
 {
@@ -28,6 +34,7 @@ class AutomationTrack : public QObject
     Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
     Q_PROPERTY(QString nodeType READ nodeType CONSTANT)
     Q_PROPERTY(QString nodeName READ nodeName NOTIFY nodeNameChanged)
+    Q_PROPERTY(int bakedBytes READ bakedBytes NOTIFY bakeChanged)
 
 public:
     explicit AutomationTrack(int nbParams, const QString& trackName,
@@ -59,7 +66,7 @@ public:
     void setColor(const QColor& color);
 
     int paramCount() const { return _nbParams; }
-    int keyFrameCount() const { return _keyFrames.count(); }
+    int keyFrameCount() const { return _keyTimes.size(); }
 
     // Parent node info (for watermark display)
     QString nodeType() const;
@@ -75,6 +82,7 @@ public:
     Q_INVOKABLE QString suffix(int index) const;
 
     // Keyframe operations
+    // createKeyFrame() and keyFrame() hand out views owned by the track (see KeyFrame)
     Q_INVOKABLE KeyFrame* createKeyFrame(int timeMs);
     Q_INVOKABLE void moveKeyFrame(int oldTimeMs, int newTimeMs);
     Q_INVOKABLE void updateKeyFrameValue(int timeMs, int paramIndex, double value);
@@ -82,11 +90,28 @@ public:
     Q_INVOKABLE bool hasKeyFrameAt(int timeMs) const;
 
     // Value interpolation
+    // The surrounding keyframes are found by binary search, or in O(1) when time
+    // moves forward from the previous lookup (playback); safe to call concurrently
     Q_INVOKABLE double timedValue(int timeMs, int paramIndex) const;
 
+    // Every parameter at timeMs from one keyframe lookup; out holds paramCount() values
+    void timedValues(int timeMs, double* out) const;
+
+    // Baked playback (see AutomationBake)
+    // With a bake period, an automated track samples itself in the background, and
+    // again after each edit (debounced). While baked reads are on and the samples
+    // are up to date, timedValue(s) read them; otherwise they read the keyframes,
+    // exactly: off for scrubbing, on for playback.
+    qreal bakePeriodMs() const { return _bakePeriodMs; }
+    void setBakePeriodMs(qreal periodMs);       // 0 drops the samples
+    bool bakedReads() const { return _bakedReads; }
+    void setBakedReads(bool baked) { _bakedReads = baked; }
+    bool isBaked() const { return _bake != nullptr; }
+    int bakedBytes() const { return _bake ? static_cast<int>(_bake->memoryBytes()) : 0; }
+
     // Keyframe access
-    const QMap<int, KeyFrame*>& keyFrames() const { return _keyFrames; }
-    Q_INVOKABLE QList<int> keyFrameTimes() const { return _keyFrames.keys(); }
+    KeyFrame* keyFrame(int timeMs);     // nullptr if there is none at timeMs
+    Q_INVOKABLE QList<int> keyFrameTimes() const { return _keyTimes; }
     Q_INVOKABLE int keyFrameCurveType(int timeMs) const;
     Q_INVOKABLE void setKeyFrameCurveType(int timeMs, int curveType);
 
@@ -105,12 +130,67 @@ signals:
     void keyFrameCountChanged();
     void keyFrameModified(int timeMs);
     void nodeNameChanged();
+    void bakeChanged();
 
 private:
+    // Keyframes around a time and the eased progress from prev to next;
+    // prev is null before the first keyframe (initial values), next is null
+    // on or after the last one and on an exact keyframe time
+    struct Segment
+    {
+        const double* prev{nullptr};    // Keyframe values
+        const double* next{nullptr};
+        double progress{0.0};
+    };
+
+    Segment segmentAt(int timeMs) const;
+    double valueIn(const Segment& segment, int paramIndex) const;
+
+    // timedValues() from the keyframes, ignoring playback samples
+    void keyFrameValues(int timeMs, double* out) const;
+
+    // Index of the first keyframe after timeMs (0..count), cursor first
+    int upperIndex(int timeMs) const;
+
+    // Flat keyframe storage
+    friend class KeyFrame;
+    int indexOf(int timeMs) const;                  // -1 if no keyframe at timeMs
+    int insertKeyFrame(int timeMs);                 // Row of the (new or existing) keyframe
+    void removeKeyFrameAt(int index);
+    void clearKeyFrames();
+    double* keyRow(int index) { return _keyValues.data() + index * _nbParams; }
+    const double* keyRow(int index) const { return _keyValues.constData() + index * _nbParams; }
+
+    // Add a parsed keyframe (file loading); a later one at the same time replaces it
+    void addLoadedKeyFrame(int timeMs, const KeyFrame& keyFrame);
+
+    // Baked playback: any edit outdates the samples
+    static constexpr int REBAKE_DELAY_MS = 100;     // Edits within it are baked once
+    void initBaking();
+    void valuesEdited();
+    void startBake();
+    void bakeFinished(std::shared_ptr<const AutomationBake> bake);
+
+    // Move every keyframe to mapTime(time), a non-decreasing mapping; keyframes
+    // mapped before 0 or onto the time of an earlier one are dropped
+    void remapKeyFrames(const std::function<int(int)>& mapTime);
+
     int _nbParams;
     QString _trackName;
     QVector<Param> _parameters;
-    QMap<int, KeyFrame*> _keyFrames;
+
+    // Keyframes sorted by time: one row of _nbParams values and one curve each
+    QVector<int> _keyTimes;
+    QVector<double> _keyValues;             // keyFrameCount() x _nbParams
+    QVector<KeyCurve> _keyCurves;
+    QHash<int, KeyFrame*> _views;           // Views handed out, by keyframe time
+    mutable std::atomic<int> _cursor{0};    // Last upperIndex() result, only a hint
+
+    std::shared_ptr<const AutomationBake> _bake;    // Up to date with the keyframes, or null
+    quint64 _revision{0};                   // Bumped by every edit of values or keyframes
+    qreal _bakePeriodMs{0.0};
+    bool _bakedReads{false};
+    QTimer _rebakeTimer;
     bool _automated{false};
     QColor _color;
 };
@@ -1,41 +1,91 @@
 #include "KeyFrame.h"
+#include "AutomationTrack.h"
+#include "core/EasingTable.h"
+
+#include <algorithm>
 
 namespace gizmotweak2
 {
 
+// ============================================================================
+// KeyCurve
+// ============================================================================
+
+double KeyCurve::valueForProgress(double progress) const
+{
+    progress = qBound(0.0, progress, 1.0);
+    if (type == QEasingCurve::Linear)
+    {
+        return progress;
+    }
+    if (hasDefaultShape())
+    {
+        return EasingTable::forType(type).valueForProgress(progress);
+    }
+
+    QEasingCurve curve(static_cast<QEasingCurve::Type>(type));
+    curve.setAmplitude(amplitude);
+    curve.setPeriod(period);
+    curve.setOvershoot(overshoot);
+    return curve.valueForProgress(progress);
+}
+
+// ============================================================================
+// KeyFrame
+// ============================================================================
+
 KeyFrame::KeyFrame(int nbParams)
     : _nbParams(nbParams)
-    , _curve(QEasingCurve::Linear)
 {
     Q_ASSERT(nbParams >= 0 && nbParams <= 16);
     _values.resize(nbParams);
 }
 
+KeyFrame::KeyFrame(const double* values, int nbParams, const KeyCurve& curve)
+    : _nbParams(nbParams)
+    , _curve(curve)
+{
+    _values.resize(nbParams);
+    std::copy_n(values, nbParams, _values.data());
+}
+
 KeyFrame::KeyFrame(const KeyFrame& other)
-    : _nbParams(other._nbParams)
-    , _curve(other._curve.type())
+    : _nbParams(other.paramCount())
+    , _curve(other.curve())
+{
+    _values.resize(_nbParams);
+    for (int i = 0; i < _nbParams; ++i)
+    {
+        _values[i] = other.value(i);
+    }
+}
+
+KeyFrame::KeyFrame(AutomationTrack* track, int timeMs)
+    : _nbParams(track->paramCount())
+    , _track(track)
+    , _timeMs(timeMs)
 {
-    _curve.setAmplitude(other._curve.amplitude());
-    _curve.setOvershoot(other._curve.overshoot());
-    _curve.setPeriod(other._curve.period());
-    _values = other._values;
 }
 
 bool KeyFrame::save(QDataStream& out) const
 {
-    out << _nbParams << static_cast<int>(_curve.type());
-    for (int i = 0; i < _nbParams; ++i)
+    const int nbParams = paramCount();
+    out << nbParams << static_cast<int>(curve().type);
+    for (int i = 0; i < nbParams; ++i)
     {
-        out << _values[i];
+        out << value(i);
     }
     return true;
 }
 
 bool KeyFrame::load(QDataStream& in)
 {
+    if (_track) return false;
+
     int curveType;
     in >> _nbParams >> curveType;
-    _curve.setType(static_cast<QEasingCurve::Type>(curveType));
+    _curve = KeyCurve();
+    _curve.type = static_cast<quint8>(curveType);
     _values.resize(_nbParams);
     for (int i = 0; i < _nbParams; ++i)
     {
@@ -47,12 +97,21 @@ bool KeyFrame::load(QDataStream& in)
 QJsonObject KeyFrame::toJson() const
 {
     QJsonObject obj;
-    obj["curveType"] = static_cast<int>(_curve.type());
+    const KeyCurve& c = curve();
+    obj["curveType"] = static_cast<int>(c.type);
+
+    // Shape only when it is not the default, older files never have it
+    if (!c.hasDefaultShape())
+    {
+        obj["amplitude"] = static_cast<double>(c.amplitude);
+        obj["period"] = static_cast<double>(c.period);
+        obj["overshoot"] = static_cast<double>(c.overshoot);
+    }
 
     QJsonArray valuesArray;
-    for (int i = 0; i < _nbParams; ++i)
+    for (int i = 0; i < paramCount(); ++i)
     {
-        valuesArray.append(_values[i]);
+        valuesArray.append(value(i));
     }
     obj["values"] = valuesArray;
 
@@ -61,12 +120,16 @@ QJsonObject KeyFrame::toJson() const
 
 bool KeyFrame::fromJson(const QJsonObject& json)
 {
-    if (!json.contains("curveType") || !json.contains("values"))
+    if (_track || !json.contains("curveType") || !json.contains("values"))
     {
         return false;
     }
 
-    _curve.setType(static_cast<QEasingCurve::Type>(json["curveType"].toInt()));
+    _curve = KeyCurve();
+    _curve.type = static_cast<quint8>(json["curveType"].toInt());
+    _curve.amplitude = static_cast<float>(json["amplitude"].toDouble(KeyCurve::DEFAULT_AMPLITUDE));
+    _curve.period = static_cast<float>(json["period"].toDouble(KeyCurve::DEFAULT_PERIOD));
+    _curve.overshoot = static_cast<float>(json["overshoot"].toDouble(KeyCurve::DEFAULT_OVERSHOOT));
 
     auto valuesArray = json["values"].toArray();
     _nbParams = valuesArray.size();
@@ -81,49 +144,102 @@ bool KeyFrame::fromJson(const QJsonObject& json)
 
 double KeyFrame::value(int paramIndex) const
 {
-    Q_ASSERT(paramIndex >= 0 && paramIndex < _values.count());
+    Q_ASSERT(paramIndex >= 0 && paramIndex < paramCount());
+    if (_track)
+    {
+        const int index = _track->indexOf(_timeMs);
+        return index >= 0 ? _track->keyRow(index)[paramIndex] : 0.0;
+    }
     return _values[paramIndex];
 }
 
 void KeyFrame::setValue(int paramIndex, double value)
 {
-    Q_ASSERT(paramIndex >= 0 && paramIndex < _values.count());
+    Q_ASSERT(paramIndex >= 0 && paramIndex < paramCount());
+    if (_track)
+    {
+        _track->updateKeyFrameValue(_timeMs, paramIndex, value);
+        return;
+    }
     _values[paramIndex] = value;
 }
 
+int KeyFrame::paramCount() const
+{
+    return _track ? _track->paramCount() : _nbParams;
+}
+
+const KeyCurve& KeyFrame::curve() const
+{
+    if (_track)
+    {
+        const int index = _track->indexOf(_timeMs);
+        if (index >= 0) return _track->_keyCurves[index];
+    }
+    return _curve;
+}
+
+KeyCurve* KeyFrame::editableCurve()
+{
+    if (!_track) return &_curve;
+
+    const int index = _track->indexOf(_timeMs);
+    return index >= 0 ? &_track->_keyCurves[index] : nullptr;
+}
+
+void KeyFrame::curveEdited()
+{
+    if (_track)
+    {
+        emit _track->keyFrameModified(_timeMs);
+    }
+}
+
 QEasingCurve::Type KeyFrame::curveType() const
 {
-    return _curve.type();
+    return static_cast<QEasingCurve::Type>(curve().type);
 }
 
 void KeyFrame::setCurveType(QEasingCurve::Type type)
 {
-    _curve.setType(type);
+    if (auto* c = editableCurve())
+    {
+        c->type = static_cast<quint8>(type);
+        curveEdited();
+    }
 }
 
 double KeyFrame::period() const
 {
-    return _curve.period();
+    return curve().period;
 }
 
 void KeyFrame::setPeriod(double period)
 {
-    _curve.setPeriod(period);
+    if (auto* c = editableCurve())
+    {
+        c->period = static_cast<float>(period);
+        curveEdited();
+    }
 }
 
 double KeyFrame::amplitude() const
 {
-    return _curve.amplitude();
+    return curve().amplitude;
 }
 
 void KeyFrame::setAmplitude(double amplitude)
 {
-    _curve.setAmplitude(amplitude);
+    if (auto* c = editableCurve())
+    {
+        c->amplitude = static_cast<float>(amplitude);
+        curveEdited();
+    }
 }
 
 double KeyFrame::valueForProgress(double progress) const
 {
-    return _curve.valueForProgress(qBound(0.0, progress, 1.0));
+    return curve().valueForProgress(progress);
 }
 
 } // namespace gizmotweak2
@@ -9,23 +9,59 @@
 namespace gizmotweak2
 {
 
+class AutomationTrack;
+
+// Easing of the segment that ends on a keyframe, without a QEasingCurve per keyframe.
+// Curves with the default shape (the usual case) read the shared EasingTable of their type.
+struct KeyCurve
+{
+    static constexpr float DEFAULT_AMPLITUDE = 1.0f;
+    static constexpr float DEFAULT_PERIOD = 0.3f;
+    static constexpr float DEFAULT_OVERSHOOT = 1.70158f;
+
+    quint8 type{QEasingCurve::Linear};
+    float amplitude{DEFAULT_AMPLITUDE};     // Elastic, Bounce
+    float period{DEFAULT_PERIOD};           // Elastic
+    float overshoot{DEFAULT_OVERSHOOT};     // Back
+
+    bool hasDefaultShape() const
+    {
+        return amplitude == DEFAULT_AMPLITUDE && period == DEFAULT_PERIOD && overshoot == DEFAULT_OVERSHOOT;
+    }
+
+    // Eased progress for progress in [0, 1] (clamped)
+    double valueForProgress(double progress) const;
+};
+
+// One keyframe of an automation track.
+// Tracks store their keyframes flat (times, values and curves in arrays), so a
+// KeyFrame is either a standalone copy (serialization, tests) or a view on a
+// track keyframe handed out to the editing API; edits through a view go to the
+// track and emit its keyFrameModified(). A view follows its keyframe when it is
+// moved and is deleted with it.
 class KeyFrame
 {
 public:
     explicit KeyFrame(int nbParams);
-    KeyFrame(const KeyFrame& other);
+    KeyFrame(const double* values, int nbParams, const KeyCurve& curve);
+    KeyFrame(const KeyFrame& other);      // Always a standalone copy
     ~KeyFrame() = default;
 
     bool save(QDataStream& out) const;
-    bool load(QDataStream& in);
+    bool load(QDataStream& in);           // Standalone only
 
     QJsonObject toJson() const;
-    bool fromJson(const QJsonObject& json);
+    bool fromJson(const QJsonObject& json);   // Standalone only
 
     double value(int paramIndex) const;
     void setValue(int paramIndex, double value);
 
-    int paramCount() const { return _nbParams; }
+    int paramCount() const;
+
+    // View on a track keyframe rather than a standalone one
+    bool isView() const { return _track != nullptr; }
+
+    const KeyCurve& curve() const;
 
     QEasingCurve::Type curveType() const;
     void setCurveType(QEasingCurve::Type type);
@@ -39,9 +75,19 @@ public:
     double valueForProgress(double progress) const;
 
 private:
+    friend class AutomationTrack;
+    KeyFrame(AutomationTrack* track, int timeMs);
+
+    // Curve to edit: this keyframe's, or the track's (nullptr if the keyframe is gone)
+    KeyCurve* editableCurve();
+    void curveEdited();
+
     int _nbParams;
-    QVector<double> _values;
-    QEasingCurve _curve;
+    QVector<double> _values;              // Standalone only
+    KeyCurve _curve;                      // Standalone only
+
+    AutomationTrack* _track{nullptr};     // View only
+    int _timeMs{0};
 };
 
 } // namespace gizmotweak2
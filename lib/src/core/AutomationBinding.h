@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QVarLengthArray>
+
+#include "Node.h"
+
+namespace gizmotweak2
+{
+
+// Static table binding a node type's automation tracks to members of its Params.
+// Each node type lists its tracks once, in its .cpp, and paramsAt() hands the
+// table to Node::applyAutomation(): tracks are looked up by name only when the
+// node's tracks change, then every automated track is applied in one loop with
+// one keyframe lookup per track.
+template<typename Params>
+struct AutomationBinding
+{
+    static constexpr int MAX_FIELDS = 6;
+
+    using Field = qreal Params::*;
+    using Apply = void (*)(Params& params, const double* values, int paramCount);
+
+    const char* trackName;
+    Field fields[MAX_FIELDS];       // Track parameter i drives fields[i], up to the first nullptr
+    Apply apply{nullptr};           // Instead of fields, for members that are not a plain qreal
+    bool initialWhenOff{false};     // Not automated: the track's initial values instead of params' own
+};
+
+template<typename Params, std::size_t N>
+void Node::applyAutomation(const AutomationBinding<Params> (&bindings)[N], Params& params, int timeMs) const
+{
+    if (_boundTracks.size() != static_cast<qsizetype>(N))
+    {
+        _boundTracks.resize(N);
+        for (std::size_t b = 0; b < N; ++b)
+        {
+            _boundTracks[b] = automationTrack(QString::fromLatin1(bindings[b].trackName));
+        }
+    }
+
+    QVarLengthArray<double, 16> values;
+    for (std::size_t b = 0; b < N; ++b)
+    {
+        const AutomationTrack* track = _boundTracks[b];
+        if (!track) continue;
+
+        const AutomationBinding<Params>& binding = bindings[b];
+        const int count = track->paramCount();
+        values.resize(count);
+        if (track->isAutomated())
+        {
+            track->timedValues(timeMs, values.data());
+        }
+        else if (binding.initialWhenOff)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                values[i] = track->initialValue(i);
+            }
+        }
+        else
+        {
+            continue;
+        }
+
+        if (binding.apply)
+        {
+            binding.apply(params, values.constData(), count);
+            continue;
+        }
+        for (int i = 0; i < count && i < AutomationBinding<Params>::MAX_FIELDS && binding.fields[i]; ++i)
+        {
+            params.*(binding.fields[i]) = values[i];
+        }
+    }
+}
+
+} // namespace gizmotweak2
@@ -99,7 +99,7 @@ DeleteNodeCommand::DeleteNodeCommand(NodeGraph* graph, const QString& nodeUuid,
         // Save outgoing connections (from this node's outputs)
         for (auto port : node->outputs())
         {
-            for (auto conn : graph->connections())
+            for (auto conn : graph->connectionsForPort(port))
             {
                 if (conn->sourcePort() == port)
                 {
@@ -308,7 +308,7 @@ void ConnectCommand::undo()
     if (sourcePort && targetPort)
     {
         // Find and remove the connection
-        for (auto conn : _graph->connections())
+        for (auto conn : _graph->connectionsForPort(sourcePort))
         {
             if (conn->sourcePort() == sourcePort && conn->targetPort() == targetPort)
             {
@@ -442,7 +442,7 @@ void DisconnectCommand::redo()
 
     if (sourcePort && targetPort)
     {
-        for (auto conn : _graph->connections())
+        for (auto conn : _graph->connectionsForPort(sourcePort))
         {
             if (conn->sourcePort() == sourcePort && conn->targetPort() == targetPort)
             {
@@ -0,0 +1,59 @@
+#include "EasingTable.h"
+
+#include <QList>
+
+namespace gizmotweak2
+{
+
+// Checked points per interval besides the samples themselves: the error of a
+// linear interpolation peaks inside the interval, at a kink for Bounce curves,
+// and may peak between two checks, hence the margin
+static constexpr int CHECKS_PER_INTERVAL = 4;
+static constexpr qreal CHECK_MARGIN = 2.0;
+
+EasingTable::EasingTable(QEasingCurve::Type type)
+    : _curve(type)
+{
+    _values.resize(SAMPLES + 1);
+    for (int i = 0; i <= SAMPLES; ++i)
+    {
+        _values[i] = static_cast<float>(_curve.valueForProgress(static_cast<qreal>(i) / SAMPLES));
+    }
+
+    for (int i = 0; i < SAMPLES * CHECKS_PER_INTERVAL; ++i)
+    {
+        const qreal progress = (i + 0.5) / (SAMPLES * CHECKS_PER_INTERVAL);
+        _maxError = qMax(_maxError, qAbs(valueForProgress(progress) - _curve.valueForProgress(progress)));
+    }
+    _exact = _maxError * CHECK_MARGIN > TOLERANCE;
+}
+
+const EasingTable& EasingTable::forType(int type)
+{
+    static const QList<EasingTable> tables = [] {
+        QList<EasingTable> list;
+        for (int t = 0; t < QEasingCurve::NCurveTypes; ++t)
+        {
+            list.append(EasingTable(t == QEasingCurve::Custom ? QEasingCurve::Linear
+                                                              : static_cast<QEasingCurve::Type>(t)));
+        }
+        return list;
+    }();
+    return (type >= 0 && type < tables.size()) ? tables[type] : tables[QEasingCurve::Linear];
+}
+
+qreal EasingTable::valueForProgress(qreal progress) const
+{
+    progress = qBound(0.0, progress, 1.0);
+    if (_exact)
+    {
+        return _curve.valueForProgress(progress);
+    }
+
+    const qreal x = progress * SAMPLES;
+    const int i = qMin(static_cast<int>(x), SAMPLES - 1);
+    const qreal a = _values[i];
+    return a + (_values[i + 1] - a) * (x - i);
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QEasingCurve>
+#include <QVector>
+
+namespace gizmotweak2
+{
+
+// QEasingCurve sampled once per type and read back by linear interpolation.
+// Gizmo falloffs and keyframe easings evaluate a curve per point or per
+// parameter; a table lookup is a few multiplies where Qt dispatches through
+// the curve's function every time. Each table is checked against Qt when it
+// is built: a type whose interpolation may stray more than TOLERANCE from Qt
+// (Bounce curves, with their kinks) evaluates exactly instead. Only the default shape (amplitude,
+// period, overshoot) is tabulated; other shapes need their own QEasingCurve.
+// Tables are built once, read-only afterwards, and usable from any thread.
+class EasingTable
+{
+public:
+    static constexpr int SAMPLES = 1024;            // Intervals over [0, 1]
+    static constexpr qreal TOLERANCE = 1e-3;        // Max |table - Qt| over [0, 1]
+
+    // Shared table for a QEasingCurve::Type; Custom and unknown types are Linear
+    static const EasingTable& forType(int type);
+
+    // Eased progress for progress in [0, 1] (clamped), exact at 0 and 1
+    qreal valueForProgress(qreal progress) const;
+
+    QEasingCurve::Type type() const { return _curve.type(); }
+
+    // The table was not accurate enough: Qt evaluates every call
+    bool isExact() const { return _exact; }
+
+    // Largest difference to Qt measured when the table was built
+    qreal maxError() const { return _maxError; }
+
+private:
+    explicit EasingTable(QEasingCurve::Type type);
+
+    QEasingCurve _curve;
+    QVector<float> _values;                         // SAMPLES + 1 samples
+    qreal _maxError{0.0};
+    bool _exact{false};
+};
+
+} // namespace gizmotweak2
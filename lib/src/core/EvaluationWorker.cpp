@@ -0,0 +1,98 @@
+#include "EvaluationWorker.h"
+#include "GraphEvaluator.h"
+#include "NodeGraph.h"
+
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <utility>
+
+namespace gizmotweak2
+{
+
+EvaluationWorker::EvaluationWorker(QObject* parent)
+    : QObject(parent)
+{
+    _thread = QThread::create([this]() { run(); });
+    _thread->setObjectName(QStringLiteral("EvaluationWorker"));
+    _thread->start();
+}
+
+EvaluationWorker::~EvaluationWorker()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _stopping = true;
+        _wake.wakeAll();
+    }
+    _thread->wait();
+    delete _thread;
+}
+
+quint64 EvaluationWorker::request(NodeGraph* graph, const xengine::Frame& input, qreal time, int stride)
+{
+    if (!graph) return 0;
+
+    // Capture without holding the lock: the worker keeps computing meanwhile
+    auto* evaluator = graph->evaluator();
+    const bool cacheable = stride <= 1 && evaluator->frameCacheKey(input, time, _staging.cacheKey);
+    if (!evaluator->captureSnapshot(_staging.snapshot, time)) return 0;
+    _staging.cache = cacheable && !_staging.snapshot.random ? evaluator->frameCache() : nullptr;
+    evaluator->syncNodes(_staging.snapshot);
+    _staging.input.fromFrame(input);
+    _staging.input.decimate(stride);
+    _staging.stride = qMax(1, stride);
+    _staging.sequence = ++_requestCount;
+
+    // Latest wins: an older request still pending is dropped here
+    QMutexLocker locker(&_mutex);
+    std::swap(_staging, _pending);
+    _hasPending = true;
+    _wake.wakeOne();
+    return _requestCount;
+}
+
+void EvaluationWorker::run()
+{
+    QMutexLocker locker(&_mutex);
+    for (;;)
+    {
+        while (!_hasPending && !_stopping)
+        {
+            _wake.wait(&_mutex);
+        }
+        if (_stopping) return;
+
+        std::swap(_pending, _working);
+        _hasPending = false;
+        locker.unlock();
+
+        QElapsedTimer timer;
+        timer.start();
+
+        Result& result = _results.back();
+        if (!_working.cache || !_working.cache->find(_working.cacheKey, result.points))
+        {
+            // Buffers are swapped, not copied, so steady state does not allocate
+            std::swap(_compute.input(), _working.input);
+            const PointBuffer& output = _compute.run(_working.snapshot);
+            result.points.copyFrom(output);
+            if (_working.cache)
+            {
+                _working.cache->insert(_working.cacheKey, output);
+            }
+        }
+        result.points.toFrame(result.frame);
+        result.time = _working.snapshot.time;
+        result.sequence = _working.sequence;
+        result.stride = _working.stride;
+        result.costMs = timer.nsecsElapsed() / 1e6;
+        _results.publish();
+        _computedCount.fetch_add(1, std::memory_order_relaxed);
+        emit resultReady();
+
+        locker.relock();
+    }
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <memory>
+
+#include <frame.h>
+
+#include "FrameCache.h"
+#include "ParamSnapshot.h"
+#include "PointBuffer.h"
+#include "SnapshotEvaluator.h"
+#include "TripleBuffer.h"
+
+class QThread;
+
+namespace gizmotweak2
+{
+
+class NodeGraph;
+
+// Evaluates graph snapshots on a dedicated thread.
+// request() captures the graph on the calling (GUI) thread and queues it,
+// replacing any request the worker has not started yet: only the newest
+// (graph state, time) pair is ever computed. Results go through a lock-free
+// triple buffer, so neither the worker nor the readers wait on each other.
+class EvaluationWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    // One computed frame and what it was computed for
+    struct Result
+    {
+        xengine::Frame frame;   // For drawing
+        PointBuffer points;     // Same samples, packed for laser output
+        qreal time{0.0};
+        quint64 sequence{0};    // request() number, 0 = nothing computed yet
+        int stride{1};          // Input points kept, 1 = all of them
+        qreal costMs{0.0};      // Worker time spent on it
+    };
+
+    explicit EvaluationWorker(QObject* parent = nullptr);
+    ~EvaluationWorker() override;
+
+    // GUI thread: capture graph at time over input and queue it for the worker
+    // A stride > 1 keeps every stride-th input point only (reduced-quality previews);
+    // such frames never go through the frame cache, laser output shares it.
+    // Returns the request number, 0 if there is nothing to evaluate (no graph)
+    quint64 request(NodeGraph* graph, const xengine::Frame& input, qreal time, int stride = 1);
+
+    // GUI thread: switch latest() to the newest computed frame
+    // Returns false if nothing new was computed since the last call
+    bool acquireLatest() { return _results.acquire(); }
+
+    // GUI thread: last acquired result, stable until the next acquireLatest()
+    Result& latest() { return _results.front(); }
+
+    // Diagnostics: requests made, and how many the worker actually computed
+    quint64 requestCount() const { return _requestCount; }
+    quint64 computedCount() const { return _computedCount.load(std::memory_order_relaxed); }
+
+signals:
+    // A new result can be acquired (emitted from the worker thread)
+    void resultReady();
+
+private:
+    // Everything the worker needs, detached from the graph
+    struct Request
+    {
+        EvaluationSnapshot snapshot;
+        PointBuffer input;
+        quint64 sequence{0};
+        int stride{1};
+
+        // Set when the graph's frame cache applies (held here so it outlives the graph)
+        std::shared_ptr<FrameCache> cache;
+        FrameCache::Key cacheKey;
+    };
+
+    // Worker thread loop: wait for a request, compute it, publish, repeat
+    void run();
+
+    QThread* _thread{nullptr};
+
+    // Request hand-off: the GUI fills _staging, then swaps it with _pending
+    // under the lock; the worker swaps _pending with its own _working copy
+    Request _staging;
+    Request _pending;
+    Request _working;
+    bool _hasPending{false};
+    bool _stopping{false};
+    QMutex _mutex;
+    QWaitCondition _wake;
+
+    SnapshotEvaluator _compute;             // Worker thread only
+    TripleBuffer<Result> _results;
+
+    quint64 _requestCount{0};
+    std::atomic<quint64> _computedCount{0};
+};
+
+} // namespace gizmotweak2
@@ -0,0 +1,12 @@
+#include "FrameCache.h"
+
+namespace gizmotweak2
+{
+
+qint64 FrameCacheTraits::bytes(const PointBuffer& points)
+{
+    // Five qreal channels and the repeat counts; copies are sized to the frame
+    return static_cast<qint64>(points.size()) * (5 * sizeof(qreal) + sizeof(int));
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QHash>
+
+#include "LruCache.h"
+#include "PointBuffer.h"
+
+namespace gizmotweak2
+{
+
+// Identity of an evaluated frame
+struct FrameCacheKey
+{
+    quint64 revision{0};    // GraphEvaluator::revision() at capture
+    quintptr pattern{0};    // Input pattern identity
+    qint64 timeSlot{0};     // Time in output frame periods
+
+    bool operator==(const FrameCacheKey& other) const
+    {
+        return revision == other.revision && pattern == other.pattern && timeSlot == other.timeSlot;
+    }
+};
+
+inline size_t qHash(const FrameCacheKey& key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.revision, key.pattern, key.timeSlot);
+}
+
+// Frames are copied into the caller's buffer, which keeps its capacity
+struct FrameCacheTraits
+{
+    static qint64 bytes(const PointBuffer& points);
+    static void copy(const PointBuffer& from, PointBuffer& to) { to.copyFrom(from); }
+};
+
+// LRU cache of evaluated frames, bounded by a memory budget.
+// Keys carry the graph revision, so an edit never needs to clear anything:
+// entries of older revisions are simply never hit again and age out.
+class FrameCache : public LruCache<FrameCacheKey, PointBuffer, FrameCacheTraits>
+{
+public:
+    using Key = FrameCacheKey;
+};
+
+} // namespace gizmotweak2
@@ -0,0 +1,34 @@
+#include "FramePacer.h"
+
+#include <cmath>
+
+namespace gizmotweak2
+{
+
+void FramePacer::start(Clock::time_point now, qreal fps)
+{
+    _origin = now;
+    _fps = qMax(fps, 1.0);
+    _frame = 0;
+}
+
+FramePacer::Clock::time_point FramePacer::deadlineOf(qint64 frame) const
+{
+    const std::chrono::duration<double> offset(frame / _fps);
+    return _origin + std::chrono::round<Clock::duration>(offset);
+}
+
+int FramePacer::advance(Clock::time_point now)
+{
+    ++_frame;
+    if (deadlineOf(_frame) >= now) return 0;
+
+    // Late: jump to the newest deadline already passed, the ones before it are dropped
+    const std::chrono::duration<double> elapsed = now - _origin;
+    const qint64 latest = qMax(_frame, static_cast<qint64>(std::floor(elapsed.count() * _fps)));
+    const int missed = static_cast<int>(latest - _frame + 1);
+    _frame = latest;
+    return missed;
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <chrono>
+
+namespace gizmotweak2
+{
+
+// Frame deadlines on the monotonic clock.
+// Deadline n is origin + n / fps, computed from the frame number rather than
+// accumulated, so wake-up jitter never drifts the timeline. A frame that
+// starts after its deadline is counted as missed; when more than a whole
+// period is lost, the frames in between are dropped instead of replayed.
+class FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Restart at frame 0, whose deadline is now
+    void start(Clock::time_point now, qreal fps);
+
+    qreal fps() const { return _fps; }
+    qint64 frameIndex() const { return _frame; }
+
+    // When the current frame should go out
+    Clock::time_point deadline() const { return deadlineOf(_frame); }
+
+    // Time shown by the current frame, in ms since start()
+    qreal elapsedMs() const { return _frame * 1000.0 / _fps; }
+
+    // Done with the current frame at now: move on to the next one
+    // Returns how many deadlines were missed on the way (0 when on time)
+    int advance(Clock::time_point now);
+
+private:
+    Clock::time_point deadlineOf(qint64 frame) const;
+
+    Clock::time_point _origin;
+    qreal _fps{25.0};
+    qint64 _frame{0};
+};
+
+} // namespace gizmotweak2
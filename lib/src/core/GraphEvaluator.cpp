@@ -4,36 +4,39 @@
 #include "Port.h"
 #include "Connection.h"
 
-#include <QtMath>
-#include <cmath>
-
-// Node includes for type-specific evaluation
+// Node includes for type-specific capture
 #include "nodes/GizmoNode.h"
+#include "nodes/InputNode.h"
 #include "nodes/GroupNode.h"
-#include "nodes/SurfaceFactoryNode.h"
 #include "nodes/TimeShiftNode.h"
 #include "nodes/MirrorNode.h"
-#include "nodes/PositionTweak.h"
-#include "nodes/ScaleTweak.h"
-#include "nodes/RotationTweak.h"
-#include "nodes/ColorTweak.h"
-#include "nodes/PolarTweak.h"
-#include "nodes/WaveTweak.h"
-#include "nodes/SqueezeTweak.h"
-#include "nodes/SparkleTweak.h"
-#include "nodes/FuzzynessTweak.h"
-#include "nodes/ColorFuzzynessTweak.h"
-#include "nodes/SplitTweak.h"
-#include "nodes/RounderTweak.h"
 #include "nodes/OutputNode.h"
 
 #include <QVariantMap>
 
+#include <atomic>
+
 namespace gizmotweak2
 {
 
+// Ratio inputs (RatioAny/2D/1D)
+static bool isRatioPort(const Port* port)
+{
+    return port->dataType() == Port::DataType::Ratio2D ||
+           port->dataType() == Port::DataType::Ratio1D ||
+           port->dataType() == Port::DataType::RatioAny;
+}
+
+// Revisions are unique across evaluators: a SnapshotEvaluator fed from two graphs never mixes them up
+static quint64 nextRevision()
+{
+    static std::atomic<quint64> counter{0};
+    return ++counter;
+}
+
 GraphEvaluator::GraphEvaluator(QObject* parent)
     : QObject(parent)
+    , _revision(nextRevision())
 {
 }
 
@@ -41,11 +44,110 @@ void GraphEvaluator::setGraph(NodeGraph* graph)
 {
     if (_graph != graph)
     {
+        if (_graph)
+        {
+            QObject::disconnect(_graph, nullptr, this, nullptr);
+            for (int i = 0; i < _graph->rowCount(); ++i)
+            {
+                QObject::disconnect(_graph->nodeAt(i), nullptr, this, nullptr);
+            }
+        }
+
         _graph = graph;
+        _nodeRevisions.clear();
+        invalidatePlan();
+
+        if (_graph)
+        {
+            // Any topology change makes the compiled plan stale
+            QObject::connect(_graph, &NodeGraph::connectionsChanged, this, &GraphEvaluator::invalidatePlan);
+            QObject::connect(_graph, &QAbstractItemModel::rowsInserted, this, &GraphEvaluator::invalidatePlan);
+            QObject::connect(_graph, &QAbstractItemModel::rowsRemoved, this, &GraphEvaluator::invalidatePlan);
+            QObject::connect(_graph, &QAbstractItemModel::modelReset, this, &GraphEvaluator::invalidatePlan);
+
+            // Parameter edits are tracked per node (see watchNode)
+            QObject::connect(_graph, &NodeGraph::nodeAdded, this, &GraphEvaluator::watchNode);
+            for (int i = 0; i < _graph->rowCount(); ++i)
+            {
+                watchNode(_graph->nodeAt(i));
+            }
+        }
+
         emit graphValidityChanged();
     }
 }
 
+void GraphEvaluator::invalidatePlan()
+{
+    _plan = EvaluationPlan();
+    bumpRevision();
+    _planRevision = _revision;
+
+    // Nodes may have been deleted; the last snapshot must not point at them
+    _snapshot.clear();
+}
+
+void GraphEvaluator::bumpRevision()
+{
+    _revision = nextRevision();
+}
+
+void GraphEvaluator::watchNode(Node* node)
+{
+    // Parameter edits (keyframes included) don't touch the plan, only what was computed from them
+    QObject::connect(node, &Node::propertyChanged, this, [this, node]() {
+        bumpRevision();
+        _nodeRevisions[node] = _revision;
+    });
+
+    if (auto* input = qobject_cast<InputNode*>(node))
+    {
+        QObject::connect(input, &InputNode::patternNamesChanged, this, &GraphEvaluator::bumpRevision,
+                         Qt::UniqueConnection);
+    }
+}
+
+const EvaluationPlan& GraphEvaluator::plan()
+{
+    if (_plan.valid) return _plan;
+
+    _plan = EvaluationPlan();
+    _plan.path = buildFramePath();
+    _plan.outputNode = qobject_cast<OutputNode*>(findNodeByType(QStringLiteral("Output")));
+    _plan.stages.reserve(_plan.path.size());
+
+    for (auto* node : _plan.path)
+    {
+        EvaluationPlan::Stage stage;
+        stage.node = node;
+        stage.kind = node->kind();
+        stage.isTweak = node->category() == Node::Category::Tweak;
+        stage.isFrameLevel = stage.kind == Node::Kind::SparkleTweak;
+
+        for (auto* port : node->inputs())
+        {
+            if (port->dataType() == Port::DataType::RatioAny ||
+                port->dataType() == Port::DataType::Ratio2D ||
+                port->dataType() == Port::DataType::Ratio1D)
+            {
+                stage.ratioPort = port;
+                break;
+            }
+        }
+        stage.positionPort = findPositionPort(node);
+        stage.ratioSource = getConnectedNode(stage.ratioPort);
+        stage.positionSource = getConnectedNode(stage.positionPort);
+        collectCenterGizmos(stage.ratioPort, stage.centerGizmos);
+        stage.ratioSampleInvariant = isRatioSampleInvariant(stage.ratioSource);
+
+        _plan.stages.append(stage);
+    }
+
+    _plan.valid = _graph != nullptr;
+    ++_planBuildCount;
+    return _plan;
+}
+
 Node* GraphEvaluator::findNodeByType(const QString& type) const
 {
     if (!_graph) return nullptr;
@@ -65,26 +167,8 @@ Node* GraphEvaluator::getConnectedNode(Port* port) const
 {
     if (!port || !_graph) return nullptr;
 
-    // Find the connection that involves this port
-    const auto& connections = _graph->connections();
-    for (auto* conn : connections)
-    {
-        if (port->direction() == Port::Direction::In)
-        {
-            if (conn->targetPort() == port)
-            {
-                return conn->sourcePort()->node();
-            }
-        }
-        else
-        {
-            if (conn->sourcePort() == port)
-            {
-                return conn->targetPort()->node();
-            }
-        }
-    }
-    return nullptr;
+    // Hash lookup in the graph's adjacency index
+    return _graph->connectedNode(port);
 }
 
 QList<Node*> GraphEvaluator::buildFramePath()
@@ -127,741 +211,612 @@ QList<Node*> GraphEvaluator::buildFramePath()
     return path;
 }
 
-qreal GraphEvaluator::evaluateRatioChain(Port* ratioPort, qreal x, qreal y, qreal time) const
+bool GraphEvaluator::captureSnapshot(EvaluationSnapshot& snapshot, qreal time, const QList<Node*>& taps)
 {
-    if (!ratioPort || !_graph) return 1.0;
-
-    // Find the node connected to this ratio input
-    Node* sourceNode = getConnectedNode(ratioPort);
-    if (!sourceNode) return 1.0;  // No connection = full ratio
+    snapshot.clear();
+    if (!_graph) return false;
 
-    // Sync automation for this node (Gizmos, etc. not in frame path)
-    int timeMs = static_cast<int>(time * 1000.0);
-    sourceNode->syncToAnimatedValues(timeMs);
+    const auto& evalPlan = plan();
+    const int timeMs = static_cast<int>(time * 1000.0);
+    snapshot.time = time;
+    snapshot.taps.fill(-1, taps.size());
 
-    QString nodeType = sourceNode->type();
+    // Params captured by the invariant prefix end here (params are only ever appended)
+    bool prefixOpen = true;
+    int prefixParamsEnd = 0;
 
-    // Handle Gizmo
-    if (nodeType == QStringLiteral("Gizmo"))
+    // Tweaks in order
+    for (const auto& planStage : evalPlan.stages)
     {
-        auto* gizmo = qobject_cast<GizmoNode*>(sourceNode);
-        if (gizmo)
-        {
-            return gizmo->computeRatio(x, y, time);
-        }
-    }
+        auto* node = planStage.node;
 
-    // Handle Transform - combine connected inputs with geometric transformation
-    if (nodeType == QStringLiteral("Transform"))
-    {
-        auto* group = qobject_cast<GroupNode*>(sourceNode);
-        if (group)
+        if (planStage.isTweak)
         {
-            // Transform coordinates using GroupNode method
-            qreal x1, y1;
-            group->transformCoordinates(x, y, x1, y1);
+            // followGizmo is a plain property, not topology: read it once per stage
+            QVariant followGizmoProp = node->property("followGizmo");
+            bool followGizmo = followGizmoProp.isValid() ? followGizmoProp.toBool() : false;
+            bool ratioConnected = planStage.ratioPort && planStage.ratioPort->isConnected();
 
-            // In single input mode, just pass through the first input
-            if (group->singleInputMode())
+            // If followGizmo is enabled but no ratio is connected, the tweak has no effect
+            if (!followGizmo || ratioConnected)
             {
-                auto* input = sourceNode->inputAt(0);
-                if (input && input->isConnected())
+                EvaluationSnapshot::Stage stage;
+                stage.kind = planStage.kind;
+                stage.params = snapshot.snapshotIndex(node, timeMs);
+                stage.frameLevel = planStage.isFrameLevel;
+
+                // Unseeded noise (Sparkle, Fuzzyness without a seed) is never the same twice
+                const bool random = snapshot.params[stage.params].isRandom();
+                snapshot.random = snapshot.random || random;
+                bool timeInvariant = !random && !node->hasAutomation();
+
+                // Ratio: constant 1.0 without followGizmo, once per frame if the chain ignores position
+                if (followGizmo)
                 {
-                    return evaluateRatioChain(input, x1, y1, time);
+                    stage.ratioOp = captureRatioOp(snapshot, planStage.ratioSource, time);
+                    stage.uniformRatio = planStage.ratioSampleInvariant;
+                    timeInvariant = timeInvariant && snapshot.ratioOps[stage.ratioOp].timeInvariant;
                 }
-                return 0.0;
-            }
 
-            // Collect ratios from connected inputs using transformed coordinates
-            QList<qreal> ratios;
-            for (auto* input : sourceNode->inputs())
-            {
-                if (input->dataType() == Port::DataType::Ratio2D ||
-                    input->dataType() == Port::DataType::Ratio1D ||
-                    input->dataType() == Port::DataType::RatioAny)
+                // Center: position patch cord takes priority over the followed Gizmo
+                if (planStage.positionPort && planStage.positionPort->isConnected())
+                {
+                    QPointF center = capturePositionChain(snapshot, planStage.positionPort, time, timeInvariant);
+                    stage.centerX = center.x();
+                    stage.centerY = center.y();
+                }
+                else if (followGizmo)
                 {
-                    if (input->isConnected() && input->isVisible())
+                    // First Gizmo with a non-zero center, in input order
+                    for (auto* gizmo : planStage.centerGizmos)
                     {
-                        ratios.append(evaluateRatioChain(input, x1, y1, time));
+                        timeInvariant = timeInvariant && !gizmo->hasAutomation();
+                        const int index = snapshot.snapshotIndex(gizmo, timeMs);
+                        const auto& params = snapshot.params[index].get<GizmoNode::Params>();
+                        if (params.centerX != 0.0 || params.centerY != 0.0)
+                        {
+                            stage.centerX = params.centerX;
+                            stage.centerY = params.centerY;
+                            break;
+                        }
                     }
                 }
-            }
 
-            // Combine using GroupNode method (exact formulas from GizmoTweak)
-            return group->combine(ratios);
-        }
-    }
+                stage.timeInvariant = timeInvariant;
+                snapshot.stages.append(stage);
 
-    // Handle SurfaceFactory
-    if (nodeType == QStringLiteral("SurfaceFactory"))
-    {
-        auto* surface = qobject_cast<SurfaceFactoryNode*>(sourceNode);
-        if (surface)
-        {
-            // SurfaceFactory uses time as input
-            return surface->computeRatio(time);
+                prefixOpen = prefixOpen && timeInvariant;
+                if (prefixOpen)
+                {
+                    ++snapshot.invariantPrefix;
+                    prefixParamsEnd = snapshot.params.size();
+                }
+            }
         }
-    }
 
-    // Handle TimeShift
-    if (nodeType == QStringLiteral("TimeShift"))
-    {
-        auto* timeShift = qobject_cast<TimeShiftNode*>(sourceNode);
-        if (timeShift)
+        // Taps on this node see every stage captured so far
+        for (int i = 0; i < taps.size(); ++i)
         {
-            // TimeShift modifies time and passes to its input
-            qreal shiftedTime = timeShift->shiftTime(time);
-
-            // Find the ratio input of TimeShift
-            for (auto* input : sourceNode->inputs())
+            if (taps[i] == node)
             {
-                if (input->dataType() == Port::DataType::RatioAny ||
-                    input->dataType() == Port::DataType::Ratio1D ||
-                    input->dataType() == Port::DataType::Ratio2D)
-                {
-                    return evaluateRatioChain(input, x, y, shiftedTime);
-                }
+                snapshot.taps[i] = snapshot.stages.size();
             }
         }
     }
 
-    // Handle Mirror - evaluate input at mirrored coordinates
-    if (nodeType == QStringLiteral("Mirror"))
+    // Any edit of a node the prefix reads, or of the topology, gives a newer revision
+    snapshot.prefixRevision = paramsRevision(snapshot, prefixParamsEnd);
+
+    // Post-processing: line break on Output node
+    if (evalPlan.outputNode)
     {
-        auto* mirror = qobject_cast<MirrorNode*>(sourceNode);
-        if (mirror)
-        {
-            // Get mirrored coordinates
-            QPointF mirrored = mirror->mirror(x, y);
+        snapshot.lineBreakThreshold = evalPlan.outputNode->lineBreakThreshold();
+    }
 
-            // Evaluate input at mirrored position
-            for (auto* input : sourceNode->inputs())
-            {
-                if (input->dataType() == Port::DataType::Ratio2D)
-                {
-                    return evaluateRatioChain(input, mirrored.x(), mirrored.y(), time);
-                }
-            }
-        }
+    snapshot.valid = true;
+    return true;
+}
+
+quint64 GraphEvaluator::paramsRevision(const EvaluationSnapshot& snapshot, int end) const
+{
+    quint64 revision = _planRevision;
+    for (int i = 0; i < end; ++i)
+    {
+        revision = qMax(revision, _nodeRevisions.value(snapshot.params[i].node));
     }
+    return revision;
+}
 
-    return 1.0;
+int GraphEvaluator::captureRatioSnapshot(EvaluationSnapshot& snapshot, Node* source, qreal time)
+{
+    snapshot.clear();
+    if (!_graph || !source) return -1;
+
+    snapshot.time = time;
+    snapshot.valid = true;
+    return captureRatioOp(snapshot, source, time);
 }
 
-QPointF GraphEvaluator::findConnectedGizmoCenter(Port* ratioPort) const
+int GraphEvaluator::captureRatioOp(EvaluationSnapshot& snapshot, Node* sourceNode, qreal time) const
 {
-    if (!ratioPort || !_graph) return QPointF(0.0, 0.0);
+    // Slot first: nested ops are appended after their parent
+    const int index = snapshot.ratioOps.size();
+    snapshot.ratioOps.append(EvaluationSnapshot::RatioOp());
+    if (!sourceNode) return index;  // No connection = full ratio
 
-    // Find the node connected to this ratio input
-    Node* sourceNode = getConnectedNode(ratioPort);
-    if (!sourceNode) return QPointF(0.0, 0.0);
+    EvaluationSnapshot::RatioOp op;
+    op.kind = sourceNode->kind();
+    op.time = time;
+    op.timeInvariant = !sourceNode->hasAutomation();
 
-    QString nodeType = sourceNode->type();
+    // Inputs read by the op: a single port, or every connected and visible ratio input
+    Port* singleInput = nullptr;
+    bool allInputs = false;
+    qreal inputTime = time;
 
-    // Direct connection to Gizmo
-    if (nodeType == QStringLiteral("Gizmo"))
+    switch (op.kind)
+    {
+    case Node::Kind::Gizmo:
     {
-        auto* gizmo = qobject_cast<GizmoNode*>(sourceNode);
-        if (gizmo)
+        op.params = snapshot.snapshotIndex(sourceNode, static_cast<int>(time * 1000.0));
+
+        // Noise moves with time only when it has a speed
+        const auto& gizmo = snapshot.params[op.params].get<GizmoNode::Params>();
+        if (!qFuzzyIsNull(gizmo.noiseIntensity) && gizmo.noiseSpeed != 0.0)
         {
-            return QPointF(gizmo->centerX(), gizmo->centerY());
+            op.timeInvariant = false;
         }
+        break;
     }
 
-    // Transform, TimeShift, Mirror - recursively search their inputs for a Gizmo
-    if (nodeType == QStringLiteral("Transform") ||
-        nodeType == QStringLiteral("TimeShift") ||
-        nodeType == QStringLiteral("Mirror"))
+    case Node::Kind::SurfaceFactory:
+        // A function of time by definition
+        op.params = snapshot.snapshotIndex(sourceNode, static_cast<int>(time * 1000.0));
+        op.timeInvariant = false;
+        break;
+
+    case Node::Kind::Transform:
     {
-        for (auto* input : sourceNode->inputs())
+        op.params = snapshot.snapshotIndex(sourceNode, static_cast<int>(time * 1000.0));
+        if (snapshot.params[op.params].get<GroupNode::Params>().singleInputMode)
         {
-            if (input->dataType() == Port::DataType::Ratio2D ||
-                input->dataType() == Port::DataType::Ratio1D ||
-                input->dataType() == Port::DataType::RatioAny)
+            // Only the first input, and nothing (ratio 0) when it is not connected
+            auto* input = sourceNode->inputAt(0);
+            if (input && input->isConnected())
             {
-                if (input->isConnected())
-                {
-                    QPointF center = findConnectedGizmoCenter(input);
-                    if (!center.isNull() || center != QPointF(0.0, 0.0))
-                    {
-                        return center;
-                    }
-                }
+                singleInput = input;
             }
         }
-    }
-
-    return QPointF(0.0, 0.0);
-}
-
-Port* GraphEvaluator::findPositionPort(Node* node) const
-{
-    if (!node) return nullptr;
-    for (auto* port : node->inputs())
-    {
-        if (port->dataType() == Port::DataType::Position)
+        else
         {
-            return port;
+            allInputs = true;
         }
+        break;
     }
-    return nullptr;
-}
-
-QPointF GraphEvaluator::evaluatePositionChain(Port* positionPort) const
-{
-    if (!positionPort || !_graph) return QPointF(0.0, 0.0);
-
-    auto* sourceNode = getConnectedNode(positionPort);
-    if (!sourceNode) return QPointF(0.0, 0.0);
-
-    auto nodeType = sourceNode->type();
 
-    // GizmoNode: return center (0,0 for LinearWave)
-    if (nodeType == QStringLiteral("Gizmo"))
+    case Node::Kind::TimeShift:
     {
-        auto* gizmo = qobject_cast<GizmoNode*>(sourceNode);
-        if (gizmo)
+        op.params = snapshot.snapshotIndex(sourceNode, static_cast<int>(time * 1000.0));
+
+        // Everything upstream is read at the shifted time
+        inputTime = snapshot.params[op.params].get<TimeShiftNode::Params>().shiftTime(time);
+        for (auto* input : sourceNode->inputs())
         {
-            if (gizmo->shape() == GizmoNode::Shape::LinearWave)
+            if (isRatioPort(input))
             {
-                return QPointF(0.0, 0.0);
+                singleInput = input;
+                break;
             }
-            return QPointF(gizmo->centerX(), gizmo->centerY());
         }
+        break;
     }
 
-    // Transform: transform input position through geometry
-    if (nodeType == QStringLiteral("Transform"))
-    {
-        auto* group = qobject_cast<GroupNode*>(sourceNode);
-        if (group)
+    case Node::Kind::Mirror:
+        op.params = snapshot.snapshotIndex(sourceNode, static_cast<int>(time * 1000.0));
+        for (auto* input : sourceNode->inputs())
         {
-            // Find Position input on this Transform
-            auto* posInput = findPositionPort(sourceNode);
-            if (posInput && posInput->isConnected())
+            if (input->dataType() == Port::DataType::Ratio2D)
             {
-                auto inputPos = evaluatePositionChain(posInput);
-                // Apply transform: translate by position offset
-                return QPointF(inputPos.x() + group->positionX(),
-                               inputPos.y() + group->positionY());
+                singleInput = input;
+                break;
             }
-            // No Position input — use Transform's own position
-            return QPointF(group->positionX(), group->positionY());
         }
+        break;
+
+    default:
+        op.kind = Node::Kind::Unknown;  // Not a ratio source: full ratio
+        break;
     }
 
-    // Mirror: mirror input position
-    if (nodeType == QStringLiteral("Mirror"))
+    // Children take consecutive slots, reserved before recursing (nested ops add their own)
+    op.firstChild = snapshot.ratioChildren.size();
+    if (singleInput)
+    {
+        op.childCount = 1;
+    }
+    else if (allInputs)
     {
-        auto* mirror = qobject_cast<MirrorNode*>(sourceNode);
-        if (mirror)
+        for (auto* input : sourceNode->inputs())
         {
-            auto* posInput = findPositionPort(sourceNode);
-            if (posInput && posInput->isConnected())
+            if (isRatioPort(input) && input->isConnected() && input->isVisible())
             {
-                auto inputPos = evaluatePositionChain(posInput);
-                return mirror->mirror(inputPos.x(), inputPos.y());
+                ++op.childCount;
             }
-            return QPointF(0.0, 0.0);
         }
     }
+    snapshot.ratioChildren.resize(op.firstChild + op.childCount);
 
-    // TimeShift: pass-through
-    if (nodeType == QStringLiteral("TimeShift"))
+    if (singleInput)
     {
-        auto* posInput = findPositionPort(sourceNode);
-        if (posInput && posInput->isConnected())
+        const int child = captureRatioOp(snapshot, getConnectedNode(singleInput), inputTime);
+        snapshot.ratioChildren[op.firstChild] = child;
+        op.timeInvariant = op.timeInvariant && snapshot.ratioOps[child].timeInvariant;
+    }
+    else if (allInputs)
+    {
+        int slot = op.firstChild;
+        for (auto* input : sourceNode->inputs())
         {
-            return evaluatePositionChain(posInput);
+            if (isRatioPort(input) && input->isConnected() && input->isVisible())
+            {
+                const int child = captureRatioOp(snapshot, getConnectedNode(input), inputTime);
+                snapshot.ratioChildren[slot++] = child;
+                op.timeInvariant = op.timeInvariant && snapshot.ratioOps[child].timeInvariant;
+            }
         }
-        return QPointF(0.0, 0.0);
     }
 
-    return QPointF(0.0, 0.0);
+    snapshot.ratioOps[index] = op;
+    return index;
 }
 
-GraphEvaluator::Point GraphEvaluator::applyTweak(Node* tweakNode, const Point& input, qreal ratio, qreal time, int sampleIndex,
-                                                   qreal gizmoX, qreal gizmoY) const
+QPointF GraphEvaluator::capturePositionChain(EvaluationSnapshot& snapshot, Port* positionPort, qreal time,
+                                             bool& timeInvariant) const
 {
-    if (!tweakNode) return input;
-
-    Point result = input;
-    QString nodeType = tweakNode->type();
-
-    // PositionTweak
-    if (nodeType == QStringLiteral("PositionTweak"))
-    {
-        auto* tweak = qobject_cast<PositionTweak*>(tweakNode);
-        if (tweak)
-        {
-            QPointF pos = tweak->apply(input.x, input.y, ratio);
-            result.x = pos.x();
-            result.y = pos.y();
-        }
-    }
+    if (!positionPort || !_graph) return QPointF(0.0, 0.0);
 
-    // ScaleTweak
-    else if (nodeType == QStringLiteral("ScaleTweak"))
-    {
-        auto* tweak = qobject_cast<ScaleTweak*>(tweakNode);
-        if (tweak)
-        {
-            // Use same ratio for X and Y (TODO: support Ratio2D with separate components)
-            QPointF pos = tweak->apply(input.x, input.y, ratio, ratio, gizmoX, gizmoY);
-            result.x = pos.x();
-            result.y = pos.y();
-        }
-    }
+    auto* sourceNode = getConnectedNode(positionPort);
+    if (!sourceNode) return QPointF(0.0, 0.0);
 
-    // RotationTweak
-    else if (nodeType == QStringLiteral("RotationTweak"))
-    {
-        auto* tweak = qobject_cast<RotationTweak*>(tweakNode);
-        if (tweak)
-        {
-            QPointF pos = tweak->apply(input.x, input.y, ratio, gizmoX, gizmoY);
-            result.x = pos.x();
-            result.y = pos.y();
-        }
-    }
+    timeInvariant = timeInvariant && !sourceNode->hasAutomation();
 
-    // ColorTweak
-    else if (nodeType == QStringLiteral("ColorTweak"))
-    {
-        auto* tweak = qobject_cast<ColorTweak*>(tweakNode);
-        if (tweak)
-        {
-            QColor inputColor = QColor::fromRgbF(input.r, input.g, input.b);
-            QColor outputColor = tweak->apply(inputColor, ratio);
-            result.r = outputColor.redF();
-            result.g = outputColor.greenF();
-            result.b = outputColor.blueF();
-        }
-    }
+    const int timeMs = static_cast<int>(time * 1000.0);
 
-    // PolarTweak
-    else if (nodeType == QStringLiteral("PolarTweak"))
+    switch (sourceNode->kind())
     {
-        auto* tweak = qobject_cast<PolarTweak*>(tweakNode);
-        if (tweak)
-        {
-            QPointF pos = tweak->apply(input.x, input.y, ratio, ratio, gizmoX, gizmoY);
-            result.x = pos.x();
-            result.y = pos.y();
-        }
-    }
-
-    // WaveTweak
-    else if (nodeType == QStringLiteral("WaveTweak"))
+    case Node::Kind::Gizmo:
     {
-        auto* tweak = qobject_cast<WaveTweak*>(tweakNode);
-        if (tweak)
+        // GizmoNode: return center (0,0 for LinearWave)
+        const auto& gizmo = snapshot.params[snapshot.snapshotIndex(sourceNode, timeMs)].get<GizmoNode::Params>();
+        if (gizmo.shape == GizmoNode::Shape::LinearWave)
         {
-            QPointF pos = tweak->apply(input.x, input.y, ratio, gizmoX, gizmoY);
-            result.x = pos.x();
-            result.y = pos.y();
+            return QPointF(0.0, 0.0);
         }
+        return QPointF(gizmo.centerX, gizmo.centerY);
     }
 
-    // SqueezeTweak
-    else if (nodeType == QStringLiteral("SqueezeTweak"))
+    case Node::Kind::Transform:
     {
-        auto* tweak = qobject_cast<SqueezeTweak*>(tweakNode);
-        if (tweak)
+        // Transform: transform input position through geometry
+        const GroupNode::Params group =
+            snapshot.params[snapshot.snapshotIndex(sourceNode, timeMs)].get<GroupNode::Params>();
+        auto* posInput = findPositionPort(sourceNode);
+        if (posInput && posInput->isConnected())
         {
-            QPointF pos = tweak->apply(input.x, input.y, ratio, gizmoX, gizmoY);
-            result.x = pos.x();
-            result.y = pos.y();
+            auto inputPos = capturePositionChain(snapshot, posInput, time, timeInvariant);
+            // Apply transform: translate by position offset
+            return QPointF(inputPos.x() + group.positionX,
+                           inputPos.y() + group.positionY);
         }
+        // No Position input — use Transform's own position
+        return QPointF(group.positionX, group.positionY);
     }
 
-    // SparkleTweak - handled at frame level, not per-sample
-    // (sparkles are inserted between samples, not modifying individual points)
-
-    // FuzzynessTweak
-    else if (nodeType == QStringLiteral("FuzzynessTweak"))
+    case Node::Kind::Mirror:
     {
-        auto* tweak = qobject_cast<FuzzynessTweak*>(tweakNode);
-        if (tweak)
+        // Mirror: mirror input position
+        const MirrorNode::Params mirror =
+            snapshot.params[snapshot.snapshotIndex(sourceNode, timeMs)].get<MirrorNode::Params>();
+        auto* posInput = findPositionPort(sourceNode);
+        if (posInput && posInput->isConnected())
         {
-            QPointF pos = tweak->apply(QPointF(input.x, input.y), ratio, sampleIndex);
-            result.x = pos.x();
-            result.y = pos.y();
+            auto inputPos = capturePositionChain(snapshot, posInput, time, timeInvariant);
+            return mirror.mirror(inputPos.x(), inputPos.y());
         }
+        return QPointF(0.0, 0.0);
     }
 
-    // ColorFuzzynessTweak
-    else if (nodeType == QStringLiteral("ColorFuzzynessTweak"))
+    case Node::Kind::TimeShift:
     {
-        auto* tweak = qobject_cast<ColorFuzzynessTweak*>(tweakNode);
-        if (tweak)
+        // TimeShift: pass-through, upstream position read at the shifted time
+        const TimeShiftNode::Params timeShift =
+            snapshot.params[snapshot.snapshotIndex(sourceNode, timeMs)].get<TimeShiftNode::Params>();
+        auto* posInput = findPositionPort(sourceNode);
+        if (posInput && posInput->isConnected())
         {
-            QColor inputColor = QColor::fromRgbF(input.r, input.g, input.b);
-            QColor outputColor = tweak->apply(inputColor, ratio, sampleIndex);
-            result.r = outputColor.redF();
-            result.g = outputColor.greenF();
-            result.b = outputColor.blueF();
+            return capturePositionChain(snapshot, posInput, timeShift.shiftTime(time), timeInvariant);
         }
+        return QPointF(0.0, 0.0);
     }
 
-    // RounderTweak
-    else if (nodeType == QStringLiteral("RounderTweak"))
-    {
-        auto* tweak = qobject_cast<RounderTweak*>(tweakNode);
-        if (tweak)
-        {
-            QPointF pos = tweak->apply(input.x, input.y, ratio);
-            result.x = pos.x();
-            result.y = pos.y();
-        }
+    default:
+        break;
     }
 
-    // SplitTweak - handled at frame level, not per-point
-    // (splits are inserted between samples, not modifying individual points)
-
-    return result;
+    return QPointF(0.0, 0.0);
 }
 
-xengine::Frame* GraphEvaluator::evaluate(xengine::Frame* input, qreal time)
+void GraphEvaluator::collectCenterGizmos(Port* ratioPort, QList<GizmoNode*>& gizmos) const
 {
-    if (!input || !_graph) return nullptr;
+    if (!ratioPort || !_graph) return;
 
-    // Build the path from Input to Output
-    QList<Node*> path = buildFramePath();
-
-    // Use double-buffered frames for frame-level tweaks
-    xengine::Frame* currentFrame = new xengine::Frame();
-    currentFrame->clone(*input);
-
-    xengine::Frame* tempFrame = new xengine::Frame();
-
-    // Calculate time in milliseconds for automation
-    int timeMs = static_cast<int>(time * 1000.0);
-
-    // Sync ALL nodes to their animated values first (not just Tweaks)
-    for (auto* node : path)
-    {
-        node->syncToAnimatedValues(timeMs);
-    }
+    // Find the node connected to this ratio input
+    Node* sourceNode = getConnectedNode(ratioPort);
+    if (!sourceNode) return;
 
-    // Apply tweaks in order
-    for (auto* node : path)
+    switch (sourceNode->kind())
     {
-        if (node->category() != Node::Category::Tweak) continue;
-
-        QString nodeType = node->type();
+    case Node::Kind::Gizmo:
+        // Direct connection to Gizmo
+        gizmos.append(static_cast<GizmoNode*>(sourceNode));
+        break;
 
-        // Check if this is a frame-level tweak
-        if (nodeType == QStringLiteral("SparkleTweak"))
+    case Node::Kind::Transform:
+    case Node::Kind::TimeShift:
+    case Node::Kind::Mirror:
+        // Recursively search their inputs for a Gizmo
+        for (auto* input : sourceNode->inputs())
         {
-            auto* sparkleTweak = qobject_cast<SparkleTweak*>(node);
-            if (sparkleTweak)
+            if (input->dataType() == Port::DataType::Ratio2D ||
+                input->dataType() == Port::DataType::Ratio1D ||
+                input->dataType() == Port::DataType::RatioAny)
             {
-                QVariant followGizmoProp = node->property("followGizmo");
-                bool followGizmo = followGizmoProp.isValid() ? followGizmoProp.toBool() : false;
-
-                tempFrame->clear();
-
-                if (followGizmo)
-                {
-                    // Find ratio port
-                    Port* ratioPort = nullptr;
-                    for (auto* port : node->inputs())
-                    {
-                        if (port->dataType() == Port::DataType::RatioAny ||
-                            port->dataType() == Port::DataType::Ratio2D ||
-                            port->dataType() == Port::DataType::Ratio1D)
-                        {
-                            ratioPort = port;
-                            break;
-                        }
-                    }
-
-                    if (ratioPort && ratioPort->isConnected())
-                    {
-                        // Use per-sample ratio evaluation
-                        auto ratioEvaluator = [this, ratioPort, time](qreal x, qreal y) {
-                            return evaluateRatioChain(ratioPort, x, y, time);
-                        };
-                        sparkleTweak->applyToFrame(currentFrame, tempFrame, ratioEvaluator);
-                    }
-                    else
-                    {
-                        // No ratio connected with followGizmo enabled: skip effect (no transformation)
-                        continue;
-                    }
-                }
-                else
+                if (input->isConnected())
                 {
-                    // followGizmo disabled, use full ratio
-                    sparkleTweak->applyToFrame(currentFrame, tempFrame, 1.0);
+                    collectCenterGizmos(input, gizmos);
                 }
-
-                // Swap buffers
-                std::swap(currentFrame, tempFrame);
             }
-            continue;
         }
+        break;
 
-        // Per-sample tweaks
-        tempFrame->clear();
+    default:
+        break;
+    }
+}
 
-        // Find the ratio input port
-        Port* ratioPort = nullptr;
-        for (auto* port : node->inputs())
+bool GraphEvaluator::isRatioSampleInvariant(Node* sourceNode) const
+{
+    if (!sourceNode) return true;  // No connection = constant full ratio
+
+    switch (sourceNode->kind())
+    {
+    case Node::Kind::SurfaceFactory:
+        return true;
+
+    case Node::Kind::TimeShift:
+    case Node::Kind::Mirror:
+    case Node::Kind::Transform:
+        // Only invariant if everything feeding it is: coordinate transforms
+        // have no effect on a value that ignores the coordinates
+        for (auto* input : sourceNode->inputs())
         {
-            if (port->dataType() == Port::DataType::RatioAny ||
-                port->dataType() == Port::DataType::Ratio2D ||
-                port->dataType() == Port::DataType::Ratio1D)
+            if (input->dataType() == Port::DataType::Ratio2D ||
+                input->dataType() == Port::DataType::Ratio1D ||
+                input->dataType() == Port::DataType::RatioAny)
             {
-                ratioPort = port;
-                break;
+                if (input->isConnected() && !isRatioSampleInvariant(getConnectedNode(input)))
+                {
+                    return false;
+                }
             }
         }
+        return true;
 
-        // Check if this tweak has followGizmo property enabled
-        QVariant followGizmoProp = node->property("followGizmo");
-        bool followGizmo = followGizmoProp.isValid() ? followGizmoProp.toBool() : false;
+    default:
+        // Gizmo and anything unknown vary with the sample position
+        return false;
+    }
+}
 
-        // If followGizmo is enabled but no ratio is connected, skip this tweak entirely
-        // (no effect when disconnected)
-        if (followGizmo && (!ratioPort || !ratioPort->isConnected()))
+Port* GraphEvaluator::findPositionPort(Node* node) const
+{
+    if (!node) return nullptr;
+    for (auto* port : node->inputs())
+    {
+        if (port->dataType() == Port::DataType::Position)
         {
-            continue;
+            return port;
         }
+    }
+    return nullptr;
+}
 
-        // Process each sample
-        for (int i = 0; i < currentFrame->size(); ++i)
+void GraphEvaluator::syncNodes(const EvaluationSnapshot& snapshot) const
+{
+    // Only the evaluated time: a node also read through a TimeShift is shown unshifted
+    const int timeMs = static_cast<int>(snapshot.time * 1000.0);
+    for (const auto& param : snapshot.params)
+    {
+        if (param.timeMs == timeMs)
         {
-            xengine::XSample sample = currentFrame->at(i);
-            Point point{sample.getX(), sample.getY(), sample.getR(), sample.getG(), sample.getB()};
-
-            // Calculate ratio if followGizmo is enabled
-            qreal ratio = 1.0;
-            if (followGizmo && ratioPort && ratioPort->isConnected())
-            {
-                ratio = evaluateRatioChain(ratioPort, point.x, point.y, time);
-            }
+            param.node->syncToAnimatedValues(timeMs);
+        }
+    }
+}
 
-            // Find gizmo center for tweaks that use it as transformation center
-            qreal gizmoX = 0.0, gizmoY = 0.0;
-            auto* posPort = findPositionPort(node);
-            if (posPort && posPort->isConnected())
-            {
-                // Position patch cord takes priority
-                auto posCenter = evaluatePositionChain(posPort);
-                gizmoX = posCenter.x();
-                gizmoY = posCenter.y();
-            }
-            else if (followGizmo)
-            {
-                QPointF gizmoCenter = findConnectedGizmoCenter(ratioPort);
-                gizmoX = gizmoCenter.x();
-                gizmoY = gizmoCenter.y();
-            }
+const PointBuffer& GraphEvaluator::runSnapshot(qreal time, const QList<Node*>& taps)
+{
+    captureSnapshot(_snapshot, time, taps);
+    syncNodes(_snapshot);
+    return _compute.run(_snapshot);
+}
 
-            // Apply the tweak
-            point = applyTweak(node, point, ratio, time, i, gizmoX, gizmoY);
+const PointBuffer& GraphEvaluator::runCached(const xengine::Frame& input, qreal time)
+{
+    FrameCache::Key key;
+    bool cacheable = frameCacheKey(input, time, key);
 
-            tempFrame->addSample(point.x, point.y, 0.0, point.r, point.g, point.b, sample.getNb());
-        }
+    // Captured even on a hit: syncNodes keeps property panels following playback
+    captureSnapshot(_snapshot, time);
+    syncNodes(_snapshot);
 
-        // Swap buffers
-        std::swap(currentFrame, tempFrame);
+    // Noise is drawn anew on every pass: replaying a cached frame would freeze it
+    cacheable = cacheable && !_snapshot.random;
+    if (cacheable && _frameCache->find(key, _cachedPoints))
+    {
+        return _cachedPoints;
     }
 
-    // Post-processing: line break on Output node
-    auto* outputNode = qobject_cast<OutputNode*>(findNodeByType(QStringLiteral("Output")));
-    if (outputNode)
+    _compute.input().fromFrame(input);
+    const PointBuffer& output = _compute.run(_snapshot);
+    if (cacheable)
     {
-        qreal threshold = outputNode->lineBreakThreshold();
-        if (threshold > 0.0 && currentFrame->size() > 1)
-        {
-            tempFrame->clear();
-            auto prev = currentFrame->at(0);
-            tempFrame->addSample(prev);
+        _frameCache->insert(key, output);
+    }
+    return output;
+}
 
-            for (int i = 1; i < currentFrame->size(); ++i)
-            {
-                auto cur = currentFrame->at(i);
+xengine::Frame* GraphEvaluator::evaluate(xengine::Frame* input, qreal time)
+{
+    if (!input || !_graph) return nullptr;
 
-                // Only break between two colored (non-blank) samples
-                if (prev.isColored() && cur.isColored())
-                {
-                    qreal dx = cur.getX() - prev.getX();
-                    qreal dy = cur.getY() - prev.getY();
-                    qreal dist = qSqrt(dx * dx + dy * dy);
+    auto* result = new xengine::Frame();
+    runCached(*input, time).toFrame(*result);
+    return result;
+}
 
-                    if (dist > threshold)
-                    {
-                        // Insert blank at end of previous segment (same position as prev)
-                        tempFrame->addSample(prev.getX(), prev.getY(), 0.0, 0.0, 0.0, 0.0, prev.getNb());
-                        // Insert blank at start of new segment (same position as cur)
-                        tempFrame->addSample(cur.getX(), cur.getY(), 0.0, 0.0, 0.0, 0.0, cur.getNb());
-                    }
-                }
+bool GraphEvaluator::evaluateInto(const xengine::Frame& input, xengine::Frame& output, qreal time)
+{
+    if (!_graph)
+    {
+        output.clear();
+        return false;
+    }
 
-                tempFrame->addSample(cur);
-                prev = cur;
-            }
+    runCached(input, time).toFrame(output);
+    return true;
+}
 
-            std::swap(currentFrame, tempFrame);
+bool GraphEvaluator::evaluateTaps(const xengine::Frame& input, const QList<Node*>& tapNodes,
+                                  QList<xengine::Frame>& tapFrames, xengine::Frame& output, qreal time)
+{
+    tapFrames.resize(tapNodes.size());
+    if (!_graph)
+    {
+        for (auto& frame : tapFrames)
+        {
+            frame.clear();
         }
+        output.clear();
+        return false;
     }
 
-    // Clean up temp frame
-    delete tempFrame;
-
-    return currentFrame;
+    _compute.input().fromFrame(input);
+    runSnapshot(time, tapNodes).toFrame(output);
+    for (int i = 0; i < tapNodes.size(); ++i)
+    {
+        _compute.tap(i).toFrame(tapFrames[i]);
+    }
+    return true;
 }
 
 xengine::Frame* GraphEvaluator::evaluateUpTo(xengine::Frame* input, Node* stopNode, qreal time)
 {
     if (!input || !_graph || !stopNode) return nullptr;
 
-    // Build the path from Input to Output
-    QList<Node*> path = buildFramePath();
-
     // Check stopNode is in the path
-    if (!path.contains(stopNode)) return nullptr;
+    const auto& evalPlan = plan();
+    const int index = evalPlan.path.indexOf(stopNode);
+    if (index < 0) return nullptr;
 
-    // Use double-buffered frames for frame-level tweaks
-    auto* currentFrame = new xengine::Frame();
-    currentFrame->clone(*input);
-
-    auto* tempFrame = new xengine::Frame();
-
-    // Calculate time in milliseconds for automation
-    int timeMs = static_cast<int>(time * 1000.0);
-
-    // Sync ALL nodes to their animated values first
-    for (auto* node : path)
+    // Node previews ask for every node of the path at the same tick: one pass serves them all
+    auto& points = _compute.input();
+    points.fromFrame(*input);
+    if (_tapRevision != _revision || _tapTime != time || !points.equals(_tapInput))
     {
-        node->syncToAnimatedValues(timeMs);
-    }
+        _tapInput.copyFrom(points);
+        runSnapshot(time, evalPlan.path);
 
-    // Apply tweaks in order, stop after stopNode
-    for (auto* node : path)
-    {
-        if (node->category() != Node::Category::Tweak)
+        _tapPoints.resize(evalPlan.path.size());
+        for (int i = 0; i < evalPlan.path.size(); ++i)
         {
-            if (node == stopNode) break;
-            continue;
+            _tapPoints[i].copyFrom(_compute.tap(i));
         }
+        _tapRevision = _revision;
+        _tapTime = time;
+        ++_tapPassCount;
+    }
 
-        QString nodeType = node->type();
-
-        // Check if this is a frame-level tweak
-        if (nodeType == QStringLiteral("SparkleTweak"))
-        {
-            auto* sparkleTweak = qobject_cast<SparkleTweak*>(node);
-            if (sparkleTweak)
-            {
-                QVariant followGizmoProp = node->property("followGizmo");
-                bool followGizmo = followGizmoProp.isValid() ? followGizmoProp.toBool() : false;
-
-                tempFrame->clear();
-
-                if (followGizmo)
-                {
-                    Port* ratioPort = nullptr;
-                    for (auto* port : node->inputs())
-                    {
-                        if (port->dataType() == Port::DataType::RatioAny ||
-                            port->dataType() == Port::DataType::Ratio2D ||
-                            port->dataType() == Port::DataType::Ratio1D)
-                        {
-                            ratioPort = port;
-                            break;
-                        }
-                    }
-
-                    if (ratioPort && ratioPort->isConnected())
-                    {
-                        auto ratioEvaluator = [this, ratioPort, time](qreal x, qreal y) {
-                            return evaluateRatioChain(ratioPort, x, y, time);
-                        };
-                        sparkleTweak->applyToFrame(currentFrame, tempFrame, ratioEvaluator);
-                    }
-                    else
-                    {
-                        if (node == stopNode) break;
-                        continue;
-                    }
-                }
-                else
-                {
-                    sparkleTweak->applyToFrame(currentFrame, tempFrame, 1.0);
-                }
-
-                std::swap(currentFrame, tempFrame);
-            }
-
-            if (node == stopNode) break;
-            continue;
-        }
+    auto* result = new xengine::Frame();
+    _tapPoints[index].toFrame(*result);
+    return result;
+}
 
-        // Per-sample tweaks
-        tempFrame->clear();
+void GraphEvaluator::setFramePeriodMs(qreal ms)
+{
+    ms = qMax(ms, 1.0);
+    if (qFuzzyCompare(_framePeriodMs, ms)) return;
 
-        Port* ratioPort = nullptr;
-        for (auto* port : node->inputs())
-        {
-            if (port->dataType() == Port::DataType::RatioAny ||
-                port->dataType() == Port::DataType::Ratio2D ||
-                port->dataType() == Port::DataType::Ratio1D)
-            {
-                ratioPort = port;
-                break;
-            }
-        }
+    // Time slots change meaning: nothing cached so far can be hit again
+    _framePeriodMs = ms;
+    _frameCache->clear();
+}
 
-        QVariant followGizmoProp = node->property("followGizmo");
-        bool followGizmo = followGizmoProp.isValid() ? followGizmoProp.toBool() : false;
+bool GraphEvaluator::frameCacheKey(const xengine::Frame& input, qreal& time, FrameCache::Key& key)
+{
+    if (!_graph || !_frameCache->isEnabled()) return false;
 
-        if (followGizmo && (!ratioPort || !ratioPort->isConnected()))
-        {
-            if (node == stopNode) break;
-            continue;
-        }
+    auto* inputNode = qobject_cast<InputNode*>(findNodeByType(QStringLiteral("Input")));
+    if (!inputNode || inputNode->currentFrame() != &input) return false;
 
-        for (int i = 0; i < currentFrame->size(); ++i)
-        {
-            xengine::XSample sample = currentFrame->at(i);
-            Point point{sample.getX(), sample.getY(), sample.getR(), sample.getG(), sample.getB()};
+    key.revision = _revision;
+    key.pattern = reinterpret_cast<quintptr>(&input);
+    key.timeSlot = qRound64(time * 1000.0 / _framePeriodMs);
+    time = key.timeSlot * _framePeriodMs / 1000.0;
+    return true;
+}
 
-            qreal ratio = 1.0;
-            if (followGizmo && ratioPort && ratioPort->isConnected())
-            {
-                ratio = evaluateRatioChain(ratioPort, point.x, point.y, time);
-            }
+QVariantMap GraphEvaluator::frameCacheStats() const
+{
+    const auto stats = _frameCache->stats();
+    const quint64 lookups = stats.hits + stats.misses;
+
+    QVariantMap result;
+    result[QStringLiteral("hits")] = stats.hits;
+    result[QStringLiteral("misses")] = stats.misses;
+    result[QStringLiteral("hitRate")] = lookups > 0 ? qreal(stats.hits) / lookups : 0.0;
+    result[QStringLiteral("evictions")] = stats.evictions;
+    result[QStringLiteral("entries")] = stats.entries;
+    result[QStringLiteral("bytes")] = stats.bytes;
+    result[QStringLiteral("budgetBytes")] = stats.budgetBytes;
+    return result;
+}
 
-            qreal gizmoX = 0.0, gizmoY = 0.0;
-            auto* posPort = findPositionPort(node);
-            if (posPort && posPort->isConnected())
-            {
-                auto posCenter = evaluatePositionChain(posPort);
-                gizmoX = posCenter.x();
-                gizmoY = posCenter.y();
-            }
-            else if (followGizmo)
-            {
-                QPointF gizmoCenter = findConnectedGizmoCenter(ratioPort);
-                gizmoX = gizmoCenter.x();
-                gizmoY = gizmoCenter.y();
-            }
+QVariantList GraphEvaluator::stageInvariants()
+{
+    QVariantList result;
+    if (!_graph || !_snapshot.valid) return result;
 
-            point = applyTweak(node, point, ratio, time, i, gizmoX, gizmoY);
-            tempFrame->addSample(point.x, point.y, 0.0, point.r, point.g, point.b, sample.getNb());
-        }
+    // Time invariance as captured by the last evaluation (automation flags, seeds)
+    QHash<const Node*, bool> timeInvariant;
+    for (const auto& stage : _snapshot.stages)
+    {
+        timeInvariant.insert(_snapshot.params[stage.params].node, stage.timeInvariant);
+    }
 
-        std::swap(currentFrame, tempFrame);
+    for (const auto& stage : plan().stages)
+    {
+        if (!stage.isTweak) continue;
 
-        if (node == stopNode) break;
+        QVariantMap entry;
+        entry[QStringLiteral("uuid")] = stage.node->uuid();
+        entry[QStringLiteral("type")] = stage.node->type();
+        entry[QStringLiteral("ratioInvariant")] = stage.ratioSampleInvariant;
+        // Tweaks without effect (followGizmo, nothing connected) are not stages: constant
+        entry[QStringLiteral("timeInvariant")] = timeInvariant.value(stage.node, true);
+        result.append(entry);
     }
-
-    delete tempFrame;
-    return currentFrame;
+    return result;
 }
 
 QVariantList GraphEvaluator::evaluateToPoints(const QVariantList& inputPoints, qreal time)
@@ -870,8 +825,10 @@ QVariantList GraphEvaluator::evaluateToPoints(const QVariantList& inputPoints, q
 
     if (!_graph) return result;
 
-    // Convert input points to Frame for processing
-    xengine::Frame inputFrame;
+    // Load input points straight into the evaluation buffer (no intermediate Frame)
+    auto& input = _compute.input();
+    input.clear();
+    input.reserve(inputPoints.size());
     for (const auto& pointVar : inputPoints)
     {
         QVariantMap pointMap = pointVar.toMap();
@@ -880,27 +837,24 @@ QVariantList GraphEvaluator::evaluateToPoints(const QVariantList& inputPoints, q
         qreal r = pointMap.value(QStringLiteral("r"), 1.0).toReal();
         qreal g = pointMap.value(QStringLiteral("g"), 1.0).toReal();
         qreal b = pointMap.value(QStringLiteral("b"), 1.0).toReal();
-        inputFrame.addSample(x, y, 0.0, r, g, b, 1);
+        input.append(x, y, r, g, b, 1);
     }
 
-    // Use the frame-based evaluate
-    xengine::Frame* outputFrame = evaluate(&inputFrame, time);
-    if (!outputFrame) return result;
+    const auto& output = runSnapshot(time);
 
-    // Convert output frame back to QVariantList
-    for (int i = 0; i < outputFrame->size(); ++i)
+    // Convert the result buffer back to QVariantList
+    result.reserve(output.size());
+    for (int i = 0; i < output.size(); ++i)
     {
-        const auto& sample = outputFrame->at(i);
         QVariantMap resultPoint;
-        resultPoint[QStringLiteral("x")] = sample.getX();
-        resultPoint[QStringLiteral("y")] = sample.getY();
-        resultPoint[QStringLiteral("r")] = sample.getR();
-        resultPoint[QStringLiteral("g")] = sample.getG();
-        resultPoint[QStringLiteral("b")] = sample.getB();
+        resultPoint[QStringLiteral("x")] = output.xs()[i];
+        resultPoint[QStringLiteral("y")] = output.ys()[i];
+        resultPoint[QStringLiteral("r")] = output.rs()[i];
+        resultPoint[QStringLiteral("g")] = output.gs()[i];
+        resultPoint[QStringLiteral("b")] = output.bs()[i];
         result.append(resultPoint);
     }
 
-    delete outputFrame;
     return result;
 }
 
@@ -1,18 +1,58 @@
 #pragma once
 
 #include <QObject>
+#include <QHash>
 #include <QList>
 #include <QVariantList>
+#include <QVariantMap>
 #include <QtQml/qqmlregistration.h>
 
 #include <frame.h>
 
+#include <memory>
+
+#include "FrameCache.h"
+#include "Node.h"
+#include "ParamSnapshot.h"
+#include "PointBuffer.h"
+#include "SnapshotEvaluator.h"
+
 namespace gizmotweak2
 {
 
 class NodeGraph;
-class Node;
 class Port;
+class OutputNode;
+class GizmoNode;
+
+// Compiled view of the graph topology, reused across evaluations.
+// Rebuilt lazily after any connection or node list change.
+struct EvaluationPlan
+{
+    struct Stage
+    {
+        Node* node{nullptr};
+        Node::Kind kind{Node::Kind::Unknown};
+        Port* ratioPort{nullptr};       // First ratio input (RatioAny/2D/1D)
+        Port* positionPort{nullptr};    // Position input, if any
+        Node* ratioSource{nullptr};     // Node feeding ratioPort
+        Node* positionSource{nullptr};  // Node feeding positionPort
+        bool isTweak{false};
+        bool isFrameLevel{false};       // Processes the whole frame (SparkleTweak)
+
+        // Gizmos reachable from ratioPort, in search order; the first one with a
+        // non-zero center is the followGizmo transformation center
+        QList<GizmoNode*> centerGizmos;
+
+        // Ratio chain only depends on time (SurfaceFactory, ...), not on sample position
+        bool ratioSampleInvariant{true};
+    };
+
+    QList<Node*> path;                  // Input -> ... -> Output, in frame order
+    QList<Stage> stages;                // One entry per node of path
+    OutputNode* outputNode{nullptr};
+    bool valid{false};
+};
 
 class GraphEvaluator : public QObject
 {
@@ -32,16 +72,111 @@ public:
     // Evaluate the graph and return the resulting Frame
     Q_INVOKABLE xengine::Frame* evaluate(xengine::Frame* input, qreal time = 0.0);
 
-    // Evaluate the graph up to (and including) a specific node, then stop
+    // Evaluate into a caller-owned frame (cleared first), reusing evaluator buffers.
+    // Once buffers have grown to the largest pattern, no evaluator memory is allocated.
+    // Returns false if there is no graph; output is left empty then.
+    bool evaluateInto(const xengine::Frame& input, xengine::Frame& output, qreal time = 0.0);
+
+    // One pass over input: output as evaluateInto(), plus in tapFrames the points right
+    // after each of tapNodes (before Output post-processing). Taps of nodes off the frame
+    // path are left empty.
+    bool evaluateTaps(const xengine::Frame& input, const QList<Node*>& tapNodes,
+                      QList<xengine::Frame>& tapFrames, xengine::Frame& output, qreal time = 0.0);
+
+    // Points right after a specific node of the frame path (nullptr if it is not on it).
+    // The first call of a tick taps every node of the path in one pass; calls for other
+    // nodes with the same input and time reuse it until the graph changes.
     xengine::Frame* evaluateUpTo(xengine::Frame* input, Node* stopNode, qreal time = 0.0);
 
     // Evaluate and return points as QVariantList for QML (array of {x, y, r, g, b})
     Q_INVOKABLE QVariantList evaluateToPoints(const QVariantList& inputPoints, qreal time = 0.0);
 
+    // Copy everything an evaluation at time reads into snapshot (GUI thread).
+    // taps: nodes whose output the run keeps along the way (SnapshotEvaluator::tap()).
+    // The snapshot can then be run by a SnapshotEvaluator on any thread.
+    // Returns false (snapshot invalid) if there is no graph.
+    bool captureSnapshot(EvaluationSnapshot& snapshot, qreal time, const QList<Node*>& taps = {});
+
+    // Capture only the ratio subgraph rooted at source, read at time (GUI thread).
+    // Returns its op in snapshot.ratioOps, for SnapshotEvaluator::evaluateRatios() on any
+    // thread; -1 (snapshot invalid) if there is no graph or no source.
+    int captureRatioSnapshot(EvaluationSnapshot& snapshot, Node* source, qreal time);
+
+    // Newest edit of any node snapshot reads, or of the topology: a later capture with
+    // the same revision (and time) computes the same values
+    quint64 snapshotRevision(const EvaluationSnapshot& snapshot) const
+    {
+        return paramsRevision(snapshot, snapshot.params.size());
+    }
+
+    // Bring the live nodes of a snapshot to its time so property panels follow playback (GUI thread)
+    void syncNodes(const EvaluationSnapshot& snapshot) const;
+
     // Validation
     bool isGraphComplete() const;
     QStringList validationErrors() const;
 
+    // Drop the compiled plan; it is rebuilt on next evaluation
+    void invalidatePlan();
+
+    // Mark every cached frame as stale
+    void bumpRevision();
+
+    // Number of times the plan has been compiled (diagnostics)
+    int planBuildCount() const { return _planBuildCount; }
+
+    // Number of passes evaluateUpTo() actually ran (diagnostics/tests)
+    int tapPassCount() const { return _tapPassCount; }
+
+    // Number of times evaluator scratch storage had to grow (diagnostics/tests)
+    int scratchAllocationCount() const { return _compute.scratchAllocationCount(); }
+
+    // Opt-in parallel evaluation of per-sample stages, see SnapshotEvaluator
+    bool parallelEnabled() const { return _compute.parallelEnabled(); }
+    void setParallelEnabled(bool enabled) { _compute.setParallelEnabled(enabled); }
+
+    // Frames with fewer samples than this stay on the calling thread
+    int parallelThreshold() const { return _compute.parallelThreshold(); }
+    void setParallelThreshold(int samples) { _compute.setParallelThreshold(samples); }
+
+    // Number of (node, time) parameter snapshots taken by the last evaluation (diagnostics/tests)
+    int snapshotCount() const { return _snapshot.params.size(); }
+
+    // Evaluations that restarted after the cached time-invariant stage prefix (diagnostics/tests)
+    int prefixReuseCount() const { return _compute.prefixReuseCount(); }
+
+    // Bumped on any node property, connection or node list change (frame cache key).
+    // Unique across evaluators, and only ever grows.
+    quint64 revision() const { return _revision; }
+
+    // Cache of evaluated output frames, shared with evaluation threads.
+    // Off until given a memory budget; evaluate()/evaluateInto() then snap time
+    // to the frame period so that nearby times share one frame.
+    const std::shared_ptr<FrameCache>& frameCache() const { return _frameCache; }
+    qint64 frameCacheBudget() const { return _frameCache->budgetBytes(); }
+    void setFrameCacheBudget(qint64 bytes) { _frameCache->setBudgetBytes(bytes); }
+
+    // Time quantization of cached frames: the output frame period
+    qreal framePeriodMs() const { return _framePeriodMs; }
+    void setFramePeriodMs(qreal ms);
+
+    // Cache key for evaluating input at time, time snapped to the frame period.
+    // Returns false (time untouched) if the cache is off or input is not the
+    // InputNode's current pattern (the only input whose identity is known).
+    // The snapshot captured at that time decides the rest: a random one
+    // (EvaluationSnapshot::random) must be neither looked up nor stored.
+    bool frameCacheKey(const xengine::Frame& input, qreal& time, FrameCache::Key& key);
+
+    // {hits, misses, hitRate, evictions, entries, bytes, budgetBytes}
+    Q_INVOKABLE QVariantMap frameCacheStats() const;
+
+    // Per tweak stage, as of the last evaluation (empty before the first one): whether
+    // the ratio is computed once per frame instead of per sample, and whether the
+    // stage output can change with time at all. The transform center is always
+    // computed once per frame.
+    // Array of {uuid, type, ratioInvariant, timeInvariant}
+    Q_INVOKABLE QVariantList stageInvariants();
+
 signals:
     void graphValidityChanged();
 
@@ -49,34 +184,69 @@ private:
     // Build the execution order: Input → Tweaks → Output
     QList<Node*> buildFramePath();
 
+    // Return the cached plan, compiling it if the topology changed
+    const EvaluationPlan& plan();
+
+    // Capture into _snapshot, then run it over the points already loaded in _compute.input()
+    const PointBuffer& runSnapshot(qreal time, const QList<Node*>& taps = {});
+
+    // Full evaluation of input through the frame cache (loads _compute.input() on a miss)
+    const PointBuffer& runCached(const xengine::Frame& input, qreal time);
+
+    // Newest revision of the topology and of the nodes of snapshot.params[0, end)
+    quint64 paramsRevision(const EvaluationSnapshot& snapshot, int end) const;
+
+    // Pattern stack reloads can reuse frame addresses: count them as graph changes
+    void watchNode(Node* node);
+
     // Find a node by type
     Node* findNodeByType(const QString& type) const;
 
     // Get the node connected to a port
     Node* getConnectedNode(Port* port) const;
 
-    // Evaluate ratio nodes recursively
-    // Returns the ratio value for a given position and time
-    qreal evaluateRatioChain(Port* ratioPort, qreal x, qreal y, qreal time) const;
+    // Append the ratio op of sourceNode (and its inputs) read at time; returns its index
+    int captureRatioOp(EvaluationSnapshot& snapshot, Node* sourceNode, qreal time) const;
 
-    // Apply a single tweak to a point
-    struct Point { qreal x, y, r, g, b; };
-    Point applyTweak(Node* tweakNode, const Point& input, qreal ratio, qreal time, int sampleIndex,
-                     qreal gizmoX, qreal gizmoY) const;
+    // Collect the Gizmos feeding a ratio port through Transform/TimeShift/Mirror (plan build)
+    void collectCenterGizmos(Port* ratioPort, QList<GizmoNode*>& gizmos) const;
 
-    // Find the first connected Gizmo's center coordinates for a tweak
-    // Returns (0, 0) if no Gizmo is connected
-    QPointF findConnectedGizmoCenter(Port* ratioPort) const;
+    // True if a ratio source yields the same value for every sample position (plan build)
+    bool isRatioSampleInvariant(Node* sourceNode) const;
 
-    // Evaluate position chain (Position port type)
-    // Returns the center coordinates transmitted through position patch cords
-    QPointF evaluatePositionChain(Port* positionPort) const;
+    // Evaluate position chain (Position port type) from snapshotted parameters
+    // Returns the center coordinates transmitted through position patch cords;
+    // clears timeInvariant if a node of the chain is automated
+    QPointF capturePositionChain(EvaluationSnapshot& snapshot, Port* positionPort, qreal time,
+                                 bool& timeInvariant) const;
 
     // Find a Position input port on a node
     Port* findPositionPort(Node* node) const;
 
     NodeGraph* _graph{nullptr};
     mutable QStringList _validationErrors;
+
+    EvaluationPlan _plan;
+    int _planBuildCount{0};
+
+    // Last captured snapshot (reused, keeps its capacity) and the evaluator running it
+    EvaluationSnapshot _snapshot;
+    SnapshotEvaluator _compute;
+
+    quint64 _revision{0};
+    quint64 _planRevision{0};                       // Revision of the last topology change
+    QHash<const Node*, quint64> _nodeRevisions;     // Revision of each node's last edit
+    static constexpr qreal DEFAULT_FRAME_PERIOD_MS = 40.0;     // 25 fps
+    qreal _framePeriodMs{DEFAULT_FRAME_PERIOD_MS};
+    std::shared_ptr<FrameCache> _frameCache{std::make_shared<FrameCache>()};
+    PointBuffer _cachedPoints;                                  // Frame read back on a hit
+
+    // Last evaluateUpTo() pass, tapped after every node of the path
+    PointBuffer _tapInput;
+    QVector<PointBuffer> _tapPoints;    // Indexed like plan().path
+    quint64 _tapRevision{0};            // 0 = no pass yet
+    qreal _tapTime{0.0};
+    int _tapPassCount{0};
 };
 
 } // namespace gizmotweak2
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <list>
+
+namespace gizmotweak2
+{
+
+// Least recently used cache bounded by a memory budget.
+// Shared between the GUI thread and worker threads, every call locks.
+// Traits tells what a cached value costs and how it is copied in and out:
+//   static qint64 bytes(const Value& value);
+//   static void copy(const Value& from, Value& to);
+// Key needs operator== and a qHash() overload.
+template<typename Key, typename Value, typename Traits>
+class LruCache
+{
+public:
+    struct Stats
+    {
+        quint64 hits{0};
+        quint64 misses{0};
+        quint64 evictions{0};
+        int entries{0};
+        qint64 bytes{0};
+        qint64 budgetBytes{0};
+    };
+
+    explicit LruCache(qint64 budgetBytes = 0)
+        : _budgetBytes(qMax<qint64>(0, budgetBytes))
+    {
+    }
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    // 0 disables the cache (and drops its content)
+    qint64 budgetBytes() const
+    {
+        QMutexLocker locker(&_mutex);
+        return _budgetBytes;
+    }
+
+    void setBudgetBytes(qint64 bytes)
+    {
+        QMutexLocker locker(&_mutex);
+        _budgetBytes = qMax<qint64>(0, bytes);
+        evictTo(_budgetBytes);
+    }
+
+    bool isEnabled() const
+    {
+        QMutexLocker locker(&_mutex);
+        return _budgetBytes > 0;
+    }
+
+    // Copy the value cached for key into out; false (out untouched) on a miss
+    bool find(const Key& key, Value& out)
+    {
+        QMutexLocker locker(&_mutex);
+        auto it = _index.constFind(key);
+        if (it == _index.constEnd())
+        {
+            ++_misses;
+            return false;
+        }
+
+        // Most recently used goes first; splice keeps the iterator valid
+        _entries.splice(_entries.begin(), _entries, it.value());
+        Traits::copy(it.value()->value, out);
+        ++_hits;
+        return true;
+    }
+
+    // Store a copy of value, evicting least recently used entries to stay in budget
+    void insert(const Key& key, const Value& value)
+    {
+        const qint64 bytes = Traits::bytes(value);
+
+        QMutexLocker locker(&_mutex);
+        if (_budgetBytes <= 0 || bytes > _budgetBytes) return;
+
+        // Another thread may have computed the same value meanwhile
+        auto it = _index.constFind(key);
+        if (it != _index.constEnd())
+        {
+            _entries.splice(_entries.begin(), _entries, it.value());
+            return;
+        }
+
+        evictTo(_budgetBytes - bytes);
+
+        _entries.push_front(Entry());
+        Entry& entry = _entries.front();
+        entry.key = key;
+        Traits::copy(value, entry.value);
+        entry.bytes = bytes;
+        _index.insert(key, _entries.begin());
+        _bytes += bytes;
+    }
+
+    void clear()
+    {
+        QMutexLocker locker(&_mutex);
+        _entries.clear();
+        _index.clear();
+        _bytes = 0;
+    }
+
+    Stats stats() const
+    {
+        QMutexLocker locker(&_mutex);
+        Stats result;
+        result.hits = _hits;
+        result.misses = _misses;
+        result.evictions = _evictions;
+        result.entries = static_cast<int>(_index.size());
+        result.bytes = _bytes;
+        result.budgetBytes = _budgetBytes;
+        return result;
+    }
+
+    void resetStats()
+    {
+        QMutexLocker locker(&_mutex);
+        _hits = 0;
+        _misses = 0;
+        _evictions = 0;
+    }
+
+    // Memory held by a cached copy of value
+    static qint64 bytesFor(const Value& value) { return Traits::bytes(value); }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        qint64 bytes{0};
+    };
+
+    // Drop least recently used entries until bytes fit (lock held)
+    void evictTo(qint64 bytes)
+    {
+        while (_bytes > bytes && !_entries.empty())
+        {
+            const Entry& oldest = _entries.back();
+            _bytes -= oldest.bytes;
+            _index.remove(oldest.key);
+            _entries.pop_back();
+            ++_evictions;
+        }
+    }
+
+    mutable QMutex _mutex;
+    std::list<Entry> _entries;      // Most recently used first
+    QHash<Key, typename std::list<Entry>::iterator> _index;
+    qint64 _budgetBytes{0};
+    qint64 _bytes{0};
+    quint64 _hits{0};
+    quint64 _misses{0};
+    quint64 _evictions{0};
+};
+
+} // namespace gizmotweak2
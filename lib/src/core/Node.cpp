@@ -160,6 +160,12 @@ AutomationTrack* Node::createAutomationTrack(const QString& trackName, int param
     // Connect node displayName changes to track nodeNameChanged for watermark updates
     QObject::connect(this, &Node::displayNameChanged, track, &AutomationTrack::nodeNameChanged);
 
+    // Bindings resolve tracks by name
+    QObject::connect(track, &AutomationTrack::trackNameChanged, this, [this]() {
+        _boundTracks.clear();
+    });
+    _boundTracks.clear();
+
     emit automationTracksChanged();
     return track;
 }
@@ -172,6 +178,7 @@ void Node::removeAutomationTrack(const QString& trackName)
         {
             _automationTracks[i]->deleteLater();
             _automationTracks.removeAt(i);
+            _boundTracks.clear();
             emit automationTracksChanged();
             return;
         }
@@ -239,6 +246,10 @@ void Node::automationFromJson(const QJsonArray& json)
                     emit propertyChanged();
                 });
                 QObject::connect(this, &Node::displayNameChanged, track, &AutomationTrack::nodeNameChanged);
+                QObject::connect(track, &AutomationTrack::trackNameChanged, this, [this]() {
+                    _boundTracks.clear();
+                });
+                _boundTracks.clear();
             }
             else
             {
@@ -9,12 +9,16 @@
 #include <QQmlListProperty>
 #include <QtQml/qqmlregistration.h>
 
+#include <cstddef>
+
 #include "Port.h"
 #include "automation/AutomationTrack.h"
 
 namespace gizmotweak2
 {
 
+template<typename Params> struct AutomationBinding;
+
 class Node : public QObject
 {
     Q_OBJECT
@@ -31,6 +35,33 @@ public:
     };
     Q_ENUM(Category)
 
+    // Concrete node type as an enum, used by the evaluator to dispatch
+    // without string compares or qobject_cast in the per-sample loops
+    enum class Kind
+    {
+        Unknown,
+        Input,
+        Output,
+        Gizmo,
+        Transform,
+        SurfaceFactory,
+        TimeShift,
+        Mirror,
+        PositionTweak,
+        ScaleTweak,
+        RotationTweak,
+        ColorTweak,
+        PolarTweak,
+        WaveTweak,
+        SqueezeTweak,
+        SparkleTweak,
+        FuzzynessTweak,
+        ColorFuzzynessTweak,
+        SplitTweak,
+        RounderTweak
+    };
+    Q_ENUM(Kind)
+
     Q_PROPERTY(QString uuid READ uuid CONSTANT)
     Q_PROPERTY(QString type READ type CONSTANT)
     Q_PROPERTY(QString displayName READ displayName WRITE setDisplayName NOTIFY displayNameChanged)
@@ -49,6 +80,7 @@ public:
     QString uuid() const { return _uuid.toString(QUuid::WithoutBraces); }
     virtual QString type() const = 0;
     virtual Category category() const = 0;
+    virtual Kind kind() const { return Kind::Unknown; }
 
     QString displayName() const { return _displayName; }
     void setDisplayName(const QString& name);
@@ -101,6 +133,11 @@ protected:
     // Call this from derived class setters to notify property changes
     void emitPropertyChanged() { emit propertyChanged(); }
 
+    // Apply the node type's automation binding table to params at timeMs
+    // (see AutomationBinding.h; one table per node type, GUI thread like the tracks)
+    template<typename Params, std::size_t N>
+    void applyAutomation(const AutomationBinding<Params> (&bindings)[N], Params& params, int timeMs) const;
+
 public:
     Port* addInput(const QString& name, Port::DataType dataType, bool required = false);
     Port* addOutput(const QString& name, Port::DataType dataType);
@@ -121,6 +158,7 @@ private:
     QList<Port*> _inputs;
     QList<Port*> _outputs;
     QList<AutomationTrack*> _automationTracks;
+    mutable QList<AutomationTrack*> _boundTracks;   // applyAutomation() tracks, emptied when the tracks change
 };
 
 } // namespace gizmotweak2
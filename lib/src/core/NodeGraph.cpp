@@ -46,6 +46,7 @@ NodeGraph::~NodeGraph()
     // Delete connections before nodes are destroyed by QObject
     qDeleteAll(_connections);
     _connections.clear();
+    _portConnections.clear();
 
     // Clear nodes explicitly to ensure proper cleanup order
     qDeleteAll(_nodes);
@@ -162,86 +163,59 @@ Node* NodeGraph::createNode(const QString& type, QPointF position)
     return nodeByUuid(cmd->nodeUuid());
 }
 
+// Node factory table, in palette order (also drives availableNodeTypes)
+struct NodeFactoryEntry
+{
+    QString type;
+    Node* (*create)(QObject* parent);
+};
+
+template<typename T>
+static Node* createNodeOf(QObject* parent)
+{
+    return new T(parent);
+}
+
+static const QList<NodeFactoryEntry>& nodeFactory()
+{
+    static const QList<NodeFactoryEntry> table = {
+        {QStringLiteral("Input"),               &createNodeOf<InputNode>},
+        {QStringLiteral("Output"),              &createNodeOf<OutputNode>},
+        {QStringLiteral("Gizmo"),               &createNodeOf<GizmoNode>},
+        {QStringLiteral("Transform"),           &createNodeOf<GroupNode>},
+        {QStringLiteral("PositionTweak"),       &createNodeOf<PositionTweak>},
+        {QStringLiteral("ScaleTweak"),          &createNodeOf<ScaleTweak>},
+        {QStringLiteral("RotationTweak"),       &createNodeOf<RotationTweak>},
+        {QStringLiteral("ColorTweak"),          &createNodeOf<ColorTweak>},
+        {QStringLiteral("PolarTweak"),          &createNodeOf<PolarTweak>},
+        {QStringLiteral("SparkleTweak"),        &createNodeOf<SparkleTweak>},
+        {QStringLiteral("FuzzynessTweak"),      &createNodeOf<FuzzynessTweak>},
+        {QStringLiteral("ColorFuzzynessTweak"), &createNodeOf<ColorFuzzynessTweak>},
+        {QStringLiteral("SplitTweak"),          &createNodeOf<SplitTweak>},
+        {QStringLiteral("RounderTweak"),        &createNodeOf<RounderTweak>},
+        {QStringLiteral("WaveTweak"),           &createNodeOf<WaveTweak>},
+        {QStringLiteral("SqueezeTweak"),        &createNodeOf<SqueezeTweak>},
+        {QStringLiteral("TimeShift"),           &createNodeOf<TimeShiftNode>},
+        {QStringLiteral("SurfaceFactory"),      &createNodeOf<SurfaceFactoryNode>},
+        {QStringLiteral("Mirror"),              &createNodeOf<MirrorNode>}
+    };
+    return table;
+}
+
 Node* NodeGraph::createNodeInternal(const QString& type, QPointF position)
 {
-    Node* node = nullptr;
+    // Type name -> constructor, resolved once
+    static const QHash<QString, Node* (*)(QObject*)> creators = [] {
+        QHash<QString, Node* (*)(QObject*)> map;
+        for (const auto& entry : nodeFactory())
+        {
+            map.insert(entry.type, entry.create);
+        }
+        return map;
+    }();
 
-    if (type == QStringLiteral("Input"))
-    {
-        node = new InputNode(this);
-    }
-    else if (type == QStringLiteral("Output"))
-    {
-        node = new OutputNode(this);
-    }
-    else if (type == QStringLiteral("Gizmo"))
-    {
-        node = new GizmoNode(this);
-    }
-    else if (type == QStringLiteral("Transform"))
-    {
-        node = new GroupNode(this);
-    }
-    else if (type == QStringLiteral("PositionTweak"))
-    {
-        node = new PositionTweak(this);
-    }
-    else if (type == QStringLiteral("ScaleTweak"))
-    {
-        node = new ScaleTweak(this);
-    }
-    else if (type == QStringLiteral("RotationTweak"))
-    {
-        node = new RotationTweak(this);
-    }
-    else if (type == QStringLiteral("ColorTweak"))
-    {
-        node = new ColorTweak(this);
-    }
-    else if (type == QStringLiteral("PolarTweak"))
-    {
-        node = new PolarTweak(this);
-    }
-    else if (type == QStringLiteral("SparkleTweak"))
-    {
-        node = new SparkleTweak(this);
-    }
-    else if (type == QStringLiteral("FuzzynessTweak"))
-    {
-        node = new FuzzynessTweak(this);
-    }
-    else if (type == QStringLiteral("ColorFuzzynessTweak"))
-    {
-        node = new ColorFuzzynessTweak(this);
-    }
-    else if (type == QStringLiteral("SplitTweak"))
-    {
-        node = new SplitTweak(this);
-    }
-    else if (type == QStringLiteral("RounderTweak"))
-    {
-        node = new RounderTweak(this);
-    }
-    else if (type == QStringLiteral("WaveTweak"))
-    {
-        node = new WaveTweak(this);
-    }
-    else if (type == QStringLiteral("SqueezeTweak"))
-    {
-        node = new SqueezeTweak(this);
-    }
-    else if (type == QStringLiteral("TimeShift"))
-    {
-        node = new TimeShiftNode(this);
-    }
-    else if (type == QStringLiteral("SurfaceFactory"))
-    {
-        node = new SurfaceFactoryNode(this);
-    }
-    else if (type == QStringLiteral("Mirror"))
-    {
-        node = new MirrorNode(this);
-    }
+    auto create = creators.value(type, nullptr);
+    Node* node = create ? create(this) : nullptr;
 
     if (node)
     {
@@ -254,27 +228,13 @@ Node* NodeGraph::createNodeInternal(const QString& type, QPointF position)
 
 QStringList NodeGraph::availableNodeTypes() const
 {
-    return {
-        QStringLiteral("Input"),
-        QStringLiteral("Output"),
-        QStringLiteral("Gizmo"),
-        QStringLiteral("Transform"),
-        QStringLiteral("PositionTweak"),
-        QStringLiteral("ScaleTweak"),
-        QStringLiteral("RotationTweak"),
-        QStringLiteral("ColorTweak"),
-        QStringLiteral("PolarTweak"),
-        QStringLiteral("SparkleTweak"),
-        QStringLiteral("FuzzynessTweak"),
-        QStringLiteral("ColorFuzzynessTweak"),
-        QStringLiteral("SplitTweak"),
-        QStringLiteral("RounderTweak"),
-        QStringLiteral("WaveTweak"),
-        QStringLiteral("SqueezeTweak"),
-        QStringLiteral("TimeShift"),
-        QStringLiteral("SurfaceFactory"),
-        QStringLiteral("Mirror")
-    };
+    QStringList types;
+    types.reserve(nodeFactory().size());
+    for (const auto& entry : nodeFactory())
+    {
+        types.append(entry.type);
+    }
+    return types;
 }
 
 void NodeGraph::addNode(Node* node)
@@ -285,6 +245,7 @@ void NodeGraph::addNode(Node* node)
     }
 
     node->setParent(this);
+    applyAutomationBake(node);
 
     // Connect to selection changes to update hasSelection
     QObject::connect(node, &Node::selectedChanged, this, &NodeGraph::hasSelectionChanged);
@@ -355,14 +316,8 @@ void NodeGraph::disconnectPortInternal(Port* port)
         return;
     }
 
-    QList<Connection*> toRemove;
-    for (auto conn : _connections)
-    {
-        if (conn->sourcePort() == port || conn->targetPort() == port)
-        {
-            toRemove.append(conn);
-        }
-    }
+    // Copy: the index is modified while disconnecting
+    const QList<Connection*> toRemove = _portConnections.value(port);
 
     for (auto conn : toRemove)
     {
@@ -530,34 +485,74 @@ void NodeGraph::distributeSelected(const QString& mode)
     }
 }
 
-xengine::Frame* NodeGraph::evaluate(xengine::Frame* input, qreal time)
+GraphEvaluator* NodeGraph::evaluator()
 {
     if (!_evaluator)
     {
         _evaluator = new GraphEvaluator(this);
         _evaluator->setGraph(this);
     }
-    return _evaluator->evaluate(input, time);
+    return _evaluator;
 }
 
-xengine::Frame* NodeGraph::evaluateUpTo(xengine::Frame* input, Node* stopNode, qreal time)
+void NodeGraph::setAutomationBakePeriodMs(qreal periodMs)
 {
-    if (!_evaluator)
+    _automationBakePeriodMs = periodMs;
+    for (auto* node : _nodes)
     {
-        _evaluator = new GraphEvaluator(this);
-        _evaluator->setGraph(this);
+        applyAutomationBake(node);
     }
-    return _evaluator->evaluateUpTo(input, stopNode, time);
 }
 
-QVariantList NodeGraph::evaluatePoints(const QVariantList& sourcePoints, qreal time)
+void NodeGraph::setBakedAutomationReads(bool baked)
 {
-    if (!_evaluator)
+    _bakedAutomationReads = baked;
+    for (auto* node : _nodes)
     {
-        _evaluator = new GraphEvaluator(this);
-        _evaluator->setGraph(this);
+        applyAutomationBake(node);
     }
-    return _evaluator->evaluateToPoints(sourcePoints, time);
+}
+
+qint64 NodeGraph::bakedAutomationBytes() const
+{
+    qint64 bytes = 0;
+    for (auto* node : _nodes)
+    {
+        for (auto* track : node->automationTracks())
+        {
+            bytes += track->bakedBytes();
+        }
+    }
+    return bytes;
+}
+
+void NodeGraph::applyAutomationBake(Node* node) const
+{
+    for (auto* track : node->automationTracks())
+    {
+        track->setBakePeriodMs(_automationBakePeriodMs);
+        track->setBakedReads(_bakedAutomationReads);
+    }
+}
+
+xengine::Frame* NodeGraph::evaluate(xengine::Frame* input, qreal time)
+{
+    return evaluator()->evaluate(input, time);
+}
+
+bool NodeGraph::evaluateInto(const xengine::Frame& input, xengine::Frame& output, qreal time)
+{
+    return evaluator()->evaluateInto(input, output, time);
+}
+
+xengine::Frame* NodeGraph::evaluateUpTo(xengine::Frame* input, Node* stopNode, qreal time)
+{
+    return evaluator()->evaluateUpTo(input, stopNode, time);
+}
+
+QVariantList NodeGraph::evaluatePoints(const QVariantList& sourcePoints, qreal time)
+{
+    return evaluator()->evaluateToPoints(sourcePoints, time);
 }
 
 bool NodeGraph::isGraphComplete() const
@@ -590,7 +585,7 @@ Connection* NodeGraph::connect(Port* source, Port* target)
     }
 
     // Check if connection already exists
-    for (auto conn : _connections)
+    for (auto conn : _portConnections.value(source))
     {
         if ((conn->sourcePort() == source && conn->targetPort() == target) ||
             (conn->sourcePort() == target && conn->targetPort() == source))
@@ -604,7 +599,7 @@ Connection* NodeGraph::connect(Port* source, Port* target)
         target->node()->uuid(), target->name()));
 
     // Find and return the new connection
-    for (auto conn : _connections)
+    for (auto conn : _portConnections.value(source))
     {
         if (conn->sourcePort() == source && conn->targetPort() == target)
         {
@@ -622,7 +617,7 @@ Connection* NodeGraph::connectInternal(Port* source, Port* target)
     }
 
     // Check if connection already exists
-    for (auto conn : _connections)
+    for (auto conn : _portConnections.value(source))
     {
         if ((conn->sourcePort() == source && conn->targetPort() == target) ||
             (conn->sourcePort() == target && conn->targetPort() == source))
@@ -639,6 +634,7 @@ Connection* NodeGraph::connectInternal(Port* source, Port* target)
 
     auto connection = new Connection(source, target, this);
     _connections.append(connection);
+    indexConnection(connection);
 
     emit connectionCountChanged();
     emit connectionsChanged();
@@ -676,6 +672,7 @@ void NodeGraph::disconnectInternal(Connection* connection)
     }
 
     _connections.removeOne(connection);
+    unindexConnection(connection);
 
     emit connectionCountChanged();
     emit connectionsChanged();
@@ -692,14 +689,8 @@ void NodeGraph::disconnectPort(Port* port)
         return;
     }
 
-    QList<Connection*> toRemove;
-    for (auto conn : _connections)
-    {
-        if (conn->sourcePort() == port || conn->targetPort() == port)
-        {
-            toRemove.append(conn);
-        }
-    }
+    // Copy: the index is modified while disconnecting
+    const QList<Connection*> toRemove = _portConnections.value(port);
 
     for (auto conn : toRemove)
     {
@@ -714,14 +705,67 @@ Connection* NodeGraph::connectionForPort(Port* port) const
         return nullptr;
     }
 
-    for (auto conn : _connections)
+    auto it = _portConnections.constFind(port);
+    if (it == _portConnections.constEnd() || it->isEmpty())
     {
-        if (conn->sourcePort() == port || conn->targetPort() == port)
+        return nullptr;
+    }
+    return it->first();
+}
+
+Node* NodeGraph::connectedNode(Port* port) const
+{
+    auto conn = connectionForPort(port);
+    if (!conn)
+    {
+        return nullptr;
+    }
+
+    auto other = conn->sourcePort() == port ? conn->targetPort() : conn->sourcePort();
+    return other ? other->node() : nullptr;
+}
+
+void NodeGraph::indexConnection(Connection* connection)
+{
+    if (connection->sourcePort())
+    {
+        _portConnections[connection->sourcePort()].append(connection);
+    }
+    if (connection->targetPort())
+    {
+        _portConnections[connection->targetPort()].append(connection);
+    }
+}
+
+void NodeGraph::unindexConnection(Connection* connection)
+{
+    auto removeFrom = [this, connection](Port* port) {
+        auto it = _portConnections.find(port);
+        if (it != _portConnections.end() && it->removeOne(connection) && it->isEmpty())
         {
-            return conn;
+            _portConnections.erase(it);
+        }
+    };
+
+    if (connection->sourcePort() && connection->targetPort())
+    {
+        removeFrom(connection->sourcePort());
+        removeFrom(connection->targetPort());
+        return;
+    }
+
+    // A port is already gone (QPointer cleared): sweep every bucket
+    for (auto it = _portConnections.begin(); it != _portConnections.end();)
+    {
+        if (it->removeOne(connection) && it->isEmpty())
+        {
+            it = _portConnections.erase(it);
+        }
+        else
+        {
+            ++it;
         }
     }
-    return nullptr;
 }
 
 // Current file format version - increment when format changes
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QHash>
 #include <QList>
 #include <QJsonObject>
 #include <QPointF>
@@ -93,10 +94,26 @@ public:
     Q_INVOKABLE void alignSelected(const QString& mode);       // "left","center","right","top","middle","bottom"
     Q_INVOKABLE void distributeSelected(const QString& mode);   // "horizontal","vertical"
 
+    // Evaluator used by evaluate*() (created on first use), e.g. to enable parallel mode
+    GraphEvaluator* evaluator();
+
+    // Baked automation on every track, nodes added later included (see
+    // AutomationTrack::setBakePeriodMs): samples every periodMs (0: none), read
+    // instead of the keyframes while baked reads are on (playback)
+    qreal automationBakePeriodMs() const { return _automationBakePeriodMs; }
+    void setAutomationBakePeriodMs(qreal periodMs);
+    void setBakedAutomationReads(bool baked);
+
+    // Memory held by baked automation samples, all tracks together
+    Q_INVOKABLE qint64 bakedAutomationBytes() const;
+
     // Graph evaluation - returns transformed Frame
     Q_INVOKABLE xengine::Frame* evaluate(xengine::Frame* input, qreal time = 0.0);
 
-    // Evaluate graph up to (and including) a specific node
+    // Graph evaluation into a caller-owned Frame (no per-call allocation once warmed up)
+    bool evaluateInto(const xengine::Frame& input, xengine::Frame& output, qreal time = 0.0);
+
+    // Points right after a specific node (one tapped pass shared by every node of a tick)
     xengine::Frame* evaluateUpTo(xengine::Frame* input, Node* stopNode, qreal time = 0.0);
 
     // Graph evaluation - returns transformed points array [{x,y,r,g,b}, ...]
@@ -111,6 +128,10 @@ public:
     Q_INVOKABLE void disconnectPort(Port* port);
     Q_INVOKABLE Connection* connectionForPort(Port* port) const;
 
+    // Fast adjacency lookups (hash index, no scan of all connections)
+    QList<Connection*> connectionsForPort(Port* port) const { return _portConnections.value(port); }
+    Node* connectedNode(Port* port) const;
+
     // Persistence
     Q_INVOKABLE QJsonObject toJson() const;
     Q_INVOKABLE bool fromJson(const QJsonObject& json);
@@ -158,8 +179,15 @@ signals:
 private:
     void connectUndoSignals();
 
+    // Keep _portConnections in sync with _connections
+    void indexConnection(Connection* connection);
+    void unindexConnection(Connection* connection);
+
     QList<Node*> _nodes;
     QList<Connection*> _connections;
+
+    // Adjacency index: port -> connections touching it (in creation order)
+    QHash<Port*, QList<Connection*>> _portConnections;
     QUndoStack _undoStack;
 
     // Move tracking
@@ -171,6 +199,11 @@ private:
 
     // Evaluator
     GraphEvaluator* _evaluator{nullptr};
+
+    // Baked automation settings, applied to each node when it is added
+    void applyAutomationBake(Node* node) const;
+    qreal _automationBakePeriodMs{0.0};
+    bool _bakedAutomationReads{false};
 };
 
 } // namespace gizmotweak2
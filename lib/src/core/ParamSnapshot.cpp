@@ -0,0 +1,119 @@
+#include "ParamSnapshot.h"
+
+namespace gizmotweak2
+{
+
+ParamSnapshot ParamSnapshot::capture(Node* node, int timeMs)
+{
+    ParamSnapshot snapshot;
+    snapshot.node = node;
+    snapshot.timeMs = timeMs;
+    if (!node) return snapshot;
+
+    snapshot.kind = node->kind();
+
+    // kind() identifies the concrete class, so the static_casts below are safe
+    switch (snapshot.kind)
+    {
+    case Node::Kind::Gizmo:
+        snapshot.params = static_cast<const GizmoNode*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::Transform:
+        snapshot.params = static_cast<const GroupNode*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::SurfaceFactory:
+        // Not automated
+        snapshot.params = static_cast<const SurfaceFactoryNode*>(node)->params();
+        break;
+    case Node::Kind::TimeShift:
+        snapshot.params = static_cast<const TimeShiftNode*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::Mirror:
+        snapshot.params = static_cast<const MirrorNode*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::PositionTweak:
+        snapshot.params = static_cast<const PositionTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::ScaleTweak:
+        snapshot.params = static_cast<const ScaleTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::RotationTweak:
+        snapshot.params = static_cast<const RotationTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::ColorTweak:
+        snapshot.params = static_cast<const ColorTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::PolarTweak:
+        snapshot.params = static_cast<const PolarTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::WaveTweak:
+        snapshot.params = static_cast<const WaveTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::SqueezeTweak:
+        snapshot.params = static_cast<const SqueezeTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::FuzzynessTweak:
+        snapshot.params = static_cast<const FuzzynessTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::ColorFuzzynessTweak:
+        snapshot.params = static_cast<const ColorFuzzynessTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::RounderTweak:
+        snapshot.params = static_cast<const RounderTweak*>(node)->paramsAt(timeMs);
+        break;
+    case Node::Kind::SparkleTweak:
+        snapshot.params = static_cast<const SparkleTweak*>(node)->paramsAt(timeMs);
+        break;
+    default:
+        break;
+    }
+
+    return snapshot;
+}
+
+bool ParamSnapshot::isRandom() const
+{
+    switch (kind)
+    {
+    case Node::Kind::SparkleTweak:
+        return true;
+    case Node::Kind::FuzzynessTweak:
+        return !get<FuzzynessTweak::Params>().useSeed;
+    case Node::Kind::ColorFuzzynessTweak:
+        return !get<ColorFuzzynessTweak::Params>().useSeed;
+    default:
+        return false;
+    }
+}
+
+void EvaluationSnapshot::clear()
+{
+    params.clear();
+    ratioOps.clear();
+    ratioChildren.clear();
+    stages.clear();
+    taps.clear();
+    time = 0.0;
+    lineBreakThreshold = 0.0;
+    valid = false;
+    random = false;
+    invariantPrefix = 0;
+    prefixRevision = 0;
+}
+
+int EvaluationSnapshot::snapshotIndex(Node* node, int timeMs)
+{
+    // A handful of nodes per graph: a linear scan beats hashing here
+    for (int i = 0; i < params.size(); ++i)
+    {
+        if (params[i].node == node && params[i].timeMs == timeMs)
+        {
+            return i;
+        }
+    }
+
+    params.append(ParamSnapshot::capture(node, timeMs));
+    return params.size() - 1;
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QVector>
+
+#include <variant>
+
+#include "Node.h"
+
+#include "nodes/GizmoNode.h"
+#include "nodes/GroupNode.h"
+#include "nodes/SurfaceFactoryNode.h"
+#include "nodes/TimeShiftNode.h"
+#include "nodes/MirrorNode.h"
+#include "nodes/PositionTweak.h"
+#include "nodes/ScaleTweak.h"
+#include "nodes/RotationTweak.h"
+#include "nodes/ColorTweak.h"
+#include "nodes/PolarTweak.h"
+#include "nodes/WaveTweak.h"
+#include "nodes/SqueezeTweak.h"
+#include "nodes/FuzzynessTweak.h"
+#include "nodes/ColorFuzzynessTweak.h"
+#include "nodes/RounderTweak.h"
+#include "nodes/SparkleTweak.h"
+
+namespace gizmotweak2
+{
+
+// Parameters of one node at one time, copied out of the node.
+// Evaluation reads these instead of the node, so it can run on any thread
+// while the GUI keeps editing (and syncing) the live nodes.
+struct ParamSnapshot
+{
+    using Params = std::variant<std::monostate,
+                                GizmoNode::Params,
+                                GroupNode::Params,
+                                SurfaceFactoryNode::Params,
+                                TimeShiftNode::Params,
+                                MirrorNode::Params,
+                                PositionTweak::Params,
+                                ScaleTweak::Params,
+                                RotationTweak::Params,
+                                ColorTweak::Params,
+                                PolarTweak::Params,
+                                WaveTweak::Params,
+                                SqueezeTweak::Params,
+                                FuzzynessTweak::Params,
+                                ColorFuzzynessTweak::Params,
+                                RounderTweak::Params,
+                                SparkleTweak::Params>;
+
+    Node* node{nullptr};        // Source node, never dereferenced during evaluation
+    Node::Kind kind{Node::Kind::Unknown};
+    int timeMs{0};
+    Params params;              // std::monostate for nodes without parameters
+
+    template<typename T>
+    const T& get() const { return std::get<T>(params); }
+
+    // Resolve a node's automation at timeMs (GUI thread: reads automation tracks)
+    static ParamSnapshot capture(Node* node, int timeMs);
+
+    // Draws from QRandomGenerator::global(): Sparkle, and Fuzzyness / ColorFuzzyness
+    // without a seed give a different result on every evaluation
+    bool isRandom() const;
+};
+
+// Everything one evaluation reads, detached from the graph.
+// Captured by GraphEvaluator::captureSnapshot(), computed by SnapshotEvaluator.
+struct EvaluationSnapshot
+{
+    // One node of a ratio subgraph; its inputs are ratioChildren[firstChild, firstChild + childCount)
+    struct RatioOp
+    {
+        Node::Kind kind{Node::Kind::Unknown};   // Unknown = nothing connected, full ratio
+        int params{-1};                         // Index in params
+        qreal time{0.0};                        // Effective time (shifted below a TimeShift)
+        int firstChild{0};
+        int childCount{0};
+        bool timeInvariant{true};               // Same ratios at any time, inputs included
+    };
+
+    // One tweak of the frame path, in order
+    struct Stage
+    {
+        Node::Kind kind{Node::Kind::Unknown};
+        int params{-1};
+        bool frameLevel{false};     // Inserts samples (SparkleTweak)
+        int ratioOp{-1};            // Root ratio op, -1 = full ratio (followGizmo off)
+        bool uniformRatio{true};    // Ratio does not depend on the sample
+        qreal centerX{0.0};         // Transformation center (position cord or followed Gizmo)
+        qreal centerY{0.0};
+        bool timeInvariant{false};  // Same output at any time for the same input
+    };
+
+    QVector<ParamSnapshot> params;
+    QVector<RatioOp> ratioOps;
+    QVector<int> ratioChildren;
+    QVector<Stage> stages;
+
+    qreal time{0.0};
+    qreal lineBreakThreshold{0.0};  // Output post-processing, 0 = none
+    bool valid{false};
+    bool random{false};             // A stage draws unseeded noise (ParamSnapshot::isRandom)
+
+    // Points to keep along the way: number of stages applied before each tap,
+    // -1 for a tap node that is not on the frame path
+    QVector<int> taps;
+
+    // Leading time-invariant stages, and the newest edit of any node they read:
+    // two snapshots with the same pair give the same prefix output for the same input
+    int invariantPrefix{0};
+    quint64 prefixRevision{0};
+
+    // Empty, keeping capacity for the next capture
+    void clear();
+
+    // Index of (node, timeMs) in params, capturing it on first use
+    int snapshotIndex(Node* node, int timeMs);
+};
+
+} // namespace gizmotweak2
@@ -0,0 +1,146 @@
+#include "PointBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gizmotweak2
+{
+
+void PointBuffer::reserve(int count)
+{
+    if (count <= _x.size()) return;
+
+    // Arrays only ever grow; _size tracks the used part
+    _x.resize(count);
+    _y.resize(count);
+    _r.resize(count);
+    _g.resize(count);
+    _b.resize(count);
+    _repeat.resize(count);
+    ++_growthCount;
+}
+
+void PointBuffer::resize(int count)
+{
+    reserve(count);
+    _size = qMax(0, count);
+}
+
+void PointBuffer::append(qreal x, qreal y, qreal r, qreal g, qreal b, int repeat)
+{
+    if (_size == _x.size())
+    {
+        reserve(qMax(64, _size * 2));
+    }
+
+    _x[_size] = x;
+    _y[_size] = y;
+    _r[_size] = r;
+    _g[_size] = g;
+    _b[_size] = b;
+    _repeat[_size] = repeat;
+    ++_size;
+}
+
+void PointBuffer::copyFrom(const PointBuffer& other)
+{
+    if (&other == this) return;
+
+    resize(other._size);
+    std::copy_n(other._x.constData(), _size, _x.data());
+    std::copy_n(other._y.constData(), _size, _y.data());
+    std::copy_n(other._r.constData(), _size, _r.data());
+    std::copy_n(other._g.constData(), _size, _g.data());
+    std::copy_n(other._b.constData(), _size, _b.data());
+    std::copy_n(other._repeat.constData(), _size, _repeat.data());
+}
+
+bool PointBuffer::equals(const PointBuffer& other) const
+{
+    if (_size != other._size) return false;
+    if (_size == 0) return true;
+
+    const size_t bytes = static_cast<size_t>(_size) * sizeof(qreal);
+    return std::memcmp(_x.constData(), other._x.constData(), bytes) == 0 &&
+           std::memcmp(_y.constData(), other._y.constData(), bytes) == 0 &&
+           std::memcmp(_r.constData(), other._r.constData(), bytes) == 0 &&
+           std::memcmp(_g.constData(), other._g.constData(), bytes) == 0 &&
+           std::memcmp(_b.constData(), other._b.constData(), bytes) == 0 &&
+           std::memcmp(_repeat.constData(), other._repeat.constData(), _size * sizeof(int)) == 0;
+}
+
+void PointBuffer::decimate(int stride)
+{
+    if (stride <= 1 || _size <= 2) return;
+
+    // The last point is kept too, so an open path still ends where it did
+    int kept = 0;
+    for (int i = 0; i < _size; i += stride)
+    {
+        _x[kept] = _x[i];
+        _y[kept] = _y[i];
+        _r[kept] = _r[i];
+        _g[kept] = _g[i];
+        _b[kept] = _b[i];
+        _repeat[kept] = _repeat[i];
+        ++kept;
+    }
+    if ((_size - 1) % stride != 0)
+    {
+        const int last = _size - 1;
+        _x[kept] = _x[last];
+        _y[kept] = _y[last];
+        _r[kept] = _r[last];
+        _g[kept] = _g[last];
+        _b[kept] = _b[last];
+        _repeat[kept] = _repeat[last];
+        ++kept;
+    }
+    _size = kept;
+}
+
+void PointBuffer::fromFrame(const xengine::Frame& frame)
+{
+    const int count = frame.size();
+    resize(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        const auto& sample = frame.at(i);
+        _x[i] = sample.getX();
+        _y[i] = sample.getY();
+        _r[i] = sample.getR();
+        _g[i] = sample.getG();
+        _b[i] = sample.getB();
+        _repeat[i] = sample.getNb();
+    }
+}
+
+void PointBuffer::toFrame(xengine::Frame& frame) const
+{
+    frame.clear();
+    for (int i = 0; i < _size; ++i)
+    {
+        frame.addSample(_x[i], _y[i], 0.0, _r[i], _g[i], _b[i], _repeat[i]);
+    }
+}
+
+qreal* ScratchArrays::acquire(int count)
+{
+    if (_top == _arrays.size())
+    {
+        // Moving a QVector inside the list keeps its data pointer, so
+        // arrays handed out earlier stay valid
+        _arrays.append(QVector<qreal>());
+    }
+
+    auto& array = _arrays[_top++];
+    if (array.size() < count)
+    {
+        array.resize(count);
+        ++_growthCount;
+    }
+    return array.data();
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QList>
+#include <QVector>
+
+#include <frame.h>
+
+namespace gizmotweak2
+{
+
+// Structure-of-arrays point storage used inside the evaluator.
+// One contiguous array per channel so stage kernels run over plain qreal spans.
+// Capacity is kept across resize()/clear() so a buffer reused frame after
+// frame stops allocating once it has seen the largest pattern.
+// Z is not carried: laser output is 2D and tweaks always wrote z = 0.
+class PointBuffer
+{
+public:
+    PointBuffer() = default;
+
+    int size() const { return _size; }
+    bool isEmpty() const { return _size == 0; }
+    int capacity() const { return _x.size(); }
+
+    // Number of times the arrays had to grow (steady state should stop at zero)
+    int growthCount() const { return _growthCount; }
+
+    void clear() { _size = 0; }
+    void reserve(int count);
+    void resize(int count);
+
+    // Append one point (frame-level stages that insert samples)
+    void append(qreal x, qreal y, qreal r, qreal g, qreal b, int repeat);
+
+    // Deep copy of other's points into this buffer's own storage (no implicit sharing,
+    // so neither buffer detaches on its next write)
+    void copyFrom(const PointBuffer& other);
+
+    // Same points, compared bitwise
+    bool equals(const PointBuffer& other) const;
+
+    // Keep every stride-th point and the last one, in place (reduced-quality previews)
+    void decimate(int stride);
+
+    // Channel spans, valid for size() elements
+    qreal* xs() { return _x.data(); }
+    qreal* ys() { return _y.data(); }
+    qreal* rs() { return _r.data(); }
+    qreal* gs() { return _g.data(); }
+    qreal* bs() { return _b.data(); }
+    int* repeats() { return _repeat.data(); }
+
+    const qreal* xs() const { return _x.constData(); }
+    const qreal* ys() const { return _y.constData(); }
+    const qreal* rs() const { return _r.constData(); }
+    const qreal* gs() const { return _g.constData(); }
+    const qreal* bs() const { return _b.constData(); }
+    const int* repeats() const { return _repeat.constData(); }
+
+    // Non-blank sample (same meaning as XSample::isColored)
+    bool isColored(int i) const { return _r[i] > 0.0 || _g[i] > 0.0 || _b[i] > 0.0; }
+
+    // Boundary conversions
+    void fromFrame(const xengine::Frame& frame);
+    void toFrame(xengine::Frame& frame) const;
+
+private:
+    QVector<qreal> _x, _y, _r, _g, _b;
+    QVector<int> _repeat;
+    int _size{0};
+    int _growthCount{0};
+};
+
+// Stack of reusable qreal arrays for nested (recursive) scratch space.
+// acquire() hands out the next slot; a Scope releases everything it acquired.
+// Slots keep their storage, so repeated evaluations stop allocating.
+class ScratchArrays
+{
+public:
+    class Scope
+    {
+    public:
+        explicit Scope(ScratchArrays& arrays) : _arrays(arrays), _mark(arrays._top) {}
+        ~Scope() { _arrays._top = _mark; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ScratchArrays& _arrays;
+        int _mark;
+    };
+
+    // Array of at least count elements, valid until the enclosing Scope ends
+    qreal* acquire(int count);
+
+    // Slot index the next acquire() will use
+    int top() const { return _top; }
+    qreal* at(int slot) { return _arrays[slot].data(); }
+
+    int growthCount() const { return _growthCount; }
+
+private:
+    QList<QVector<qreal>> _arrays;
+    int _top{0};
+    int _growthCount{0};
+};
+
+} // namespace gizmotweak2
@@ -0,0 +1,89 @@
+#include "PreviewQuality.h"
+
+namespace gizmotweak2
+{
+
+PreviewQuality::PreviewQuality(qreal budgetMs)
+    : _budgetMs(qMax<qreal>(1.0, budgetMs))
+{
+}
+
+void PreviewQuality::touch(qint64 nowMs)
+{
+    _lastActivityMs = nowMs;
+}
+
+bool PreviewQuality::isActive(qint64 nowMs) const
+{
+    return _lastActivityMs >= 0 && nowMs - _lastActivityMs < IDLE_MS;
+}
+
+bool PreviewQuality::report(qreal costMs, qint64 nowMs)
+{
+    // Exponential average: one slow frame alone does not change the level
+    _averageMs = _samples == 0 ? costMs : _averageMs * 0.7 + costMs * 0.3;
+    ++_samples;
+
+    if (!isActive(nowMs) || _samples < MIN_SAMPLES) return false;
+
+    if (_averageMs > _budgetMs && _level < Draft)
+    {
+        setLevel(static_cast<Level>(_level + 1));
+        return true;
+    }
+    if (_averageMs < _budgetMs * RAISE_RATIO && _level > Full)
+    {
+        setLevel(static_cast<Level>(_level - 1));
+        return true;
+    }
+    return false;
+}
+
+bool PreviewQuality::settle(qint64 nowMs)
+{
+    if (_level == Full || isActive(nowMs)) return false;
+
+    setLevel(Full);
+    return true;
+}
+
+int PreviewQuality::pointStride(Level level)
+{
+    switch (level)
+    {
+    case Reduced: return 2;
+    case Draft: return 4;
+    default: return 1;
+    }
+}
+
+int PreviewQuality::heatmapDivisor(Level level)
+{
+    switch (level)
+    {
+    case Reduced: return 2;
+    case Draft: return 4;
+    default: return 1;
+    }
+}
+
+int PreviewQuality::frameIntervalMs(Level level)
+{
+    // About 30 and 15 previews per second
+    switch (level)
+    {
+    case Reduced: return 33;
+    case Draft: return 66;
+    default: return 0;
+    }
+}
+
+void PreviewQuality::setLevel(Level level)
+{
+    // Costs measured at the previous level no longer apply
+    _level = level;
+    _averageMs = 0.0;
+    _samples = 0;
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QtGlobal>
+
+namespace gizmotweak2
+{
+
+// Adaptive quality of a GUI preview under a per-frame time budget.
+// The preview reports what each frame cost it (evaluation and drawing) and
+// touches the governor whenever the user scrubs, plays or edits. While the
+// user is active, frames over budget step the level down and frames well
+// under budget step it back up; once idle, full quality returns at once.
+// Only previews use it: laser output is never computed at a lower level.
+class PreviewQuality
+{
+public:
+    enum Level
+    {
+        Full = 0,
+        Reduced = 1,
+        Draft = 2
+    };
+
+    static constexpr qreal DEFAULT_BUDGET_MS = 20.0;
+    static constexpr qint64 IDLE_MS = 300;          // No activity for this long = idle
+    static constexpr int MIN_SAMPLES = 3;           // Frames measured before the level may move again
+    static constexpr qreal RAISE_RATIO = 0.4;       // Average under budget * ratio steps back up
+
+    explicit PreviewQuality(qreal budgetMs = DEFAULT_BUDGET_MS);
+
+    qreal budgetMs() const { return _budgetMs; }
+    Level level() const { return _level; }
+
+    // Smoothed frame cost since the level last changed, 0 before any frame
+    qreal averageCostMs() const { return _averageMs; }
+
+    // The user scrubbed, played or edited at nowMs
+    void touch(qint64 nowMs);
+    bool isActive(qint64 nowMs) const;
+
+    // One preview frame cost costMs; frames measured while idle never lower the level
+    // Returns true if the level changed
+    bool report(qreal costMs, qint64 nowMs);
+
+    // Full quality once idle; returns true if the level changed
+    bool settle(qint64 nowMs);
+
+    // What each level draws: every n-th input point, heatmap cells divided by n,
+    // and the minimum time between two preview frames
+    static int pointStride(Level level);
+    static int heatmapDivisor(Level level);
+    static int frameIntervalMs(Level level);
+
+private:
+    void setLevel(Level level);
+
+    qreal _budgetMs;
+    Level _level{Full};
+    qreal _averageMs{0.0};
+    int _samples{0};
+    qint64 _lastActivityMs{-1};
+};
+
+} // namespace gizmotweak2
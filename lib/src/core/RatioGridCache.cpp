@@ -0,0 +1,11 @@
+#include "RatioGridCache.h"
+
+namespace gizmotweak2
+{
+
+qint64 RatioGridTraits::bytes(const QVector<qreal>& ratios)
+{
+    return static_cast<qint64>(ratios.size()) * sizeof(qreal);
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "LruCache.h"
+
+namespace gizmotweak2
+{
+
+// Identity of a node preview ratio grid
+struct RatioGridKey
+{
+    QString uuid;           // Node::uuid() of the previewed node
+    quint64 revision{0};    // GraphEvaluator::snapshotRevision() of its ratio snapshot
+    qint64 timeMs{0};       // Preview time, at the resolution snapshots are captured
+    int resolution{0};      // Cells per side
+
+    bool operator==(const RatioGridKey& other) const
+    {
+        return revision == other.revision && timeMs == other.timeMs &&
+               resolution == other.resolution && uuid == other.uuid;
+    }
+};
+
+inline size_t qHash(const RatioGridKey& key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.uuid, key.revision, key.timeMs, key.resolution);
+}
+
+// Grids are shared, not copied
+struct RatioGridTraits
+{
+    static qint64 bytes(const QVector<qreal>& ratios);
+    static void copy(const QVector<qreal>& from, QVector<qreal>& to) { to = from; }
+};
+
+// LRU cache of node preview ratio grids, bounded by a memory budget.
+// Keyed by node uuid rather than address, and by the revision of everything the
+// grid was computed from (GraphEvaluator::snapshotRevision), so a parameter edit
+// or a reused address can never return a stale grid. Looping playback hits the
+// grids of the previous loop.
+class RatioGridCache : public LruCache<RatioGridKey, QVector<qreal>, RatioGridTraits>
+{
+public:
+    using Key = RatioGridKey;
+
+    static constexpr qint64 DEFAULT_BUDGET_BYTES = 16 * 1024 * 1024;
+
+    explicit RatioGridCache(qint64 budgetBytes = DEFAULT_BUDGET_BYTES)
+        : LruCache(budgetBytes)
+    {
+    }
+};
+
+} // namespace gizmotweak2
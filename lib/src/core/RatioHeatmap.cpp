@@ -0,0 +1,106 @@
+#include "RatioHeatmap.h"
+
+#include <QtMath>
+
+#include <algorithm>
+
+namespace gizmotweak2
+{
+
+// Smallest pass worth showing before the full resolution one
+static constexpr int COARSEST_PASS = 4;
+
+QRgb RatioHeatmap::colorOf(qreal ratio)
+{
+    // Near-zero values are black
+    if (qAbs(ratio) < 0.004)  // ~1/255
+    {
+        return qRgb(0, 0, 0);
+    }
+
+    if (ratio >= 0.0)
+    {
+        // Positive: Blue → Cyan → Green
+        int pixValue = qMin(qMax(0, int(ratio * 255.0)), 255);
+
+        if (pixValue >= 128)
+        {
+            // 128-255: Cyan (0,255,255) → Green (0,255,0)
+            int blue = int((1.0 - (pixValue - 128) / 127.0) * 255.0);
+            return qRgb(0, 255, blue);
+        }
+
+        // 0-127: Blue (0,0,255) → Cyan (0,255,255)
+        int green = int((pixValue / 127.0) * 255.0);
+        return qRgb(0, green, 255);
+    }
+
+    // Negative: Red → Magenta
+    int pixValue = qMin(qMax(0, int(-ratio * 255.0)), 255);
+
+    if (pixValue >= 128)
+    {
+        // 128-255: Magenta (255,0,255) → Red (255,0,0)
+        int blue = int((1.0 - (pixValue - 128) / 127.0) * 255.0);
+        return qRgb(255, 0, blue);
+    }
+
+    // 0-127: Red (255,0,0) → Magenta (255,0,255)
+    int blue = int((pixValue / 127.0) * 255.0);
+    return qRgb(255, 0, blue);
+}
+
+QList<int> RatioHeatmap::passResolutions(int resolution)
+{
+    QList<int> passes{qMax(2, resolution)};
+    while (passes.first() / 2 >= COARSEST_PASS)
+    {
+        passes.prepend(passes.first() / 2);
+    }
+    return passes;
+}
+
+bool RatioHeatmap::render(const EvaluationSnapshot& snapshot, int op, int resolution, QImage& image,
+                          QVector<qreal>* ratios, const std::function<bool()>& cancelled)
+{
+    resolution = qMax(2, resolution);
+    if (image.width() != resolution || image.height() != resolution || image.format() != QImage::Format_RGB32)
+    {
+        image = QImage(resolution, resolution, QImage::Format_RGB32);
+    }
+    if (ratios)
+    {
+        ratios->resize(resolution * resolution);
+    }
+
+    // Same X for every row: normalized [-1, +1] cell coordinates
+    _xs.resize(resolution);
+    _ys.resize(resolution);
+    _row.resize(resolution);
+    for (int ix = 0; ix < resolution; ++ix)
+    {
+        _xs[ix] = (qreal(ix) / (resolution - 1)) * 2.0 - 1.0;
+    }
+
+    for (int iy = 0; iy < resolution; ++iy)
+    {
+        if (cancelled && cancelled()) return false;
+
+        // Y inverted: row 0 is the top of the preview
+        std::fill(_ys.begin(), _ys.end(), 1.0 - (qreal(iy) / (resolution - 1)) * 2.0);
+        _evaluator.evaluateRatios(snapshot, op, _xs.constData(), _ys.constData(), resolution, _row.data());
+
+        auto* line = reinterpret_cast<QRgb*>(image.scanLine(iy));
+        for (int ix = 0; ix < resolution; ++ix)
+        {
+            line[ix] = colorOf(_row[ix]);
+        }
+        if (ratios)
+        {
+            std::copy(_row.constBegin(), _row.constEnd(), ratios->begin() + iy * resolution);
+        }
+    }
+    return true;
+}
+
+} // namespace gizmotweak2
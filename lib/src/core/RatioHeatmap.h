@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QImage>
+#include <QList>
+#include <QVector>
+
+#include <functional>
+
+#include "ParamSnapshot.h"
+#include "SnapshotEvaluator.h"
+
+namespace gizmotweak2
+{
+
+// Node preview heatmap: the ratio of a captured ratio subgraph over [-1, +1]²,
+// one pixel per cell, Y up. Reads nothing but the snapshot (see
+// GraphEvaluator::captureRatioSnapshot), so it renders on any thread;
+// one instance per thread, its buffers are reused across renders.
+class RatioHeatmap
+{
+public:
+    // Blue -> cyan -> green for positive ratios, red -> magenta for negative ones, black near 0
+    static QRgb colorOf(qreal ratio);
+
+    // Coarse to fine: each pass twice the previous one, the last one is resolution
+    static QList<int> passResolutions(int resolution);
+
+    // Render op at resolution x resolution into image (RGB32, scanlines written in place)
+    // and, if given, the ratios row by row. cancelled is polled between rows: returns
+    // false, image incomplete, as soon as it says so.
+    bool render(const EvaluationSnapshot& snapshot, int op, int resolution, QImage& image,
+                QVector<qreal>* ratios = nullptr, const std::function<bool()>& cancelled = {});
+
+private:
+    SnapshotEvaluator _evaluator;
+    QVector<qreal> _xs;
+    QVector<qreal> _ys;
+    QVector<qreal> _row;
+};
+
+} // namespace gizmotweak2
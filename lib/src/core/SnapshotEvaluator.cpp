@@ -0,0 +1,481 @@
+#include "SnapshotEvaluator.h"
+
+#include <QtMath>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <algorithm>
+#include <atomic>
+
+namespace gizmotweak2
+{
+
+// Parallel per-sample stages: smallest chunk worth a thread hop, and how many
+// chunks per thread to queue so faster threads can take over slower ones' work
+static constexpr int MIN_PARALLEL_CHUNK = 1024;
+static constexpr int CHUNKS_PER_WORKER = 4;
+
+int SnapshotEvaluator::scratchAllocationCount() const
+{
+    int count = _bufferA.growthCount() + _bufferB.growthCount();
+    for (const auto& scratch : _batchScratch)
+    {
+        count += scratch.arrays.growthCount() + scratch.combineGrowthCount;
+    }
+    return count;
+}
+
+const PointBuffer& SnapshotEvaluator::run(const EvaluationSnapshot& snapshot)
+{
+    // Ping-pong SoA buffers: stages read *current and write in place or into *next
+    PointBuffer* current = &_bufferA;
+    PointBuffer* next = &_bufferB;
+
+    if (!snapshot.valid) return *current;
+
+    // Per-thread scratch is sized up front: it must not move while stages hold on to it
+    if (_parallelEnabled)
+    {
+        const int threads = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+        if (_batchScratch.size() < threads)
+        {
+            _batchScratch.resize(threads);
+        }
+    }
+
+    if (_taps.size() < snapshot.taps.size())
+    {
+        _taps.resize(snapshot.taps.size());
+    }
+    for (int i = 0; i < snapshot.taps.size(); ++i)
+    {
+        _taps[i].clear();
+    }
+    keepTaps(snapshot, 0, *current);
+
+    // Same time-invariant prefix over the same input as last time: start after it,
+    // unless a tap needs the points of a stage inside it
+    const int prefix = snapshot.invariantPrefix;
+    int firstStage = 0;
+    if (prefix > 0)
+    {
+        bool tapInPrefix = false;
+        for (int stageCount : snapshot.taps)
+        {
+            tapInPrefix = tapInPrefix || (stageCount > 0 && stageCount < prefix);
+        }
+
+        if (!tapInPrefix && prefix == _prefixStages && snapshot.prefixRevision == _prefixRevision &&
+            current->equals(_prefixInput))
+        {
+            current->copyFrom(_prefixOutput);
+            firstStage = prefix;
+            ++_prefixReuseCount;
+            keepTaps(snapshot, firstStage, *current);
+        }
+        else
+        {
+            _prefixInput.copyFrom(*current);
+            _prefixStages = 0;      // Until the prefix has run below
+        }
+    }
+
+    for (int i = firstStage; i < snapshot.stages.size(); ++i)
+    {
+        const auto& stage = snapshot.stages[i];
+
+        // Frame-level tweak: inserts samples, so it goes through Frame scratch storage
+        if (stage.frameLevel)
+        {
+            applySparkle(snapshot, stage, *current);
+        }
+        else
+        {
+            applyStage(snapshot, stage, *current);
+        }
+
+        keepTaps(snapshot, i + 1, *current);
+
+        if (i + 1 == prefix)
+        {
+            _prefixOutput.copyFrom(*current);
+            _prefixStages = prefix;
+            _prefixRevision = snapshot.prefixRevision;
+        }
+    }
+
+    // Post-processing: line break on Output node, after the taps
+    if (snapshot.lineBreakThreshold > 0.0 && current->size() > 1)
+    {
+        applyLineBreak(snapshot.lineBreakThreshold, *current, *next);
+        std::swap(current, next);
+    }
+
+    return *current;
+}
+
+void SnapshotEvaluator::applyStage(const EvaluationSnapshot& snapshot, const EvaluationSnapshot::Stage& stage,
+                                   PointBuffer& buffer)
+{
+    // Per-sample tweak: kernel calls over the buffer arrays, in place
+    const int count = buffer.size();
+    auto& mainScratch = _batchScratch[0];
+    ScratchArrays::Scope scratchScope(mainScratch.arrays);
+
+    // Ratio that does not depend on the sample: evaluated once for the frame
+    qreal uniformRatio = 1.0;
+    if (stage.uniformRatio && stage.ratioOp >= 0)
+    {
+        const qreal origin = 0.0;
+        evaluateRatioBatch(snapshot, stage.ratioOp, &origin, &origin, 1, &uniformRatio, mainScratch);
+    }
+
+    // Ratio array only when it is not 1.0 everywhere (nullptr = 1.0)
+    const bool perSampleRatio = !stage.uniformRatio;
+    qreal* ratios = nullptr;
+    if (perSampleRatio || uniformRatio != 1.0)
+    {
+        ratios = mainScratch.arrays.acquire(count);
+        if (!perSampleRatio)
+        {
+            std::fill(ratios, ratios + count, uniformRatio);
+        }
+    }
+
+    // Every sample only depends on its own coordinates and index, so any
+    // split into [begin, end) ranges gives the same result as one call
+    const ParamSnapshot& tweak = snapshot.params[stage.params];
+    PointBuffer* points = &buffer;
+    auto runChunk = [this, &snapshot, &stage, &tweak, points, ratios, perSampleRatio](int begin, int end,
+                                                                                    BatchScratch& scratch) {
+        const int n = end - begin;
+        if (n <= 0) return;
+
+        if (perSampleRatio)
+        {
+            evaluateRatioBatch(snapshot, stage.ratioOp, points->xs() + begin, points->ys() + begin, n,
+                               ratios + begin, scratch);
+        }
+        applyTweakBatch(tweak, n, begin, ratios ? ratios + begin : nullptr,
+                        stage.centerX, stage.centerY,
+                        points->xs() + begin, points->ys() + begin,
+                        points->rs() + begin, points->gs() + begin, points->bs() + begin);
+    };
+
+    if (!runChunked(count, runChunk))
+    {
+        runChunk(0, count, mainScratch);
+    }
+}
+
+void SnapshotEvaluator::evaluateRatios(const EvaluationSnapshot& snapshot, int op,
+                                       const qreal* xs, const qreal* ys, int count, qreal* out)
+{
+    evaluateRatioBatch(snapshot, op, xs, ys, count, out, _batchScratch[0]);
+}
+
+void SnapshotEvaluator::keepTaps(const EvaluationSnapshot& snapshot, int stageCount, const PointBuffer& buffer)
+{
+    for (int i = 0; i < snapshot.taps.size(); ++i)
+    {
+        if (snapshot.taps[i] == stageCount)
+        {
+            _taps[i].copyFrom(buffer);
+        }
+    }
+}
+
+bool SnapshotEvaluator::runChunked(int count, const ChunkFunction& chunk)
+{
+    if (!_parallelEnabled || count < _parallelThreshold) return false;
+
+    auto* pool = QThreadPool::globalInstance();
+    const int workers = std::min({pool->maxThreadCount(), int(_batchScratch.size()),
+                                  (count + MIN_PARALLEL_CHUNK - 1) / MIN_PARALLEL_CHUNK});
+    if (workers < 2) return false;
+
+    // More chunks than workers: threads that finish early pick up the remaining ones
+    const int chunkCount = qMin((count + MIN_PARALLEL_CHUNK - 1) / MIN_PARALLEL_CHUNK, workers * CHUNKS_PER_WORKER);
+    const int chunkSize = (count + chunkCount - 1) / chunkCount;
+    std::atomic<int> nextChunk{0};
+    QSemaphore finished;
+
+    auto work = [&](int worker) {
+        int index;
+        while ((index = nextChunk.fetch_add(1)) < chunkCount)
+        {
+            const int begin = index * chunkSize;
+            chunk(begin, qMin(begin + chunkSize, count), _batchScratch[worker]);
+        }
+    };
+
+    // Threads the pool cannot give right now are simply not waited for
+    int started = 0;
+    for (int worker = 1; worker < workers; ++worker)
+    {
+        if (!pool->tryStart([&work, &finished, worker]() {
+                work(worker);
+                finished.release();
+            }))
+        {
+            break;
+        }
+        ++started;
+    }
+
+    work(0);
+    finished.acquire(started);
+    return true;
+}
+
+void SnapshotEvaluator::evaluateRatioBatch(const EvaluationSnapshot& snapshot, int op,
+                                           const qreal* xs, const qreal* ys, int count,
+                                           qreal* out, BatchScratch& scratch) const
+{
+    if (op < 0)
+    {
+        std::fill(out, out + count, 1.0);  // followGizmo off = full ratio
+        return;
+    }
+
+    const auto& ratioOp = snapshot.ratioOps[op];
+    const int* children = snapshot.ratioChildren.constData() + ratioOp.firstChild;
+
+    switch (ratioOp.kind)
+    {
+    case Node::Kind::Gizmo:
+    {
+        const auto& gizmo = snapshot.params[ratioOp.params].get<GizmoNode::Params>();
+        for (int i = 0; i < count; ++i)
+        {
+            out[i] = gizmo.computeRatio(xs[i], ys[i], ratioOp.time);
+        }
+        return;
+    }
+
+    case Node::Kind::Transform:
+    {
+        const auto& group = snapshot.params[ratioOp.params].get<GroupNode::Params>();
+
+        ScratchArrays::Scope scratchScope(scratch.arrays);
+
+        // One rotation/scale setup for all points
+        qreal* localX = scratch.arrays.acquire(count);
+        qreal* localY = scratch.arrays.acquire(count);
+        group.transformCoordinatesBatch(xs, ys, count, localX, localY);
+
+        // Single input mode: the first input passes through, nothing connected gives 0
+        if (group.singleInputMode)
+        {
+            if (ratioOp.childCount > 0)
+            {
+                evaluateRatioBatch(snapshot, children[0], localX, localY, count, out, scratch);
+            }
+            else
+            {
+                std::fill(out, out + count, 0.0);
+            }
+            return;
+        }
+
+        // Evaluate every input over the whole batch. Nested calls release their
+        // scratch before returning, so the per-input arrays occupy consecutive
+        // slots starting at firstSlot.
+        const int firstSlot = scratch.arrays.top();
+        for (int j = 0; j < ratioOp.childCount; ++j)
+        {
+            qreal* ratios = scratch.arrays.acquire(count);
+            evaluateRatioBatch(snapshot, children[j], localX, localY, count, ratios, scratch);
+        }
+
+        // Combine per point (the list keeps its capacity across points and calls)
+        if (scratch.combineRatios.capacity() < ratioOp.childCount)
+        {
+            scratch.combineRatios.reserve(ratioOp.childCount);
+            ++scratch.combineGrowthCount;
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            scratch.combineRatios.clear();
+            for (int j = 0; j < ratioOp.childCount; ++j)
+            {
+                scratch.combineRatios.append(scratch.arrays.at(firstSlot + j)[i]);
+            }
+            out[i] = group.combine(scratch.combineRatios);
+        }
+        return;
+    }
+
+    case Node::Kind::SurfaceFactory:
+    {
+        // Depends on time only
+        const auto& surface = snapshot.params[ratioOp.params].get<SurfaceFactoryNode::Params>();
+        std::fill(out, out + count, surface.computeRatio(ratioOp.time));
+        return;
+    }
+
+    case Node::Kind::TimeShift:
+        // The input was captured at the shifted time
+        if (ratioOp.childCount > 0)
+        {
+            evaluateRatioBatch(snapshot, children[0], xs, ys, count, out, scratch);
+            return;
+        }
+        break;
+
+    case Node::Kind::Mirror:
+        if (ratioOp.childCount > 0)
+        {
+            const auto& mirror = snapshot.params[ratioOp.params].get<MirrorNode::Params>();
+
+            ScratchArrays::Scope scratchScope(scratch.arrays);
+            qreal* mirroredX = scratch.arrays.acquire(count);
+            qreal* mirroredY = scratch.arrays.acquire(count);
+            for (int i = 0; i < count; ++i)
+            {
+                QPointF mirrored = mirror.mirror(xs[i], ys[i]);
+                mirroredX[i] = mirrored.x();
+                mirroredY[i] = mirrored.y();
+            }
+            evaluateRatioBatch(snapshot, children[0], mirroredX, mirroredY, count, out, scratch);
+            return;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    std::fill(out, out + count, 1.0);
+}
+
+void SnapshotEvaluator::applyTweakBatch(const ParamSnapshot& tweak, int count, int firstIndex,
+                                        const qreal* ratios, qreal gizmoX, qreal gizmoY,
+                                        qreal* xs, qreal* ys, qreal* rs, qreal* gs, qreal* bs) const
+{
+    if (count <= 0) return;
+
+    // kind was set with the params alternative, so the get<>()s below match
+    switch (tweak.kind)
+    {
+    case Node::Kind::PositionTweak:
+        tweak.get<PositionTweak::Params>().applyBatch(xs, ys, ratios, count, xs, ys);
+        break;
+
+    case Node::Kind::ScaleTweak:
+        // Use same ratio for X and Y (TODO: support Ratio2D with separate components)
+        tweak.get<ScaleTweak::Params>().applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, xs, ys);
+        break;
+
+    case Node::Kind::RotationTweak:
+        tweak.get<RotationTweak::Params>().applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, xs, ys);
+        break;
+
+    case Node::Kind::ColorTweak:
+        tweak.get<ColorTweak::Params>().applyBatch(rs, gs, bs, ratios, count, rs, gs, bs);
+        break;
+
+    case Node::Kind::PolarTweak:
+        tweak.get<PolarTweak::Params>().applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, xs, ys);
+        break;
+
+    case Node::Kind::WaveTweak:
+        tweak.get<WaveTweak::Params>().applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, xs, ys);
+        break;
+
+    case Node::Kind::SqueezeTweak:
+        tweak.get<SqueezeTweak::Params>().applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, xs, ys);
+        break;
+
+    case Node::Kind::FuzzynessTweak:
+        tweak.get<FuzzynessTweak::Params>().applyBatch(xs, ys, ratios, count, firstIndex, xs, ys);
+        break;
+
+    case Node::Kind::ColorFuzzynessTweak:
+        tweak.get<ColorFuzzynessTweak::Params>().applyBatch(rs, gs, bs, ratios, count, firstIndex, rs, gs, bs);
+        break;
+
+    case Node::Kind::RounderTweak:
+        tweak.get<RounderTweak::Params>().applyBatch(xs, ys, ratios, count, xs, ys);
+        break;
+
+    // SparkleTweak is handled at frame level (samples are inserted between
+    // points, not modified); SplitTweak has no per-sample effect
+    default:
+        break;
+    }
+}
+
+void SnapshotEvaluator::applySparkle(const EvaluationSnapshot& snapshot, const EvaluationSnapshot::Stage& stage,
+                                     PointBuffer& buffer)
+{
+    const auto& sparkle = snapshot.params[stage.params].get<SparkleTweak::Params>();
+    auto& scratch = _batchScratch[0];
+
+    buffer.toFrame(_stageFrameIn);
+    _stageFrameOut.clear();
+
+    const int op = stage.ratioOp;
+    if (!stage.uniformRatio)
+    {
+        // Use per-sample ratio evaluation
+        auto ratioEvaluator = [this, &snapshot, op, &scratch](qreal x, qreal y) {
+            qreal ratio = 1.0;
+            evaluateRatioBatch(snapshot, op, &x, &y, 1, &ratio, scratch);
+            return ratio;
+        };
+        sparkle.applyToFrame(&_stageFrameIn, &_stageFrameOut, ratioEvaluator);
+    }
+    else
+    {
+        // followGizmo disabled (full ratio) or ratio constant over the frame
+        qreal ratio = 1.0;
+        if (op >= 0)
+        {
+            const qreal origin = 0.0;
+            evaluateRatioBatch(snapshot, op, &origin, &origin, 1, &ratio, scratch);
+        }
+        sparkle.applyToFrame(&_stageFrameIn, &_stageFrameOut, ratio);
+    }
+
+    buffer.fromFrame(_stageFrameOut);
+}
+
+void SnapshotEvaluator::applyLineBreak(qreal threshold, const PointBuffer& in, PointBuffer& out) const
+{
+    const int count = in.size();
+    const qreal* xs = in.xs();
+    const qreal* ys = in.ys();
+    const qreal* rs = in.rs();
+    const qreal* gs = in.gs();
+    const qreal* bs = in.bs();
+    const int* repeats = in.repeats();
+
+    out.clear();
+    out.reserve(count);
+    out.append(xs[0], ys[0], rs[0], gs[0], bs[0], repeats[0]);
+
+    for (int i = 1; i < count; ++i)
+    {
+        const int prev = i - 1;
+
+        // Only break between two colored (non-blank) samples
+        if (in.isColored(prev) && in.isColored(i))
+        {
+            qreal dx = xs[i] - xs[prev];
+            qreal dy = ys[i] - ys[prev];
+            qreal dist = qSqrt(dx * dx + dy * dy);
+
+            if (dist > threshold)
+            {
+                // Insert blank at end of previous segment (same position as prev)
+                out.append(xs[prev], ys[prev], 0.0, 0.0, 0.0, repeats[prev]);
+                // Insert blank at start of new segment (same position as cur)
+                out.append(xs[i], ys[i], 0.0, 0.0, 0.0, repeats[i]);
+            }
+        }
+
+        out.append(xs[i], ys[i], rs[i], gs[i], bs[i], repeats[i]);
+    }
+}
+
+} // namespace gizmotweak2
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QList>
+#include <QVector>
+
+#include <functional>
+
+#include <frame.h>
+
+#include "ParamSnapshot.h"
+#include "PointBuffer.h"
+
+namespace gizmotweak2
+{
+
+// Runs an EvaluationSnapshot over a point buffer.
+// Reads nothing but the snapshot, so it does not care which thread it is on;
+// one instance per thread, its buffers are reused across runs.
+class SnapshotEvaluator
+{
+public:
+    SnapshotEvaluator() = default;
+
+    // Points to evaluate: load them here before run()
+    PointBuffer& input() { return _bufferA; }
+
+    // Apply every stage of the snapshot to input()
+    // Returns the buffer holding the result, valid until the next run()
+    const PointBuffer& run(const EvaluationSnapshot& snapshot);
+
+    // Points kept at snapshot.taps[index] by the last run() (empty for an off-path tap)
+    const PointBuffer& tap(int index) const { return _taps[index]; }
+
+    // out[i] = ratio of snapshot.ratioOps[op] at (xs[i], ys[i]), for i < count (op < 0 = 1.0)
+    void evaluateRatios(const EvaluationSnapshot& snapshot, int op,
+                        const qreal* xs, const qreal* ys, int count, qreal* out);
+
+    // Opt-in parallel evaluation of per-sample stages on QThreadPool::globalInstance().
+    // Output is bit-identical to serial mode (seeded RNG tweaks seed from the sample index).
+    bool parallelEnabled() const { return _parallelEnabled; }
+    void setParallelEnabled(bool enabled) { _parallelEnabled = enabled; }
+
+    // Frames with fewer samples than this stay on the calling thread
+    int parallelThreshold() const { return _parallelThreshold; }
+    void setParallelThreshold(int samples) { _parallelThreshold = qMax(1, samples); }
+
+    // Number of times scratch storage had to grow (diagnostics/tests)
+    int scratchAllocationCount() const;
+
+    // Number of runs that restarted after a cached time-invariant prefix (diagnostics/tests)
+    int prefixReuseCount() const { return _prefixReuseCount; }
+
+private:
+    // Scratch space of one thread running batch kernels (index 0 = calling thread)
+    struct BatchScratch
+    {
+        ScratchArrays arrays;           // Ratio arrays, nested Transform/Mirror coordinates
+        QList<qreal> combineRatios;     // Transform combine input, reused per point
+        int combineGrowthCount{0};
+    };
+
+    // Processes samples [begin, end) with the given thread's scratch
+    using ChunkFunction = std::function<void(int begin, int end, BatchScratch& scratch)>;
+
+    // Split a per-sample stage into chunks on the thread pool, the calling thread included.
+    // Returns false (nothing run) when the stage should run serially instead.
+    bool runChunked(int count, const ChunkFunction& chunk);
+
+    // out[i] = ratio of op at (xs[i], ys[i]) for i < count
+    void evaluateRatioBatch(const EvaluationSnapshot& snapshot, int op,
+                            const qreal* xs, const qreal* ys, int count,
+                            qreal* out, BatchScratch& scratch) const;
+
+    // Per-sample tweak stage over the whole buffer, in place (chunked when parallel)
+    void applyStage(const EvaluationSnapshot& snapshot, const EvaluationSnapshot::Stage& stage,
+                    PointBuffer& buffer);
+
+    // Apply one per-sample tweak stage in place over whole arrays (one kernel call per stage)
+    // firstIndex is the frame index of xs[0] (per-sample RNG seeding)
+    void applyTweakBatch(const ParamSnapshot& tweak, int count, int firstIndex, const qreal* ratios,
+                         qreal gizmoX, qreal gizmoY,
+                         qreal* xs, qreal* ys, qreal* rs, qreal* gs, qreal* bs) const;
+
+    // Frame-level SparkleTweak stage, through Frame scratch storage
+    void applySparkle(const EvaluationSnapshot& snapshot, const EvaluationSnapshot::Stage& stage,
+                      PointBuffer& buffer);
+
+    // Copy buffer into every tap taken after stageCount stages
+    void keepTaps(const EvaluationSnapshot& snapshot, int stageCount, const PointBuffer& buffer);
+
+    // Output post-processing: blank samples around jumps longer than threshold
+    void applyLineBreak(qreal threshold, const PointBuffer& in, PointBuffer& out) const;
+
+    // Ping-pong buffers, reused so steady-state frames don't allocate
+    PointBuffer _bufferA;
+    PointBuffer _bufferB;
+    QVector<BatchScratch> _batchScratch{BatchScratch()};
+
+    bool _parallelEnabled{false};
+    int _parallelThreshold{8192};
+
+    xengine::Frame _stageFrameIn;   // Frame-level stages still speak xengine::Frame
+    xengine::Frame _stageFrameOut;
+
+    QVector<PointBuffer> _taps;     // One per snapshot tap, reused across runs
+
+    // Output of the last run's time-invariant prefix, and the input it came from
+    PointBuffer _prefixInput;
+    PointBuffer _prefixOutput;
+    int _prefixStages{0};           // 0 = nothing cached
+    quint64 _prefixRevision{0};
+    int _prefixReuseCount{0};
+};
+
+} // namespace gizmotweak2
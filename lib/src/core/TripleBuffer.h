@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+
+namespace gizmotweak2
+{
+
+// Lock-free single-producer / single-consumer triple buffer.
+// The producer fills back() and publish()es it; the consumer acquire()s the
+// newest published slot and reads front(). Neither side ever waits, a slow
+// consumer simply skips the values it did not get to.
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer side: slot being written, only ever touched by the producer
+    T& back() { return _slots[_back]; }
+
+    // Producer side: hand back() over to the consumer and take the spare slot
+    void publish()
+    {
+        _back = _middle.exchange(_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Consumer side: switch front() to the newest published slot
+    // Returns false (front() unchanged) if nothing was published since the last call
+    bool acquire()
+    {
+        if (!(_middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // Consumer side: last acquired slot, stable until the next acquire()
+    T& front() { return _slots[_front]; }
+    const T& front() const { return _slots[_front]; }
+
+private:
+    // _middle packs the spare slot index and whether it holds an unread value
+    static constexpr int INDEX_MASK = 3;
+    static constexpr int FRESH = 4;
+
+    T _slots[3];
+    int _back{0};
+    std::atomic<int> _middle{1};
+    int _front{2};
+};
+
+} // namespace gizmotweak2
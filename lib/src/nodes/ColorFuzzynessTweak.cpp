@@ -1,4 +1,5 @@
 #include "ColorFuzzynessTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -21,18 +22,18 @@ ColorFuzzynessTweak::ColorFuzzynessTweak(QObject* parent)
 
     // Automation: Amount track with amount (0)
     auto* amountTrack = createAutomationTrack(QStringLiteral("Amount"), 1, QColor(255, 182, 193));
-    amountTrack->setupParameter(0, 0.0, 2.0, _amount, tr("Amount"), 100.0, QStringLiteral("%"));
+    amountTrack->setupParameter(0, 0.0, 2.0, _params.amount, tr("Amount"), 100.0, QStringLiteral("%"));
 
     auto* seedTrack = createAutomationTrack(QStringLiteral("Seed"), 1, QColor(169, 169, 169));
-    seedTrack->setupParameter(0, 0.0, 999999.0, _seed, tr("Seed"), 1.0, QString());
+    seedTrack->setupParameter(0, 0.0, 999999.0, _params.seed, tr("Seed"), 1.0, QString());
 }
 
 void ColorFuzzynessTweak::setAmount(qreal a)
 {
     a = qBound(0.0, a, 2.0);
-    if (!qFuzzyCompare(_amount, a))
+    if (!qFuzzyCompare(_params.amount, a))
     {
-        _amount = a;
+        _params.amount = a;
         auto* track = automationTrack(QStringLiteral("Amount"));
         if (track) track->setInitialValue(0, a);
         emit amountChanged();
@@ -42,36 +43,36 @@ void ColorFuzzynessTweak::setAmount(qreal a)
 
 void ColorFuzzynessTweak::setAffectRed(bool affect)
 {
-    if (_affectRed != affect)
+    if (_params.affectRed != affect)
     {
-        _affectRed = affect;
+        _params.affectRed = affect;
         emit affectRedChanged();
     }
 }
 
 void ColorFuzzynessTweak::setAffectGreen(bool affect)
 {
-    if (_affectGreen != affect)
+    if (_params.affectGreen != affect)
     {
-        _affectGreen = affect;
+        _params.affectGreen = affect;
         emit affectGreenChanged();
     }
 }
 
 void ColorFuzzynessTweak::setAffectBlue(bool affect)
 {
-    if (_affectBlue != affect)
+    if (_params.affectBlue != affect)
     {
-        _affectBlue = affect;
+        _params.affectBlue = affect;
         emit affectBlueChanged();
     }
 }
 
 void ColorFuzzynessTweak::setSeed(int s)
 {
-    if (_seed != s)
+    if (_params.seed != s)
     {
-        _seed = s;
+        _params.seed = s;
         auto* track = automationTrack(QStringLiteral("Seed"));
         if (track) track->setInitialValue(0, static_cast<qreal>(s));
         emit seedChanged();
@@ -81,9 +82,9 @@ void ColorFuzzynessTweak::setSeed(int s)
 
 void ColorFuzzynessTweak::setUseSeed(bool use)
 {
-    if (_useSeed != use)
+    if (_params.useSeed != use)
     {
-        _useSeed = use;
+        _params.useSeed = use;
         emit useSeedChanged();
     }
 }
@@ -107,22 +108,22 @@ void ColorFuzzynessTweak::setFollowGizmo(bool follow)
     }
 }
 
-QColor ColorFuzzynessTweak::apply(const QColor& input, qreal ratio, int sampleIndex) const
+QColor ColorFuzzynessTweak::Params::apply(const QColor& input, qreal ratio, int sampleIndex) const
 {
-    if (_amount <= 0.0 || ratio <= 0.0)
+    if (amount <= 0.0 || ratio <= 0.0)
     {
         return input;
     }
 
-    qreal effectiveAmount = _amount * ratio;
+    qreal effectiveAmount = amount * ratio;
 
     QRandomGenerator* rng;
     QRandomGenerator seededRng;
 
-    if (_useSeed)
+    if (useSeed)
     {
         // Create deterministic random based on seed and sample index
-        seededRng.seed(_seed + sampleIndex);
+        seededRng.seed(seed + sampleIndex);
         rng = &seededRng;
     }
     else
@@ -134,19 +135,19 @@ QColor ColorFuzzynessTweak::apply(const QColor& input, qreal ratio, int sampleIn
     qreal outG = input.greenF();
     qreal outB = input.blueF();
 
-    if (_affectRed)
+    if (affectRed)
     {
         qreal randomR = (rng->bounded(2.0) - 1.0) * effectiveAmount;
         outR = qBound(0.0, outR + randomR, 1.0);
     }
 
-    if (_affectGreen)
+    if (affectGreen)
     {
         qreal randomG = (rng->bounded(2.0) - 1.0) * effectiveAmount;
         outG = qBound(0.0, outG + randomG, 1.0);
     }
 
-    if (_affectBlue)
+    if (affectBlue)
     {
         qreal randomB = (rng->bounded(2.0) - 1.0) * effectiveAmount;
         outB = qBound(0.0, outB + randomB, 1.0);
@@ -155,15 +156,50 @@ QColor ColorFuzzynessTweak::apply(const QColor& input, qreal ratio, int sampleIn
     return QColor::fromRgbF(outR, outG, outB, input.alphaF());
 }
 
+void ColorFuzzynessTweak::Params::applyBatch(const qreal* rs, const qreal* gs, const qreal* bs, const qreal* ratios, int count,
+                                             int firstIndex, qreal* outRs, qreal* outGs, qreal* outBs) const
+{
+    QRandomGenerator seededRng;
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal outR = rs[i];
+        qreal outG = gs[i];
+        qreal outB = bs[i];
+        qreal ratio = ratios ? ratios[i] : 1.0;
+
+        if (amount > 0.0 && ratio > 0.0)
+        {
+            qreal effectiveAmount = amount * ratio;
+
+            // Same seeding as apply(): one generator state per sample index
+            QRandomGenerator* rng = QRandomGenerator::global();
+            if (useSeed)
+            {
+                seededRng.seed(seed + firstIndex + i);
+                rng = &seededRng;
+            }
+
+            if (affectRed)   outR = qBound(0.0, outR + (rng->bounded(2.0) - 1.0) * effectiveAmount, 1.0);
+            if (affectGreen) outG = qBound(0.0, outG + (rng->bounded(2.0) - 1.0) * effectiveAmount, 1.0);
+            if (affectBlue)  outB = qBound(0.0, outB + (rng->bounded(2.0) - 1.0) * effectiveAmount, 1.0);
+        }
+
+        outRs[i] = outR;
+        outGs[i] = outG;
+        outBs[i] = outB;
+    }
+}
+
 QJsonObject ColorFuzzynessTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["amount"] = _amount;
-    obj["affectRed"] = _affectRed;
-    obj["affectGreen"] = _affectGreen;
-    obj["affectBlue"] = _affectBlue;
-    obj["seed"] = _seed;
-    obj["useSeed"] = _useSeed;
+    obj["amount"] = _params.amount;
+    obj["affectRed"] = _params.affectRed;
+    obj["affectGreen"] = _params.affectGreen;
+    obj["affectBlue"] = _params.affectBlue;
+    obj["seed"] = _params.seed;
+    obj["useSeed"] = _params.useSeed;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -179,20 +215,26 @@ void ColorFuzzynessTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
-void ColorFuzzynessTweak::syncToAnimatedValues(int timeMs)
+using ColorFuzzynessParams = ColorFuzzynessTweak::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<ColorFuzzynessParams> AUTOMATION_BINDINGS[] = {
+    {"Amount", {&ColorFuzzynessParams::amount}},
+    {"Seed", {}, [](ColorFuzzynessParams& params, const double* values, int) {
+        params.seed = static_cast<int>(values[0]);
+    }},
+};
+
+ColorFuzzynessTweak::Params ColorFuzzynessTweak::paramsAt(int timeMs) const
 {
-    // Only sync if automation is active for each track
-    auto* amountTrack = automationTrack(QStringLiteral("Amount"));
-    if (amountTrack && amountTrack->isAutomated())
-    {
-        _amount = amountTrack->timedValue(timeMs, 0);
-    }
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* seedTrack = automationTrack(QStringLiteral("Seed"));
-    if (seedTrack && seedTrack->isAutomated())
-    {
-        _seed = static_cast<int>(seedTrack->timedValue(timeMs, 0));
-    }
+void ColorFuzzynessTweak::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
@@ -20,37 +20,59 @@ class ColorFuzzynessTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Color jitter parameters at one evaluation time
+    struct Params
+    {
+        qreal amount{0.1};
+        bool affectRed{true};
+        bool affectGreen{true};
+        bool affectBlue{true};
+        int seed{0};
+        bool useSeed{false};
+
+        // Apply fuzzyness to a color
+        QColor apply(const QColor& input, qreal ratio, int sampleIndex = 0) const;
+
+        // Color jitter for count samples, seeded per sample index like apply()
+        void applyBatch(const qreal* rs, const qreal* gs, const qreal* bs, const qreal* ratios, int count,
+                        int firstIndex, qreal* outRs, qreal* outGs, qreal* outBs) const;
+    };
+
     explicit ColorFuzzynessTweak(QObject* parent = nullptr);
     ~ColorFuzzynessTweak() override = default;
 
     QString type() const override { return QStringLiteral("ColorFuzzynessTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::ColorFuzzynessTweak; }
 
     // Properties
-    qreal amount() const { return _amount; }
+    qreal amount() const { return _params.amount; }
     void setAmount(qreal a);
 
-    bool affectRed() const { return _affectRed; }
+    bool affectRed() const { return _params.affectRed; }
     void setAffectRed(bool affect);
 
-    bool affectGreen() const { return _affectGreen; }
+    bool affectGreen() const { return _params.affectGreen; }
     void setAffectGreen(bool affect);
 
-    bool affectBlue() const { return _affectBlue; }
+    bool affectBlue() const { return _params.affectBlue; }
     void setAffectBlue(bool affect);
 
-    int seed() const { return _seed; }
+    int seed() const { return _params.seed; }
     void setSeed(int s);
 
-    bool useSeed() const { return _useSeed; }
+    bool useSeed() const { return _params.useSeed; }
     void setUseSeed(bool use);
 
     // Follow gizmo - use gizmo's ratio when true, full effect when false
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Apply fuzzyness to a color
-    Q_INVOKABLE QColor apply(const QColor& input, qreal ratio, int sampleIndex = 0) const;
+    // Evaluate with the current parameters (see Params)
+    Q_INVOKABLE QColor apply(const QColor& input, qreal ratio, int sampleIndex = 0) const { return _params.apply(input, ratio, sampleIndex); }
+
+    void applyBatch(const qreal* rs, const qreal* gs, const qreal* bs, const qreal* ratios, int count,
+                    int firstIndex, qreal* outRs, qreal* outGs, qreal* outBs) const { _params.applyBatch(rs, gs, bs, ratios, count, firstIndex, outRs, outGs, outBs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
@@ -58,6 +80,10 @@ public:
 
     // Automation
     void syncToAnimatedValues(int timeMs) override;
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
 
 signals:
     void amountChanged();
@@ -69,12 +95,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    qreal _amount{0.1};
-    bool _affectRed{true};
-    bool _affectGreen{true};
-    bool _affectBlue{true};
-    int _seed{0};
-    bool _useSeed{false};
+    Params _params;
     bool _followGizmo{true};
 };
 
@@ -1,4 +1,5 @@
 #include "ColorTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -20,25 +21,25 @@ ColorTweak::ColorTweak(QObject* parent)
 
     // Automation: Color track with R (0), G (1), B (2), Alpha (3)
     auto* colorTrack = createAutomationTrack(QStringLiteral("Color"), 4, QColor(220, 20, 60));
-    colorTrack->setupParameter(0, 0.0, 1.0, _color.redF(), tr("Red"), 100.0, QStringLiteral("%"));
-    colorTrack->setupParameter(1, 0.0, 1.0, _color.greenF(), tr("Green"), 100.0, QStringLiteral("%"));
-    colorTrack->setupParameter(2, 0.0, 1.0, _color.blueF(), tr("Blue"), 100.0, QStringLiteral("%"));
-    colorTrack->setupParameter(3, -2.0, 2.0, _alpha, tr("Alpha"), 100.0, QStringLiteral("%"));
+    colorTrack->setupParameter(0, 0.0, 1.0, _params.color.redF(), tr("Red"), 100.0, QStringLiteral("%"));
+    colorTrack->setupParameter(1, 0.0, 1.0, _params.color.greenF(), tr("Green"), 100.0, QStringLiteral("%"));
+    colorTrack->setupParameter(2, 0.0, 1.0, _params.color.blueF(), tr("Blue"), 100.0, QStringLiteral("%"));
+    colorTrack->setupParameter(3, -2.0, 2.0, _params.alpha, tr("Alpha"), 100.0, QStringLiteral("%"));
 
     auto* filterTrack = createAutomationTrack(QStringLiteral("Filter"), 6, QColor(100, 149, 237));
-    filterTrack->setupParameter(0, 0.0, 1.0, _filterRedMin, tr("R Min"), 100.0, QStringLiteral("%"));
-    filterTrack->setupParameter(1, 0.0, 1.0, _filterRedMax, tr("R Max"), 100.0, QStringLiteral("%"));
-    filterTrack->setupParameter(2, 0.0, 1.0, _filterGreenMin, tr("G Min"), 100.0, QStringLiteral("%"));
-    filterTrack->setupParameter(3, 0.0, 1.0, _filterGreenMax, tr("G Max"), 100.0, QStringLiteral("%"));
-    filterTrack->setupParameter(4, 0.0, 1.0, _filterBlueMin, tr("B Min"), 100.0, QStringLiteral("%"));
-    filterTrack->setupParameter(5, 0.0, 1.0, _filterBlueMax, tr("B Max"), 100.0, QStringLiteral("%"));
+    filterTrack->setupParameter(0, 0.0, 1.0, _params.filterRedMin, tr("R Min"), 100.0, QStringLiteral("%"));
+    filterTrack->setupParameter(1, 0.0, 1.0, _params.filterRedMax, tr("R Max"), 100.0, QStringLiteral("%"));
+    filterTrack->setupParameter(2, 0.0, 1.0, _params.filterGreenMin, tr("G Min"), 100.0, QStringLiteral("%"));
+    filterTrack->setupParameter(3, 0.0, 1.0, _params.filterGreenMax, tr("G Max"), 100.0, QStringLiteral("%"));
+    filterTrack->setupParameter(4, 0.0, 1.0, _params.filterBlueMin, tr("B Min"), 100.0, QStringLiteral("%"));
+    filterTrack->setupParameter(5, 0.0, 1.0, _params.filterBlueMax, tr("B Max"), 100.0, QStringLiteral("%"));
 }
 
 void ColorTweak::setColor(const QColor& c)
 {
-    if (_color != c)
+    if (_params.color != c)
     {
-        _color = c;
+        _params.color = c;
         // Sync to automation track initial values (R, G, B)
         auto* track = automationTrack(QStringLiteral("Color"));
         if (track)
@@ -55,9 +56,9 @@ void ColorTweak::setColor(const QColor& c)
 void ColorTweak::setAlpha(qreal a)
 {
     a = qBound(-2.0, a, 2.0);
-    if (!qFuzzyCompare(_alpha, a))
+    if (!qFuzzyCompare(_params.alpha, a))
     {
-        _alpha = a;
+        _params.alpha = a;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Color"));
         if (track) track->setInitialValue(3, a);
@@ -68,9 +69,9 @@ void ColorTweak::setAlpha(qreal a)
 
 void ColorTweak::setAffectRed(bool affect)
 {
-    if (_affectRed != affect)
+    if (_params.affectRed != affect)
     {
-        _affectRed = affect;
+        _params.affectRed = affect;
         emit affectRedChanged();
         emitPropertyChanged();
     }
@@ -78,9 +79,9 @@ void ColorTweak::setAffectRed(bool affect)
 
 void ColorTweak::setAffectGreen(bool affect)
 {
-    if (_affectGreen != affect)
+    if (_params.affectGreen != affect)
     {
-        _affectGreen = affect;
+        _params.affectGreen = affect;
         emit affectGreenChanged();
         emitPropertyChanged();
     }
@@ -88,9 +89,9 @@ void ColorTweak::setAffectGreen(bool affect)
 
 void ColorTweak::setAffectBlue(bool affect)
 {
-    if (_affectBlue != affect)
+    if (_params.affectBlue != affect)
     {
-        _affectBlue = affect;
+        _params.affectBlue = affect;
         emit affectBlueChanged();
         emitPropertyChanged();
     }
@@ -99,9 +100,9 @@ void ColorTweak::setAffectBlue(bool affect)
 void ColorTweak::setFilterRedMin(qreal value)
 {
     value = qBound(0.0, value, 1.0);
-    if (!qFuzzyCompare(_filterRedMin, value))
+    if (!qFuzzyCompare(_params.filterRedMin, value))
     {
-        _filterRedMin = value;
+        _params.filterRedMin = value;
         auto* track = automationTrack(QStringLiteral("Filter"));
         if (track) track->setInitialValue(0, value);
         emit filterRedMinChanged();
@@ -112,9 +113,9 @@ void ColorTweak::setFilterRedMin(qreal value)
 void ColorTweak::setFilterRedMax(qreal value)
 {
     value = qBound(0.0, value, 1.0);
-    if (!qFuzzyCompare(_filterRedMax, value))
+    if (!qFuzzyCompare(_params.filterRedMax, value))
     {
-        _filterRedMax = value;
+        _params.filterRedMax = value;
         auto* track = automationTrack(QStringLiteral("Filter"));
         if (track) track->setInitialValue(1, value);
         emit filterRedMaxChanged();
@@ -125,9 +126,9 @@ void ColorTweak::setFilterRedMax(qreal value)
 void ColorTweak::setFilterGreenMin(qreal value)
 {
     value = qBound(0.0, value, 1.0);
-    if (!qFuzzyCompare(_filterGreenMin, value))
+    if (!qFuzzyCompare(_params.filterGreenMin, value))
     {
-        _filterGreenMin = value;
+        _params.filterGreenMin = value;
         auto* track = automationTrack(QStringLiteral("Filter"));
         if (track) track->setInitialValue(2, value);
         emit filterGreenMinChanged();
@@ -138,9 +139,9 @@ void ColorTweak::setFilterGreenMin(qreal value)
 void ColorTweak::setFilterGreenMax(qreal value)
 {
     value = qBound(0.0, value, 1.0);
-    if (!qFuzzyCompare(_filterGreenMax, value))
+    if (!qFuzzyCompare(_params.filterGreenMax, value))
     {
-        _filterGreenMax = value;
+        _params.filterGreenMax = value;
         auto* track = automationTrack(QStringLiteral("Filter"));
         if (track) track->setInitialValue(3, value);
         emit filterGreenMaxChanged();
@@ -151,9 +152,9 @@ void ColorTweak::setFilterGreenMax(qreal value)
 void ColorTweak::setFilterBlueMin(qreal value)
 {
     value = qBound(0.0, value, 1.0);
-    if (!qFuzzyCompare(_filterBlueMin, value))
+    if (!qFuzzyCompare(_params.filterBlueMin, value))
     {
-        _filterBlueMin = value;
+        _params.filterBlueMin = value;
         auto* track = automationTrack(QStringLiteral("Filter"));
         if (track) track->setInitialValue(4, value);
         emit filterBlueMinChanged();
@@ -164,9 +165,9 @@ void ColorTweak::setFilterBlueMin(qreal value)
 void ColorTweak::setFilterBlueMax(qreal value)
 {
     value = qBound(0.0, value, 1.0);
-    if (!qFuzzyCompare(_filterBlueMax, value))
+    if (!qFuzzyCompare(_params.filterBlueMax, value))
     {
-        _filterBlueMax = value;
+        _params.filterBlueMax = value;
         auto* track = automationTrack(QStringLiteral("Filter"));
         if (track) track->setInitialValue(5, value);
         emit filterBlueMaxChanged();
@@ -196,14 +197,14 @@ void ColorTweak::setFollowGizmo(bool follow)
     }
 }
 
-bool ColorTweak::passesFilter(qreal r, qreal g, qreal b) const
+bool ColorTweak::Params::passesFilter(qreal r, qreal g, qreal b) const
 {
-    return (r >= _filterRedMin && r <= _filterRedMax &&
-            g >= _filterGreenMin && g <= _filterGreenMax &&
-            b >= _filterBlueMin && b <= _filterBlueMax);
+    return (r >= filterRedMin && r <= filterRedMax &&
+            g >= filterGreenMin && g <= filterGreenMax &&
+            b >= filterBlueMin && b <= filterBlueMax);
 }
 
-QColor ColorTweak::apply(const QColor& input, qreal ratio) const
+QColor ColorTweak::Params::apply(const QColor& input, qreal ratio) const
 {
     qreal inR = input.redF();
     qreal inG = input.greenF();
@@ -219,20 +220,20 @@ QColor ColorTweak::apply(const QColor& input, qreal ratio) const
     // alpha = ratio * colorAlpha (range can be negative for inverse effect)
     // beta = 1 - alpha
     // out = beta * in + alpha * target
-    qreal effectiveAlpha = ratio * _alpha;
+    qreal effectiveAlpha = ratio * alpha;
     qreal beta = 1.0 - effectiveAlpha;
 
-    qreal targetR = _color.redF();
-    qreal targetG = _color.greenF();
-    qreal targetB = _color.blueF();
+    qreal targetR = color.redF();
+    qreal targetG = color.greenF();
+    qreal targetB = color.blueF();
 
     qreal outR = inR;
     qreal outG = inG;
     qreal outB = inB;
 
-    if (_affectRed)   outR = beta * inR + effectiveAlpha * targetR;
-    if (_affectGreen) outG = beta * inG + effectiveAlpha * targetG;
-    if (_affectBlue)  outB = beta * inB + effectiveAlpha * targetB;
+    if (affectRed)   outR = beta * inR + effectiveAlpha * targetR;
+    if (affectGreen) outG = beta * inG + effectiveAlpha * targetG;
+    if (affectBlue)  outB = beta * inB + effectiveAlpha * targetB;
 
     // Clamp values
     outR = qBound(0.0, outR, 1.0);
@@ -242,20 +243,54 @@ QColor ColorTweak::apply(const QColor& input, qreal ratio) const
     return QColor::fromRgbF(outR, outG, outB, input.alphaF());
 }
 
+void ColorTweak::Params::applyBatch(const qreal* rs, const qreal* gs, const qreal* bs, const qreal* ratios, int count,
+                                    qreal* outRs, qreal* outGs, qreal* outBs) const
+{
+    qreal targetR = color.redF();
+    qreal targetG = color.greenF();
+    qreal targetB = color.blueF();
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal inR = rs[i];
+        qreal inG = gs[i];
+        qreal inB = bs[i];
+
+        if (!passesFilter(inR, inG, inB))
+        {
+            outRs[i] = inR;
+            outGs[i] = inG;
+            outBs[i] = inB;
+            continue;
+        }
+
+        qreal effectiveAlpha = (ratios ? ratios[i] : 1.0) * alpha;
+        qreal beta = 1.0 - effectiveAlpha;
+
+        qreal outR = affectRed   ? beta * inR + effectiveAlpha * targetR : inR;
+        qreal outG = affectGreen ? beta * inG + effectiveAlpha * targetG : inG;
+        qreal outB = affectBlue  ? beta * inB + effectiveAlpha * targetB : inB;
+
+        outRs[i] = qBound(0.0, outR, 1.0);
+        outGs[i] = qBound(0.0, outG, 1.0);
+        outBs[i] = qBound(0.0, outB, 1.0);
+    }
+}
+
 QJsonObject ColorTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["color"] = _color.name(QColor::HexArgb);
-    obj["alpha"] = _alpha;
-    obj["affectRed"] = _affectRed;
-    obj["affectGreen"] = _affectGreen;
-    obj["affectBlue"] = _affectBlue;
-    obj["filterRedMin"] = _filterRedMin;
-    obj["filterRedMax"] = _filterRedMax;
-    obj["filterGreenMin"] = _filterGreenMin;
-    obj["filterGreenMax"] = _filterGreenMax;
-    obj["filterBlueMin"] = _filterBlueMin;
-    obj["filterBlueMax"] = _filterBlueMax;
+    obj["color"] = _params.color.name(QColor::HexArgb);
+    obj["alpha"] = _params.alpha;
+    obj["affectRed"] = _params.affectRed;
+    obj["affectGreen"] = _params.affectGreen;
+    obj["affectBlue"] = _params.affectBlue;
+    obj["filterRedMin"] = _params.filterRedMin;
+    obj["filterRedMax"] = _params.filterRedMax;
+    obj["filterGreenMin"] = _params.filterGreenMin;
+    obj["filterGreenMax"] = _params.filterGreenMax;
+    obj["filterBlueMin"] = _params.filterBlueMin;
+    obj["filterBlueMax"] = _params.filterBlueMax;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -281,29 +316,30 @@ void ColorTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
-void ColorTweak::syncToAnimatedValues(int timeMs)
+using ColorParams = ColorTweak::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<ColorParams> AUTOMATION_BINDINGS[] = {
+    {"Color", {}, [](ColorParams& params, const double* values, int paramCount) {
+        if (paramCount < 4) return;
+        params.color = QColor::fromRgbF(values[0], values[1], values[2]);
+        params.alpha = values[3];
+    }},
+    {"Filter", {&ColorParams::filterRedMin, &ColorParams::filterRedMax,
+                &ColorParams::filterGreenMin, &ColorParams::filterGreenMax,
+                &ColorParams::filterBlueMin, &ColorParams::filterBlueMax}},
+};
+
+ColorTweak::Params ColorTweak::paramsAt(int timeMs) const
 {
-    // Only sync if automation is active for each track
-    auto* colorTrack = automationTrack(QStringLiteral("Color"));
-    if (colorTrack && colorTrack->isAutomated())
-    {
-        qreal r = colorTrack->timedValue(timeMs, 0);
-        qreal g = colorTrack->timedValue(timeMs, 1);
-        qreal b = colorTrack->timedValue(timeMs, 2);
-        _color = QColor::fromRgbF(r, g, b);
-        _alpha = colorTrack->timedValue(timeMs, 3);
-    }
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* filterTrack = automationTrack(QStringLiteral("Filter"));
-    if (filterTrack && filterTrack->isAutomated())
-    {
-        _filterRedMin = filterTrack->timedValue(timeMs, 0);
-        _filterRedMax = filterTrack->timedValue(timeMs, 1);
-        _filterGreenMin = filterTrack->timedValue(timeMs, 2);
-        _filterGreenMax = filterTrack->timedValue(timeMs, 3);
-        _filterBlueMin = filterTrack->timedValue(timeMs, 4);
-        _filterBlueMax = filterTrack->timedValue(timeMs, 5);
-    }
+void ColorTweak::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
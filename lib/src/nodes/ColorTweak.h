@@ -29,60 +29,95 @@ public:
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Color and filter parameters at one evaluation time
+    struct Params
+    {
+        QColor color{Qt::white};
+        qreal alpha{0.0};  // Range -2 to 2 (displayed as -200% to 200%)
+        bool affectRed{true};
+        bool affectGreen{true};
+        bool affectBlue{true};
+
+        // Filter ranges (0.0 to 1.0)
+        qreal filterRedMin{0.0};
+        qreal filterRedMax{1.0};
+        qreal filterGreenMin{0.0};
+        qreal filterGreenMax{1.0};
+        qreal filterBlueMin{0.0};
+        qreal filterBlueMax{1.0};
+
+        // Check if a color passes the filter
+        bool passesFilter(qreal r, qreal g, qreal b) const;
+
+        // Apply tweak to a color
+        QColor apply(const QColor& input, qreal ratio) const;
+
+        // Blend count colors toward the target color (nullptr ratios = 1.0, outputs may alias inputs)
+        void applyBatch(const qreal* rs, const qreal* gs, const qreal* bs, const qreal* ratios, int count,
+                        qreal* outRs, qreal* outGs, qreal* outBs) const;
+    };
+
     explicit ColorTweak(QObject* parent = nullptr);
     ~ColorTweak() override = default;
 
     QString type() const override { return QStringLiteral("ColorTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::ColorTweak; }
 
     // Properties
-    QColor color() const { return _color; }
+    QColor color() const { return _params.color; }
     void setColor(const QColor& c);
 
-    qreal alpha() const { return _alpha; }
+    qreal alpha() const { return _params.alpha; }
     void setAlpha(qreal a);
 
-    bool affectRed() const { return _affectRed; }
+    bool affectRed() const { return _params.affectRed; }
     void setAffectRed(bool affect);
 
-    bool affectGreen() const { return _affectGreen; }
+    bool affectGreen() const { return _params.affectGreen; }
     void setAffectGreen(bool affect);
 
-    bool affectBlue() const { return _affectBlue; }
+    bool affectBlue() const { return _params.affectBlue; }
     void setAffectBlue(bool affect);
 
     // Filter getters/setters
-    qreal filterRedMin() const { return _filterRedMin; }
+    qreal filterRedMin() const { return _params.filterRedMin; }
     void setFilterRedMin(qreal value);
 
-    qreal filterRedMax() const { return _filterRedMax; }
+    qreal filterRedMax() const { return _params.filterRedMax; }
     void setFilterRedMax(qreal value);
 
-    qreal filterGreenMin() const { return _filterGreenMin; }
+    qreal filterGreenMin() const { return _params.filterGreenMin; }
     void setFilterGreenMin(qreal value);
 
-    qreal filterGreenMax() const { return _filterGreenMax; }
+    qreal filterGreenMax() const { return _params.filterGreenMax; }
     void setFilterGreenMax(qreal value);
 
-    qreal filterBlueMin() const { return _filterBlueMin; }
+    qreal filterBlueMin() const { return _params.filterBlueMin; }
     void setFilterBlueMin(qreal value);
 
-    qreal filterBlueMax() const { return _filterBlueMax; }
+    qreal filterBlueMax() const { return _params.filterBlueMax; }
     void setFilterBlueMax(qreal value);
 
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Check if a color passes the filter
-    Q_INVOKABLE bool passesFilter(qreal r, qreal g, qreal b) const;
+    // Evaluate with the current parameters (see Params)
+    Q_INVOKABLE bool passesFilter(qreal r, qreal g, qreal b) const { return _params.passesFilter(r, g, b); }
+
+    Q_INVOKABLE QColor apply(const QColor& input, qreal ratio) const { return _params.apply(input, ratio); }
 
-    // Apply tweak to a color
-    Q_INVOKABLE QColor apply(const QColor& input, qreal ratio) const;
+    void applyBatch(const qreal* rs, const qreal* gs, const qreal* bs, const qreal* ratios, int count,
+                    qreal* outRs, qreal* outGs, qreal* outBs) const { _params.applyBatch(rs, gs, bs, ratios, count, outRs, outGs, outBs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
     void propertiesFromJson(const QJsonObject& json) override;
 
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
     // Automation sync
     void syncToAnimatedValues(int timeMs) override;
 
@@ -101,19 +136,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    QColor _color{Qt::white};
-    qreal _alpha{0.0};  // Range -2 to 2 (displayed as -200% to 200%)
-    bool _affectRed{true};
-    bool _affectGreen{true};
-    bool _affectBlue{true};
-
-    // Filter ranges (0.0 to 1.0)
-    qreal _filterRedMin{0.0};
-    qreal _filterRedMax{1.0};
-    qreal _filterGreenMin{0.0};
-    qreal _filterGreenMax{1.0};
-    qreal _filterBlueMin{0.0};
-    qreal _filterBlueMax{1.0};
+    Params _params;
     bool _followGizmo{true};
 };
 
@@ -1,4 +1,5 @@
 #include "FuzzynessTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -21,18 +22,18 @@ FuzzynessTweak::FuzzynessTweak(QObject* parent)
 
     // Automation: Amount track with amount (0)
     auto* amountTrack = createAutomationTrack(QStringLiteral("Amount"), 1, QColor(255, 182, 193));
-    amountTrack->setupParameter(0, 0.0, 2.0, _amount, tr("Amount"), 100.0, QStringLiteral("%"));
+    amountTrack->setupParameter(0, 0.0, 2.0, _params.amount, tr("Amount"), 100.0, QStringLiteral("%"));
 
     auto* seedTrack = createAutomationTrack(QStringLiteral("Seed"), 1, QColor(169, 169, 169));
-    seedTrack->setupParameter(0, 0.0, 999999.0, _seed, tr("Seed"), 1.0, QString());
+    seedTrack->setupParameter(0, 0.0, 999999.0, _params.seed, tr("Seed"), 1.0, QString());
 }
 
 void FuzzynessTweak::setAmount(qreal a)
 {
     a = qBound(0.0, a, 2.0);
-    if (!qFuzzyCompare(_amount, a))
+    if (!qFuzzyCompare(_params.amount, a))
     {
-        _amount = a;
+        _params.amount = a;
         auto* track = automationTrack(QStringLiteral("Amount"));
         if (track) track->setInitialValue(0, a);
         emit amountChanged();
@@ -42,27 +43,27 @@ void FuzzynessTweak::setAmount(qreal a)
 
 void FuzzynessTweak::setAffectX(bool affect)
 {
-    if (_affectX != affect)
+    if (_params.affectX != affect)
     {
-        _affectX = affect;
+        _params.affectX = affect;
         emit affectXChanged();
     }
 }
 
 void FuzzynessTweak::setAffectY(bool affect)
 {
-    if (_affectY != affect)
+    if (_params.affectY != affect)
     {
-        _affectY = affect;
+        _params.affectY = affect;
         emit affectYChanged();
     }
 }
 
 void FuzzynessTweak::setSeed(int s)
 {
-    if (_seed != s)
+    if (_params.seed != s)
     {
-        _seed = s;
+        _params.seed = s;
         auto* track = automationTrack(QStringLiteral("Seed"));
         if (track) track->setInitialValue(0, static_cast<qreal>(s));
         emit seedChanged();
@@ -72,9 +73,9 @@ void FuzzynessTweak::setSeed(int s)
 
 void FuzzynessTweak::setUseSeed(bool use)
 {
-    if (_useSeed != use)
+    if (_params.useSeed != use)
     {
-        _useSeed = use;
+        _params.useSeed = use;
         emit useSeedChanged();
     }
 }
@@ -98,22 +99,22 @@ void FuzzynessTweak::setFollowGizmo(bool follow)
     }
 }
 
-QPointF FuzzynessTweak::apply(const QPointF& input, qreal ratio, int sampleIndex) const
+QPointF FuzzynessTweak::Params::apply(const QPointF& input, qreal ratio, int sampleIndex) const
 {
-    if (_amount <= 0.0 || ratio <= 0.0)
+    if (amount <= 0.0 || ratio <= 0.0)
     {
         return input;
     }
 
-    qreal effectiveAmount = _amount * ratio;
+    qreal effectiveAmount = amount * ratio;
 
     QRandomGenerator* rng;
     QRandomGenerator seededRng;
 
-    if (_useSeed)
+    if (useSeed)
     {
         // Create deterministic random based on seed and sample index
-        seededRng.seed(_seed + sampleIndex);
+        seededRng.seed(seed + sampleIndex);
         rng = &seededRng;
     }
     else
@@ -124,14 +125,14 @@ QPointF FuzzynessTweak::apply(const QPointF& input, qreal ratio, int sampleIndex
     qreal outX = input.x();
     qreal outY = input.y();
 
-    if (_affectX)
+    if (affectX)
     {
         // Random value in range [-1, 1] multiplied by amount
         qreal randomX = (rng->bounded(2.0) - 1.0) * effectiveAmount;
         outX += randomX;
     }
 
-    if (_affectY)
+    if (affectY)
     {
         qreal randomY = (rng->bounded(2.0) - 1.0) * effectiveAmount;
         outY += randomY;
@@ -140,14 +141,46 @@ QPointF FuzzynessTweak::apply(const QPointF& input, qreal ratio, int sampleIndex
     return QPointF(outX, outY);
 }
 
+void FuzzynessTweak::Params::applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                                        int firstIndex, qreal* outXs, qreal* outYs) const
+{
+    QRandomGenerator seededRng;
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal outX = xs[i];
+        qreal outY = ys[i];
+        qreal ratio = ratios ? ratios[i] : 1.0;
+
+        if (amount > 0.0 && ratio > 0.0)
+        {
+            qreal effectiveAmount = amount * ratio;
+
+            // Same seeding as apply(): one generator state per sample index
+            QRandomGenerator* rng = QRandomGenerator::global();
+            if (useSeed)
+            {
+                seededRng.seed(seed + firstIndex + i);
+                rng = &seededRng;
+            }
+
+            if (affectX) outX += (rng->bounded(2.0) - 1.0) * effectiveAmount;
+            if (affectY) outY += (rng->bounded(2.0) - 1.0) * effectiveAmount;
+        }
+
+        outXs[i] = outX;
+        outYs[i] = outY;
+    }
+}
+
 QJsonObject FuzzynessTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["amount"] = _amount;
-    obj["affectX"] = _affectX;
-    obj["affectY"] = _affectY;
-    obj["seed"] = _seed;
-    obj["useSeed"] = _useSeed;
+    obj["amount"] = _params.amount;
+    obj["affectX"] = _params.affectX;
+    obj["affectY"] = _params.affectY;
+    obj["seed"] = _params.seed;
+    obj["useSeed"] = _params.useSeed;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -162,20 +195,26 @@ void FuzzynessTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
-void FuzzynessTweak::syncToAnimatedValues(int timeMs)
+using FuzzynessParams = FuzzynessTweak::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<FuzzynessParams> AUTOMATION_BINDINGS[] = {
+    {"Amount", {&FuzzynessParams::amount}},
+    {"Seed", {}, [](FuzzynessParams& params, const double* values, int) {
+        params.seed = static_cast<int>(values[0]);
+    }},
+};
+
+FuzzynessTweak::Params FuzzynessTweak::paramsAt(int timeMs) const
 {
-    // Only sync if automation is active for each track
-    auto* amountTrack = automationTrack(QStringLiteral("Amount"));
-    if (amountTrack && amountTrack->isAutomated())
-    {
-        _amount = amountTrack->timedValue(timeMs, 0);
-    }
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* seedTrack = automationTrack(QStringLiteral("Seed"));
-    if (seedTrack && seedTrack->isAutomated())
-    {
-        _seed = static_cast<int>(seedTrack->timedValue(timeMs, 0));
-    }
+void FuzzynessTweak::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
@@ -19,34 +19,55 @@ class FuzzynessTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Jitter parameters; noise is seeded from the sample index, so copies stay deterministic
+    struct Params
+    {
+        qreal amount{0.1};
+        bool affectX{true};
+        bool affectY{true};
+        int seed{0};
+        bool useSeed{false};
+
+        // Apply fuzzyness to a position
+        QPointF apply(const QPointF& input, qreal ratio, int sampleIndex = 0) const;
+
+        // Jitter count points; sample i is seeded as sample (firstIndex + i) would be in apply()
+        void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                        int firstIndex, qreal* outXs, qreal* outYs) const;
+    };
+
     explicit FuzzynessTweak(QObject* parent = nullptr);
     ~FuzzynessTweak() override = default;
 
     QString type() const override { return QStringLiteral("FuzzynessTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::FuzzynessTweak; }
 
     // Properties
-    qreal amount() const { return _amount; }
+    qreal amount() const { return _params.amount; }
     void setAmount(qreal a);
 
-    bool affectX() const { return _affectX; }
+    bool affectX() const { return _params.affectX; }
     void setAffectX(bool affect);
 
-    bool affectY() const { return _affectY; }
+    bool affectY() const { return _params.affectY; }
     void setAffectY(bool affect);
 
-    int seed() const { return _seed; }
+    int seed() const { return _params.seed; }
     void setSeed(int s);
 
-    bool useSeed() const { return _useSeed; }
+    bool useSeed() const { return _params.useSeed; }
     void setUseSeed(bool use);
 
     // Follow gizmo - use gizmo's ratio when true, full effect when false
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Apply fuzzyness to a position
-    Q_INVOKABLE QPointF apply(const QPointF& input, qreal ratio, int sampleIndex = 0) const;
+    // Evaluate with the current parameters (see Params)
+    Q_INVOKABLE QPointF apply(const QPointF& input, qreal ratio, int sampleIndex = 0) const { return _params.apply(input, ratio, sampleIndex); }
+
+    void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                    int firstIndex, qreal* outXs, qreal* outYs) const { _params.applyBatch(xs, ys, ratios, count, firstIndex, outXs, outYs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
@@ -54,6 +75,10 @@ public:
 
     // Automation
     void syncToAnimatedValues(int timeMs) override;
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
 
 signals:
     void amountChanged();
@@ -64,11 +89,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    qreal _amount{0.1};
-    bool _affectX{true};
-    bool _affectY{true};
-    int _seed{0};
-    bool _useSeed{false};
+    Params _params;
     bool _followGizmo{true};
 };
 
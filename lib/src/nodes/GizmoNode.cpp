@@ -1,8 +1,9 @@
 #include "GizmoNode.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
+#include "core/EasingTable.h"
 
 #include <QtMath>
-#include <QEasingCurve>
 
 namespace gizmotweak2
 {
@@ -16,45 +17,45 @@ GizmoNode::GizmoNode(QObject* parent)
 
     // Automation: Scale track with scaleX (0) and scaleY (1)
     auto* scaleTrack = createAutomationTrack(QStringLiteral("Scale"), 2, QColor(255, 165, 0));
-    scaleTrack->setupParameter(0, 0.01, 3.0, _scaleX, tr("Scale X"), 100.0, QStringLiteral("%"));
-    scaleTrack->setupParameter(1, 0.01, 3.0, _scaleY, tr("Scale Y"), 100.0, QStringLiteral("%"));
+    scaleTrack->setupParameter(0, 0.01, 3.0, _params.scaleX, tr("Scale X"), 100.0, QStringLiteral("%"));
+    scaleTrack->setupParameter(1, 0.01, 3.0, _params.scaleY, tr("Scale Y"), 100.0, QStringLiteral("%"));
 
     // Automation: Position track with centerX (0) and centerY (1)
     auto* centerTrack = createAutomationTrack(QStringLiteral("Position"), 2, QColor(186, 85, 211));
-    centerTrack->setupParameter(0, -1.0, 1.0, _centerX, tr("Position X"), 100.0, QStringLiteral("%"));
-    centerTrack->setupParameter(1, -1.0, 1.0, _centerY, tr("Position Y"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(0, -1.0, 1.0, _params.centerX, tr("Position X"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(1, -1.0, 1.0, _params.centerY, tr("Position Y"), 100.0, QStringLiteral("%"));
 
     // Automation: Border track with horizontalBorder (0), horizontalBend (1), verticalBorder (2), verticalBend (3)
     auto* borderTrack = createAutomationTrack(QStringLiteral("Border"), 4, QColor(32, 178, 170));
-    borderTrack->setupParameter(0, 0.0, 1.0, _horizontalBorder, tr("H Border"), 100.0, QStringLiteral("%"));
-    borderTrack->setupParameter(1, -1.0, 1.0, _horizontalBend, tr("H Bend"), 100.0, QStringLiteral("%"));
-    borderTrack->setupParameter(2, 0.0, 1.0, _verticalBorder, tr("V Border"), 100.0, QStringLiteral("%"));
-    borderTrack->setupParameter(3, -1.0, 1.0, _verticalBend, tr("V Bend"), 100.0, QStringLiteral("%"));
+    borderTrack->setupParameter(0, 0.0, 1.0, _params.horizontalBorder, tr("H Border"), 100.0, QStringLiteral("%"));
+    borderTrack->setupParameter(1, -1.0, 1.0, _params.horizontalBend, tr("H Bend"), 100.0, QStringLiteral("%"));
+    borderTrack->setupParameter(2, 0.0, 1.0, _params.verticalBorder, tr("V Border"), 100.0, QStringLiteral("%"));
+    borderTrack->setupParameter(3, -1.0, 1.0, _params.verticalBend, tr("V Bend"), 100.0, QStringLiteral("%"));
 
     // Automation: Aperture track with aperture (0)
     auto* apertureTrack = createAutomationTrack(QStringLiteral("Aperture"), 1, QColor(255, 99, 71));
-    apertureTrack->setupParameter(0, 0.0, 360.0, _aperture, tr("Aperture"), 1.0, QStringLiteral("\u00B0"));
+    apertureTrack->setupParameter(0, 0.0, 360.0, _params.aperture, tr("Aperture"), 1.0, QStringLiteral("\u00B0"));
 
     // Automation: Phase track with phase (0)
     auto* phaseTrack = createAutomationTrack(QStringLiteral("Phase"), 1, QColor(30, 144, 255));
-    phaseTrack->setupParameter(0, 0.0, 360.0, _phase, tr("Phase"), 1.0, QStringLiteral("\u00B0"));
+    phaseTrack->setupParameter(0, 0.0, 360.0, _params.phase, tr("Phase"), 1.0, QStringLiteral("\u00B0"));
 
     // Automation: WaveCount track with waveCount (0)
     auto* waveTrack = createAutomationTrack(QStringLiteral("WaveCount"), 1, QColor(138, 43, 226));
-    waveTrack->setupParameter(0, 1.0, 20.0, _waveCount, tr("Wave Count"), 1.0, QString());
+    waveTrack->setupParameter(0, 1.0, 20.0, _params.waveCount, tr("Wave Count"), 1.0, QString());
 
     // Automation: Noise track with noiseIntensity (0), noiseScale (1), noiseSpeed (2)
     auto* noiseTrack = createAutomationTrack(QStringLiteral("Noise"), 3, QColor(128, 128, 0));
-    noiseTrack->setupParameter(0, 0.0, 1.0, _noiseIntensity, tr("Intensity"), 100.0, QStringLiteral("%"));
-    noiseTrack->setupParameter(1, 0.01, 2.0, _noiseScale, tr("Scale"), 100.0, QStringLiteral("%"));
-    noiseTrack->setupParameter(2, 0.0, 10.0, _noiseSpeed, tr("Speed"), 1.0, QString());
+    noiseTrack->setupParameter(0, 0.0, 1.0, _params.noiseIntensity, tr("Intensity"), 100.0, QStringLiteral("%"));
+    noiseTrack->setupParameter(1, 0.01, 2.0, _params.noiseScale, tr("Scale"), 100.0, QStringLiteral("%"));
+    noiseTrack->setupParameter(2, 0.0, 10.0, _params.noiseSpeed, tr("Speed"), 1.0, QString());
 }
 
 void GizmoNode::setShape(Shape s)
 {
-    if (_shape != s)
+    if (_params.shape != s)
     {
-        _shape = s;
+        _params.shape = s;
         emit shapeChanged();
         emitPropertyChanged();
     }
@@ -63,9 +64,9 @@ void GizmoNode::setShape(Shape s)
 void GizmoNode::setScaleX(qreal sx)
 {
     sx = qBound(0.01, sx, 3.0);
-    if (!qFuzzyCompare(_scaleX, sx))
+    if (!qFuzzyCompare(_params.scaleX, sx))
     {
-        _scaleX = sx;
+        _params.scaleX = sx;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Scale"));
         if (track) track->setInitialValue(0, sx);
@@ -77,9 +78,9 @@ void GizmoNode::setScaleX(qreal sx)
 void GizmoNode::setScaleY(qreal sy)
 {
     sy = qBound(0.01, sy, 3.0);
-    if (!qFuzzyCompare(_scaleY, sy))
+    if (!qFuzzyCompare(_params.scaleY, sy))
     {
-        _scaleY = sy;
+        _params.scaleY = sy;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Scale"));
         if (track) track->setInitialValue(1, sy);
@@ -90,9 +91,9 @@ void GizmoNode::setScaleY(qreal sy)
 
 void GizmoNode::setCenterX(qreal x)
 {
-    if (!qFuzzyCompare(_centerX, x))
+    if (!qFuzzyCompare(_params.centerX, x))
     {
-        _centerX = x;
+        _params.centerX = x;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(0, x);
@@ -103,9 +104,9 @@ void GizmoNode::setCenterX(qreal x)
 
 void GizmoNode::setCenterY(qreal y)
 {
-    if (!qFuzzyCompare(_centerY, y))
+    if (!qFuzzyCompare(_params.centerY, y))
     {
-        _centerY = y;
+        _params.centerY = y;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(1, y);
@@ -117,9 +118,9 @@ void GizmoNode::setCenterY(qreal y)
 void GizmoNode::setHorizontalBorder(qreal b)
 {
     b = qMax(0.001, b);
-    if (!qFuzzyCompare(_horizontalBorder, b))
+    if (!qFuzzyCompare(_params.horizontalBorder, b))
     {
-        _horizontalBorder = b;
+        _params.horizontalBorder = b;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Border"));
         if (track && track->paramCount() >= 4) track->setInitialValue(0, b);
@@ -131,9 +132,9 @@ void GizmoNode::setHorizontalBorder(qreal b)
 void GizmoNode::setVerticalBorder(qreal b)
 {
     b = qMax(0.001, b);
-    if (!qFuzzyCompare(_verticalBorder, b))
+    if (!qFuzzyCompare(_params.verticalBorder, b))
     {
-        _verticalBorder = b;
+        _params.verticalBorder = b;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Border"));
         if (track && track->paramCount() >= 4) track->setInitialValue(2, b);
@@ -144,9 +145,9 @@ void GizmoNode::setVerticalBorder(qreal b)
 
 void GizmoNode::setFalloffCurve(int curve)
 {
-    if (_falloffCurve != curve)
+    if (_params.falloffCurve != curve)
     {
-        _falloffCurve = curve;
+        _params.falloffCurve = curve;
         emit falloffCurveChanged();
         emitPropertyChanged();
     }
@@ -155,9 +156,9 @@ void GizmoNode::setFalloffCurve(int curve)
 void GizmoNode::setHorizontalBend(qreal b)
 {
     b = qBound(-1.0, b, 1.0);
-    if (!qFuzzyCompare(_horizontalBend, b))
+    if (!qFuzzyCompare(_params.horizontalBend, b))
     {
-        _horizontalBend = b;
+        _params.horizontalBend = b;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Border"));
         if (track && track->paramCount() >= 4) track->setInitialValue(1, b);
@@ -169,9 +170,9 @@ void GizmoNode::setHorizontalBend(qreal b)
 void GizmoNode::setVerticalBend(qreal b)
 {
     b = qBound(-1.0, b, 1.0);
-    if (!qFuzzyCompare(_verticalBend, b))
+    if (!qFuzzyCompare(_params.verticalBend, b))
     {
-        _verticalBend = b;
+        _params.verticalBend = b;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Border"));
         if (track && track->paramCount() >= 4) track->setInitialValue(3, b);
@@ -183,9 +184,9 @@ void GizmoNode::setVerticalBend(qreal b)
 void GizmoNode::setAperture(qreal a)
 {
     a = qBound(0.0, a, 360.0);
-    if (!qFuzzyCompare(_aperture, a))
+    if (!qFuzzyCompare(_params.aperture, a))
     {
-        _aperture = a;
+        _params.aperture = a;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Aperture"));
         if (track) track->setInitialValue(0, a);
@@ -199,9 +200,9 @@ void GizmoNode::setPhase(qreal p)
     // Normalize to 0-360
     while (p < 0.0) p += 360.0;
     while (p >= 360.0) p -= 360.0;
-    if (!qFuzzyCompare(_phase, p))
+    if (!qFuzzyCompare(_params.phase, p))
     {
-        _phase = p;
+        _params.phase = p;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Phase"));
         if (track) track->setInitialValue(0, p);
@@ -213,9 +214,9 @@ void GizmoNode::setPhase(qreal p)
 void GizmoNode::setWaveCount(int count)
 {
     count = qMax(1, count);
-    if (_waveCount != count)
+    if (_params.waveCount != count)
     {
-        _waveCount = count;
+        _params.waveCount = count;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("WaveCount"));
         if (track) track->setInitialValue(0, count);
@@ -227,9 +228,9 @@ void GizmoNode::setWaveCount(int count)
 void GizmoNode::setNoiseIntensity(qreal intensity)
 {
     intensity = qBound(0.0, intensity, 1.0);
-    if (!qFuzzyCompare(_noiseIntensity, intensity))
+    if (!qFuzzyCompare(_params.noiseIntensity, intensity))
     {
-        _noiseIntensity = intensity;
+        _params.noiseIntensity = intensity;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Noise"));
         if (track) track->setInitialValue(0, intensity);
@@ -241,9 +242,9 @@ void GizmoNode::setNoiseIntensity(qreal intensity)
 void GizmoNode::setNoiseScale(qreal scale)
 {
     scale = qMax(0.01, scale);
-    if (!qFuzzyCompare(_noiseScale, scale))
+    if (!qFuzzyCompare(_params.noiseScale, scale))
     {
-        _noiseScale = scale;
+        _params.noiseScale = scale;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Noise"));
         if (track) track->setInitialValue(1, scale);
@@ -255,9 +256,9 @@ void GizmoNode::setNoiseScale(qreal scale)
 void GizmoNode::setNoiseSpeed(qreal speed)
 {
     speed = qMax(0.0, speed);
-    if (!qFuzzyCompare(_noiseSpeed, speed))
+    if (!qFuzzyCompare(_params.noiseSpeed, speed))
     {
-        _noiseSpeed = speed;
+        _params.noiseSpeed = speed;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Noise"));
         if (track) track->setInitialValue(2, speed);
@@ -266,7 +267,7 @@ void GizmoNode::setNoiseSpeed(qreal speed)
     }
 }
 
-qreal GizmoNode::pseudoRandom(qreal x, qreal y) const
+qreal GizmoNode::Params::pseudoRandom(qreal x, qreal y) const
 {
     // Deterministic pseudo-random based on position
     // Returns value in [-1, 1]
@@ -275,40 +276,40 @@ qreal GizmoNode::pseudoRandom(qreal x, qreal y) const
     return (hash - qFloor(hash)) * 2.0 - 1.0;
 }
 
-qreal GizmoNode::applyNoise(qreal ratio, qreal x, qreal y, qreal time) const
+qreal GizmoNode::Params::applyNoise(qreal ratio, qreal x, qreal y, qreal time) const
 {
-    if (qFuzzyIsNull(_noiseIntensity))
+    if (qFuzzyIsNull(noiseIntensity))
     {
         return ratio;
     }
 
     // Scale coordinates for grain size (smaller scale = finer grain)
-    qreal scaledX = x / _noiseScale;
-    qreal scaledY = y / _noiseScale;
+    qreal scaledX = x / noiseScale;
+    qreal scaledY = y / noiseScale;
 
     // Add time offset for animation (speed controls how fast noise changes)
-    qreal timeOffset = time * _noiseSpeed;
+    qreal timeOffset = time * noiseSpeed;
     scaledX += timeOffset;
     scaledY += timeOffset * 0.7;  // Slightly different offset for Y to avoid linear motion
 
     qreal noise = pseudoRandom(scaledX, scaledY);
-    qreal noisyRatio = ratio * (1.0 + noise * _noiseIntensity);
+    qreal noisyRatio = ratio * (1.0 + noise * noiseIntensity);
     return qBound(0.0, noisyRatio, 1.0);
 }
 
 
-qreal GizmoNode::computeRatio(qreal x, qreal y, qreal time) const
+qreal GizmoNode::Params::computeRatio(qreal x, qreal y, qreal time) const
 {
-    if (qFuzzyIsNull(_scaleX) || qFuzzyIsNull(_scaleY))
+    if (qFuzzyIsNull(scaleX) || qFuzzyIsNull(scaleY))
         return 0.0;
 
     // Normalize to local coordinates: translate by center, then divide by scale
-    auto x1 = (x - _centerX) / _scaleX;
-    auto y1 = (y - _centerY) / _scaleY;
+    auto x1 = (x - centerX) / scaleX;
+    auto y1 = (y - centerY) / scaleY;
 
     qreal ratio = 0.0;
 
-    switch (_shape)
+    switch (shape)
     {
     case Shape::Rectangle:
         ratio = computeRectangleRatio(x1, y1);
@@ -331,20 +332,20 @@ qreal GizmoNode::computeRatio(qreal x, qreal y, qreal time) const
     return applyNoise(ratio, x, y, time);
 }
 
-qreal GizmoNode::computeRectangleRatio(qreal x1, qreal y1) const
+qreal GizmoNode::Params::computeRectangleRatio(qreal x1, qreal y1) const
 {
     // x1, y1 are already in local normalized coordinates [-1, 1]
 
     // Compute asymmetric slopes from border + bend (original GizmoTweak formula)
-    auto rightSlope = qMax(_horizontalBorder * (1.0 - _horizontalBend), 1e-6);
-    auto leftSlope  = qMax(_horizontalBorder * (1.0 + _horizontalBend), 1e-6);
-    auto horizontalCentralPoint = _horizontalBend * _horizontalBorder;
+    auto rightSlope = qMax(horizontalBorder * (1.0 - horizontalBend), 1e-6);
+    auto leftSlope  = qMax(horizontalBorder * (1.0 + horizontalBend), 1e-6);
+    auto horizontalCentralPoint = horizontalBend * horizontalBorder;
 
-    auto topSlope    = qMax(_verticalBorder * (1.0 - _verticalBend), 1e-6);
-    auto bottomSlope = qMax(_verticalBorder * (1.0 + _verticalBend), 1e-6);
-    auto verticalCentralPoint = _verticalBend * _verticalBorder;
+    auto topSlope    = qMax(verticalBorder * (1.0 - verticalBend), 1e-6);
+    auto bottomSlope = qMax(verticalBorder * (1.0 + verticalBend), 1e-6);
+    auto verticalCentralPoint = verticalBend * verticalBorder;
 
-    QEasingCurve curve(static_cast<QEasingCurve::Type>(_falloffCurve));
+    const EasingTable& curve = EasingTable::forType(falloffCurve);
 
     double xOmega;
     if (x1 > horizontalCentralPoint)
@@ -363,7 +364,7 @@ qreal GizmoNode::computeRectangleRatio(qreal x1, qreal y1) const
     return qMin(xResult, yResult);
 }
 
-qreal GizmoNode::computeEllipseRatio(qreal x1, qreal y1) const
+qreal GizmoNode::Params::computeEllipseRatio(qreal x1, qreal y1) const
 {
     // x1, y1 are already in local normalized coordinates
 
@@ -371,13 +372,13 @@ qreal GizmoNode::computeEllipseRatio(qreal x1, qreal y1) const
     if (distance >= 1.0)
         return 0.0;
 
-    if (qFuzzyIsNull(_horizontalBorder) && qFuzzyIsNull(_verticalBorder))
+    if (qFuzzyIsNull(horizontalBorder) && qFuzzyIsNull(verticalBorder))
         return 1.0;
 
     auto x1Abs = qAbs(x1);
     auto y1Abs = qAbs(y1);
-    auto ellipseHalfWidth = 1.0 - _horizontalBorder;
-    auto ellipseHalfHeight = 1.0 - _verticalBorder;
+    auto ellipseHalfWidth = 1.0 - horizontalBorder;
+    auto ellipseHalfHeight = 1.0 - verticalBorder;
 
     // Inside inner ellipse: full effect
     if (ellipseHalfWidth > 1e-6 && ellipseHalfHeight > 1e-6)
@@ -400,22 +401,22 @@ qreal GizmoNode::computeEllipseRatio(qreal x1, qreal y1) const
     double linearAlpha = 0.0;
     if (outerDist > 1e-6)
     {
-        auto pointDist = qSqrt((x1Abs - _horizontalBend - normalizedX) * (x1Abs - _horizontalBend - normalizedX) +
-                                (y1Abs - _verticalBend - normalizedY) * (y1Abs - _verticalBend - normalizedY));
+        auto pointDist = qSqrt((x1Abs - horizontalBend - normalizedX) * (x1Abs - horizontalBend - normalizedX) +
+                                (y1Abs - verticalBend - normalizedY) * (y1Abs - verticalBend - normalizedY));
         linearAlpha = pointDist / outerDist;
     }
 
-    QEasingCurve curve(static_cast<QEasingCurve::Type>(_falloffCurve));
+    const EasingTable& curve = EasingTable::forType(falloffCurve);
     return curve.valueForProgress(qBound(0.0, linearAlpha, 1.0));
 }
 
-qreal GizmoNode::computeAngleRatio(qreal x1, qreal y1) const
+qreal GizmoNode::Params::computeAngleRatio(qreal x1, qreal y1) const
 {
     // x1, y1 are already in local normalized coordinates
 
     // Aperture in radians (half-aperture centered on phase)
-    auto apertureRad = qDegreesToRadians(_aperture) / 2.0;
-    auto phaseRad = qDegreesToRadians(_phase);
+    auto apertureRad = qDegreesToRadians(aperture) / 2.0;
+    auto phaseRad = qDegreesToRadians(phase);
 
     // Angle relative to phase direction
     auto angle = qAtan2(y1, x1) - phaseRad;
@@ -430,9 +431,9 @@ qreal GizmoNode::computeAngleRatio(qreal x1, qreal y1) const
         return 0.0;
 
     // Compute asymmetric slopes
-    auto rightSlope = qMax(_horizontalBorder * (1.0 - _horizontalBend), 1e-6);
-    auto leftSlope  = qMax(_horizontalBorder * (1.0 + _horizontalBend), 1e-6);
-    auto horizontalCentralPoint = _horizontalBend * _horizontalBorder;
+    auto rightSlope = qMax(horizontalBorder * (1.0 - horizontalBend), 1e-6);
+    auto leftSlope  = qMax(horizontalBorder * (1.0 + horizontalBend), 1e-6);
+    auto horizontalCentralPoint = horizontalBend * horizontalBorder;
 
     // Normalize angle to [-1, 1] within aperture
     auto angleAlpha = angle * 2.0 / (apertureRad * 2.0);
@@ -443,7 +444,7 @@ qreal GizmoNode::computeAngleRatio(qreal x1, qreal y1) const
     else
         omega = qBound(0.0, (1.0 + angleAlpha) / leftSlope, 1.0);
 
-    QEasingCurve curve(static_cast<QEasingCurve::Type>(_falloffCurve));
+    const EasingTable& curve = EasingTable::forType(falloffCurve);
 
     auto angleSlope = (angleAlpha * rightSlope + (1.0 - angleAlpha) * leftSlope);
     omega = qMin(omega, curve.valueForProgress(qSqrt(x1 * x1 + y1 * y1)) * angleSlope);
@@ -451,12 +452,12 @@ qreal GizmoNode::computeAngleRatio(qreal x1, qreal y1) const
     return curve.valueForProgress(omega);
 }
 
-qreal GizmoNode::computeLinearWaveRatio(qreal x1, qreal /*y1*/) const
+qreal GizmoNode::Params::computeLinearWaveRatio(qreal x1, qreal /*y1*/) const
 {
     // x1 is already in local normalized coordinates
 
     // Phase offset (normalized)
-    auto phaseOffset = _phase / 360.0;
+    auto phaseOffset = phase / 360.0;
 
     // Fold into [0, 1] triangle wave
     auto mod1 = std::fmod(qAbs((x1 - phaseOffset) * 2.0), 2.0);
@@ -464,9 +465,9 @@ qreal GizmoNode::computeLinearWaveRatio(qreal x1, qreal /*y1*/) const
         mod1 = 2.0 - mod1;
 
     // Compute asymmetric slopes
-    auto rightSlope = qMax(_horizontalBorder * (1.0 - _horizontalBend), 1e-6);
-    auto leftSlope  = qMax(_horizontalBorder * (1.0 + _horizontalBend), 1e-6);
-    auto horizontalCentralPoint = _horizontalBend * _horizontalBorder;
+    auto rightSlope = qMax(horizontalBorder * (1.0 - horizontalBend), 1e-6);
+    auto leftSlope  = qMax(horizontalBorder * (1.0 + horizontalBend), 1e-6);
+    auto horizontalCentralPoint = horizontalBend * horizontalBorder;
 
     double xOmega;
     if (mod1 > horizontalCentralPoint)
@@ -474,18 +475,18 @@ qreal GizmoNode::computeLinearWaveRatio(qreal x1, qreal /*y1*/) const
     else
         xOmega = qBound(0.0, (1.0 + mod1) / leftSlope, 1.0);
 
-    QEasingCurve curve(static_cast<QEasingCurve::Type>(_falloffCurve));
+    const EasingTable& curve = EasingTable::forType(falloffCurve);
     return curve.valueForProgress(xOmega);
 }
 
-qreal GizmoNode::computeCircularWaveRatio(qreal x1, qreal y1) const
+qreal GizmoNode::Params::computeCircularWaveRatio(qreal x1, qreal y1) const
 {
     // x1, y1 are already in local normalized coordinates
 
     auto dist = qSqrt(x1 * x1 + y1 * y1);
 
     // Phase offset (normalized)
-    auto phaseOffset = _phase / 360.0;
+    auto phaseOffset = phase / 360.0;
 
     // Fold into [0, 1] triangle wave
     auto mod1 = std::fmod(qAbs((dist - phaseOffset) * 2.0), 2.0);
@@ -493,9 +494,9 @@ qreal GizmoNode::computeCircularWaveRatio(qreal x1, qreal y1) const
         mod1 = 2.0 - mod1;
 
     // Compute asymmetric slopes
-    auto rightSlope = qMax(_horizontalBorder * (1.0 - _horizontalBend), 1e-6);
-    auto leftSlope  = qMax(_horizontalBorder * (1.0 + _horizontalBend), 1e-6);
-    auto horizontalCentralPoint = _horizontalBend * _horizontalBorder;
+    auto rightSlope = qMax(horizontalBorder * (1.0 - horizontalBend), 1e-6);
+    auto leftSlope  = qMax(horizontalBorder * (1.0 + horizontalBend), 1e-6);
+    auto horizontalCentralPoint = horizontalBend * horizontalBorder;
 
     double xOmega;
     if (mod1 > horizontalCentralPoint)
@@ -503,29 +504,29 @@ qreal GizmoNode::computeCircularWaveRatio(qreal x1, qreal y1) const
     else
         xOmega = qBound(0.0, (1.0 + mod1) / leftSlope, 1.0);
 
-    QEasingCurve curve(static_cast<QEasingCurve::Type>(_falloffCurve));
+    const EasingTable& curve = EasingTable::forType(falloffCurve);
     return curve.valueForProgress(xOmega);
 }
 
 QJsonObject GizmoNode::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["shape"] = static_cast<int>(_shape);
-    obj["scaleX"] = _scaleX;
-    obj["scaleY"] = _scaleY;
-    obj["centerX"] = _centerX;
-    obj["centerY"] = _centerY;
-    obj["horizontalBorder"] = _horizontalBorder;
-    obj["verticalBorder"] = _verticalBorder;
-    obj["falloffCurve"] = _falloffCurve;
-    obj["horizontalBend"] = _horizontalBend;
-    obj["verticalBend"] = _verticalBend;
-    obj["aperture"] = _aperture;
-    obj["phase"] = _phase;
-    obj["waveCount"] = _waveCount;
-    obj["noiseIntensity"] = _noiseIntensity;
-    obj["noiseScale"] = _noiseScale;
-    obj["noiseSpeed"] = _noiseSpeed;
+    obj["shape"] = static_cast<int>(_params.shape);
+    obj["scaleX"] = _params.scaleX;
+    obj["scaleY"] = _params.scaleY;
+    obj["centerX"] = _params.centerX;
+    obj["centerY"] = _params.centerY;
+    obj["horizontalBorder"] = _params.horizontalBorder;
+    obj["verticalBorder"] = _params.verticalBorder;
+    obj["falloffCurve"] = _params.falloffCurve;
+    obj["horizontalBend"] = _params.horizontalBend;
+    obj["verticalBend"] = _params.verticalBend;
+    obj["aperture"] = _params.aperture;
+    obj["phase"] = _params.phase;
+    obj["waveCount"] = _params.waveCount;
+    obj["noiseIntensity"] = _params.noiseIntensity;
+    obj["noiseScale"] = _params.noiseScale;
+    obj["noiseSpeed"] = _params.noiseSpeed;
     return obj;
 }
 
@@ -601,66 +602,46 @@ void GizmoNode::automationFromJson(const QJsonArray& json)
     }
 }
 
-void GizmoNode::syncToAnimatedValues(int timeMs)
-{
-    // Only sync if automation is active for each track
-    auto* scaleTrack = automationTrack(QStringLiteral("Scale"));
-    if (scaleTrack && scaleTrack->isAutomated())
-    {
-        _scaleX = scaleTrack->timedValue(timeMs, 0);
-        _scaleY = scaleTrack->timedValue(timeMs, 1);
-    }
-
-    auto* centerTrack = automationTrack(QStringLiteral("Center"));
-    if (centerTrack && centerTrack->isAutomated())
-    {
-        _centerX = centerTrack->timedValue(timeMs, 0);
-        _centerY = centerTrack->timedValue(timeMs, 1);
-    }
+using GizmoParams = GizmoNode::Params;
 
-    auto* borderTrack = automationTrack(QStringLiteral("Border"));
-    if (borderTrack && borderTrack->isAutomated())
-    {
-        if (borderTrack->paramCount() == 4)
+// Automation tracks -> Params members; "Center" is the center track of older files
+static constexpr AutomationBinding<GizmoParams> AUTOMATION_BINDINGS[] = {
+    {"Scale", {&GizmoParams::scaleX, &GizmoParams::scaleY}},
+    {"Position", {&GizmoParams::centerX, &GizmoParams::centerY}},
+    {"Center", {&GizmoParams::centerX, &GizmoParams::centerY}},
+    {"Border", {}, [](GizmoParams& params, const double* values, int paramCount) {
+        if (paramCount == 4)
         {
-            _horizontalBorder = borderTrack->timedValue(timeMs, 0);
-            _horizontalBend = borderTrack->timedValue(timeMs, 1);
-            _verticalBorder = borderTrack->timedValue(timeMs, 2);
-            _verticalBend = borderTrack->timedValue(timeMs, 3);
+            params.horizontalBorder = values[0];
+            params.horizontalBend = values[1];
+            params.verticalBorder = values[2];
+            params.verticalBend = values[3];
         }
-        else if (borderTrack->paramCount() == 2)
+        else if (paramCount == 2)
         {
             // Legacy 2-param border track
-            _horizontalBorder = borderTrack->timedValue(timeMs, 0);
-            _verticalBorder = borderTrack->timedValue(timeMs, 1);
+            params.horizontalBorder = values[0];
+            params.verticalBorder = values[1];
         }
-    }
-
-    auto* apertureTrack = automationTrack(QStringLiteral("Aperture"));
-    if (apertureTrack && apertureTrack->isAutomated())
-    {
-        _aperture = apertureTrack->timedValue(timeMs, 0);
-    }
-
-    auto* phaseTrack = automationTrack(QStringLiteral("Phase"));
-    if (phaseTrack && phaseTrack->isAutomated())
-    {
-        _phase = phaseTrack->timedValue(timeMs, 0);
-    }
-
-    auto* waveCountTrack = automationTrack(QStringLiteral("WaveCount"));
-    if (waveCountTrack && waveCountTrack->isAutomated())
-    {
-        _waveCount = static_cast<int>(waveCountTrack->timedValue(timeMs, 0));
-    }
+    }},
+    {"Aperture", {&GizmoParams::aperture}},
+    {"Phase", {&GizmoParams::phase}},
+    {"WaveCount", {}, [](GizmoParams& params, const double* values, int) {
+        params.waveCount = static_cast<int>(values[0]);
+    }},
+    {"Noise", {&GizmoParams::noiseIntensity, &GizmoParams::noiseScale, &GizmoParams::noiseSpeed}},
+};
+
+GizmoNode::Params GizmoNode::paramsAt(int timeMs) const
+{
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* noiseTrack = automationTrack(QStringLiteral("Noise"));
-    if (noiseTrack && noiseTrack->isAutomated())
-    {
-        _noiseIntensity = noiseTrack->timedValue(timeMs, 0);
-        _noiseScale = noiseTrack->timedValue(timeMs, 1);
-        _noiseSpeed = noiseTrack->timedValue(timeMs, 2);
-    }
+void GizmoNode::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
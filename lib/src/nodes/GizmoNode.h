@@ -42,83 +42,121 @@ private:
     Q_PROPERTY(qreal noiseSpeed READ noiseSpeed WRITE setNoiseSpeed NOTIFY noiseSpeedChanged)
 
 public:
+    // Shape parameters at one evaluation time; computeRatio() reads nothing else
+    struct Params
+    {
+        Shape shape{Shape::Ellipse};
+        qreal scaleX{1.0};
+        qreal scaleY{1.0};
+        qreal centerX{0.0};
+        qreal centerY{0.0};
+        qreal horizontalBorder{1.0};
+        qreal verticalBorder{1.0};
+        int falloffCurve{QEasingCurve::Linear};
+        qreal horizontalBend{0.0};
+        qreal verticalBend{0.0};
+        qreal aperture{90.0};   // Degrees for Angle shape
+        qreal phase{0.0};       // Degrees for wave shapes
+        int waveCount{4};       // Number of waves
+        qreal noiseIntensity{0.0};  // Noise intensity [0, 1]
+        qreal noiseScale{1.0};      // Noise scale (grain size)
+        qreal noiseSpeed{0.0};      // Noise animation speed (0 = static)
+
+        // Compute ratio at position (time parameter for animated noise)
+        qreal computeRatio(qreal x, qreal y, qreal time = 0.0) const;
+
+        // Per-shape falloff, in local coordinates (centered, divided by scale)
+        qreal computeEllipseRatio(qreal x1, qreal y1) const;
+        qreal computeRectangleRatio(qreal x1, qreal y1) const;
+        qreal computeAngleRatio(qreal x1, qreal y1) const;
+        qreal computeLinearWaveRatio(qreal x1, qreal y1) const;
+        qreal computeCircularWaveRatio(qreal x1, qreal y1) const;
+        qreal applyNoise(qreal ratio, qreal x, qreal y, qreal time) const;
+        qreal pseudoRandom(qreal x, qreal y) const;
+    };
+
     explicit GizmoNode(QObject* parent = nullptr);
     ~GizmoNode() override = default;
 
     QString type() const override { return QStringLiteral("Gizmo"); }
     Category category() const override { return Category::Shape; }
+    Kind kind() const override { return Kind::Gizmo; }
 
     // Shape
-    Shape shape() const { return _shape; }
+    Shape shape() const { return _params.shape; }
     void setShape(Shape s);
 
     // Scale (gizmo half-size)
-    qreal scaleX() const { return _scaleX; }
+    qreal scaleX() const { return _params.scaleX; }
     void setScaleX(qreal sx);
 
-    qreal scaleY() const { return _scaleY; }
+    qreal scaleY() const { return _params.scaleY; }
     void setScaleY(qreal sy);
 
     // Position
-    qreal centerX() const { return _centerX; }
+    qreal centerX() const { return _params.centerX; }
     void setCenterX(qreal x);
 
-    qreal centerY() const { return _centerY; }
+    qreal centerY() const { return _params.centerY; }
     void setCenterY(qreal y);
 
     // Asymmetric borders
-    qreal horizontalBorder() const { return _horizontalBorder; }
+    qreal horizontalBorder() const { return _params.horizontalBorder; }
     void setHorizontalBorder(qreal b);
 
-    qreal verticalBorder() const { return _verticalBorder; }
+    qreal verticalBorder() const { return _params.verticalBorder; }
     void setVerticalBorder(qreal b);
 
     // Falloff curve
-    int falloffCurve() const { return _falloffCurve; }
+    int falloffCurve() const { return _params.falloffCurve; }
     void setFalloffCurve(int curve);
 
     // Bend (distortion)
-    qreal horizontalBend() const { return _horizontalBend; }
+    qreal horizontalBend() const { return _params.horizontalBend; }
     void setHorizontalBend(qreal b);
 
-    qreal verticalBend() const { return _verticalBend; }
+    qreal verticalBend() const { return _params.verticalBend; }
     void setVerticalBend(qreal b);
 
     // Aperture (for Angle shape, in degrees 0-360)
-    qreal aperture() const { return _aperture; }
+    qreal aperture() const { return _params.aperture; }
     void setAperture(qreal a);
 
     // Phase (for wave shapes, in degrees 0-360)
-    qreal phase() const { return _phase; }
+    qreal phase() const { return _params.phase; }
     void setPhase(qreal p);
 
     // Wave count (for wave shapes)
-    int waveCount() const { return _waveCount; }
+    int waveCount() const { return _params.waveCount; }
     void setWaveCount(int count);
 
     // Noise
-    qreal noiseIntensity() const { return _noiseIntensity; }
+    qreal noiseIntensity() const { return _params.noiseIntensity; }
     void setNoiseIntensity(qreal intensity);
 
-    qreal noiseScale() const { return _noiseScale; }
+    qreal noiseScale() const { return _params.noiseScale; }
     void setNoiseScale(qreal scale);
 
-    qreal noiseSpeed() const { return _noiseSpeed; }
+    qreal noiseSpeed() const { return _params.noiseSpeed; }
     void setNoiseSpeed(qreal speed);
 
-    // Compute ratio at position (time parameter for animated noise)
-    Q_INVOKABLE qreal computeRatio(qreal x, qreal y, qreal time = 0.0) const;
+    // Compute ratio at position with the current parameters (time parameter for animated noise)
+    Q_INVOKABLE qreal computeRatio(qreal x, qreal y, qreal time = 0.0) const { return _params.computeRatio(x, y, time); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
     void propertiesFromJson(const QJsonObject& json) override;
     void automationFromJson(const QJsonArray& json) override;
 
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
     // Automation
     void syncToAnimatedValues(int timeMs) override;
 
     // Legacy compatibility
-    qreal radius() const { return (_horizontalBorder + _verticalBorder) / 2.0; }
+    qreal radius() const { return (_params.horizontalBorder + _params.verticalBorder) / 2.0; }
     void setRadius(qreal r) { setHorizontalBorder(r); setVerticalBorder(r); }
 
 signals:
@@ -140,30 +178,7 @@ signals:
     void noiseSpeedChanged();
 
 private:
-    qreal computeEllipseRatio(qreal x1, qreal y1) const;
-    qreal computeRectangleRatio(qreal x1, qreal y1) const;
-    qreal computeAngleRatio(qreal x1, qreal y1) const;
-    qreal computeLinearWaveRatio(qreal x1, qreal y1) const;
-    qreal computeCircularWaveRatio(qreal x1, qreal y1) const;
-    qreal applyNoise(qreal ratio, qreal x, qreal y, qreal time) const;
-    qreal pseudoRandom(qreal x, qreal y) const;
-
-    Shape _shape{Shape::Ellipse};
-    qreal _scaleX{1.0};
-    qreal _scaleY{1.0};
-    qreal _centerX{0.0};
-    qreal _centerY{0.0};
-    qreal _horizontalBorder{1.0};
-    qreal _verticalBorder{1.0};
-    int _falloffCurve{QEasingCurve::Linear};
-    qreal _horizontalBend{0.0};
-    qreal _verticalBend{0.0};
-    qreal _aperture{90.0};   // Degrees for Angle shape
-    qreal _phase{0.0};       // Degrees for wave shapes
-    int _waveCount{4};       // Number of waves
-    qreal _noiseIntensity{0.0};  // Noise intensity [0, 1]
-    qreal _noiseScale{1.0};      // Noise scale (grain size)
-    qreal _noiseSpeed{0.0};      // Noise animation speed (0 = static)
+    Params _params;
 };
 
 } // namespace gizmotweak2
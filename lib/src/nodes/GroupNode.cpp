@@ -1,4 +1,5 @@
 #include "GroupNode.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -26,22 +27,22 @@ GroupNode::GroupNode(QObject* parent)
 
     // Automation: Position track with positionX (0) and positionY (1)
     auto* positionTrack = createAutomationTrack(QStringLiteral("Position"), 2, QColor(70, 130, 180));
-    positionTrack->setupParameter(0, -2.0, 2.0, _positionX, tr("Position X"), 100.0, QStringLiteral("%"));
-    positionTrack->setupParameter(1, -2.0, 2.0, _positionY, tr("Position Y"), 100.0, QStringLiteral("%"));
+    positionTrack->setupParameter(0, -2.0, 2.0, _params.positionX, tr("Position X"), 100.0, QStringLiteral("%"));
+    positionTrack->setupParameter(1, -2.0, 2.0, _params.positionY, tr("Position Y"), 100.0, QStringLiteral("%"));
 
     auto* scaleTrack = createAutomationTrack(QStringLiteral("Scale"), 2, QColor(60, 179, 113));
-    scaleTrack->setupParameter(0, 0.01, 10.0, _scaleX, tr("Scale X"), 100.0, QStringLiteral("%"));
-    scaleTrack->setupParameter(1, 0.01, 10.0, _scaleY, tr("Scale Y"), 100.0, QStringLiteral("%"));
+    scaleTrack->setupParameter(0, 0.01, 10.0, _params.scaleX, tr("Scale X"), 100.0, QStringLiteral("%"));
+    scaleTrack->setupParameter(1, 0.01, 10.0, _params.scaleY, tr("Scale Y"), 100.0, QStringLiteral("%"));
 
     auto* rotationTrack = createAutomationTrack(QStringLiteral("Rotation"), 1, QColor(255, 140, 0));
-    rotationTrack->setupParameter(0, -360.0, 360.0, _rotation, tr("Rotation"), 1.0, QStringLiteral("\u00B0"));
+    rotationTrack->setupParameter(0, -360.0, 360.0, _params.rotation, tr("Rotation"), 1.0, QStringLiteral("\u00B0"));
 }
 
 void GroupNode::setCompositionMode(CompositionMode mode)
 {
-    if (_compositionMode != mode)
+    if (_params.compositionMode != mode)
     {
-        _compositionMode = mode;
+        _params.compositionMode = mode;
         emit compositionModeChanged();
         emitPropertyChanged();
     }
@@ -49,9 +50,9 @@ void GroupNode::setCompositionMode(CompositionMode mode)
 
 void GroupNode::setSingleInputMode(bool enabled)
 {
-    if (_singleInputMode != enabled)
+    if (_params.singleInputMode != enabled)
     {
-        _singleInputMode = enabled;
+        _params.singleInputMode = enabled;
 
         auto* input2 = inputAt(1);
         if (input2)
@@ -79,9 +80,9 @@ void GroupNode::setSingleInputMode(bool enabled)
 
 void GroupNode::setPositionX(qreal x)
 {
-    if (!qFuzzyCompare(_positionX, x))
+    if (!qFuzzyCompare(_params.positionX, x))
     {
-        _positionX = x;
+        _params.positionX = x;
         emit positionXChanged();
         emitPropertyChanged();
     }
@@ -89,9 +90,9 @@ void GroupNode::setPositionX(qreal x)
 
 void GroupNode::setPositionY(qreal y)
 {
-    if (!qFuzzyCompare(_positionY, y))
+    if (!qFuzzyCompare(_params.positionY, y))
     {
-        _positionY = y;
+        _params.positionY = y;
         emit positionYChanged();
         emitPropertyChanged();
     }
@@ -99,9 +100,9 @@ void GroupNode::setPositionY(qreal y)
 
 void GroupNode::setScaleX(qreal sx)
 {
-    if (!qFuzzyCompare(_scaleX, sx))
+    if (!qFuzzyCompare(_params.scaleX, sx))
     {
-        _scaleX = sx;
+        _params.scaleX = sx;
         emit scaleXChanged();
         emitPropertyChanged();
     }
@@ -109,9 +110,9 @@ void GroupNode::setScaleX(qreal sx)
 
 void GroupNode::setScaleY(qreal sy)
 {
-    if (!qFuzzyCompare(_scaleY, sy))
+    if (!qFuzzyCompare(_params.scaleY, sy))
     {
-        _scaleY = sy;
+        _params.scaleY = sy;
         emit scaleYChanged();
         emitPropertyChanged();
     }
@@ -119,46 +120,69 @@ void GroupNode::setScaleY(qreal sy)
 
 void GroupNode::setRotation(qreal r)
 {
-    if (!qFuzzyCompare(_rotation, r))
+    if (!qFuzzyCompare(_params.rotation, r))
     {
-        _rotation = r;
+        _params.rotation = r;
         emit rotationChanged();
         emitPropertyChanged();
     }
 }
 
-void GroupNode::transformCoordinates(qreal x, qreal y, qreal& outX, qreal& outY) const
+void GroupNode::Params::transformCoordinates(qreal x, qreal y, qreal& outX, qreal& outY) const
 {
     // Apply inverse geometric transformation to get local coordinates
     // Same as original GizmoTweak Group::getTweakRatio
 
-    if (qFuzzyIsNull(_scaleX) || qFuzzyIsNull(_scaleY))
+    if (qFuzzyIsNull(scaleX) || qFuzzyIsNull(scaleY))
     {
         outX = 0.0;
         outY = 0.0;
         return;
     }
 
-    qreal rotRad = qDegreesToRadians(_rotation);
+    qreal rotRad = qDegreesToRadians(rotation);
     qreal myCos = std::cos(rotRad);
     qreal mySin = std::sin(rotRad);
 
     // Translate to local origin
-    qreal x0 = x - _positionX;
-    qreal y0 = y - _positionY;
+    qreal x0 = x - positionX;
+    qreal y0 = y - positionY;
 
     // Rotate and scale (inverse transformation)
-    outX = (myCos * x0 - mySin * y0) / _scaleX;
-    outY = (mySin * x0 + myCos * y0) / _scaleY;
+    outX = (myCos * x0 - mySin * y0) / scaleX;
+    outY = (mySin * x0 + myCos * y0) / scaleY;
 }
 
-qreal GroupNode::combine(const QList<qreal>& ratios) const
+void GroupNode::Params::transformCoordinatesBatch(const qreal* xs, const qreal* ys, int count,
+                                                  qreal* outXs, qreal* outYs) const
+{
+    if (qFuzzyIsNull(scaleX) || qFuzzyIsNull(scaleY))
+    {
+        std::fill(outXs, outXs + count, 0.0);
+        std::fill(outYs, outYs + count, 0.0);
+        return;
+    }
+
+    qreal rotRad = qDegreesToRadians(rotation);
+    qreal myCos = std::cos(rotRad);
+    qreal mySin = std::sin(rotRad);
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal x0 = xs[i] - positionX;
+        qreal y0 = ys[i] - positionY;
+        outXs[i] = (myCos * x0 - mySin * y0) / scaleX;
+        outYs[i] = (mySin * x0 + myCos * y0) / scaleY;
+    }
+}
+
+qreal GroupNode::Params::combine(const QList<qreal>& ratios) const
 {
     // Exact formulas from original GizmoTweak Group::getTweakRatio
     qreal result = 0.0;
     int activeCount = ratios.size();
 
-    switch (_compositionMode)
+    switch (compositionMode)
     {
     case CompositionMode::Normal:
         // Original formula: same signs take max/min, opposite signs sum
@@ -283,13 +307,13 @@ qreal GroupNode::combine(const QList<qreal>& ratios) const
 QJsonObject GroupNode::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["compositionMode"] = static_cast<int>(_compositionMode);
-    obj["singleInputMode"] = _singleInputMode;
-    obj["positionX"] = _positionX;
-    obj["positionY"] = _positionY;
-    obj["scaleX"] = _scaleX;
-    obj["scaleY"] = _scaleY;
-    obj["rotation"] = _rotation;
+    obj["compositionMode"] = static_cast<int>(_params.compositionMode);
+    obj["singleInputMode"] = _params.singleInputMode;
+    obj["positionX"] = _params.positionX;
+    obj["positionY"] = _params.positionY;
+    obj["scaleX"] = _params.scaleX;
+    obj["scaleY"] = _params.scaleY;
+    obj["rotation"] = _params.rotation;
     return obj;
 }
 
@@ -325,13 +349,34 @@ void GroupNode::propertiesFromJson(const QJsonObject& json)
     }
 }
 
+using GroupParams = GroupNode::Params;
+
+// Automation tracks -> Params members; tracks that are not automated still give
+// their initial values
+static constexpr AutomationBinding<GroupParams> AUTOMATION_BINDINGS[] = {
+    {"Position", {&GroupParams::positionX, &GroupParams::positionY}, nullptr, true},
+    {"Scale", {&GroupParams::scaleX, &GroupParams::scaleY}, nullptr, true},
+    {"Rotation", {&GroupParams::rotation}, nullptr, true},
+};
+
+GroupNode::Params GroupNode::paramsAt(int timeMs) const
+{
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
+
 void GroupNode::syncToAnimatedValues(int timeMs)
 {
-    setPositionX(automatedValue(QStringLiteral("Position"), 0, timeMs));
-    setPositionY(automatedValue(QStringLiteral("Position"), 1, timeMs));
-    setScaleX(automatedValue(QStringLiteral("Scale"), 0, timeMs));
-    setScaleY(automatedValue(QStringLiteral("Scale"), 1, timeMs));
-    setRotation(automatedValue(QStringLiteral("Rotation"), 0, timeMs));
+    // Not an edit: only the property signals the Transform panel follows, without
+    // propertyChanged (graph revision, modified flag, preview refresh)
+    const Params previous = _params;
+    _params = paramsAt(timeMs);
+    if (!qFuzzyCompare(previous.positionX, _params.positionX)) emit positionXChanged();
+    if (!qFuzzyCompare(previous.positionY, _params.positionY)) emit positionYChanged();
+    if (!qFuzzyCompare(previous.scaleX, _params.scaleX)) emit scaleXChanged();
+    if (!qFuzzyCompare(previous.scaleY, _params.scaleY)) emit scaleYChanged();
+    if (!qFuzzyCompare(previous.rotation, _params.rotation)) emit rotationChanged();
 }
 
 } // namespace gizmotweak2
@@ -36,47 +36,78 @@ public:
     Q_PROPERTY(qreal rotation READ rotation WRITE setRotation NOTIFY rotationChanged)
 
 public:
+    // Composition and transform parameters at one evaluation time
+    struct Params
+    {
+        CompositionMode compositionMode{CompositionMode::Normal};
+        bool singleInputMode{false};
+
+        // Geometric controls
+        qreal positionX{0.0};
+        qreal positionY{0.0};
+        qreal scaleX{1.0};
+        qreal scaleY{1.0};
+        qreal rotation{0.0};  // In degrees
+
+        // Transform world coordinates to local coordinates
+        void transformCoordinates(qreal x, qreal y, qreal& outX, qreal& outY) const;
+
+        // Batch version of transformCoordinates(), rotation computed once per call
+        void transformCoordinatesBatch(const qreal* xs, const qreal* ys, int count,
+                                       qreal* outXs, qreal* outYs) const;
+
+        // Combine multiple ratios according to composition mode
+        // This contains the exact formulas from original GizmoTweak
+        qreal combine(const QList<qreal>& ratios) const;
+    };
+
     explicit GroupNode(QObject* parent = nullptr);
     ~GroupNode() override = default;
 
     QString type() const override { return QStringLiteral("Transform"); }
     Category category() const override { return Category::Shape; }
+    Kind kind() const override { return Kind::Transform; }
 
     // Composition mode
-    CompositionMode compositionMode() const { return _compositionMode; }
+    CompositionMode compositionMode() const { return _params.compositionMode; }
     void setCompositionMode(CompositionMode mode);
 
     // Single input mode (bypass combination)
-    bool singleInputMode() const { return _singleInputMode; }
+    bool singleInputMode() const { return _params.singleInputMode; }
     void setSingleInputMode(bool enabled);
 
     // Geometric properties
-    qreal positionX() const { return _positionX; }
+    qreal positionX() const { return _params.positionX; }
     void setPositionX(qreal x);
 
-    qreal positionY() const { return _positionY; }
+    qreal positionY() const { return _params.positionY; }
     void setPositionY(qreal y);
 
-    qreal scaleX() const { return _scaleX; }
+    qreal scaleX() const { return _params.scaleX; }
     void setScaleX(qreal sx);
 
-    qreal scaleY() const { return _scaleY; }
+    qreal scaleY() const { return _params.scaleY; }
     void setScaleY(qreal sy);
 
-    qreal rotation() const { return _rotation; }
+    qreal rotation() const { return _params.rotation; }
     void setRotation(qreal r);
 
-    // Transform world coordinates to local coordinates
-    void transformCoordinates(qreal x, qreal y, qreal& outX, qreal& outY) const;
+    // Evaluate with the current parameters (see Params)
+    void transformCoordinates(qreal x, qreal y, qreal& outX, qreal& outY) const { _params.transformCoordinates(x, y, outX, outY); }
 
-    // Combine multiple ratios according to composition mode
-    // This contains the exact formulas from original GizmoTweak
-    Q_INVOKABLE qreal combine(const QList<qreal>& ratios) const;
+    void transformCoordinatesBatch(const qreal* xs, const qreal* ys, int count,
+                                   qreal* outXs, qreal* outYs) const { _params.transformCoordinatesBatch(xs, ys, count, outXs, outYs); }
+
+    Q_INVOKABLE qreal combine(const QList<qreal>& ratios) const { return _params.combine(ratios); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
     void propertiesFromJson(const QJsonObject& json) override;
 
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
     // Automation
     void syncToAnimatedValues(int timeMs) override;
 
@@ -90,15 +121,7 @@ signals:
     void rotationChanged();
 
 private:
-    CompositionMode _compositionMode{CompositionMode::Normal};
-    bool _singleInputMode{false};
-
-    // Geometric controls
-    qreal _positionX{0.0};
-    qreal _positionY{0.0};
-    qreal _scaleX{1.0};
-    qreal _scaleY{1.0};
-    qreal _rotation{0.0};  // In degrees
+    Params _params;
 };
 
 } // namespace gizmotweak2
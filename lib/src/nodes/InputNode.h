@@ -42,6 +42,7 @@ public:
 
     QString type() const override { return QStringLiteral("Input"); }
     Category category() const override { return Category::IO; }
+    Kind kind() const override { return Kind::Input; }
 
     // Source type
     SourceType sourceType() const { return _sourceType; }
@@ -1,4 +1,5 @@
 #include "MirrorNode.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -23,14 +24,14 @@ MirrorNode::MirrorNode(QObject* parent)
 
     // Automation: Angle track with customAngle (0)
     auto* angleTrack = createAutomationTrack(QStringLiteral("Angle"), 1, QColor(255, 140, 0));  // Dark orange
-    angleTrack->setupParameter(0, -180.0, 180.0, _customAngle, tr("Angle"), 1.0, QStringLiteral("°"));
+    angleTrack->setupParameter(0, -180.0, 180.0, _params.customAngle, tr("Angle"), 1.0, QStringLiteral("°"));
 }
 
 void MirrorNode::setAxis(Axis a)
 {
-    if (_axis != a)
+    if (_params.axis != a)
     {
-        _axis = a;
+        _params.axis = a;
         emit axisChanged();
         emitPropertyChanged();
     }
@@ -42,20 +43,20 @@ void MirrorNode::setCustomAngle(qreal angle)
     while (angle > 180.0) angle -= 360.0;
     while (angle < -180.0) angle += 360.0;
 
-    if (!qFuzzyCompare(_customAngle, angle))
+    if (!qFuzzyCompare(_params.customAngle, angle))
     {
-        _customAngle = angle;
+        _params.customAngle = angle;
         emit customAngleChanged();
         emitPropertyChanged();
     }
 }
 
-QPointF MirrorNode::mirror(qreal x, qreal y) const
+QPointF MirrorNode::Params::mirror(qreal x, qreal y) const
 {
     // Coordinate system is centered at (0, 0)
     qreal mirroredX, mirroredY;
 
-    switch (_axis)
+    switch (axis)
     {
     case Axis::Horizontal:
         // Mirror across vertical axis (flip X)
@@ -85,7 +86,7 @@ QPointF MirrorNode::mirror(qreal x, qreal y) const
         {
             // Mirror across line at custom angle through origin
             // Reflection matrix: [cos(2t), sin(2t); sin(2t), -cos(2t)]
-            qreal theta = qDegreesToRadians(_customAngle);
+            qreal theta = qDegreesToRadians(customAngle);
             qreal cos2t = qCos(2.0 * theta);
             qreal sin2t = qSin(2.0 * theta);
 
@@ -106,8 +107,8 @@ QPointF MirrorNode::mirror(qreal x, qreal y) const
 QJsonObject MirrorNode::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["axis"] = static_cast<int>(_axis);
-    obj["customAngle"] = _customAngle;
+    obj["axis"] = static_cast<int>(_params.axis);
+    obj["customAngle"] = _params.customAngle;
     return obj;
 }
 
@@ -123,14 +124,23 @@ void MirrorNode::propertiesFromJson(const QJsonObject& json)
     }
 }
 
+using MirrorParams = MirrorNode::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<MirrorParams> AUTOMATION_BINDINGS[] = {
+    {"Angle", {&MirrorParams::customAngle}},
+};
+
+MirrorNode::Params MirrorNode::paramsAt(int timeMs) const
+{
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
+
 void MirrorNode::syncToAnimatedValues(int timeMs)
 {
-    // Only sync if automation is active
-    auto* angleTrack = automationTrack(QStringLiteral("Angle"));
-    if (angleTrack && angleTrack->isAutomated())
-    {
-        _customAngle = angleTrack->timedValue(timeMs, 0);
-    }
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
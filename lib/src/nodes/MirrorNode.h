@@ -25,21 +25,32 @@ public:
     };
     Q_ENUM(Axis)
 
+    // Mirror axis at one evaluation time
+    struct Params
+    {
+        Axis axis{Axis::Horizontal};
+        qreal customAngle{0.0};  // In degrees, used when axis == Custom
+
+        // Compute mirrored position
+        // Returns the mirrored (x, y) coordinates
+        QPointF mirror(qreal x, qreal y) const;
+    };
+
     explicit MirrorNode(QObject* parent = nullptr);
     ~MirrorNode() override = default;
 
     QString type() const override { return QStringLiteral("Mirror"); }
     Category category() const override { return Category::Utility; }
+    Kind kind() const override { return Kind::Mirror; }
 
-    Axis axis() const { return _axis; }
+    Axis axis() const { return _params.axis; }
     void setAxis(Axis a);
 
-    qreal customAngle() const { return _customAngle; }
+    qreal customAngle() const { return _params.customAngle; }
     void setCustomAngle(qreal angle);
 
-    // Compute mirrored position
-    // Returns the mirrored (x, y) coordinates
-    Q_INVOKABLE QPointF mirror(qreal x, qreal y) const;
+    // Evaluate with the current parameters (see Params)
+    Q_INVOKABLE QPointF mirror(qreal x, qreal y) const { return _params.mirror(x, y); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
@@ -47,14 +58,17 @@ public:
 
     // Automation
     void syncToAnimatedValues(int timeMs) override;
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
 
 signals:
     void axisChanged();
     void customAngleChanged();
 
 private:
-    Axis _axis{Axis::Horizontal};
-    qreal _customAngle{0.0};  // In degrees, used when axis == Custom
+    Params _params;
 };
 
 } // namespace gizmotweak2
@@ -21,6 +21,7 @@ public:
 
     QString type() const override { return QStringLiteral("Output"); }
     Category category() const override { return Category::IO; }
+    Kind kind() const override { return Kind::Output; }
 
     // Zone selection
     int zoneIndex() const { return _zoneIndex; }
@@ -1,4 +1,5 @@
 #include "PolarTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -21,18 +22,18 @@ PolarTweak::PolarTweak(QObject* parent)
 
     // Automation: Expansion track with expansion (0), ringRadius (1) - matches GizmoTweak v1
     auto* expansionTrack = createAutomationTrack(QStringLiteral("Expansion"), 2, QColor(255, 127, 80));
-    expansionTrack->setupParameter(0, -2.0, 2.0, _expansion, tr("Expansion"), 100.0, QStringLiteral("%"));
-    expansionTrack->setupParameter(1, 0.01, 2.0, _ringRadius, tr("Radius"), 100.0, QStringLiteral("%"));
+    expansionTrack->setupParameter(0, -2.0, 2.0, _params.expansion, tr("Expansion"), 100.0, QStringLiteral("%"));
+    expansionTrack->setupParameter(1, 0.01, 2.0, _params.ringRadius, tr("Radius"), 100.0, QStringLiteral("%"));
 
     auto* ringScaleTrack = createAutomationTrack(QStringLiteral("RingScale"), 1, QColor(138, 43, 226));
-    ringScaleTrack->setupParameter(0, -1.0, 1.0, _ringScale, tr("Ring Scale"), 100.0, QStringLiteral("%"));
+    ringScaleTrack->setupParameter(0, -1.0, 1.0, _params.ringScale, tr("Ring Scale"), 100.0, QStringLiteral("%"));
 }
 
 void PolarTweak::setExpansion(qreal e)
 {
-    if (!qFuzzyCompare(_expansion, e))
+    if (!qFuzzyCompare(_params.expansion, e))
     {
-        _expansion = e;
+        _params.expansion = e;
         auto* track = automationTrack(QStringLiteral("Expansion"));
         if (track) track->setInitialValue(0, e);
         emit expansionChanged();
@@ -43,9 +44,9 @@ void PolarTweak::setExpansion(qreal e)
 void PolarTweak::setRingRadius(qreal r)
 {
     r = qMax(0.0, r);
-    if (!qFuzzyCompare(_ringRadius, r))
+    if (!qFuzzyCompare(_params.ringRadius, r))
     {
-        _ringRadius = r;
+        _params.ringRadius = r;
         auto* track = automationTrack(QStringLiteral("Expansion"));
         if (track) track->setInitialValue(1, r);
         emit ringRadiusChanged();
@@ -55,9 +56,9 @@ void PolarTweak::setRingRadius(qreal r)
 
 void PolarTweak::setRingScale(qreal s)
 {
-    if (!qFuzzyCompare(_ringScale, s))
+    if (!qFuzzyCompare(_params.ringScale, s))
     {
-        _ringScale = s;
+        _params.ringScale = s;
         auto* track = automationTrack(QStringLiteral("RingScale"));
         if (track) track->setInitialValue(0, s);
         emit ringScaleChanged();
@@ -67,9 +68,9 @@ void PolarTweak::setRingScale(qreal s)
 
 void PolarTweak::setCenterX(qreal cx)
 {
-    if (!qFuzzyCompare(_centerX, cx))
+    if (!qFuzzyCompare(_params.centerX, cx))
     {
-        _centerX = cx;
+        _params.centerX = cx;
         emit centerXChanged();
         emitPropertyChanged();
     }
@@ -77,9 +78,9 @@ void PolarTweak::setCenterX(qreal cx)
 
 void PolarTweak::setCenterY(qreal cy)
 {
-    if (!qFuzzyCompare(_centerY, cy))
+    if (!qFuzzyCompare(_params.centerY, cy))
     {
-        _centerY = cy;
+        _params.centerY = cy;
         emit centerYChanged();
         emitPropertyChanged();
     }
@@ -87,9 +88,9 @@ void PolarTweak::setCenterY(qreal cy)
 
 void PolarTweak::setCrossOver(bool co)
 {
-    if (_crossOver != co)
+    if (_params.crossOver != co)
     {
-        _crossOver = co;
+        _params.crossOver = co;
         emit crossOverChanged();
         emitPropertyChanged();
     }
@@ -97,9 +98,9 @@ void PolarTweak::setCrossOver(bool co)
 
 void PolarTweak::setTargetted(bool t)
 {
-    if (_targetted != t)
+    if (_params.targetted != t)
     {
-        _targetted = t;
+        _params.targetted = t;
         emit targettedChanged();
         emitPropertyChanged();
     }
@@ -127,12 +128,12 @@ void PolarTweak::setFollowGizmo(bool follow)
     }
 }
 
-QPointF PolarTweak::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
-                          qreal gizmoX, qreal gizmoY) const
+QPointF PolarTweak::Params::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
+                                  qreal gizmoX, qreal gizmoY) const
 {
     // Determine which ratio to use
     qreal rX, rY;
-    if (_crossOver)
+    if (crossOver)
     {
         rX = ratioY;
         rY = ratioX;
@@ -147,8 +148,8 @@ QPointF PolarTweak::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
     qreal ratio = (rX + rY) / 2.0;
 
     // Center = own automatable center + position cable offset (additive)
-    qreal cx = _centerX + gizmoX;
-    qreal cy = _centerY + gizmoY;
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
 
     // Convert to polar coordinates relative to center
     qreal dx = x - cx;
@@ -163,10 +164,10 @@ QPointF PolarTweak::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
 
     // Apply expansion effect
     qreal newDistance = distance;
-    if (!qFuzzyIsNull(_expansion))
+    if (!qFuzzyIsNull(expansion))
     {
-        qreal expansionAmount = _expansion * ratio;
-        if (_targetted)
+        qreal expansionAmount = expansion * ratio;
+        if (targetted)
         {
             newDistance = distance * (1.0 - expansionAmount);
         }
@@ -177,10 +178,10 @@ QPointF PolarTweak::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
     }
 
     // Apply ring effect
-    if (!qFuzzyIsNull(_ringScale) && _ringRadius > 0.0)
+    if (!qFuzzyIsNull(ringScale) && ringRadius > 0.0)
     {
-        qreal ringPhase = (distance / _ringRadius) * 2.0 * M_PI;
-        qreal ringOffset = qSin(ringPhase) * _ringScale * ratio;
+        qreal ringPhase = (distance / ringRadius) * 2.0 * M_PI;
+        qreal ringOffset = qSin(ringPhase) * ringScale * ratio;
         newDistance += ringOffset;
     }
 
@@ -193,16 +194,64 @@ QPointF PolarTweak::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
     return QPointF(resultX, resultY);
 }
 
+void PolarTweak::Params::applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                                    qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const
+{
+    // Same ratio on both components: (r + r) / 2 == r, crossOver is irrelevant
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
+    bool hasExpansion = !qFuzzyIsNull(expansion);
+    bool hasRing = !qFuzzyIsNull(ringScale) && ringRadius > 0.0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal x = xs[i];
+        qreal y = ys[i];
+        qreal ratio = ratios ? ratios[i] : 1.0;
+
+        qreal dx = x - cx;
+        qreal dy = y - cy;
+        qreal distance = qSqrt(dx * dx + dy * dy);
+
+        if (distance < 0.0001)
+        {
+            outXs[i] = x;
+            outYs[i] = y;
+            continue;
+        }
+
+        qreal angle = qAtan2(dy, dx);
+        qreal newDistance = distance;
+        if (hasExpansion)
+        {
+            qreal expansionAmount = expansion * ratio;
+            newDistance = targetted ? distance * (1.0 - expansionAmount)
+                                     : distance * (1.0 + expansionAmount);
+        }
+
+        if (hasRing)
+        {
+            qreal ringPhase = (distance / ringRadius) * 2.0 * M_PI;
+            newDistance += qSin(ringPhase) * ringScale * ratio;
+        }
+
+        newDistance = qMax(0.0, newDistance);
+
+        outXs[i] = cx + newDistance * qCos(angle);
+        outYs[i] = cy + newDistance * qSin(angle);
+    }
+}
+
 QJsonObject PolarTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["expansion"] = _expansion;
-    obj["ringRadius"] = _ringRadius;
-    obj["ringScale"] = _ringScale;
-    obj["centerX"] = _centerX;
-    obj["centerY"] = _centerY;
-    obj["crossOver"] = _crossOver;
-    obj["targetted"] = _targetted;
+    obj["expansion"] = _params.expansion;
+    obj["ringRadius"] = _params.ringRadius;
+    obj["ringScale"] = _params.ringScale;
+    obj["centerX"] = _params.centerX;
+    obj["centerY"] = _params.centerY;
+    obj["crossOver"] = _params.crossOver;
+    obj["targetted"] = _params.targetted;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -219,22 +268,25 @@ void PolarTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
-void PolarTweak::syncToAnimatedValues(int timeMs)
+using PolarParams = PolarTweak::Params;
+
+// Automation tracks -> Params members
+// Matches GizmoTweak v1: Expansion track (expansion, radius) + RingScale track (scale)
+static constexpr AutomationBinding<PolarParams> AUTOMATION_BINDINGS[] = {
+    {"Expansion", {&PolarParams::expansion, &PolarParams::ringRadius}},
+    {"RingScale", {&PolarParams::ringScale}},
+};
+
+PolarTweak::Params PolarTweak::paramsAt(int timeMs) const
 {
-    // Only sync if automation is active for each track
-    // Matches GizmoTweak v1: Expansion track (expansion, radius) + RingScale track (scale)
-    auto* expansionTrack = automationTrack(QStringLiteral("Expansion"));
-    if (expansionTrack && expansionTrack->isAutomated())
-    {
-        _expansion = expansionTrack->timedValue(timeMs, 0);
-        _ringRadius = expansionTrack->timedValue(timeMs, 1);
-    }
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* ringScaleTrack = automationTrack(QStringLiteral("RingScale"));
-    if (ringScaleTrack && ringScaleTrack->isAutomated())
-    {
-        _ringScale = ringScaleTrack->timedValue(timeMs, 0);
-    }
+void PolarTweak::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
@@ -21,45 +21,69 @@ class PolarTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Polar parameters at one evaluation time (plain data)
+    struct Params
+    {
+        qreal expansion{0.0};
+        qreal ringRadius{0.5};
+        qreal ringScale{0.0};
+        qreal centerX{0.0};
+        qreal centerY{0.0};
+        bool crossOver{false};
+        bool targetted{false};
+
+        // Apply tweak to a point
+        QPointF apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
+                      qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+
+        // Polar distortion of count points with a shared center (nullptr ratios = 1.0)
+        void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                        qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const;
+    };
+
     explicit PolarTweak(QObject* parent = nullptr);
     ~PolarTweak() override = default;
 
     QString type() const override { return QStringLiteral("PolarTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::PolarTweak; }
 
     // Expansion - radial scaling (positive = expand, negative = contract)
-    qreal expansion() const { return _expansion; }
+    qreal expansion() const { return _params.expansion; }
     void setExpansion(qreal e);
 
     // Ring effect - creates concentric ring distortion
-    qreal ringRadius() const { return _ringRadius; }
+    qreal ringRadius() const { return _params.ringRadius; }
     void setRingRadius(qreal r);
 
-    qreal ringScale() const { return _ringScale; }
+    qreal ringScale() const { return _params.ringScale; }
     void setRingScale(qreal s);
 
     // Center of polar transformation
-    qreal centerX() const { return _centerX; }
+    qreal centerX() const { return _params.centerX; }
     void setCenterX(qreal cx);
 
-    qreal centerY() const { return _centerY; }
+    qreal centerY() const { return _params.centerY; }
     void setCenterY(qreal cy);
 
     // CrossOver - X uses Y ratio component and vice versa
-    bool crossOver() const { return _crossOver; }
+    bool crossOver() const { return _params.crossOver; }
     void setCrossOver(bool co);
 
     // Targetted - expansion moves towards center rather than outward
-    bool targetted() const { return _targetted; }
+    bool targetted() const { return _params.targetted; }
     void setTargetted(bool t);
 
     // Follow Gizmo - use connected Gizmo center
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Apply tweak to a point
+    // Evaluate with the current parameters (see Params)
     Q_INVOKABLE QPointF apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
-                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const { return _params.apply(x, y, ratioX, ratioY, gizmoX, gizmoY); }
+
+    void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                    qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const { _params.applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, outXs, outYs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
@@ -67,6 +91,10 @@ public:
 
     // Automation
     void syncToAnimatedValues(int timeMs) override;
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
 
 signals:
     void expansionChanged();
@@ -79,13 +107,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    qreal _expansion{0.0};
-    qreal _ringRadius{0.5};
-    qreal _ringScale{0.0};
-    qreal _centerX{0.0};
-    qreal _centerY{0.0};
-    bool _crossOver{false};
-    bool _targetted{false};
+    Params _params;
     bool _followGizmo{true};
 };
 
@@ -1,4 +1,5 @@
 #include "PositionTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -20,15 +21,15 @@ PositionTweak::PositionTweak(QObject* parent)
 
     // Automation: Position track with offsetX (0) and offsetY (1)
     auto* track = createAutomationTrack(QStringLiteral("Position"), 2, QColor(70, 130, 180));
-    track->setupParameter(0, -2.0, 2.0, _offsetX, tr("X"), 100.0, QStringLiteral("%"));
-    track->setupParameter(1, -2.0, 2.0, _offsetY, tr("Y"), 100.0, QStringLiteral("%"));
+    track->setupParameter(0, -2.0, 2.0, _params.offsetX, tr("X"), 100.0, QStringLiteral("%"));
+    track->setupParameter(1, -2.0, 2.0, _params.offsetY, tr("Y"), 100.0, QStringLiteral("%"));
 }
 
 void PositionTweak::setOffsetX(qreal x)
 {
-    if (!qFuzzyCompare(_offsetX, x))
+    if (!qFuzzyCompare(_params.offsetX, x))
     {
-        _offsetX = x;
+        _params.offsetX = x;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Position"));
         if (track) track->setInitialValue(0, x);
@@ -39,9 +40,9 @@ void PositionTweak::setOffsetX(qreal x)
 
 void PositionTweak::setOffsetY(qreal y)
 {
-    if (!qFuzzyCompare(_offsetY, y))
+    if (!qFuzzyCompare(_params.offsetY, y))
     {
-        _offsetY = y;
+        _params.offsetY = y;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Position"));
         if (track) track->setInitialValue(1, y);
@@ -72,16 +73,36 @@ void PositionTweak::setFollowGizmo(bool follow)
     }
 }
 
-QPointF PositionTweak::apply(qreal x, qreal y, qreal ratio) const
+QPointF PositionTweak::Params::apply(qreal x, qreal y, qreal ratio) const
 {
-    return QPointF(x + _offsetX * ratio, y + _offsetY * ratio);
+    return QPointF(x + offsetX * ratio, y + offsetY * ratio);
+}
+
+void PositionTweak::Params::applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                                       qreal* outXs, qreal* outYs) const
+{
+    if (!ratios)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            outXs[i] = xs[i] + offsetX;
+            outYs[i] = ys[i] + offsetY;
+        }
+        return;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        outXs[i] = xs[i] + offsetX * ratios[i];
+        outYs[i] = ys[i] + offsetY * ratios[i];
+    }
 }
 
 QJsonObject PositionTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["offsetX"] = _offsetX;
-    obj["offsetY"] = _offsetY;
+    obj["offsetX"] = _params.offsetX;
+    obj["offsetY"] = _params.offsetY;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -93,15 +114,23 @@ void PositionTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
+using PositionParams = PositionTweak::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<PositionParams> AUTOMATION_BINDINGS[] = {
+    {"Position", {&PositionParams::offsetX, &PositionParams::offsetY}},
+};
+
+PositionTweak::Params PositionTweak::paramsAt(int timeMs) const
+{
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
+
 void PositionTweak::syncToAnimatedValues(int timeMs)
 {
-    // Only sync if automation is active
-    auto* track = automationTrack(QStringLiteral("Position"));
-    if (track && track->isAutomated())
-    {
-        _offsetX = track->timedValue(timeMs, 0);
-        _offsetY = track->timedValue(timeMs, 1);
-    }
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
@@ -16,28 +16,50 @@ class PositionTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Offset parameters, resolved per evaluation time by paramsAt()
+    struct Params
+    {
+        qreal offsetX{0.0};
+        qreal offsetY{0.0};
+
+        // Apply tweak to a point
+        QPointF apply(qreal x, qreal y, qreal ratio) const;
+
+        // Offset count points in one pass (nullptr ratios = full offset, outputs may alias inputs)
+        void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                        qreal* outXs, qreal* outYs) const;
+    };
+
     explicit PositionTweak(QObject* parent = nullptr);
     ~PositionTweak() override = default;
 
     QString type() const override { return QStringLiteral("PositionTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::PositionTweak; }
 
-    qreal offsetX() const { return _offsetX; }
+    qreal offsetX() const { return _params.offsetX; }
     void setOffsetX(qreal x);
 
-    qreal offsetY() const { return _offsetY; }
+    qreal offsetY() const { return _params.offsetY; }
     void setOffsetY(qreal y);
 
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Apply tweak to a point
-    Q_INVOKABLE QPointF apply(qreal x, qreal y, qreal ratio) const;
+    // Evaluate with the current parameters (see Params)
+    Q_INVOKABLE QPointF apply(qreal x, qreal y, qreal ratio) const { return _params.apply(x, y, ratio); }
+
+    void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                    qreal* outXs, qreal* outYs) const { _params.applyBatch(xs, ys, ratios, count, outXs, outYs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
     void propertiesFromJson(const QJsonObject& json) override;
 
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
     // Automation sync
     void syncToAnimatedValues(int timeMs) override;
 
@@ -47,8 +69,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    qreal _offsetX{0.0};
-    qreal _offsetY{0.0};
+    Params _params;
     bool _followGizmo{true};
 };
 
@@ -1,4 +1,5 @@
 #include "RotationTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -21,18 +22,18 @@ RotationTweak::RotationTweak(QObject* parent)
 
     // Automation: Rotation track with angle (0)
     auto* rotationTrack = createAutomationTrack(QStringLiteral("Rotation"), 1, QColor(255, 140, 0));
-    rotationTrack->setupParameter(0, -360.0, 360.0, _angle, tr("Angle"), 1.0, QStringLiteral("\u00B0"));
+    rotationTrack->setupParameter(0, -360.0, 360.0, _params.angle, tr("Angle"), 1.0, QStringLiteral("\u00B0"));
 
     auto* centerTrack = createAutomationTrack(QStringLiteral("Center"), 2, QColor(186, 85, 211));
-    centerTrack->setupParameter(0, -1.0, 1.0, _centerX, tr("Center X"), 100.0, QStringLiteral("%"));
-    centerTrack->setupParameter(1, -1.0, 1.0, _centerY, tr("Center Y"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(0, -1.0, 1.0, _params.centerX, tr("Center X"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(1, -1.0, 1.0, _params.centerY, tr("Center Y"), 100.0, QStringLiteral("%"));
 }
 
 void RotationTweak::setAngle(qreal a)
 {
-    if (!qFuzzyCompare(_angle, a))
+    if (!qFuzzyCompare(_params.angle, a))
     {
-        _angle = a;
+        _params.angle = a;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Rotation"));
         if (track) track->setInitialValue(0, a);
@@ -43,9 +44,9 @@ void RotationTweak::setAngle(qreal a)
 
 void RotationTweak::setCenterX(qreal cx)
 {
-    if (!qFuzzyCompare(_centerX, cx))
+    if (!qFuzzyCompare(_params.centerX, cx))
     {
-        _centerX = cx;
+        _params.centerX = cx;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(0, cx);
@@ -56,9 +57,9 @@ void RotationTweak::setCenterX(qreal cx)
 
 void RotationTweak::setCenterY(qreal cy)
 {
-    if (!qFuzzyCompare(_centerY, cy))
+    if (!qFuzzyCompare(_params.centerY, cy))
     {
-        _centerY = cy;
+        _params.centerY = cy;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(1, cy);
@@ -89,16 +90,16 @@ void RotationTweak::setFollowGizmo(bool follow)
     }
 }
 
-QPointF RotationTweak::apply(qreal x, qreal y, qreal ratio,
-                             qreal gizmoX, qreal gizmoY) const
+QPointF RotationTweak::Params::apply(qreal x, qreal y, qreal ratio,
+                                     qreal gizmoX, qreal gizmoY) const
 {
     // Effective angle based on ratio
-    qreal effectiveAngle = _angle * ratio;
+    qreal effectiveAngle = angle * ratio;
     qreal radians = qDegreesToRadians(effectiveAngle);
 
     // Center = own automatable center + position cable offset (additive)
-    qreal cx = _centerX + gizmoX;
-    qreal cy = _centerY + gizmoY;
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
 
     // Translate to origin (center)
     qreal dx = x - cx;
@@ -115,12 +116,42 @@ QPointF RotationTweak::apply(qreal x, qreal y, qreal ratio,
     return QPointF(cx + rotatedX, cy + rotatedY);
 }
 
+void RotationTweak::Params::applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                                       qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const
+{
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
+
+    // sin/cos only change with the ratio: recompute on change, not per point
+    qreal lastRatio = 1.0;
+    qreal radians = qDegreesToRadians(angle * lastRatio);
+    qreal cosA = qCos(radians);
+    qreal sinA = qSin(radians);
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal r = ratios ? ratios[i] : 1.0;
+        if (r != lastRatio)
+        {
+            lastRatio = r;
+            radians = qDegreesToRadians(angle * r);
+            cosA = qCos(radians);
+            sinA = qSin(radians);
+        }
+
+        qreal dx = xs[i] - cx;
+        qreal dy = ys[i] - cy;
+        outXs[i] = cx + (dx * cosA - dy * sinA);
+        outYs[i] = cy + (dx * sinA + dy * cosA);
+    }
+}
+
 QJsonObject RotationTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["angle"] = _angle;
-    obj["centerX"] = _centerX;
-    obj["centerY"] = _centerY;
+    obj["angle"] = _params.angle;
+    obj["centerX"] = _params.centerX;
+    obj["centerY"] = _params.centerY;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -133,21 +164,24 @@ void RotationTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
-void RotationTweak::syncToAnimatedValues(int timeMs)
+using RotationParams = RotationTweak::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<RotationParams> AUTOMATION_BINDINGS[] = {
+    {"Rotation", {&RotationParams::angle}},
+    {"Center", {&RotationParams::centerX, &RotationParams::centerY}},
+};
+
+RotationTweak::Params RotationTweak::paramsAt(int timeMs) const
 {
-    // Only sync if automation is active for each track
-    auto* rotationTrack = automationTrack(QStringLiteral("Rotation"));
-    if (rotationTrack && rotationTrack->isAutomated())
-    {
-        _angle = rotationTrack->timedValue(timeMs, 0);
-    }
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* centerTrack = automationTrack(QStringLiteral("Center"));
-    if (centerTrack && centerTrack->isAutomated())
-    {
-        _centerX = centerTrack->timedValue(timeMs, 0);
-        _centerY = centerTrack->timedValue(timeMs, 1);
-    }
+void RotationTweak::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
@@ -17,35 +17,60 @@ class RotationTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Rotation parameters at one evaluation time
+    struct Params
+    {
+        qreal angle{0.0};
+        qreal centerX{0.0};
+        qreal centerY{0.0};
+
+        // Apply tweak to a point
+        QPointF apply(qreal x, qreal y, qreal ratio,
+                      qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+
+        // Rotate count points; sin/cos are only recomputed when the ratio changes
+        // (nullptr ratios = 1.0, outputs may alias inputs)
+        void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                        qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const;
+    };
+
     explicit RotationTweak(QObject* parent = nullptr);
     ~RotationTweak() override = default;
 
     QString type() const override { return QStringLiteral("RotationTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::RotationTweak; }
 
     // Rotation angle in degrees
-    qreal angle() const { return _angle; }
+    qreal angle() const { return _params.angle; }
     void setAngle(qreal a);
 
     // Center of rotation
-    qreal centerX() const { return _centerX; }
+    qreal centerX() const { return _params.centerX; }
     void setCenterX(qreal cx);
 
-    qreal centerY() const { return _centerY; }
+    qreal centerY() const { return _params.centerY; }
     void setCenterY(qreal cy);
 
     // Follow Gizmo - use connected Gizmo center as rotation center
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Apply tweak to a point
+    // Evaluate with the current parameters (see Params)
     Q_INVOKABLE QPointF apply(qreal x, qreal y, qreal ratio,
-                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const { return _params.apply(x, y, ratio, gizmoX, gizmoY); }
+
+    void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                    qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const { _params.applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, outXs, outYs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
     void propertiesFromJson(const QJsonObject& json) override;
 
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
     // Automation sync
     void syncToAnimatedValues(int timeMs) override;
 
@@ -56,9 +81,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    qreal _angle{0.0};
-    qreal _centerX{0.0};
-    qreal _centerY{0.0};
+    Params _params;
     bool _followGizmo{true};
 };
 
@@ -1,4 +1,5 @@
 #include "RounderTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -21,20 +22,20 @@ RounderTweak::RounderTweak(QObject* parent)
     // Automation: Rounder track with amount (0), verticalShift (1), horizontalShift (2),
     // tighten (3), radialResize (4), radialShift (5)
     auto* rounderTrack = createAutomationTrack(QStringLiteral("Rounder"), 6, QColor(64, 224, 208));  // Turquoise
-    rounderTrack->setupParameter(0, -2.0, 2.0, _amount, tr("Amount"), 100.0, QStringLiteral("%"));
-    rounderTrack->setupParameter(1, -2.0, 2.0, _verticalShift, tr("V Shift"), 100.0, QStringLiteral("%"));
-    rounderTrack->setupParameter(2, -2.0, 2.0, _horizontalShift, tr("H Shift"), 100.0, QStringLiteral("%"));
-    rounderTrack->setupParameter(3, 0.0, 1.0, _tighten, tr("Tighten"), 100.0, QStringLiteral("%"));
-    rounderTrack->setupParameter(4, 0.5, 2.0, _radialResize, tr("Radial Resize"), 100.0, QStringLiteral("%"));
-    rounderTrack->setupParameter(5, -2.0, 2.0, _radialShift, tr("Radial Shift"), 100.0, QStringLiteral("%"));
+    rounderTrack->setupParameter(0, -2.0, 2.0, _params.amount, tr("Amount"), 100.0, QStringLiteral("%"));
+    rounderTrack->setupParameter(1, -2.0, 2.0, _params.verticalShift, tr("V Shift"), 100.0, QStringLiteral("%"));
+    rounderTrack->setupParameter(2, -2.0, 2.0, _params.horizontalShift, tr("H Shift"), 100.0, QStringLiteral("%"));
+    rounderTrack->setupParameter(3, 0.0, 1.0, _params.tighten, tr("Tighten"), 100.0, QStringLiteral("%"));
+    rounderTrack->setupParameter(4, 0.5, 2.0, _params.radialResize, tr("Radial Resize"), 100.0, QStringLiteral("%"));
+    rounderTrack->setupParameter(5, -2.0, 2.0, _params.radialShift, tr("Radial Shift"), 100.0, QStringLiteral("%"));
 }
 
 void RounderTweak::setAmount(qreal value)
 {
     value = qBound(-2.0, value, 2.0);
-    if (!qFuzzyCompare(_amount, value))
+    if (!qFuzzyCompare(_params.amount, value))
     {
-        _amount = value;
+        _params.amount = value;
         auto* track = automationTrack(QStringLiteral("Rounder"));
         if (track) track->setInitialValue(0, value);
         emit amountChanged();
@@ -45,9 +46,9 @@ void RounderTweak::setAmount(qreal value)
 void RounderTweak::setVerticalShift(qreal value)
 {
     value = qBound(-2.0, value, 2.0);
-    if (!qFuzzyCompare(_verticalShift, value))
+    if (!qFuzzyCompare(_params.verticalShift, value))
     {
-        _verticalShift = value;
+        _params.verticalShift = value;
         auto* track = automationTrack(QStringLiteral("Rounder"));
         if (track) track->setInitialValue(1, value);
         emit verticalShiftChanged();
@@ -58,9 +59,9 @@ void RounderTweak::setVerticalShift(qreal value)
 void RounderTweak::setHorizontalShift(qreal value)
 {
     value = qBound(-2.0, value, 2.0);
-    if (!qFuzzyCompare(_horizontalShift, value))
+    if (!qFuzzyCompare(_params.horizontalShift, value))
     {
-        _horizontalShift = value;
+        _params.horizontalShift = value;
         auto* track = automationTrack(QStringLiteral("Rounder"));
         if (track) track->setInitialValue(2, value);
         emit horizontalShiftChanged();
@@ -71,9 +72,9 @@ void RounderTweak::setHorizontalShift(qreal value)
 void RounderTweak::setTighten(qreal value)
 {
     value = qBound(0.0, value, 1.0);
-    if (!qFuzzyCompare(_tighten, value))
+    if (!qFuzzyCompare(_params.tighten, value))
     {
-        _tighten = value;
+        _params.tighten = value;
         auto* track = automationTrack(QStringLiteral("Rounder"));
         if (track) track->setInitialValue(3, value);
         emit tightenChanged();
@@ -84,9 +85,9 @@ void RounderTweak::setTighten(qreal value)
 void RounderTweak::setRadialResize(qreal value)
 {
     value = qBound(0.5, value, 2.0);
-    if (!qFuzzyCompare(_radialResize, value))
+    if (!qFuzzyCompare(_params.radialResize, value))
     {
-        _radialResize = value;
+        _params.radialResize = value;
         auto* track = automationTrack(QStringLiteral("Rounder"));
         if (track) track->setInitialValue(4, value);
         emit radialResizeChanged();
@@ -97,9 +98,9 @@ void RounderTweak::setRadialResize(qreal value)
 void RounderTweak::setRadialShift(qreal value)
 {
     value = qBound(-2.0, value, 2.0);
-    if (!qFuzzyCompare(_radialShift, value))
+    if (!qFuzzyCompare(_params.radialShift, value))
     {
-        _radialShift = value;
+        _params.radialShift = value;
         auto* track = automationTrack(QStringLiteral("Rounder"));
         if (track) track->setInitialValue(5, value);
         emit radialShiftChanged();
@@ -126,20 +127,20 @@ void RounderTweak::setFollowGizmo(bool follow)
     }
 }
 
-QPointF RounderTweak::apply(qreal x, qreal y, qreal ratio) const
+QPointF RounderTweak::Params::apply(qreal x, qreal y, qreal ratio) const
 {
-    if (qFuzzyIsNull(ratio) || qFuzzyIsNull(_amount))
+    if (qFuzzyIsNull(ratio) || qFuzzyIsNull(amount))
     {
         return QPointF(x, y);
     }
 
     // Apply ratio to all parameters
-    qreal effectiveAmount = _amount * ratio;
-    qreal effectiveVShift = _verticalShift * ratio;
-    qreal effectiveHShift = _horizontalShift * ratio;
-    qreal effectiveTighten = _tighten;  // Tighten is already normalized 0-1
-    qreal effectiveRadialResize = 1.0 + (_radialResize - 1.0) * ratio;  // Interpolate from 1.0
-    qreal effectiveRadialShift = _radialShift * ratio;
+    qreal effectiveAmount = amount * ratio;
+    qreal effectiveVShift = verticalShift * ratio;
+    qreal effectiveHShift = horizontalShift * ratio;
+    qreal effectiveTighten = tighten;  // Tighten is already normalized 0-1
+    qreal effectiveRadialResize = 1.0 + (radialResize - 1.0) * ratio;  // Interpolate from 1.0
+    qreal effectiveRadialShift = radialShift * ratio;
 
     // Precalculate constants (matching original GizmoTweak algorithm)
     qreal absLimAmount = qMin(1.0, qAbs(effectiveAmount));
@@ -168,15 +169,65 @@ QPointF RounderTweak::apply(qreal x, qreal y, qreal ratio) const
     return QPointF(outX, outY);
 }
 
+void RounderTweak::Params::applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                                      qreal* outXs, qreal* outYs) const
+{
+    // Ratio-dependent constants, recomputed only when the ratio changes
+    qreal lastRatio = 0.0;
+    bool haveConstants = false;
+    qreal effectiveHShift = 0.0, effectiveVShift = 0.0, rounderAmountRad = 0.0;
+    qreal rounderRR = 0.0, rounderTT = 0.0, rounderYOffset = 0.0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal x = xs[i];
+        qreal y = ys[i];
+        qreal ratio = ratios ? ratios[i] : 1.0;
+
+        if (qFuzzyIsNull(ratio) || qFuzzyIsNull(amount))
+        {
+            outXs[i] = x;
+            outYs[i] = y;
+            continue;
+        }
+
+        if (!haveConstants || ratio != lastRatio)
+        {
+            haveConstants = true;
+            lastRatio = ratio;
+
+            qreal effectiveAmount = amount * ratio;
+            effectiveVShift = verticalShift * ratio;
+            effectiveHShift = horizontalShift * ratio;
+            qreal effectiveRadialResize = 1.0 + (radialResize - 1.0) * ratio;
+            qreal effectiveRadialShift = radialShift * ratio;
+
+            qreal absLimAmount = qMin(1.0, qAbs(effectiveAmount));
+            rounderAmountRad = effectiveAmount * M_PI;
+            rounderRR = qMin(1.0, qMax(0.5, 1.0 - qAbs(effectiveAmount)
+                                           + qAbs(effectiveAmount) * effectiveRadialResize));
+            rounderTT = tighten - 2.0 * tighten * absLimAmount + absLimAmount;
+            rounderYOffset = effectiveRadialShift * effectiveAmount;
+        }
+
+        qreal shiftedX = x - effectiveHShift;
+        qreal shiftedY = y - effectiveVShift + rounderYOffset;
+        qreal rounderAngle = shiftedX * -rounderAmountRad;
+
+        outXs[i] = effectiveHShift - qSin(rounderAngle) * shiftedY * rounderRR + shiftedX * rounderTT;
+        outYs[i] = effectiveVShift + qCos(rounderAngle) * shiftedY * rounderRR;
+    }
+}
+
 QJsonObject RounderTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["amount"] = _amount;
-    obj["verticalShift"] = _verticalShift;
-    obj["horizontalShift"] = _horizontalShift;
-    obj["tighten"] = _tighten;
-    obj["radialResize"] = _radialResize;
-    obj["radialShift"] = _radialShift;
+    obj["amount"] = _params.amount;
+    obj["verticalShift"] = _params.verticalShift;
+    obj["horizontalShift"] = _params.horizontalShift;
+    obj["tighten"] = _params.tighten;
+    obj["radialResize"] = _params.radialResize;
+    obj["radialShift"] = _params.radialShift;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -192,19 +243,24 @@ void RounderTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
+using RounderParams = RounderTweak::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<RounderParams> AUTOMATION_BINDINGS[] = {
+    {"Rounder", {&RounderParams::amount, &RounderParams::verticalShift, &RounderParams::horizontalShift,
+                 &RounderParams::tighten, &RounderParams::radialResize, &RounderParams::radialShift}},
+};
+
+RounderTweak::Params RounderTweak::paramsAt(int timeMs) const
+{
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
+
 void RounderTweak::syncToAnimatedValues(int timeMs)
 {
-    // Only sync if automation is active
-    auto* rounderTrack = automationTrack(QStringLiteral("Rounder"));
-    if (rounderTrack && rounderTrack->isAutomated())
-    {
-        _amount = rounderTrack->timedValue(timeMs, 0);
-        _verticalShift = rounderTrack->timedValue(timeMs, 1);
-        _horizontalShift = rounderTrack->timedValue(timeMs, 2);
-        _tighten = rounderTrack->timedValue(timeMs, 3);
-        _radialResize = rounderTrack->timedValue(timeMs, 4);
-        _radialShift = rounderTrack->timedValue(timeMs, 5);
-    }
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
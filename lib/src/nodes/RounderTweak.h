@@ -28,38 +28,61 @@ class RounderTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Rounder parameters at one evaluation time
+    struct Params
+    {
+        qreal amount{0.0};
+        qreal verticalShift{0.0};
+        qreal horizontalShift{0.0};
+        qreal tighten{0.0};
+        qreal radialResize{1.0};
+        qreal radialShift{0.0};
+
+        // Apply the rounder effect to a coordinate
+        // ratio modulates all parameters (0 = no effect, 1 = full effect)
+        QPointF apply(qreal x, qreal y, qreal ratio) const;
+
+        // Rounder over count points; derived constants follow the ratio, not the point
+        // (nullptr ratios = 1.0, outputs may alias inputs)
+        void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                        qreal* outXs, qreal* outYs) const;
+    };
+
     explicit RounderTweak(QObject* parent = nullptr);
     ~RounderTweak() override = default;
 
     QString type() const override { return QStringLiteral("RounderTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::RounderTweak; }
 
     // Properties
-    qreal amount() const { return _amount; }
+    qreal amount() const { return _params.amount; }
     void setAmount(qreal value);
 
-    qreal verticalShift() const { return _verticalShift; }
+    qreal verticalShift() const { return _params.verticalShift; }
     void setVerticalShift(qreal value);
 
-    qreal horizontalShift() const { return _horizontalShift; }
+    qreal horizontalShift() const { return _params.horizontalShift; }
     void setHorizontalShift(qreal value);
 
-    qreal tighten() const { return _tighten; }
+    qreal tighten() const { return _params.tighten; }
     void setTighten(qreal value);
 
-    qreal radialResize() const { return _radialResize; }
+    qreal radialResize() const { return _params.radialResize; }
     void setRadialResize(qreal value);
 
-    qreal radialShift() const { return _radialShift; }
+    qreal radialShift() const { return _params.radialShift; }
     void setRadialShift(qreal value);
 
     // Follow gizmo - use gizmo's ratio when true, full effect when false
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Apply the rounder effect to a coordinate
-    // ratio modulates all parameters (0 = no effect, 1 = full effect)
-    Q_INVOKABLE QPointF apply(qreal x, qreal y, qreal ratio) const;
+    // Evaluate with the current parameters (see Params)
+    Q_INVOKABLE QPointF apply(qreal x, qreal y, qreal ratio) const { return _params.apply(x, y, ratio); }
+
+    void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                    qreal* outXs, qreal* outYs) const { _params.applyBatch(xs, ys, ratios, count, outXs, outYs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
@@ -67,6 +90,10 @@ public:
 
     // Automation
     void syncToAnimatedValues(int timeMs) override;
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
 
 signals:
     void amountChanged();
@@ -78,12 +105,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    qreal _amount{0.0};
-    qreal _verticalShift{0.0};
-    qreal _horizontalShift{0.0};
-    qreal _tighten{0.0};
-    qreal _radialResize{1.0};
-    qreal _radialShift{0.0};
+    Params _params;
     bool _followGizmo{true};
 };
 
@@ -1,4 +1,5 @@
 #include "ScaleTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 namespace gizmotweak2
@@ -19,27 +20,27 @@ ScaleTweak::ScaleTweak(QObject* parent)
 
     // Automation: Scale track with scaleX (0) and scaleY (1)
     auto* scaleTrack = createAutomationTrack(QStringLiteral("Scale"), 2, QColor(60, 179, 113));
-    scaleTrack->setupParameter(0, 0.01, 5.0, _scaleX, tr("Scale X"), 100.0, QStringLiteral("%"));
-    scaleTrack->setupParameter(1, 0.01, 5.0, _scaleY, tr("Scale Y"), 100.0, QStringLiteral("%"));
+    scaleTrack->setupParameter(0, 0.01, 5.0, _params.scaleX, tr("Scale X"), 100.0, QStringLiteral("%"));
+    scaleTrack->setupParameter(1, 0.01, 5.0, _params.scaleY, tr("Scale Y"), 100.0, QStringLiteral("%"));
 
     auto* centerTrack = createAutomationTrack(QStringLiteral("Center"), 2, QColor(186, 85, 211));
-    centerTrack->setupParameter(0, -1.0, 1.0, _centerX, tr("Center X"), 100.0, QStringLiteral("%"));
-    centerTrack->setupParameter(1, -1.0, 1.0, _centerY, tr("Center Y"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(0, -1.0, 1.0, _params.centerX, tr("Center X"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(1, -1.0, 1.0, _params.centerY, tr("Center Y"), 100.0, QStringLiteral("%"));
 }
 
 void ScaleTweak::setScaleX(qreal sx)
 {
-    if (!qFuzzyCompare(_scaleX, sx))
+    if (!qFuzzyCompare(_params.scaleX, sx))
     {
-        _scaleX = sx;
+        _params.scaleX = sx;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Scale"));
         if (track) track->setInitialValue(0, sx);
         emit scaleXChanged();
 
-        if (_uniform)
+        if (_params.uniform)
         {
-            _scaleY = sx;
+            _params.scaleY = sx;
             if (track) track->setInitialValue(1, sx);
             emit scaleYChanged();
         }
@@ -49,17 +50,17 @@ void ScaleTweak::setScaleX(qreal sx)
 
 void ScaleTweak::setScaleY(qreal sy)
 {
-    if (!qFuzzyCompare(_scaleY, sy))
+    if (!qFuzzyCompare(_params.scaleY, sy))
     {
-        _scaleY = sy;
+        _params.scaleY = sy;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Scale"));
         if (track) track->setInitialValue(1, sy);
         emit scaleYChanged();
 
-        if (_uniform)
+        if (_params.uniform)
         {
-            _scaleX = sy;
+            _params.scaleX = sy;
             if (track) track->setInitialValue(0, sy);
             emit scaleXChanged();
         }
@@ -69,14 +70,14 @@ void ScaleTweak::setScaleY(qreal sy)
 
 void ScaleTweak::setUniform(bool u)
 {
-    if (_uniform != u)
+    if (_params.uniform != u)
     {
-        _uniform = u;
+        _params.uniform = u;
         emit uniformChanged();
 
-        if (_uniform)
+        if (_params.uniform)
         {
-            _scaleY = _scaleX;
+            _params.scaleY = _params.scaleX;
             emit scaleYChanged();
         }
         emitPropertyChanged();
@@ -85,9 +86,9 @@ void ScaleTweak::setUniform(bool u)
 
 void ScaleTweak::setCenterX(qreal cx)
 {
-    if (!qFuzzyCompare(_centerX, cx))
+    if (!qFuzzyCompare(_params.centerX, cx))
     {
-        _centerX = cx;
+        _params.centerX = cx;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(0, cx);
@@ -98,9 +99,9 @@ void ScaleTweak::setCenterX(qreal cx)
 
 void ScaleTweak::setCenterY(qreal cy)
 {
-    if (!qFuzzyCompare(_centerY, cy))
+    if (!qFuzzyCompare(_params.centerY, cy))
     {
-        _centerY = cy;
+        _params.centerY = cy;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(1, cy);
@@ -111,9 +112,9 @@ void ScaleTweak::setCenterY(qreal cy)
 
 void ScaleTweak::setCrossOver(bool co)
 {
-    if (_crossOver != co)
+    if (_params.crossOver != co)
     {
-        _crossOver = co;
+        _params.crossOver = co;
         emit crossOverChanged();
         emitPropertyChanged();
     }
@@ -141,12 +142,12 @@ void ScaleTweak::setFollowGizmo(bool follow)
     }
 }
 
-QPointF ScaleTweak::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
-                          qreal gizmoX, qreal gizmoY) const
+QPointF ScaleTweak::Params::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
+                                  qreal gizmoX, qreal gizmoY) const
 {
     // Determine which ratio to use for each axis
     qreal rX, rY;
-    if (_crossOver)
+    if (crossOver)
     {
         rX = ratioY;
         rY = ratioX;
@@ -158,12 +159,12 @@ QPointF ScaleTweak::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
     }
 
     // Interpolate scale factor based on ratio
-    qreal effectiveScaleX = 1.0 + (_scaleX - 1.0) * rX;
-    qreal effectiveScaleY = 1.0 + (_scaleY - 1.0) * rY;
+    qreal effectiveScaleX = 1.0 + (scaleX - 1.0) * rX;
+    qreal effectiveScaleY = 1.0 + (scaleY - 1.0) * rY;
 
     // Center = own automatable center + position cable offset (additive)
-    qreal cx = _centerX + gizmoX;
-    qreal cy = _centerY + gizmoY;
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
 
     // Scale around center point
     qreal dx = x - cx;
@@ -175,15 +176,34 @@ QPointF ScaleTweak::apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
     return QPointF(resultX, resultY);
 }
 
+void ScaleTweak::Params::applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                                    qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const
+{
+    // Batch path uses the same ratio on both axes, so crossOver has no effect here
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
+    qreal deltaX = scaleX - 1.0;
+    qreal deltaY = scaleY - 1.0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal r = ratios ? ratios[i] : 1.0;
+        qreal dx = xs[i] - cx;
+        qreal dy = ys[i] - cy;
+        outXs[i] = cx + dx * (1.0 + deltaX * r);
+        outYs[i] = cy + dy * (1.0 + deltaY * r);
+    }
+}
+
 QJsonObject ScaleTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["scaleX"] = _scaleX;
-    obj["scaleY"] = _scaleY;
-    obj["uniform"] = _uniform;
-    obj["centerX"] = _centerX;
-    obj["centerY"] = _centerY;
-    obj["crossOver"] = _crossOver;
+    obj["scaleX"] = _params.scaleX;
+    obj["scaleY"] = _params.scaleY;
+    obj["uniform"] = _params.uniform;
+    obj["centerX"] = _params.centerX;
+    obj["centerY"] = _params.centerY;
+    obj["crossOver"] = _params.crossOver;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -200,22 +220,24 @@ void ScaleTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
-void ScaleTweak::syncToAnimatedValues(int timeMs)
+using ScaleParams = ScaleTweak::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<ScaleParams> AUTOMATION_BINDINGS[] = {
+    {"Scale", {&ScaleParams::scaleX, &ScaleParams::scaleY}},
+    {"Center", {&ScaleParams::centerX, &ScaleParams::centerY}},
+};
+
+ScaleTweak::Params ScaleTweak::paramsAt(int timeMs) const
 {
-    // Only sync if automation is active for each track
-    auto* scaleTrack = automationTrack(QStringLiteral("Scale"));
-    if (scaleTrack && scaleTrack->isAutomated())
-    {
-        _scaleX = scaleTrack->timedValue(timeMs, 0);
-        _scaleY = scaleTrack->timedValue(timeMs, 1);
-    }
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* centerTrack = automationTrack(QStringLiteral("Center"));
-    if (centerTrack && centerTrack->isAutomated())
-    {
-        _centerX = centerTrack->timedValue(timeMs, 0);
-        _centerY = centerTrack->timedValue(timeMs, 1);
-    }
+void ScaleTweak::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
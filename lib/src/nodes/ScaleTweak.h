@@ -20,46 +20,73 @@ class ScaleTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Scale parameters as plain data, safe to copy to a worker thread
+    struct Params
+    {
+        qreal scaleX{1.0};
+        qreal scaleY{1.0};
+        bool uniform{true};
+        qreal centerX{0.0};
+        qreal centerY{0.0};
+        bool crossOver{false};
+
+        // Apply tweak to a point
+        // ratioX and ratioY are 2D ratio components (for crossover)
+        QPointF apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
+                      qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+
+        // Scale count points around the same center (nullptr ratios = 1.0, outputs may alias inputs)
+        void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                        qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const;
+    };
+
     explicit ScaleTweak(QObject* parent = nullptr);
     ~ScaleTweak() override = default;
 
     QString type() const override { return QStringLiteral("ScaleTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::ScaleTweak; }
 
     // Scale properties
-    qreal scaleX() const { return _scaleX; }
+    qreal scaleX() const { return _params.scaleX; }
     void setScaleX(qreal sx);
 
-    qreal scaleY() const { return _scaleY; }
+    qreal scaleY() const { return _params.scaleY; }
     void setScaleY(qreal sy);
 
-    bool uniform() const { return _uniform; }
+    bool uniform() const { return _params.uniform; }
     void setUniform(bool u);
 
     // Center of scaling
-    qreal centerX() const { return _centerX; }
+    qreal centerX() const { return _params.centerX; }
     void setCenterX(qreal cx);
 
-    qreal centerY() const { return _centerY; }
+    qreal centerY() const { return _params.centerY; }
     void setCenterY(qreal cy);
 
     // CrossOver - X is scaled by Y ratio component and vice versa
-    bool crossOver() const { return _crossOver; }
+    bool crossOver() const { return _params.crossOver; }
     void setCrossOver(bool co);
 
     // Follow Gizmo - use connected Gizmo center as scale center
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Apply tweak to a point
-    // ratioX and ratioY are 2D ratio components (for crossover)
+    // Evaluate with the current parameters (see Params)
     Q_INVOKABLE QPointF apply(qreal x, qreal y, qreal ratioX, qreal ratioY,
-                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const { return _params.apply(x, y, ratioX, ratioY, gizmoX, gizmoY); }
+
+    void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                    qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const { _params.applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, outXs, outYs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
     void propertiesFromJson(const QJsonObject& json) override;
 
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
     // Automation sync
     void syncToAnimatedValues(int timeMs) override;
 
@@ -73,12 +100,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    qreal _scaleX{1.0};
-    qreal _scaleY{1.0};
-    bool _uniform{true};
-    qreal _centerX{0.0};
-    qreal _centerY{0.0};
-    bool _crossOver{false};
+    Params _params;
     bool _followGizmo{true};
 };
 
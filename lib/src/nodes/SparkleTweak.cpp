@@ -1,4 +1,5 @@
 #include "SparkleTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -7,6 +8,24 @@
 namespace gizmotweak2
 {
 
+// Sparkle test between two samples: random draw under the density, far enough from the last one
+static bool sparkleAllowed(qreal random, qreal density, qreal lastX, qreal lastY,
+                           qreal currentX, qreal currentY, qreal minDistance)
+{
+    if (qFuzzyIsNull(density))
+    {
+        return false;
+    }
+    if (random >= density)
+    {
+        return false;
+    }
+    // Check minimum distance from last sparkle
+    auto dx = currentX - lastX;
+    auto dy = currentY - lastY;
+    return (dx * dx + dy * dy) > (minDistance * minDistance);
+}
+
 SparkleTweak::SparkleTweak(QObject* parent)
     : Node(parent)
 {
@@ -22,19 +41,19 @@ SparkleTweak::SparkleTweak(QObject* parent)
     // Automation: Sparkle track with density (0), red (1), green (2), blue (3), alpha (4)
     // Matches GizmoTweak v1: single track with all 5 parameters
     auto* sparkleTrack = createAutomationTrack(QStringLiteral("Sparkle"), 5, QColor(255, 215, 0));
-    sparkleTrack->setupParameter(0, 0.0, 1.0, _density, tr("Density"), 100.0, QStringLiteral("%"));
-    sparkleTrack->setupParameter(1, 0.0, 1.0, _red, tr("Red"), 100.0, QStringLiteral("%"));
-    sparkleTrack->setupParameter(2, 0.0, 1.0, _green, tr("Green"), 100.0, QStringLiteral("%"));
-    sparkleTrack->setupParameter(3, 0.0, 1.0, _blue, tr("Blue"), 100.0, QStringLiteral("%"));
-    sparkleTrack->setupParameter(4, 0.0, 1.0, _alpha, tr("Alpha"), 100.0, QStringLiteral("%"));
+    sparkleTrack->setupParameter(0, 0.0, 1.0, _params.density, tr("Density"), 100.0, QStringLiteral("%"));
+    sparkleTrack->setupParameter(1, 0.0, 1.0, _params.red, tr("Red"), 100.0, QStringLiteral("%"));
+    sparkleTrack->setupParameter(2, 0.0, 1.0, _params.green, tr("Green"), 100.0, QStringLiteral("%"));
+    sparkleTrack->setupParameter(3, 0.0, 1.0, _params.blue, tr("Blue"), 100.0, QStringLiteral("%"));
+    sparkleTrack->setupParameter(4, 0.0, 1.0, _params.alpha, tr("Alpha"), 100.0, QStringLiteral("%"));
 }
 
 void SparkleTweak::setDensity(qreal d)
 {
     d = qBound(0.0, d, 1.0);
-    if (!qFuzzyCompare(_density, d))
+    if (!qFuzzyCompare(_params.density, d))
     {
-        _density = d;
+        _params.density = d;
         auto* track = automationTrack(QStringLiteral("Sparkle"));
         if (track) track->setInitialValue(0, d);
         emit densityChanged();
@@ -45,9 +64,9 @@ void SparkleTweak::setDensity(qreal d)
 void SparkleTweak::setRed(qreal r)
 {
     r = qBound(0.0, r, 1.0);
-    if (!qFuzzyCompare(_red, r))
+    if (!qFuzzyCompare(_params.red, r))
     {
-        _red = r;
+        _params.red = r;
         auto* track = automationTrack(QStringLiteral("Sparkle"));
         if (track) track->setInitialValue(1, r);
         emit redChanged();
@@ -58,9 +77,9 @@ void SparkleTweak::setRed(qreal r)
 void SparkleTweak::setGreen(qreal g)
 {
     g = qBound(0.0, g, 1.0);
-    if (!qFuzzyCompare(_green, g))
+    if (!qFuzzyCompare(_params.green, g))
     {
-        _green = g;
+        _params.green = g;
         auto* track = automationTrack(QStringLiteral("Sparkle"));
         if (track) track->setInitialValue(2, g);
         emit greenChanged();
@@ -71,9 +90,9 @@ void SparkleTweak::setGreen(qreal g)
 void SparkleTweak::setBlue(qreal b)
 {
     b = qBound(0.0, b, 1.0);
-    if (!qFuzzyCompare(_blue, b))
+    if (!qFuzzyCompare(_params.blue, b))
     {
-        _blue = b;
+        _params.blue = b;
         auto* track = automationTrack(QStringLiteral("Sparkle"));
         if (track) track->setInitialValue(3, b);
         emit blueChanged();
@@ -84,9 +103,9 @@ void SparkleTweak::setBlue(qreal b)
 void SparkleTweak::setAlpha(qreal a)
 {
     a = qBound(0.0, a, 1.0);
-    if (!qFuzzyCompare(_alpha, a))
+    if (!qFuzzyCompare(_params.alpha, a))
     {
-        _alpha = a;
+        _params.alpha = a;
         auto* track = automationTrack(QStringLiteral("Sparkle"));
         if (track) track->setInitialValue(4, a);
         emit alphaChanged();
@@ -124,14 +143,14 @@ void SparkleTweak::calculatePrecalcValues(qreal ratio)
 {
     if (_followGizmo)
     {
-        _precalcDensity = ratio * _density;
-        _precalcAlpha = ratio * _alpha;
+        _precalcDensity = ratio * _params.density;
+        _precalcAlpha = ratio * _params.alpha;
         _precalcBeta = 1.0 - _precalcAlpha;
     }
     else
     {
-        _precalcDensity = _density;
-        _precalcAlpha = _alpha;
+        _precalcDensity = _params.density;
+        _precalcAlpha = _params.alpha;
         _precalcBeta = 1.0 - _precalcAlpha;
     }
 }
@@ -139,30 +158,19 @@ void SparkleTweak::calculatePrecalcValues(qreal ratio)
 bool SparkleTweak::shouldSparkle(qreal random, qreal lastX, qreal lastY,
                                   qreal currentX, qreal currentY, qreal minDistance) const
 {
-    if (qFuzzyIsNull(_precalcDensity))
-    {
-        return false;
-    }
-    if (random >= _precalcDensity)
-    {
-        return false;
-    }
-    // Check minimum distance from last sparkle
-    auto dx = currentX - lastX;
-    auto dy = currentY - lastY;
-    return (dx * dx + dy * dy) > (minDistance * minDistance);
+    return sparkleAllowed(random, _precalcDensity, lastX, lastY, currentX, currentY, minDistance);
 }
 
 void SparkleTweak::calculateSparkleColor(qreal baseR, qreal baseG, qreal baseB,
                                           qreal& outR, qreal& outG, qreal& outB) const
 {
-    outR = qBound(0.0, _precalcAlpha * _red + _precalcBeta * baseR, 1.0);
-    outG = qBound(0.0, _precalcAlpha * _green + _precalcBeta * baseG, 1.0);
-    outB = qBound(0.0, _precalcAlpha * _blue + _precalcBeta * baseB, 1.0);
+    outR = qBound(0.0, _precalcAlpha * _params.red + _precalcBeta * baseR, 1.0);
+    outG = qBound(0.0, _precalcAlpha * _params.green + _precalcBeta * baseG, 1.0);
+    outB = qBound(0.0, _precalcAlpha * _params.blue + _precalcBeta * baseB, 1.0);
 }
 
-void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output, qreal ratio,
-                                 QRandomGenerator* rng)
+void SparkleTweak::Params::applyToFrame(xengine::Frame* input, xengine::Frame* output, qreal ratio,
+                                         QRandomGenerator* rng) const
 {
     if (!input || !output)
     {
@@ -180,11 +188,13 @@ void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output, q
     // Use provided RNG or global
     QRandomGenerator* generator = rng ? rng : QRandomGenerator::global();
 
-    // Calculate precalc values based on ratio
-    calculatePrecalcValues(ratio);
+    // Density and blend scaled by the ratio (GizmoTweak precalc values)
+    const qreal precalcDensity = ratio * density;
+    const qreal precalcAlpha = ratio * alpha;
+    const qreal precalcBeta = 1.0 - precalcAlpha;
 
     // If sparkle is not active, just copy the frame
-    if (!isActive() || qFuzzyIsNull(_precalcDensity))
+    if (qFuzzyIsNull(density) || qFuzzyIsNull(precalcDensity))
     {
         output->clone(*input);
         return;
@@ -210,14 +220,14 @@ void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output, q
         const auto& currentSample = (*input)[i];
 
         // Check if sparkle should occur between last and current sample
-        if (i > 0 && shouldSparkle(generator->generateDouble(),
-                                    lastSparkledX, lastSparkledY,
-                                    lastSample.getX(), lastSample.getY()))
+        if (i > 0 && sparkleAllowed(generator->generateDouble(), precalcDensity,
+                                     lastSparkledX, lastSparkledY,
+                                     lastSample.getX(), lastSample.getY(), 0.001))
         {
             // Calculate sparkle color
-            qreal sparkleR, sparkleG, sparkleB;
-            calculateSparkleColor(lastSample.getR(), lastSample.getG(), lastSample.getB(),
-                                  sparkleR, sparkleG, sparkleB);
+            qreal sparkleR = qBound(0.0, precalcAlpha * red + precalcBeta * lastSample.getR(), 1.0);
+            qreal sparkleG = qBound(0.0, precalcAlpha * green + precalcBeta * lastSample.getG(), 1.0);
+            qreal sparkleB = qBound(0.0, precalcAlpha * blue + precalcBeta * lastSample.getB(), 1.0);
 
             // Random interpolation factor between last and current sample
             const qreal ra = generator->generateDouble();
@@ -259,9 +269,9 @@ void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output, q
     }
 }
 
-void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output,
-                                 const RatioEvaluator& ratioEvaluator,
-                                 QRandomGenerator* rng)
+void SparkleTweak::Params::applyToFrame(xengine::Frame* input, xengine::Frame* output,
+                                         const RatioEvaluator& ratioEvaluator,
+                                         QRandomGenerator* rng) const
 {
     if (!input || !output)
     {
@@ -280,7 +290,7 @@ void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output,
     QRandomGenerator* generator = rng ? rng : QRandomGenerator::global();
 
     // If sparkle is not active, just copy the frame
-    if (!isActive())
+    if (qFuzzyIsNull(density))
     {
         output->clone(*input);
         return;
@@ -309,8 +319,8 @@ void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output,
         qreal ratio = ratioEvaluator(currentSample.getX(), currentSample.getY());
 
         // Calculate density and alpha based on ratio (followGizmo behavior)
-        qreal localDensity = ratio * _density;
-        qreal localAlpha = ratio * _alpha;
+        qreal localDensity = ratio * density;
+        qreal localAlpha = ratio * alpha;
         qreal localBeta = 1.0 - localAlpha;
 
         // Check if sparkle should occur between last and current sample
@@ -333,9 +343,9 @@ void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output,
         if (doSparkle)
         {
             // Calculate sparkle color with local alpha
-            qreal sparkleR = qBound(0.0, localAlpha * _red + localBeta * lastSample.getR(), 1.0);
-            qreal sparkleG = qBound(0.0, localAlpha * _green + localBeta * lastSample.getG(), 1.0);
-            qreal sparkleB = qBound(0.0, localAlpha * _blue + localBeta * lastSample.getB(), 1.0);
+            qreal sparkleR = qBound(0.0, localAlpha * red + localBeta * lastSample.getR(), 1.0);
+            qreal sparkleG = qBound(0.0, localAlpha * green + localBeta * lastSample.getG(), 1.0);
+            qreal sparkleB = qBound(0.0, localAlpha * blue + localBeta * lastSample.getB(), 1.0);
 
             // Random interpolation factor between last and current sample
             const qreal ra = generator->generateDouble();
@@ -377,14 +387,22 @@ void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output,
     }
 }
 
+void SparkleTweak::applyToFrame(xengine::Frame* input, xengine::Frame* output, qreal ratio,
+                                 QRandomGenerator* rng)
+{
+    // Keep the precalc accessors in step with what was applied
+    calculatePrecalcValues(ratio);
+    _params.applyToFrame(input, output, _followGizmo ? ratio : 1.0, rng);
+}
+
 QJsonObject SparkleTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["density"] = _density;
-    obj["red"] = _red;
-    obj["green"] = _green;
-    obj["blue"] = _blue;
-    obj["alpha"] = _alpha;
+    obj["density"] = _params.density;
+    obj["red"] = _params.red;
+    obj["green"] = _params.green;
+    obj["blue"] = _params.blue;
+    obj["alpha"] = _params.alpha;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -399,19 +417,25 @@ void SparkleTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
+using SparkleParams = SparkleTweak::Params;
+
+// Automation tracks -> Params members
+// Matches GizmoTweak v1: single Sparkle track with density, R, G, B, alpha
+static constexpr AutomationBinding<SparkleParams> AUTOMATION_BINDINGS[] = {
+    {"Sparkle", {&SparkleParams::density, &SparkleParams::red, &SparkleParams::green,
+                 &SparkleParams::blue, &SparkleParams::alpha}},
+};
+
+SparkleTweak::Params SparkleTweak::paramsAt(int timeMs) const
+{
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
+
 void SparkleTweak::syncToAnimatedValues(int timeMs)
 {
-    // Only sync if automation is active
-    // Matches GizmoTweak v1: single Sparkle track with density, R, G, B, alpha
-    auto* sparkleTrack = automationTrack(QStringLiteral("Sparkle"));
-    if (sparkleTrack && sparkleTrack->isAutomated())
-    {
-        _density = sparkleTrack->timedValue(timeMs, 0);
-        _red = sparkleTrack->timedValue(timeMs, 1);
-        _green = sparkleTrack->timedValue(timeMs, 2);
-        _blue = sparkleTrack->timedValue(timeMs, 3);
-        _alpha = sparkleTrack->timedValue(timeMs, 4);
-    }
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
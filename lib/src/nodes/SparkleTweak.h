@@ -31,28 +31,52 @@ class SparkleTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Per-sample ratio evaluation (for followGizmo)
+    // ratioEvaluator takes (x, y) and returns ratio at that position
+    using RatioEvaluator = std::function<qreal(qreal x, qreal y)>;
+
+    // Sparkle parameters, resolved per evaluation time by paramsAt()
+    struct Params
+    {
+        qreal density{0.0};
+        qreal red{1.0};
+        qreal green{1.0};
+        qreal blue{1.0};
+        qreal alpha{1.0};
+
+        // Insert sparkles with density and alpha scaled by a frame-wide ratio
+        void applyToFrame(xengine::Frame* input, xengine::Frame* output, qreal ratio,
+                          QRandomGenerator* rng = nullptr) const;
+
+        // Same with the ratio evaluated at each sample
+        void applyToFrame(xengine::Frame* input, xengine::Frame* output,
+                          const RatioEvaluator& ratioEvaluator,
+                          QRandomGenerator* rng = nullptr) const;
+    };
+
     explicit SparkleTweak(QObject* parent = nullptr);
     ~SparkleTweak() override = default;
 
     QString type() const override { return QStringLiteral("SparkleTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::SparkleTweak; }
 
     // Density - probability that a point sparkles (0-1)
-    qreal density() const { return _density; }
+    qreal density() const { return _params.density; }
     void setDensity(qreal d);
 
     // Sparkle color RGB (0-1 each)
-    qreal red() const { return _red; }
+    qreal red() const { return _params.red; }
     void setRed(qreal r);
 
-    qreal green() const { return _green; }
+    qreal green() const { return _params.green; }
     void setGreen(qreal g);
 
-    qreal blue() const { return _blue; }
+    qreal blue() const { return _params.blue; }
     void setBlue(qreal b);
 
     // Alpha - blend factor for sparkle color (0-1)
-    qreal alpha() const { return _alpha; }
+    qreal alpha() const { return _params.alpha; }
     void setAlpha(qreal a);
 
     // Follow gizmo - use gizmo's ratio when true
@@ -60,7 +84,7 @@ public:
     void setFollowGizmo(bool follow);
 
     // Color as QColor for convenience
-    QColor color() const { return QColor::fromRgbF(_red, _green, _blue); }
+    QColor color() const { return QColor::fromRgbF(_params.red, _params.green, _params.blue); }
     void setColor(const QColor& c);
 
     // Check if sparkle should occur based on random value and minimum distance
@@ -80,7 +104,7 @@ public:
     qreal precalcBeta() const { return _precalcBeta; }
 
     // Check if effect is active
-    bool isActive() const { return !qFuzzyIsNull(_density); }
+    bool isActive() const { return !qFuzzyIsNull(_params.density); }
 
     // Apply sparkle effect to entire frame
     // This is the main entry point - processes input frame and returns output with sparkles inserted
@@ -88,16 +112,21 @@ public:
                       QRandomGenerator* rng = nullptr);
 
     // Overload with per-sample ratio evaluation (for followGizmo)
-    // ratioEvaluator takes (x, y) and returns ratio at that position
-    using RatioEvaluator = std::function<qreal(qreal x, qreal y)>;
     void applyToFrame(xengine::Frame* input, xengine::Frame* output,
                       const RatioEvaluator& ratioEvaluator,
-                      QRandomGenerator* rng = nullptr);
+                      QRandomGenerator* rng = nullptr) const
+    {
+        _params.applyToFrame(input, output, ratioEvaluator, rng);
+    }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
     void propertiesFromJson(const QJsonObject& json) override;
 
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
     // Automation
     void syncToAnimatedValues(int timeMs) override;
 
@@ -111,11 +140,7 @@ signals:
 
 private:
     // Base parameters
-    qreal _density{0.0};
-    qreal _red{1.0};
-    qreal _green{1.0};
-    qreal _blue{1.0};
-    qreal _alpha{1.0};
+    Params _params;
     bool _followGizmo{true};
 
     // Precalculated values (updated by calculatePrecalcValues)
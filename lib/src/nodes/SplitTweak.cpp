@@ -1,4 +1,5 @@
 #include "SplitTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -97,14 +98,21 @@ void SplitTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
+// The threshold is the only automated value, a member of the node itself
+struct SplitAutomation
+{
+    qreal threshold;
+};
+
+static constexpr AutomationBinding<SplitAutomation> AUTOMATION_BINDINGS[] = {
+    {"Threshold", {&SplitAutomation::threshold}},
+};
+
 void SplitTweak::syncToAnimatedValues(int timeMs)
 {
-    // Only sync if automation is active
-    auto* thresholdTrack = automationTrack(QStringLiteral("Threshold"));
-    if (thresholdTrack && thresholdTrack->isAutomated())
-    {
-        _splitThreshold = thresholdTrack->timedValue(timeMs, 0);
-    }
+    SplitAutomation animated{_splitThreshold};
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    _splitThreshold = animated.threshold;
 }
 
 } // namespace gizmotweak2
@@ -20,6 +20,7 @@ public:
 
     QString type() const override { return QStringLiteral("SplitTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::SplitTweak; }
 
     qreal splitThreshold() const { return _splitThreshold; }
     void setSplitThreshold(qreal threshold);
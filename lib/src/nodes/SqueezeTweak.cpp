@@ -1,7 +1,9 @@
 #include "SqueezeTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
+#include <algorithm>
 #include <cmath>
 
 namespace gizmotweak2
@@ -22,20 +24,20 @@ SqueezeTweak::SqueezeTweak(QObject* parent)
 
     // Automation: Squeeze track with intensity (0) and angle (1)
     auto* squeezeTrack = createAutomationTrack(QStringLiteral("Squeeze"), 2, QColor(210, 105, 30));
-    squeezeTrack->setupParameter(0, -2.0, 2.0, _intensity, tr("Intensity"), 100.0, QStringLiteral("%"));
-    squeezeTrack->setupParameter(1, 0.0, 360.0, _angle, tr("Angle"), 1.0, QStringLiteral("\u00B0"));
+    squeezeTrack->setupParameter(0, -2.0, 2.0, _params.intensity, tr("Intensity"), 100.0, QStringLiteral("%"));
+    squeezeTrack->setupParameter(1, 0.0, 360.0, _params.angle, tr("Angle"), 1.0, QStringLiteral("\u00B0"));
 
     auto* centerTrack = createAutomationTrack(QStringLiteral("Center"), 2, QColor(186, 85, 211));
-    centerTrack->setupParameter(0, -1.0, 1.0, _centerX, tr("Center X"), 100.0, QStringLiteral("%"));
-    centerTrack->setupParameter(1, -1.0, 1.0, _centerY, tr("Center Y"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(0, -1.0, 1.0, _params.centerX, tr("Center X"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(1, -1.0, 1.0, _params.centerY, tr("Center Y"), 100.0, QStringLiteral("%"));
 }
 
 void SqueezeTweak::setIntensity(qreal i)
 {
     i = qBound(-2.0, i, 2.0);
-    if (!qFuzzyCompare(_intensity, i))
+    if (!qFuzzyCompare(_params.intensity, i))
     {
-        _intensity = i;
+        _params.intensity = i;
         auto* track = automationTrack(QStringLiteral("Squeeze"));
         if (track) track->setInitialValue(0, i);
         emit intensityChanged();
@@ -48,9 +50,9 @@ void SqueezeTweak::setAngle(qreal a)
     // Normalize angle to 0-360
     while (a < 0.0) a += 360.0;
     while (a >= 360.0) a -= 360.0;
-    if (!qFuzzyCompare(_angle, a))
+    if (!qFuzzyCompare(_params.angle, a))
     {
-        _angle = a;
+        _params.angle = a;
         auto* track = automationTrack(QStringLiteral("Squeeze"));
         if (track) track->setInitialValue(1, a);
         emit angleChanged();
@@ -60,9 +62,9 @@ void SqueezeTweak::setAngle(qreal a)
 
 void SqueezeTweak::setCenterX(qreal cx)
 {
-    if (!qFuzzyCompare(_centerX, cx))
+    if (!qFuzzyCompare(_params.centerX, cx))
     {
-        _centerX = cx;
+        _params.centerX = cx;
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(0, cx);
         emit centerXChanged();
@@ -72,9 +74,9 @@ void SqueezeTweak::setCenterX(qreal cx)
 
 void SqueezeTweak::setCenterY(qreal cy)
 {
-    if (!qFuzzyCompare(_centerY, cy))
+    if (!qFuzzyCompare(_params.centerY, cy))
     {
-        _centerY = cy;
+        _params.centerY = cy;
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(1, cy);
         emit centerYChanged();
@@ -104,24 +106,24 @@ void SqueezeTweak::setFollowGizmo(bool follow)
     }
 }
 
-QPointF SqueezeTweak::apply(qreal x, qreal y, qreal ratio,
-                            qreal gizmoX, qreal gizmoY) const
+QPointF SqueezeTweak::Params::apply(qreal x, qreal y, qreal ratio,
+                                    qreal gizmoX, qreal gizmoY) const
 {
-    if (qFuzzyIsNull(_intensity) || qFuzzyIsNull(ratio))
+    if (qFuzzyIsNull(intensity) || qFuzzyIsNull(ratio))
     {
         return QPointF(x, y);
     }
 
     // Center = own automatable center + position cable offset (additive)
-    qreal cx = _centerX + gizmoX;
-    qreal cy = _centerY + gizmoY;
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
 
     // Convert to coordinates relative to center
     qreal dx = x - cx;
     qreal dy = y - cy;
 
     // Effective intensity based on ratio
-    qreal effectiveIntensity = _intensity * ratio;
+    qreal effectiveIntensity = intensity * ratio;
 
     // Hyperbolic transformation (squeeze/stretch)
     // x' = x * cosh(k) + y * sinh(k)
@@ -137,9 +139,9 @@ QPointF SqueezeTweak::apply(qreal x, qreal y, qreal ratio,
     qreal newY = dx * sinhK + dy * coshK;
 
     // Apply rotation to orient the squeeze/stretch axes
-    if (!qFuzzyIsNull(_angle))
+    if (!qFuzzyIsNull(angle))
     {
-        qreal angleRad = qDegreesToRadians(_angle);
+        qreal angleRad = qDegreesToRadians(angle);
         qreal cosA = qCos(angleRad);
         qreal sinA = qSin(angleRad);
 
@@ -163,13 +165,80 @@ QPointF SqueezeTweak::apply(qreal x, qreal y, qreal ratio,
     return QPointF(resultX, resultY);
 }
 
+void SqueezeTweak::Params::applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                                      qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const
+{
+    if (qFuzzyIsNull(intensity))
+    {
+        if (outXs != xs) std::copy(xs, xs + count, outXs);
+        if (outYs != ys) std::copy(ys, ys + count, outYs);
+        return;
+    }
+
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
+
+    bool rotated = !qFuzzyIsNull(angle);
+    qreal angleRad = qDegreesToRadians(angle);
+    qreal cosA = qCos(angleRad);
+    qreal sinA = qSin(angleRad);
+
+    // cosh/sinh only change with the ratio: recompute on change, not per point
+    qreal lastRatio = 1.0;
+    qreal coshK = std::cosh(intensity * lastRatio);
+    qreal sinhK = std::sinh(intensity * lastRatio);
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal x = xs[i];
+        qreal y = ys[i];
+        qreal ratio = ratios ? ratios[i] : 1.0;
+
+        if (qFuzzyIsNull(ratio))
+        {
+            outXs[i] = x;
+            outYs[i] = y;
+            continue;
+        }
+
+        if (ratio != lastRatio)
+        {
+            lastRatio = ratio;
+            coshK = std::cosh(intensity * ratio);
+            sinhK = std::sinh(intensity * ratio);
+        }
+
+        qreal dx = x - cx;
+        qreal dy = y - cy;
+        qreal newX, newY;
+
+        if (rotated)
+        {
+            qreal rotX = dx * cosA - dy * sinA;
+            qreal rotY = dx * sinA + dy * cosA;
+            qreal transX = rotX * coshK + rotY * sinhK;
+            qreal transY = rotX * sinhK + rotY * coshK;
+            newX = transX * cosA + transY * sinA;
+            newY = -transX * sinA + transY * cosA;
+        }
+        else
+        {
+            newX = dx * coshK + dy * sinhK;
+            newY = dx * sinhK + dy * coshK;
+        }
+
+        outXs[i] = cx + newX;
+        outYs[i] = cy + newY;
+    }
+}
+
 QJsonObject SqueezeTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["intensity"] = _intensity;
-    obj["angle"] = _angle;
-    obj["centerX"] = _centerX;
-    obj["centerY"] = _centerY;
+    obj["intensity"] = _params.intensity;
+    obj["angle"] = _params.angle;
+    obj["centerX"] = _params.centerX;
+    obj["centerY"] = _params.centerY;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -183,22 +252,24 @@ void SqueezeTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
-void SqueezeTweak::syncToAnimatedValues(int timeMs)
+using SqueezeParams = SqueezeTweak::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<SqueezeParams> AUTOMATION_BINDINGS[] = {
+    {"Squeeze", {&SqueezeParams::intensity, &SqueezeParams::angle}},
+    {"Center", {&SqueezeParams::centerX, &SqueezeParams::centerY}},
+};
+
+SqueezeTweak::Params SqueezeTweak::paramsAt(int timeMs) const
 {
-    // Only sync if automation is active for each track
-    auto* squeezeTrack = automationTrack(QStringLiteral("Squeeze"));
-    if (squeezeTrack && squeezeTrack->isAutomated())
-    {
-        _intensity = squeezeTrack->timedValue(timeMs, 0);
-        _angle = squeezeTrack->timedValue(timeMs, 1);
-    }
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* centerTrack = automationTrack(QStringLiteral("Center"));
-    if (centerTrack && centerTrack->isAutomated())
-    {
-        _centerX = centerTrack->timedValue(timeMs, 0);
-        _centerY = centerTrack->timedValue(timeMs, 1);
-    }
+void SqueezeTweak::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
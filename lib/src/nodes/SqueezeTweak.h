@@ -18,34 +18,56 @@ class SqueezeTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Squeeze parameters at one evaluation time
+    struct Params
+    {
+        qreal intensity{0.5};
+        qreal angle{0.0};
+        qreal centerX{0.0};
+        qreal centerY{0.0};
+
+        // Apply tweak to a point
+        QPointF apply(qreal x, qreal y, qreal ratio,
+                      qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+
+        // Squeeze count points; cosh/sinh are only recomputed when the ratio changes
+        // (nullptr ratios = 1.0, outputs may alias inputs)
+        void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                        qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const;
+    };
+
     explicit SqueezeTweak(QObject* parent = nullptr);
     ~SqueezeTweak() override = default;
 
     QString type() const override { return QStringLiteral("SqueezeTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::SqueezeTweak; }
 
     // Intensity - strength of squeeze/stretch (hyperbolic transformation)
-    qreal intensity() const { return _intensity; }
+    qreal intensity() const { return _params.intensity; }
     void setIntensity(qreal i);
 
     // Angle - orientation of the squeeze/stretch axes
-    qreal angle() const { return _angle; }
+    qreal angle() const { return _params.angle; }
     void setAngle(qreal a);
 
     // Center of transformation
-    qreal centerX() const { return _centerX; }
+    qreal centerX() const { return _params.centerX; }
     void setCenterX(qreal cx);
 
-    qreal centerY() const { return _centerY; }
+    qreal centerY() const { return _params.centerY; }
     void setCenterY(qreal cy);
 
     // Follow Gizmo - use connected Gizmo center
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Apply tweak to a point
+    // Evaluate with the current parameters (see Params)
     Q_INVOKABLE QPointF apply(qreal x, qreal y, qreal ratio,
-                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const { return _params.apply(x, y, ratio, gizmoX, gizmoY); }
+
+    void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                    qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const { _params.applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, outXs, outYs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
@@ -53,6 +75,10 @@ public:
 
     // Automation
     void syncToAnimatedValues(int timeMs) override;
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
 
 signals:
     void intensityChanged();
@@ -62,10 +88,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    qreal _intensity{0.5};
-    qreal _angle{0.0};
-    qreal _centerX{0.0};
-    qreal _centerY{0.0};
+    Params _params;
     bool _followGizmo{true};
 };
 
@@ -20,9 +20,9 @@ SurfaceFactoryNode::SurfaceFactoryNode(QObject* parent)
 
 void SurfaceFactoryNode::setSurfaceType(SurfaceType type)
 {
-    if (_surfaceType != type)
+    if (_params.surfaceType != type)
     {
-        _surfaceType = type;
+        _params.surfaceType = type;
         emit surfaceTypeChanged();
         emitPropertyChanged();
     }
@@ -30,9 +30,9 @@ void SurfaceFactoryNode::setSurfaceType(SurfaceType type)
 
 void SurfaceFactoryNode::setAmplitude(qreal amp)
 {
-    if (!qFuzzyCompare(_amplitude, amp))
+    if (!qFuzzyCompare(_params.amplitude, amp))
     {
-        _amplitude = amp;
+        _params.amplitude = amp;
         emit amplitudeChanged();
         emitPropertyChanged();
     }
@@ -40,9 +40,9 @@ void SurfaceFactoryNode::setAmplitude(qreal amp)
 
 void SurfaceFactoryNode::setFrequency(qreal freq)
 {
-    if (!qFuzzyCompare(_frequency, freq))
+    if (!qFuzzyCompare(_params.frequency, freq))
     {
-        _frequency = freq;
+        _params.frequency = freq;
         emit frequencyChanged();
         emitPropertyChanged();
     }
@@ -50,9 +50,9 @@ void SurfaceFactoryNode::setFrequency(qreal freq)
 
 void SurfaceFactoryNode::setPhase(qreal ph)
 {
-    if (!qFuzzyCompare(_phase, ph))
+    if (!qFuzzyCompare(_params.phase, ph))
     {
-        _phase = ph;
+        _params.phase = ph;
         emit phaseChanged();
         emitPropertyChanged();
     }
@@ -60,9 +60,9 @@ void SurfaceFactoryNode::setPhase(qreal ph)
 
 void SurfaceFactoryNode::setOffset(qreal off)
 {
-    if (!qFuzzyCompare(_offset, off))
+    if (!qFuzzyCompare(_params.offset, off))
     {
-        _offset = off;
+        _params.offset = off;
         emit offsetChanged();
         emitPropertyChanged();
     }
@@ -70,22 +70,22 @@ void SurfaceFactoryNode::setOffset(qreal off)
 
 void SurfaceFactoryNode::setClamp(bool c)
 {
-    if (_clamp != c)
+    if (_params.clamp != c)
     {
-        _clamp = c;
+        _params.clamp = c;
         emit clampChanged();
         emitPropertyChanged();
     }
 }
 
-qreal SurfaceFactoryNode::computeRatio(qreal t) const
+qreal SurfaceFactoryNode::Params::computeRatio(qreal t) const
 {
     // Apply frequency and phase
-    qreal x = t * _frequency + _phase;
+    qreal x = t * frequency + phase;
 
     qreal result = 0.0;
 
-    switch (_surfaceType)
+    switch (surfaceType)
     {
     case SurfaceType::Linear:
         // Linear ramp from 0 to 1
@@ -148,10 +148,10 @@ qreal SurfaceFactoryNode::computeRatio(qreal t) const
     }
 
     // Apply amplitude and offset
-    result = result * _amplitude + _offset;
+    result = result * amplitude + offset;
 
     // Clamp to 0-1 if enabled
-    if (_clamp)
+    if (clamp)
     {
         result = qBound(0.0, result, 1.0);
     }
@@ -162,12 +162,12 @@ qreal SurfaceFactoryNode::computeRatio(qreal t) const
 QJsonObject SurfaceFactoryNode::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["surfaceType"] = static_cast<int>(_surfaceType);
-    obj["amplitude"] = _amplitude;
-    obj["frequency"] = _frequency;
-    obj["phase"] = _phase;
-    obj["offset"] = _offset;
-    obj["clamp"] = _clamp;
+    obj["surfaceType"] = static_cast<int>(_params.surfaceType);
+    obj["amplitude"] = _params.amplitude;
+    obj["frequency"] = _params.frequency;
+    obj["phase"] = _params.phase;
+    obj["offset"] = _params.offset;
+    obj["clamp"] = _params.clamp;
     return obj;
 }
 
@@ -32,37 +32,55 @@ public:
     };
     Q_ENUM(SurfaceType)
 
+    // Surface curve parameters at one evaluation time
+    struct Params
+    {
+        SurfaceType surfaceType{SurfaceType::Sine};
+        qreal amplitude{1.0};
+        qreal frequency{1.0};
+        qreal phase{0.0};
+        qreal offset{0.0};
+        bool clamp{true};
+
+        // Compute ratio at given time t (0.0 to 1.0 normalized)
+        qreal computeRatio(qreal t) const;
+    };
+
     explicit SurfaceFactoryNode(QObject* parent = nullptr);
     ~SurfaceFactoryNode() override = default;
 
     QString type() const override { return QStringLiteral("SurfaceFactory"); }
     Category category() const override { return Category::Shape; }
+    Kind kind() const override { return Kind::SurfaceFactory; }
 
-    SurfaceType surfaceType() const { return _surfaceType; }
+    SurfaceType surfaceType() const { return _params.surfaceType; }
     void setSurfaceType(SurfaceType type);
 
-    qreal amplitude() const { return _amplitude; }
+    qreal amplitude() const { return _params.amplitude; }
     void setAmplitude(qreal amp);
 
-    qreal frequency() const { return _frequency; }
+    qreal frequency() const { return _params.frequency; }
     void setFrequency(qreal freq);
 
-    qreal phase() const { return _phase; }
+    qreal phase() const { return _params.phase; }
     void setPhase(qreal ph);
 
-    qreal offset() const { return _offset; }
+    qreal offset() const { return _params.offset; }
     void setOffset(qreal off);
 
-    bool clamp() const { return _clamp; }
+    bool clamp() const { return _params.clamp; }
     void setClamp(bool c);
 
-    // Compute ratio at given time t (0.0 to 1.0 normalized)
-    Q_INVOKABLE qreal computeRatio(qreal t) const;
+    // Evaluate with the current parameters (see Params)
+    Q_INVOKABLE qreal computeRatio(qreal t) const { return _params.computeRatio(t); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
     void propertiesFromJson(const QJsonObject& json) override;
 
+    // Parameters as plain data (not automated, so the same at every time)
+    const Params& params() const { return _params; }
+
 signals:
     void surfaceTypeChanged();
     void amplitudeChanged();
@@ -72,12 +90,7 @@ signals:
     void clampChanged();
 
 private:
-    SurfaceType _surfaceType{SurfaceType::Sine};
-    qreal _amplitude{1.0};
-    qreal _frequency{1.0};
-    qreal _phase{0.0};
-    qreal _offset{0.0};
-    bool _clamp{true};
+    Params _params;
 };
 
 } // namespace gizmotweak2
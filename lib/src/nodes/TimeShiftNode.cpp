@@ -1,4 +1,5 @@
 #include "TimeShiftNode.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
@@ -23,19 +24,19 @@ TimeShiftNode::TimeShiftNode(QObject* parent)
 
     // Automation: Time track with delay (0) and scale (1)
     auto* timeTrack = createAutomationTrack(QStringLiteral("Time"), 2, QColor(65, 105, 225));  // Royal blue
-    timeTrack->setupParameter(0, -10.0, 10.0, _delay, tr("Delay"), 1000.0, QStringLiteral(" ms"));
-    timeTrack->setupParameter(1, 0.01, 10.0, _scale, tr("Scale"), 100.0, QStringLiteral("%"));
+    timeTrack->setupParameter(0, -10.0, 10.0, _params.delay, tr("Delay"), 1000.0, QStringLiteral(" ms"));
+    timeTrack->setupParameter(1, 0.01, 10.0, _params.scale, tr("Scale"), 100.0, QStringLiteral("%"));
 
     // Automation: Loop track with loopDuration (0)
     auto* loopTrack = createAutomationTrack(QStringLiteral("Loop"), 1, QColor(34, 139, 34));  // Forest green
-    loopTrack->setupParameter(0, 0.001, 60.0, _loopDuration, tr("Duration"), 1000.0, QStringLiteral(" ms"));
+    loopTrack->setupParameter(0, 0.001, 60.0, _params.loopDuration, tr("Duration"), 1000.0, QStringLiteral(" ms"));
 }
 
 void TimeShiftNode::setDelay(qreal d)
 {
-    if (!qFuzzyCompare(_delay, d))
+    if (!qFuzzyCompare(_params.delay, d))
     {
-        _delay = d;
+        _params.delay = d;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Time"));
         if (track) track->setInitialValue(0, d);
@@ -48,9 +49,9 @@ void TimeShiftNode::setScale(qreal s)
 {
     // Prevent zero or negative scale
     s = qMax(0.001, s);
-    if (!qFuzzyCompare(_scale, s))
+    if (!qFuzzyCompare(_params.scale, s))
     {
-        _scale = s;
+        _params.scale = s;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Time"));
         if (track) track->setInitialValue(1, s);
@@ -61,9 +62,9 @@ void TimeShiftNode::setScale(qreal s)
 
 void TimeShiftNode::setLoop(bool l)
 {
-    if (_loop != l)
+    if (_params.loop != l)
     {
-        _loop = l;
+        _params.loop = l;
         emit loopChanged();
         emitPropertyChanged();
     }
@@ -73,9 +74,9 @@ void TimeShiftNode::setLoopDuration(qreal duration)
 {
     // Minimum loop duration
     duration = qMax(0.001, duration);
-    if (!qFuzzyCompare(_loopDuration, duration))
+    if (!qFuzzyCompare(_params.loopDuration, duration))
     {
-        _loopDuration = duration;
+        _params.loopDuration = duration;
         // Sync to automation track initial value
         auto* track = automationTrack(QStringLiteral("Loop"));
         if (track) track->setInitialValue(0, duration);
@@ -84,22 +85,22 @@ void TimeShiftNode::setLoopDuration(qreal duration)
     }
 }
 
-qreal TimeShiftNode::shiftTime(qreal currentTime) const
+qreal TimeShiftNode::Params::shiftTime(qreal currentTime) const
 {
     // Apply delay (positive = retard, negative = advance)
-    qreal shifted = currentTime - _delay;
+    qreal shifted = currentTime - delay;
 
     // Apply scale (speed multiplier)
-    shifted *= _scale;
+    shifted *= scale;
 
     // Apply loop if enabled
-    if (_loop && _loopDuration > 0.0)
+    if (loop && loopDuration > 0.0)
     {
         // Use fmod for looping, handle negative values
-        shifted = std::fmod(shifted, _loopDuration);
+        shifted = std::fmod(shifted, loopDuration);
         if (shifted < 0.0)
         {
-            shifted += _loopDuration;
+            shifted += loopDuration;
         }
     }
 
@@ -109,10 +110,10 @@ qreal TimeShiftNode::shiftTime(qreal currentTime) const
 QJsonObject TimeShiftNode::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["delay"] = _delay;
-    obj["scale"] = _scale;
-    obj["loop"] = _loop;
-    obj["loopDuration"] = _loopDuration;
+    obj["delay"] = _params.delay;
+    obj["scale"] = _params.scale;
+    obj["loop"] = _params.loop;
+    obj["loopDuration"] = _params.loopDuration;
     return obj;
 }
 
@@ -124,21 +125,24 @@ void TimeShiftNode::propertiesFromJson(const QJsonObject& json)
     if (json.contains("loopDuration")) setLoopDuration(json["loopDuration"].toDouble());
 }
 
-void TimeShiftNode::syncToAnimatedValues(int timeMs)
+using TimeShiftParams = TimeShiftNode::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<TimeShiftParams> AUTOMATION_BINDINGS[] = {
+    {"Time", {&TimeShiftParams::delay, &TimeShiftParams::scale}},
+    {"Loop", {&TimeShiftParams::loopDuration}},
+};
+
+TimeShiftNode::Params TimeShiftNode::paramsAt(int timeMs) const
 {
-    // Only sync if automation is active for each track
-    auto* timeTrack = automationTrack(QStringLiteral("Time"));
-    if (timeTrack && timeTrack->isAutomated())
-    {
-        _delay = timeTrack->timedValue(timeMs, 0);
-        _scale = timeTrack->timedValue(timeMs, 1);
-    }
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* loopTrack = automationTrack(QStringLiteral("Loop"));
-    if (loopTrack && loopTrack->isAutomated())
-    {
-        _loopDuration = loopTrack->timedValue(timeMs, 0);
-    }
+void TimeShiftNode::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
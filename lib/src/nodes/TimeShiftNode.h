@@ -17,29 +17,42 @@ class TimeShiftNode : public Node
     Q_PROPERTY(qreal loopDuration READ loopDuration WRITE setLoopDuration NOTIFY loopDurationChanged)
 
 public:
+    // Time mapping parameters at one evaluation time
+    struct Params
+    {
+        qreal delay{0.0};
+        qreal scale{1.0};
+        bool loop{false};
+        qreal loopDuration{1.0};
+
+        // Compute shifted time
+        qreal shiftTime(qreal currentTime) const;
+    };
+
     explicit TimeShiftNode(QObject* parent = nullptr);
     ~TimeShiftNode() override = default;
 
     QString type() const override { return QStringLiteral("TimeShift"); }
     Category category() const override { return Category::Utility; }
+    Kind kind() const override { return Kind::TimeShift; }
 
     // Delay in seconds (positive = retard, negative = avance)
-    qreal delay() const { return _delay; }
+    qreal delay() const { return _params.delay; }
     void setDelay(qreal d);
 
     // Time scale factor (1.0 = normal, 2.0 = double speed, 0.5 = half speed)
-    qreal scale() const { return _scale; }
+    qreal scale() const { return _params.scale; }
     void setScale(qreal s);
 
     // Loop mode
-    bool loop() const { return _loop; }
+    bool loop() const { return _params.loop; }
     void setLoop(bool l);
 
-    qreal loopDuration() const { return _loopDuration; }
+    qreal loopDuration() const { return _params.loopDuration; }
     void setLoopDuration(qreal duration);
 
-    // Compute shifted time
-    Q_INVOKABLE qreal shiftTime(qreal currentTime) const;
+    // Evaluate with the current parameters (see Params)
+    Q_INVOKABLE qreal shiftTime(qreal currentTime) const { return _params.shiftTime(currentTime); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
@@ -47,6 +60,10 @@ public:
 
     // Automation
     void syncToAnimatedValues(int timeMs) override;
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
 
 signals:
     void delayChanged();
@@ -55,10 +72,7 @@ signals:
     void loopDurationChanged();
 
 private:
-    qreal _delay{0.0};
-    qreal _scale{1.0};
-    bool _loop{false};
-    qreal _loopDuration{1.0};
+    Params _params;
 };
 
 } // namespace gizmotweak2
@@ -1,7 +1,9 @@
 #include "WaveTweak.h"
+#include "core/AutomationBinding.h"
 #include "core/Port.h"
 
 #include <QtMath>
+#include <algorithm>
 
 namespace gizmotweak2
 {
@@ -21,22 +23,22 @@ WaveTweak::WaveTweak(QObject* parent)
 
     // Automation: Wave track with amplitude (0), wavelength (1), phase (2), angle (3)
     auto* waveTrack = createAutomationTrack(QStringLiteral("Wave"), 4, QColor(30, 144, 255));
-    waveTrack->setupParameter(0, 0.0, 2.0, _amplitude, tr("Amplitude"), 100.0, QStringLiteral("%"));
-    waveTrack->setupParameter(1, 0.01, 2.0, _wavelength, tr("Wavelength"), 100.0, QStringLiteral("%"));
-    waveTrack->setupParameter(2, 0.0, 360.0, _phase, tr("Phase"), 1.0, QStringLiteral("\u00B0"));
-    waveTrack->setupParameter(3, 0.0, 360.0, _angle, tr("Angle"), 1.0, QStringLiteral("\u00B0"));
+    waveTrack->setupParameter(0, 0.0, 2.0, _params.amplitude, tr("Amplitude"), 100.0, QStringLiteral("%"));
+    waveTrack->setupParameter(1, 0.01, 2.0, _params.wavelength, tr("Wavelength"), 100.0, QStringLiteral("%"));
+    waveTrack->setupParameter(2, 0.0, 360.0, _params.phase, tr("Phase"), 1.0, QStringLiteral("\u00B0"));
+    waveTrack->setupParameter(3, 0.0, 360.0, _params.angle, tr("Angle"), 1.0, QStringLiteral("\u00B0"));
 
     auto* centerTrack = createAutomationTrack(QStringLiteral("Center"), 2, QColor(186, 85, 211));
-    centerTrack->setupParameter(0, -1.0, 1.0, _centerX, tr("Center X"), 100.0, QStringLiteral("%"));
-    centerTrack->setupParameter(1, -1.0, 1.0, _centerY, tr("Center Y"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(0, -1.0, 1.0, _params.centerX, tr("Center X"), 100.0, QStringLiteral("%"));
+    centerTrack->setupParameter(1, -1.0, 1.0, _params.centerY, tr("Center Y"), 100.0, QStringLiteral("%"));
 }
 
 void WaveTweak::setAmplitude(qreal a)
 {
     a = qBound(0.0, a, 2.0);
-    if (!qFuzzyCompare(_amplitude, a))
+    if (!qFuzzyCompare(_params.amplitude, a))
     {
-        _amplitude = a;
+        _params.amplitude = a;
         auto* track = automationTrack(QStringLiteral("Wave"));
         if (track) track->setInitialValue(0, a);
         emit amplitudeChanged();
@@ -47,9 +49,9 @@ void WaveTweak::setAmplitude(qreal a)
 void WaveTweak::setWavelength(qreal wl)
 {
     wl = qMax(0.01, wl);
-    if (!qFuzzyCompare(_wavelength, wl))
+    if (!qFuzzyCompare(_params.wavelength, wl))
     {
-        _wavelength = wl;
+        _params.wavelength = wl;
         auto* track = automationTrack(QStringLiteral("Wave"));
         if (track) track->setInitialValue(1, wl);
         emit wavelengthChanged();
@@ -62,9 +64,9 @@ void WaveTweak::setPhase(qreal p)
     // Normalize phase to 0-360
     while (p < 0.0) p += 360.0;
     while (p >= 360.0) p -= 360.0;
-    if (!qFuzzyCompare(_phase, p))
+    if (!qFuzzyCompare(_params.phase, p))
     {
-        _phase = p;
+        _params.phase = p;
         auto* track = automationTrack(QStringLiteral("Wave"));
         if (track) track->setInitialValue(2, p);
         emit phaseChanged();
@@ -77,9 +79,9 @@ void WaveTweak::setAngle(qreal a)
     // Normalize angle to 0-360
     while (a < 0.0) a += 360.0;
     while (a >= 360.0) a -= 360.0;
-    if (!qFuzzyCompare(_angle, a))
+    if (!qFuzzyCompare(_params.angle, a))
     {
-        _angle = a;
+        _params.angle = a;
         auto* track = automationTrack(QStringLiteral("Wave"));
         if (track) track->setInitialValue(3, a);
         emit angleChanged();
@@ -89,9 +91,9 @@ void WaveTweak::setAngle(qreal a)
 
 void WaveTweak::setRadial(bool r)
 {
-    if (_radial != r)
+    if (_params.radial != r)
     {
-        _radial = r;
+        _params.radial = r;
         emit radialChanged();
         emitPropertyChanged();
     }
@@ -99,9 +101,9 @@ void WaveTweak::setRadial(bool r)
 
 void WaveTweak::setCenterX(qreal cx)
 {
-    if (!qFuzzyCompare(_centerX, cx))
+    if (!qFuzzyCompare(_params.centerX, cx))
     {
-        _centerX = cx;
+        _params.centerX = cx;
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(0, cx);
         emit centerXChanged();
@@ -111,9 +113,9 @@ void WaveTweak::setCenterX(qreal cx)
 
 void WaveTweak::setCenterY(qreal cy)
 {
-    if (!qFuzzyCompare(_centerY, cy))
+    if (!qFuzzyCompare(_params.centerY, cy))
     {
-        _centerY = cy;
+        _params.centerY = cy;
         auto* track = automationTrack(QStringLiteral("Center"));
         if (track) track->setInitialValue(1, cy);
         emit centerYChanged();
@@ -143,28 +145,28 @@ void WaveTweak::setFollowGizmo(bool follow)
     }
 }
 
-QPointF WaveTweak::apply(qreal x, qreal y, qreal ratio,
-                         qreal gizmoX, qreal gizmoY) const
+QPointF WaveTweak::Params::apply(qreal x, qreal y, qreal ratio,
+                                 qreal gizmoX, qreal gizmoY) const
 {
-    if (qFuzzyIsNull(_amplitude) || qFuzzyIsNull(ratio) || qFuzzyIsNull(_wavelength))
+    if (qFuzzyIsNull(amplitude) || qFuzzyIsNull(ratio) || qFuzzyIsNull(wavelength))
     {
         return QPointF(x, y);
     }
 
     // Effective amplitude based on ratio
-    qreal effectiveAmplitude = _amplitude * ratio;
+    qreal effectiveAmplitude = amplitude * ratio;
 
     // Convert phase to radians
-    qreal phaseRad = qDegreesToRadians(_phase);
+    qreal phaseRad = qDegreesToRadians(phase);
 
     // Center = own automatable center + position cable offset (additive)
-    qreal cx = _centerX + gizmoX;
-    qreal cy = _centerY + gizmoY;
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
 
     qreal resultX = x;
     qreal resultY = y;
 
-    if (_radial)
+    if (radial)
     {
         // Radial mode: concentric waves from center
         qreal dx = x - cx;
@@ -174,27 +176,27 @@ QPointF WaveTweak::apply(qreal x, qreal y, qreal ratio,
         if (distance > 0.0001)
         {
             // Calculate wave value based on distance
-            qreal waveArg = (2.0 * M_PI * distance / _wavelength) + phaseRad;
+            qreal waveArg = (2.0 * M_PI * distance / wavelength) + phaseRad;
             qreal waveValue = qSin(waveArg);
 
             // Apply displacement along the radial direction
             qreal displacement = effectiveAmplitude * waveValue;
-            qreal angle = qAtan2(dy, dx);
+            qreal radialAngle = qAtan2(dy, dx);
 
-            resultX = x + displacement * qCos(angle);
-            resultY = y + displacement * qSin(angle);
+            resultX = x + displacement * qCos(radialAngle);
+            resultY = y + displacement * qSin(radialAngle);
         }
     }
     else
     {
         // Directional mode: parallel waves at specified angle
-        qreal angleRad = qDegreesToRadians(_angle);
+        qreal angleRad = qDegreesToRadians(angle);
 
         // Project position onto wave direction
         qreal projection = x * qCos(angleRad) + y * qSin(angleRad);
 
         // Calculate wave value based on projection
-        qreal waveArg = (2.0 * M_PI * projection / _wavelength) + phaseRad;
+        qreal waveArg = (2.0 * M_PI * projection / wavelength) + phaseRad;
         qreal waveValue = qSin(waveArg);
 
         // Apply displacement perpendicular to wave direction
@@ -208,16 +210,78 @@ QPointF WaveTweak::apply(qreal x, qreal y, qreal ratio,
     return QPointF(resultX, resultY);
 }
 
+void WaveTweak::Params::applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                                   qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const
+{
+    if (qFuzzyIsNull(amplitude) || qFuzzyIsNull(wavelength))
+    {
+        if (outXs != xs) std::copy(xs, xs + count, outXs);
+        if (outYs != ys) std::copy(ys, ys + count, outYs);
+        return;
+    }
+
+    qreal phaseRad = qDegreesToRadians(phase);
+    qreal cx = centerX + gizmoX;
+    qreal cy = centerY + gizmoY;
+
+    // Directional mode: wave and displacement directions are constant
+    qreal angleRad = qDegreesToRadians(angle);
+    qreal dirCos = qCos(angleRad);
+    qreal dirSin = qSin(angleRad);
+    qreal perpAngle = angleRad + M_PI / 2.0;
+    qreal perpCos = qCos(perpAngle);
+    qreal perpSin = qSin(perpAngle);
+
+    for (int i = 0; i < count; ++i)
+    {
+        qreal x = xs[i];
+        qreal y = ys[i];
+        qreal ratio = ratios ? ratios[i] : 1.0;
+
+        outXs[i] = x;
+        outYs[i] = y;
+        if (qFuzzyIsNull(ratio)) continue;
+
+        qreal effectiveAmplitude = amplitude * ratio;
+
+        if (radial)
+        {
+            qreal dx = x - cx;
+            qreal dy = y - cy;
+            qreal distance = qSqrt(dx * dx + dy * dy);
+
+            if (distance > 0.0001)
+            {
+                qreal waveArg = (2.0 * M_PI * distance / wavelength) + phaseRad;
+                qreal displacement = effectiveAmplitude * qSin(waveArg);
+                qreal radialAngle = qAtan2(dy, dx);
+
+                outXs[i] = x + displacement * qCos(radialAngle);
+                outYs[i] = y + displacement * qSin(radialAngle);
+            }
+        }
+        else
+        {
+            qreal projection = x * dirCos + y * dirSin;
+            qreal waveArg = (2.0 * M_PI * projection / wavelength) + phaseRad;
+            qreal displacement = effectiveAmplitude * qSin(waveArg);
+
+            outXs[i] = x + displacement * perpCos;
+            outYs[i] = y + displacement * perpSin;
+        }
+    }
+}
+
 QJsonObject WaveTweak::propertiesToJson() const
 {
     QJsonObject obj;
-    obj["amplitude"] = _amplitude;
-    obj["wavelength"] = _wavelength;
-    obj["phase"] = _phase;
-    obj["angle"] = _angle;
-    obj["radial"] = _radial;
-    obj["centerX"] = _centerX;
-    obj["centerY"] = _centerY;
+    obj["amplitude"] = _params.amplitude;
+    obj["wavelength"] = _params.wavelength;
+    obj["phase"] = _params.phase;
+    obj["angle"] = _params.angle;
+    obj["radial"] = _params.radial;
+    obj["centerX"] = _params.centerX;
+    obj["centerY"] = _params.centerY;
     obj["followGizmo"] = _followGizmo;
     return obj;
 }
@@ -234,24 +298,24 @@ void WaveTweak::propertiesFromJson(const QJsonObject& json)
     if (json.contains("followGizmo")) setFollowGizmo(json["followGizmo"].toBool());
 }
 
-void WaveTweak::syncToAnimatedValues(int timeMs)
+using WaveParams = WaveTweak::Params;
+
+// Automation tracks -> Params members
+static constexpr AutomationBinding<WaveParams> AUTOMATION_BINDINGS[] = {
+    {"Wave", {&WaveParams::amplitude, &WaveParams::wavelength, &WaveParams::phase, &WaveParams::angle}},
+    {"Center", {&WaveParams::centerX, &WaveParams::centerY}},
+};
+
+WaveTweak::Params WaveTweak::paramsAt(int timeMs) const
 {
-    // Only sync if automation is active for each track
-    auto* waveTrack = automationTrack(QStringLiteral("Wave"));
-    if (waveTrack && waveTrack->isAutomated())
-    {
-        _amplitude = waveTrack->timedValue(timeMs, 0);
-        _wavelength = waveTrack->timedValue(timeMs, 1);
-        _phase = waveTrack->timedValue(timeMs, 2);
-        _angle = waveTrack->timedValue(timeMs, 3);
-    }
+    Params animated = _params;
+    applyAutomation(AUTOMATION_BINDINGS, animated, timeMs);
+    return animated;
+}
 
-    auto* centerTrack = automationTrack(QStringLiteral("Center"));
-    if (centerTrack && centerTrack->isAutomated())
-    {
-        _centerX = centerTrack->timedValue(timeMs, 0);
-        _centerY = centerTrack->timedValue(timeMs, 1);
-    }
+void WaveTweak::syncToAnimatedValues(int timeMs)
+{
+    _params = paramsAt(timeMs);
 }
 
 } // namespace gizmotweak2
@@ -21,46 +21,71 @@ class WaveTweak : public Node
     Q_PROPERTY(bool followGizmo READ followGizmo WRITE setFollowGizmo NOTIFY followGizmoChanged)
 
 public:
+    // Wave parameters; apply() reads nothing else
+    struct Params
+    {
+        qreal amplitude{0.1};
+        qreal wavelength{0.5};
+        qreal phase{0.0};
+        qreal angle{0.0};
+        bool radial{true};
+        qreal centerX{0.0};
+        qreal centerY{0.0};
+
+        // Apply tweak to a point
+        QPointF apply(qreal x, qreal y, qreal ratio,
+                      qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+
+        // Wave displacement of count points; directions and phase are resolved once
+        // (nullptr ratios = 1.0, outputs may alias inputs)
+        void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                        qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const;
+    };
+
     explicit WaveTweak(QObject* parent = nullptr);
     ~WaveTweak() override = default;
 
     QString type() const override { return QStringLiteral("WaveTweak"); }
     Category category() const override { return Category::Tweak; }
+    Kind kind() const override { return Kind::WaveTweak; }
 
     // Amplitude - strength of wave displacement
-    qreal amplitude() const { return _amplitude; }
+    qreal amplitude() const { return _params.amplitude; }
     void setAmplitude(qreal a);
 
     // Wavelength - distance between wave peaks
-    qreal wavelength() const { return _wavelength; }
+    qreal wavelength() const { return _params.wavelength; }
     void setWavelength(qreal wl);
 
     // Phase - offset for animation (0-360 degrees)
-    qreal phase() const { return _phase; }
+    qreal phase() const { return _params.phase; }
     void setPhase(qreal p);
 
     // Angle - direction of directional waves (0-360 degrees)
-    qreal angle() const { return _angle; }
+    qreal angle() const { return _params.angle; }
     void setAngle(qreal a);
 
     // Radial mode - concentric waves vs directional waves
-    bool radial() const { return _radial; }
+    bool radial() const { return _params.radial; }
     void setRadial(bool r);
 
     // Center of transformation (for radial mode)
-    qreal centerX() const { return _centerX; }
+    qreal centerX() const { return _params.centerX; }
     void setCenterX(qreal cx);
 
-    qreal centerY() const { return _centerY; }
+    qreal centerY() const { return _params.centerY; }
     void setCenterY(qreal cy);
 
     // Follow Gizmo - use connected Gizmo center
     bool followGizmo() const { return _followGizmo; }
     void setFollowGizmo(bool follow);
 
-    // Apply tweak to a point
+    // Evaluate with the current parameters (see Params)
     Q_INVOKABLE QPointF apply(qreal x, qreal y, qreal ratio,
-                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const;
+                              qreal gizmoX = 0.0, qreal gizmoY = 0.0) const { return _params.apply(x, y, ratio, gizmoX, gizmoY); }
+
+    void applyBatch(const qreal* xs, const qreal* ys, const qreal* ratios, int count,
+                    qreal gizmoX, qreal gizmoY, qreal* outXs, qreal* outYs) const { _params.applyBatch(xs, ys, ratios, count, gizmoX, gizmoY, outXs, outYs); }
 
     // Serialization
     QJsonObject propertiesToJson() const override;
@@ -68,6 +93,10 @@ public:
 
     // Automation
     void syncToAnimatedValues(int timeMs) override;
+    // Parameters as plain data; paramsAt() resolves automation without touching the node
+    const Params& params() const { return _params; }
+    Params paramsAt(int timeMs) const;
+
 
 signals:
     void amplitudeChanged();
@@ -80,13 +109,7 @@ signals:
     void followGizmoChanged();
 
 private:
-    qreal _amplitude{0.1};
-    qreal _wavelength{0.5};
-    qreal _phase{0.0};
-    qreal _angle{0.0};
-    bool _radial{true};
-    qreal _centerX{0.0};
-    qreal _centerY{0.0};
+    Params _params;
     bool _followGizmo{true};
 };
 
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "core/NodeGraph.h"
+#include "core/Node.h"
+#include "core/Port.h"
+#include "nodes/GizmoNode.h"
+#include "nodes/RotationTweak.h"
+
+// Graphs shared by several test suites
+namespace testgraphs
+{
+
+// Input -> RotationTweak (45 degrees, followGizmo) -> Output, a Gizmo on the ratio.
+// Nodes in creation order: Input, Gizmo, RotationTweak, Output
+inline gizmotweak2::NodeGraph* createGizmoRotationGraph(QObject* parent)
+{
+    using namespace gizmotweak2;
+
+    auto* graph = new NodeGraph(parent);
+    auto* input = graph->createNode("Input", QPointF(100, 100));
+    auto* gizmo = qobject_cast<GizmoNode*>(graph->createNode("Gizmo", QPointF(100, 200)));
+    auto* rotation = qobject_cast<RotationTweak*>(graph->createNode("RotationTweak", QPointF(250, 100)));
+    auto* output = graph->createNode("Output", QPointF(400, 100));
+
+    gizmo->setHorizontalBorder(0.5);
+    gizmo->setVerticalBorder(0.5);
+    rotation->setAngle(45.0);
+    rotation->setFollowGizmo(true);
+
+    graph->connect(input->outputAt(0), rotation->inputAt(0));
+    graph->connect(gizmo->outputAt(0), rotation->inputAt(1));
+    graph->connect(rotation->outputAt(0), output->inputAt(0));
+    return graph;
+}
+
+} // namespace testgraphs
@@ -5,6 +5,7 @@
 
 #include "automation/KeyFrame.h"
 #include "automation/AutomationTrack.h"
+#include "automation/AutomationBake.h"
 
 using namespace gizmotweak2;
 
@@ -42,6 +43,21 @@ private slots:
     void testInterpolationBeforeFirstKeyframe();
     void testInterpolationAfterLastKeyframe();
 
+    // Keyframe lookup
+    void testDenseTrackLookupOrders();
+    void testLookupAfterEdits();
+    void testTimedValuesBatch();
+
+    // Flat keyframe storage
+    void testKeyFrameViewFollowsTrack();
+    void testKeyFrameViewFollowsMove();
+    void testTrackCopyIsIndependent();
+
+    // Baked playback
+    void testBakeMatchesTrackOnSamples();
+    void testBakeLimits();
+    void testBakedReadsFollowEdits();
+
 private:
     bool fuzzyCompare(double a, double b, double epsilon = 0.0001);
 };
@@ -443,5 +459,281 @@ void TestAutomation::testInterpolationAfterLastKeyframe()
     QVERIFY(fuzzyCompare(track.timedValue(10000, 0), 0.7));
 }
 
+// ============================================================================
+// Keyframe lookup
+// ============================================================================
+
+void TestAutomation::testDenseTrackLookupOrders()
+{
+    // Recorded automation: a keyframe every 10 ms, a ramp on [0, 1]
+    AutomationTrack track(1, "Track");
+    track.setupParameter(0, 0.0, 1.0, 0.0, "P1");
+    for (int t = 10; t <= 3000; t += 10)
+    {
+        track.createKeyFrame(t);
+        track.updateKeyFrameValue(t, 0, t / 3000.0);
+    }
+    QCOMPARE(track.keyFrameCount(), 300);
+
+    // Linear keyframes on a ramp: the value is the time, whatever the lookup order
+    for (int t = 0; t <= 3500; t += 7)
+    {
+        QVERIFY(fuzzyCompare(track.timedValue(t, 0), qMin(t, 3000) / 3000.0));
+    }
+    for (int t = 3500; t >= 0; t -= 13)
+    {
+        QVERIFY(fuzzyCompare(track.timedValue(t, 0), qMin(t, 3000) / 3000.0));
+    }
+    for (int i = 0; i < 500; ++i)
+    {
+        const int t = (i * 7919) % 3500;
+        QVERIFY(fuzzyCompare(track.timedValue(t, 0), qMin(t, 3000) / 3000.0));
+    }
+}
+
+void TestAutomation::testLookupAfterEdits()
+{
+    AutomationTrack track(1, "Track");
+    track.setupParameter(0, 0.0, 1.0, 0.0, "P1");
+    track.createKeyFrame(1000);
+    track.updateKeyFrameValue(1000, 0, 1.0);
+    track.createKeyFrame(2000);
+    track.updateKeyFrameValue(2000, 0, 0.0);
+
+    // Leave the cursor in the 1000-2000 segment, then change the keyframes
+    QVERIFY(fuzzyCompare(track.timedValue(1500, 0), 0.5));
+
+    track.moveKeyFrame(2000, 3000);
+    QVERIFY(fuzzyCompare(track.timedValue(2000, 0), 0.5));
+
+    track.deleteKeyFrame(1000);
+    QVERIFY(fuzzyCompare(track.timedValue(1500, 0), 0.0));
+
+    track.translateKeyFrames(-2000);
+    QVERIFY(fuzzyCompare(track.timedValue(1500, 0), 0.0));
+    QCOMPARE(track.keyFrameTimes(), QList<int>{1000});
+
+    track.setAutomated(true);
+    track.setAutomated(false);
+    QCOMPARE(track.keyFrameCount(), 0);
+    QVERIFY(fuzzyCompare(track.timedValue(1500, 0), 0.0));
+}
+
+void TestAutomation::testTimedValuesBatch()
+{
+    AutomationTrack track(3, "Track");
+    track.setupParameter(0, 0.0, 1.0, 0.1, "P1");
+    track.setupParameter(1, 0.0, 1.0, 0.2, "P2");
+    track.setupParameter(2, 0.0, 1.0, 0.3, "P3");
+    track.createKeyFrame(1000);
+    track.updateKeyFrameValue(1000, 0, 0.9);
+    track.updateKeyFrameValue(1000, 2, 0.5);
+    track.setKeyFrameCurveType(1000, QEasingCurve::InOutCubic);
+    track.createKeyFrame(2000);
+    track.updateKeyFrameValue(2000, 1, 0.8);
+
+    double values[3];
+    for (int t = -100; t <= 2500; t += 50)
+    {
+        track.timedValues(t, values);
+        for (int i = 0; i < 3; ++i)
+        {
+            QCOMPARE(values[i], track.timedValue(t, i));
+        }
+    }
+
+    // No keyframes: initial values
+    AutomationTrack empty(2, "Empty");
+    empty.setupParameter(0, 0.0, 1.0, 0.4, "P1");
+    empty.setupParameter(1, 0.0, 1.0, 0.6, "P2");
+    empty.timedValues(500, values);
+    QCOMPARE(values[0], 0.4);
+    QCOMPARE(values[1], 0.6);
+}
+
+// ============================================================================
+// Flat keyframe storage
+// ============================================================================
+
+void TestAutomation::testKeyFrameViewFollowsTrack()
+{
+    AutomationTrack track(2, "Track");
+    KeyFrame* kf = track.createKeyFrame(1000);
+    QVERIFY(kf->isView());
+    QCOMPARE(track.keyFrame(1000), kf);
+    QVERIFY(track.keyFrame(500) == nullptr);
+
+    // Edits through the view land in the track, and the other way around
+    kf->setValue(0, 0.7);
+    QCOMPARE(track.timedValue(1000, 0), 0.7);
+    track.updateKeyFrameValue(1000, 1, 0.3);
+    QCOMPARE(kf->value(1), 0.3);
+
+    QSignalSpy spy(&track, &AutomationTrack::keyFrameModified);
+    kf->setCurveType(QEasingCurve::OutQuad);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(track.keyFrameCurveType(1000), static_cast<int>(QEasingCurve::OutQuad));
+
+    // A copy is standalone and keeps the values
+    KeyFrame copy(*kf);
+    QVERIFY(!copy.isView());
+    track.updateKeyFrameValue(1000, 0, 0.1);
+    QCOMPARE(copy.value(0), 0.7);
+    QCOMPARE(copy.curveType(), QEasingCurve::OutQuad);
+}
+
+void TestAutomation::testKeyFrameViewFollowsMove()
+{
+    AutomationTrack track(1, "Track");
+    track.createKeyFrame(1000);
+    track.createKeyFrame(2000);
+    KeyFrame* kf = track.keyFrame(1000);
+    kf->setValue(0, 0.5);
+    kf->setCurveType(QEasingCurve::InQuad);
+
+    // Past the other keyframe: values, curve and view move together
+    track.moveKeyFrame(1000, 3000);
+    QVERIFY(!track.hasKeyFrameAt(1000));
+    QCOMPARE(track.keyFrameTimes(), QList<int>({2000, 3000}));
+    QCOMPARE(track.keyFrame(3000), kf);
+    QCOMPARE(kf->value(0), 0.5);
+    QCOMPARE(track.keyFrameCurveType(3000), static_cast<int>(QEasingCurve::InQuad));
+
+    // Translation too; a keyframe pushed before 0 is dropped
+    track.translateKeyFrames(-2500);
+    QCOMPARE(track.keyFrameTimes(), QList<int>({500}));
+    QCOMPARE(track.keyFrame(500), kf);
+    QCOMPARE(kf->value(0), 0.5);
+}
+
+void TestAutomation::testTrackCopyIsIndependent()
+{
+    AutomationTrack track(2, "Track");
+    track.createKeyFrame(0);
+    track.createKeyFrame(1000);
+    track.updateKeyFrameValue(1000, 0, 1.0);
+
+    AutomationTrack copy(track);
+    track.updateKeyFrameValue(1000, 0, 0.2);
+    track.deleteKeyFrame(0);
+
+    QCOMPARE(copy.keyFrameCount(), 2);
+    QCOMPARE(copy.timedValue(1000, 0), 1.0);
+    QCOMPARE(copy.timedValue(500, 0), 0.5);
+    QVERIFY(copy.keyFrame(1000) != track.keyFrame(1000));
+}
+
+// ============================================================================
+// Baked playback
+// ============================================================================
+
+void TestAutomation::testBakeMatchesTrackOnSamples()
+{
+    AutomationTrack track(2, "Track");
+    track.setupParameter(0, 0.0, 1.0, 0.2, "P1");
+    track.setupParameter(1, -1.0, 1.0, 0.0, "P2");
+    track.createKeyFrame(500);
+    track.updateKeyFrameValue(500, 0, 0.9);
+    track.setKeyFrameCurveType(500, QEasingCurve::InOutCubic);
+    track.createKeyFrame(1010);
+    track.updateKeyFrameValue(1010, 1, -0.5);
+    track.setKeyFrameCurveType(1010, QEasingCurve::OutBack);
+
+    // Samples up to the first one at or after the last keyframe
+    const AutomationBake bake(track, 40.0, 7);
+    QVERIFY(bake.isValid());
+    QCOMPARE(bake.revision(), quint64(7));
+    QCOMPARE(bake.sampleCount(), 27);
+    QCOMPARE(bake.memoryBytes(), qsizetype(27 * 2 * sizeof(float)));
+
+    double baked[2];
+    double exact[2];
+    for (int k = 0; k < bake.sampleCount(); ++k)
+    {
+        bake.valuesAt(k * 40, baked);
+        track.timedValues(k * 40, exact);
+        QVERIFY(qAbs(baked[0] - exact[0]) < 1e-6);
+        QVERIFY(qAbs(baked[1] - exact[1]) < 1e-6);
+        QCOMPARE(bake.valueAt(k * 40, 1), baked[1]);
+    }
+
+    // Between samples: a linear blend, close to the curve
+    bake.valuesAt(520, baked);
+    track.timedValues(520, exact);
+    QVERIFY(qAbs(baked[0] - exact[0]) < 0.01);
+
+    // Past the last keyframe: held
+    bake.valuesAt(5000, baked);
+    QVERIFY(qAbs(baked[0] - 0.9) < 1e-6);
+    QVERIFY(qAbs(baked[1] + 0.5) < 1e-6);
+
+    // A period that is not a whole number of ms (60 fps): reads find the rounded sample times
+    const AutomationBake fps60(track, 1000.0 / 60.0, 0);
+    QVERIFY(fps60.isValid());
+    QCOMPARE(fps60.sampleTime(1), 17);
+    QCOMPARE(fps60.sampleTime(2), 33);
+    for (int k = 0; k < fps60.sampleCount(); ++k)
+    {
+        const int timeMs = fps60.sampleTime(k);
+        fps60.valuesAt(timeMs, baked);
+        track.timedValues(timeMs, exact);
+        QVERIFY(qAbs(baked[0] - exact[0]) < 1e-6);
+        QVERIFY(qAbs(baked[1] - exact[1]) < 1e-6);
+    }
+}
+
+void TestAutomation::testBakeLimits()
+{
+    AutomationTrack track(1, "Track");
+    QVERIFY(!AutomationBake(track, 40.0, 0).isValid());
+
+    // Too many samples for the budget: the track stays exact
+    track.createKeyFrame(0);
+    track.createKeyFrame(10000000);
+    QVERIFY(AutomationBake(track, 40.0, 0).isValid());
+    QVERIFY(!AutomationBake(track, 1.0, 0).isValid());
+
+    // Sample times are whole milliseconds
+    QVERIFY(!AutomationBake(track, 0.5, 0).isValid());
+}
+
+void TestAutomation::testBakedReadsFollowEdits()
+{
+    AutomationTrack track(1, "Track");
+    track.setupParameter(0, 0.0, 1.0, 0.0, "P1");
+    track.setAutomated(true);
+    track.createKeyFrame(0);
+    track.createKeyFrame(1000);
+    track.updateKeyFrameValue(1000, 0, 1.0);
+    track.setKeyFrameCurveType(1000, QEasingCurve::InQuad);
+
+    QSignalSpy spy(&track, &AutomationTrack::bakeChanged);
+    track.setBakePeriodMs(100.0);
+    track.setBakedReads(true);
+    QTRY_VERIFY(track.isBaked());
+    QCOMPARE(track.bakedBytes(), 11 * int(sizeof(float)));
+    QVERIFY(spy.count() >= 1);
+
+    // Baked reads blend samples; exact reads follow the curve
+    const double baked = track.timedValue(150, 0);
+    track.setBakedReads(false);
+    const double exact = track.timedValue(150, 0);
+    QVERIFY(qAbs(baked - (0.01 + 0.04) / 2.0) < 1e-6);
+    QVERIFY(qAbs(exact - 0.0225) < 1e-3);
+    track.setBakedReads(true);
+
+    // An edit drops the samples at once, reads are exact until they are baked again
+    track.updateKeyFrameValue(1000, 0, 0.5);
+    QVERIFY(!track.isBaked());
+    QCOMPARE(track.bakedBytes(), 0);
+    QVERIFY(qAbs(track.timedValue(1000, 0) - 0.5) < 1e-9);
+    QTRY_VERIFY(track.isBaked());
+    QVERIFY(qAbs(track.timedValue(1000, 0) - 0.5) < 1e-6);
+
+    // No period: no samples
+    track.setBakePeriodMs(0.0);
+    QVERIFY(!track.isBaked());
+}
+
 QTEST_MAIN(TestAutomation)
 #include "tst_automation.moc"
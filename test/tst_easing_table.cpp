@@ -0,0 +1,78 @@
+#include <QtTest>
+
+#include "core/EasingTable.h"
+
+using namespace gizmotweak2;
+
+class TestEasingTable : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testWithinTolerance();
+    void testExactEnds();
+    void testClampsProgress();
+    void testUnknownTypesAreLinear();
+};
+
+void TestEasingTable::testWithinTolerance()
+{
+    for (int t = 0; t < QEasingCurve::NCurveTypes; ++t)
+    {
+        if (t == QEasingCurve::Custom) continue;
+
+        const auto type = static_cast<QEasingCurve::Type>(t);
+        const EasingTable& table = EasingTable::forType(type);
+        QCOMPARE(table.type(), type);
+
+        // Off the checked points too, whether tabulated or exact
+        QEasingCurve curve(type);
+        for (int i = 0; i <= 9973; ++i)
+        {
+            const qreal progress = i / 9973.0;
+            const qreal error = qAbs(table.valueForProgress(progress) - curve.valueForProgress(progress));
+            if (error > EasingTable::TOLERANCE)
+            {
+                QFAIL(qPrintable(QStringLiteral("type %1 at %2: error %3").arg(t).arg(progress).arg(error)));
+            }
+        }
+        if (table.isExact())
+        {
+            QVERIFY(table.maxError() > 0.0);
+        }
+    }
+
+    // Smooth curves are tabulated
+    QVERIFY(!EasingTable::forType(QEasingCurve::InOutQuad).isExact());
+    QVERIFY(!EasingTable::forType(QEasingCurve::OutCubic).isExact());
+}
+
+void TestEasingTable::testExactEnds()
+{
+    // Full effect stays exactly 1, none exactly 0
+    for (int t = 0; t < QEasingCurve::NCurveTypes; ++t)
+    {
+        const EasingTable& table = EasingTable::forType(t);
+        QEasingCurve curve(table.type());
+        QCOMPARE(table.valueForProgress(0.0), curve.valueForProgress(0.0));
+        QCOMPARE(table.valueForProgress(1.0), curve.valueForProgress(1.0));
+    }
+}
+
+void TestEasingTable::testClampsProgress()
+{
+    const EasingTable& table = EasingTable::forType(QEasingCurve::InQuad);
+    QCOMPARE(table.valueForProgress(-0.5), 0.0);
+    QCOMPARE(table.valueForProgress(1.5), 1.0);
+}
+
+void TestEasingTable::testUnknownTypesAreLinear()
+{
+    QCOMPARE(EasingTable::forType(-1).type(), QEasingCurve::Linear);
+    QCOMPARE(EasingTable::forType(QEasingCurve::Custom).type(), QEasingCurve::Linear);
+    QCOMPARE(EasingTable::forType(QEasingCurve::NCurveTypes).type(), QEasingCurve::Linear);
+    QCOMPARE(EasingTable::forType(QEasingCurve::Linear).valueForProgress(0.25), 0.25);
+}
+
+QTEST_MAIN(TestEasingTable)
+#include "tst_easing_table.moc"
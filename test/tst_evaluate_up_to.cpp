@@ -35,10 +35,18 @@ private slots:
     void testEvaluateUpToWithGizmoShape();
     void testEvaluateUpToDisconnectedTweak();
 
+    // Single tapped pass
+    void testTapPassSharedAcrossNodes();
+    void testTapPassRerunOnChange();
+    void testEvaluateTapsMatchesUpTo();
+
 private:
     bool fuzzyCompare(qreal a, qreal b, qreal epsilon = 0.0001);
 
     xengine::Frame* createTestFrame();
+
+    // Input -> PositionTweak(dx=0.5) -> ScaleTweak(2x) -> Output
+    NodeGraph* createChain();
 };
 
 bool TestEvaluateUpTo::fuzzyCompare(qreal a, qreal b, qreal epsilon)
@@ -54,6 +62,29 @@ xengine::Frame* TestEvaluateUpTo::createTestFrame()
     return frame;
 }
 
+NodeGraph* TestEvaluateUpTo::createChain()
+{
+    auto* graph = new NodeGraph(this);
+    auto* input = graph->createNode("Input", QPointF(100, 100));
+    auto* posNode = qobject_cast<PositionTweak*>(graph->createNode("PositionTweak", QPointF(200, 100)));
+    auto* scaleNode = qobject_cast<ScaleTweak*>(graph->createNode("ScaleTweak", QPointF(300, 100)));
+    auto* output = graph->createNode("Output", QPointF(400, 100));
+
+    posNode->setOffsetX(0.5);
+    posNode->setOffsetY(0.0);
+    posNode->setFollowGizmo(false);
+    scaleNode->setScaleX(2.0);
+    scaleNode->setScaleY(2.0);
+    scaleNode->setCenterX(0.0);
+    scaleNode->setCenterY(0.0);
+    scaleNode->setFollowGizmo(false);
+
+    graph->connect(input->outputAt(0), posNode->inputAt(0));
+    graph->connect(posNode->outputAt(0), scaleNode->inputAt(0));
+    graph->connect(scaleNode->outputAt(0), output->inputAt(0));
+    return graph;
+}
+
 // ============================================================================
 // Basic evaluateUpTo Tests
 // ============================================================================
@@ -411,5 +442,107 @@ void TestEvaluateUpTo::testEvaluateUpToDisconnectedTweak()
     QVERIFY(result == nullptr);
 }
 
+// ============================================================================
+// Single tapped pass
+// ============================================================================
+
+void TestEvaluateUpTo::testTapPassSharedAcrossNodes()
+{
+    auto* graph = createChain();
+    auto* inputFrame = createTestFrame();
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    // Every preview of the same tick comes from one pass
+    auto* atInput = evaluator.evaluateUpTo(inputFrame, graph->nodeAt(0), 0.5);
+    auto* atPosition = evaluator.evaluateUpTo(inputFrame, graph->nodeAt(1), 0.5);
+    auto* atScale = evaluator.evaluateUpTo(inputFrame, graph->nodeAt(2), 0.5);
+    QVERIFY(atInput && atPosition && atScale);
+    QCOMPARE(evaluator.tapPassCount(), 1);
+
+    QVERIFY(fuzzyCompare(atInput->at(0).getX(), 0.1));
+    QVERIFY(fuzzyCompare(atPosition->at(0).getX(), 0.6));
+    QVERIFY(fuzzyCompare(atScale->at(0).getX(), 1.2));
+    QVERIFY(fuzzyCompare(atScale->at(1).getY(), 0.8));
+
+    // Next tick: a new pass
+    delete evaluator.evaluateUpTo(inputFrame, graph->nodeAt(1), 0.54);
+    QCOMPARE(evaluator.tapPassCount(), 2);
+
+    delete atInput;
+    delete atPosition;
+    delete atScale;
+    delete inputFrame;
+}
+
+void TestEvaluateUpTo::testTapPassRerunOnChange()
+{
+    auto* graph = createChain();
+    auto* inputFrame = createTestFrame();
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    delete evaluator.evaluateUpTo(inputFrame, graph->nodeAt(2), 0.0);
+    QCOMPARE(evaluator.tapPassCount(), 1);
+
+    // Parameter edit
+    qobject_cast<ScaleTweak*>(graph->nodeAt(2))->setScaleX(3.0);
+    auto* result = evaluator.evaluateUpTo(inputFrame, graph->nodeAt(2), 0.0);
+    QCOMPARE(evaluator.tapPassCount(), 2);
+    QVERIFY(fuzzyCompare(result->at(0).getX(), 1.8));
+    delete result;
+
+    // Different input points at the same time
+    inputFrame->addSample(0.5, 0.5, 0.0, 1.0, 1.0, 1.0, 1);
+    result = evaluator.evaluateUpTo(inputFrame, graph->nodeAt(2), 0.0);
+    QCOMPARE(evaluator.tapPassCount(), 3);
+    QCOMPARE(result->size(), 3);
+    delete result;
+
+    delete inputFrame;
+}
+
+void TestEvaluateUpTo::testEvaluateTapsMatchesUpTo()
+{
+    auto* graph = createChain();
+    auto* inputFrame = createTestFrame();
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    auto* stray = graph->createNode("RotationTweak", QPointF(0, 300));
+    const QList<Node*> taps{graph->nodeAt(2), graph->nodeAt(1), stray};
+    QList<xengine::Frame> tapFrames;
+    xengine::Frame output;
+    QVERIFY(evaluator.evaluateTaps(*inputFrame, taps, tapFrames, output, 0.0));
+    QCOMPARE(tapFrames.size(), 3);
+
+    // Taps in any order; a node off the frame path gets an empty frame
+    GraphEvaluator reference;
+    reference.setGraph(graph);
+    for (int i = 0; i < 2; ++i)
+    {
+        auto* expected = reference.evaluateUpTo(inputFrame, taps[i], 0.0);
+        QCOMPARE(tapFrames[i].size(), expected->size());
+        for (int j = 0; j < expected->size(); ++j)
+        {
+            QVERIFY(tapFrames[i].at(j).getX() == expected->at(j).getX());
+            QVERIFY(tapFrames[i].at(j).getY() == expected->at(j).getY());
+        }
+        delete expected;
+    }
+    QCOMPARE(tapFrames[2].size(), 0);
+
+    // And the full output of the same pass
+    xengine::Frame full;
+    QVERIFY(reference.evaluateInto(*inputFrame, full, 0.0));
+    QCOMPARE(output.size(), full.size());
+    QVERIFY(output.at(0).getX() == full.at(0).getX());
+
+    delete inputFrame;
+}
+
 QTEST_MAIN(TestEvaluateUpTo)
 #include "tst_evaluate_up_to.moc"
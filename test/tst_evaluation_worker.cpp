@@ -0,0 +1,163 @@
+#include <QtTest>
+
+#include "core/EvaluationWorker.h"
+#include "core/TripleBuffer.h"
+#include "core/NodeGraph.h"
+
+#include <frame.h>
+
+#include "TestGraphs.h"
+
+using namespace gizmotweak2;
+
+class TestEvaluationWorker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Triple buffer
+    void testTripleBufferStartsEmpty();
+    void testTripleBufferKeepsNewest();
+    void testTripleBufferFrontStable();
+
+    // Worker
+    void testNoGraph();
+    void testResultMatchesSynchronous();
+    void testRequestsCoalesce();
+
+private:
+    void fillInput(xengine::Frame& frame, int count);
+
+    // Wait until the worker has published the result of request sequence
+    bool waitForSequence(EvaluationWorker& worker, quint64 sequence);
+};
+
+void TestEvaluationWorker::fillInput(xengine::Frame& frame, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        frame.addSample(i * 2.0 / count - 1.0, 0.2, 0.0, 1.0, 1.0, 1.0, 1);
+    }
+}
+
+bool TestEvaluationWorker::waitForSequence(EvaluationWorker& worker, quint64 sequence)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < 5000)
+    {
+        worker.acquireLatest();
+        if (worker.latest().sequence == sequence) return true;
+        QTest::qWait(5);
+    }
+    return false;
+}
+
+// ============================================================================
+// Triple buffer
+// ============================================================================
+
+void TestEvaluationWorker::testTripleBufferStartsEmpty()
+{
+    TripleBuffer<int> buffer;
+    QVERIFY(!buffer.acquire());
+}
+
+void TestEvaluationWorker::testTripleBufferKeepsNewest()
+{
+    TripleBuffer<int> buffer;
+
+    // Consumer skips values it did not get to
+    for (int value = 1; value <= 3; ++value)
+    {
+        buffer.back() = value;
+        buffer.publish();
+    }
+    QVERIFY(buffer.acquire());
+    QCOMPARE(buffer.front(), 3);
+    QVERIFY(!buffer.acquire());
+}
+
+void TestEvaluationWorker::testTripleBufferFrontStable()
+{
+    TripleBuffer<int> buffer;
+    buffer.back() = 1;
+    buffer.publish();
+    QVERIFY(buffer.acquire());
+
+    // Publishing never writes into the slot being read
+    buffer.back() = 2;
+    buffer.publish();
+    buffer.back() = 3;
+    QCOMPARE(buffer.front(), 1);
+
+    QVERIFY(buffer.acquire());
+    QCOMPARE(buffer.front(), 2);
+}
+
+// ============================================================================
+// Worker
+// ============================================================================
+
+void TestEvaluationWorker::testNoGraph()
+{
+    EvaluationWorker worker;
+    xengine::Frame input;
+    fillInput(input, 4);
+    QCOMPARE(worker.request(nullptr, input, 0.0), quint64(0));
+    QCOMPARE(worker.requestCount(), quint64(0));
+}
+
+void TestEvaluationWorker::testResultMatchesSynchronous()
+{
+    auto* graph = testgraphs::createGizmoRotationGraph(this);
+    xengine::Frame input;
+    fillInput(input, 500);
+
+    xengine::Frame expected;
+    QVERIFY(graph->evaluateInto(input, expected, 0.5));
+
+    EvaluationWorker worker;
+    QSignalSpy spy(&worker, &EvaluationWorker::resultReady);
+    const quint64 sequence = worker.request(graph, input, 0.5);
+    QVERIFY(sequence > 0);
+    QVERIFY(waitForSequence(worker, sequence));
+    QVERIFY(spy.count() >= 1);
+
+    const auto& result = worker.latest();
+    QCOMPARE(result.time, 0.5);
+    QCOMPARE(result.frame.size(), expected.size());
+    for (int i = 0; i < expected.size(); ++i)
+    {
+        QVERIFY(result.frame.at(i).getX() == expected.at(i).getX());
+        QVERIFY(result.frame.at(i).getY() == expected.at(i).getY());
+    }
+}
+
+void TestEvaluationWorker::testRequestsCoalesce()
+{
+    auto* graph = testgraphs::createGizmoRotationGraph(this);
+    xengine::Frame input;
+    fillInput(input, 20000);
+
+    EvaluationWorker worker;
+    quint64 last = 0;
+    for (int i = 0; i < 50; ++i)
+    {
+        last = worker.request(graph, input, i * 0.04);
+    }
+
+    // The newest request is always computed; older unstarted ones may be dropped
+    QVERIFY(waitForSequence(worker, last));
+    QCOMPARE(worker.requestCount(), quint64(50));
+    QVERIFY(worker.computedCount() <= worker.requestCount());
+    QCOMPARE(worker.latest().time, 49 * 0.04);
+
+    xengine::Frame expected;
+    QVERIFY(graph->evaluateInto(input, expected, 49 * 0.04));
+    QCOMPARE(worker.latest().frame.size(), expected.size());
+    QVERIFY(worker.latest().frame.at(100).getX() == expected.at(100).getX());
+}
+
+QTEST_MAIN(TestEvaluationWorker)
+#include "tst_evaluation_worker.moc"
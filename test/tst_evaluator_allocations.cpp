@@ -0,0 +1,248 @@
+#include <QtTest>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "core/GraphEvaluator.h"
+#include "core/NodeGraph.h"
+#include "core/Node.h"
+#include "core/Port.h"
+#include "nodes/GizmoNode.h"
+#include "nodes/GroupNode.h"
+#include "nodes/PositionTweak.h"
+#include "nodes/ScaleTweak.h"
+
+#include <frame.h>
+
+// ============================================================================
+// Allocation counting
+// Global operator new is replaced for this test binary only. Counting is off
+// by default and enabled around the measured section. Qt containers allocate
+// through malloc and are not seen here; the evaluator's own scratch storage is
+// checked separately through GraphEvaluator::scratchAllocationCount().
+// ============================================================================
+
+static std::atomic<bool> s_countAllocations{false};
+static std::atomic<int> s_allocationCount{0};
+
+void* operator new(std::size_t size)
+{
+    if (s_countAllocations.load(std::memory_order_relaxed))
+    {
+        s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+using namespace gizmotweak2;
+
+class TestEvaluatorAllocations : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEvaluateIntoMatchesEvaluate();
+    void testEvaluateIntoNoGraph();
+    void testSteadyStateDoesNotAllocate();
+    void testEvaluateToPointsReusesBuffers();
+
+private:
+    // Input -> PositionTweak -> ScaleTweak -> Output, ScaleTweak ratio from Transform(Gizmo, Gizmo)
+    void buildGraph(NodeGraph& graph);
+
+    void fillFrame(xengine::Frame& frame, int count);
+
+    // Count operator new calls made by fn
+    template<typename Fn>
+    int countAllocations(Fn fn)
+    {
+        s_allocationCount = 0;
+        s_countAllocations = true;
+        fn();
+        s_countAllocations = false;
+        return s_allocationCount;
+    }
+};
+
+void TestEvaluatorAllocations::buildGraph(NodeGraph& graph)
+{
+    auto* input = graph.createNode("Input", QPointF(100, 100));
+    auto* posTweak = qobject_cast<PositionTweak*>(graph.createNode("PositionTweak", QPointF(250, 100)));
+    auto* scaleTweak = qobject_cast<ScaleTweak*>(graph.createNode("ScaleTweak", QPointF(400, 100)));
+    auto* gizmo1 = qobject_cast<GizmoNode*>(graph.createNode("Gizmo", QPointF(100, 200)));
+    auto* gizmo2 = qobject_cast<GizmoNode*>(graph.createNode("Gizmo", QPointF(100, 300)));
+    auto* group = qobject_cast<GroupNode*>(graph.createNode("Transform", QPointF(250, 250)));
+    auto* output = graph.createNode("Output", QPointF(550, 100));
+
+    posTweak->setOffsetX(0.1);
+    posTweak->setFollowGizmo(false);
+
+    scaleTweak->setScaleX(1.5);
+    scaleTweak->setScaleY(0.5);
+    scaleTweak->setFollowGizmo(true);
+
+    gizmo1->setCenterX(-0.3);
+    gizmo1->setHorizontalBorder(0.4);
+    gizmo1->setVerticalBorder(0.4);
+    gizmo2->setCenterX(0.3);
+    gizmo2->setHorizontalBorder(0.4);
+    gizmo2->setVerticalBorder(0.4);
+    group->setCompositionMode(GroupNode::CompositionMode::Max);
+
+    graph.connect(gizmo1->outputAt(0), group->inputAt(0));
+    graph.connect(gizmo2->outputAt(0), group->inputAt(1));
+
+    graph.connect(input->outputAt(0), posTweak->inputAt(0));
+    graph.connect(posTweak->outputAt(0), scaleTweak->inputAt(0));
+    graph.connect(group->outputAt(0), scaleTweak->inputAt(1));
+    graph.connect(scaleTweak->outputAt(0), output->inputAt(0));
+}
+
+void TestEvaluatorAllocations::fillFrame(xengine::Frame& frame, int count)
+{
+    frame.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        qreal t = count > 1 ? static_cast<qreal>(i) / (count - 1) : 0.0;
+        frame.addSample(-1.0 + 2.0 * t, 0.5 * t, 0.0, 1.0, t, 0.0, 1);
+    }
+}
+
+void TestEvaluatorAllocations::testEvaluateIntoMatchesEvaluate()
+{
+    NodeGraph graph;
+    buildGraph(graph);
+
+    xengine::Frame input;
+    fillFrame(input, 64);
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(&graph);
+
+    auto* expected = evaluator.evaluate(&input, 0.5);
+    QVERIFY(expected != nullptr);
+
+    xengine::Frame output;
+    QVERIFY(evaluator.evaluateInto(input, output, 0.5));
+    QCOMPARE(output.size(), expected->size());
+    for (int i = 0; i < output.size(); ++i)
+    {
+        QCOMPARE(output.at(i).getX(), expected->at(i).getX());
+        QCOMPARE(output.at(i).getY(), expected->at(i).getY());
+        QCOMPARE(output.at(i).getR(), expected->at(i).getR());
+        QCOMPARE(output.at(i).getG(), expected->at(i).getG());
+    }
+
+    delete expected;
+}
+
+void TestEvaluatorAllocations::testEvaluateIntoNoGraph()
+{
+    GraphEvaluator evaluator;
+
+    xengine::Frame input;
+    fillFrame(input, 4);
+
+    xengine::Frame output;
+    output.addSample(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1);
+
+    QVERIFY(!evaluator.evaluateInto(input, output, 0.0));
+    QCOMPARE(output.size(), 0);
+}
+
+void TestEvaluatorAllocations::testSteadyStateDoesNotAllocate()
+{
+    NodeGraph graph;
+    buildGraph(graph);
+
+    xengine::Frame input;
+    fillFrame(input, 500);
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(&graph);
+
+    // Warm-up: compile the plan and size every buffer
+    xengine::Frame output;
+    QVERIFY(evaluator.evaluateInto(input, output, 0.0));
+    QCOMPARE(output.size(), 500);
+
+    const int scratchAfterWarmUp = evaluator.scratchAllocationCount();
+    QVERIFY(scratchAfterWarmUp > 0);
+
+    // Sustained output: 25 frames at 40 ms
+    int allocations = countAllocations([&]() {
+        for (int frame = 1; frame <= 25; ++frame)
+        {
+            evaluator.evaluateInto(input, output, frame * 0.04);
+        }
+    });
+
+    QCOMPARE(allocations, 0);
+    QCOMPARE(evaluator.scratchAllocationCount(), scratchAfterWarmUp);
+
+    // Smaller patterns reuse the same storage
+    xengine::Frame smaller;
+    fillFrame(smaller, 100);
+    evaluator.evaluateInto(smaller, output, 1.0);
+    QCOMPARE(output.size(), 100);
+    QCOMPARE(evaluator.scratchAllocationCount(), scratchAfterWarmUp);
+}
+
+void TestEvaluatorAllocations::testEvaluateToPointsReusesBuffers()
+{
+    NodeGraph graph;
+    buildGraph(graph);
+
+    QVariantList points;
+    for (int i = 0; i < 32; ++i)
+    {
+        QVariantMap point;
+        point[QStringLiteral("x")] = -0.5 + i / 32.0;
+        point[QStringLiteral("y")] = 0.0;
+        points.append(point);
+    }
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(&graph);
+
+    auto first = evaluator.evaluateToPoints(points, 0.0);
+    QCOMPARE(first.size(), 32);
+    const int scratchAfterWarmUp = evaluator.scratchAllocationCount();
+
+    auto second = evaluator.evaluateToPoints(points, 0.04);
+    QCOMPARE(second.size(), 32);
+    QCOMPARE(evaluator.scratchAllocationCount(), scratchAfterWarmUp);
+}
+
+QTEST_MAIN(TestEvaluatorAllocations)
+#include "tst_evaluator_allocations.moc"
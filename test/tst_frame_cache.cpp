@@ -0,0 +1,403 @@
+#include <QtTest>
+
+#include "core/FrameCache.h"
+#include "core/GraphEvaluator.h"
+#include "core/EvaluationWorker.h"
+#include "core/NodeGraph.h"
+#include "core/Node.h"
+#include "core/Port.h"
+#include "nodes/InputNode.h"
+#include "nodes/GizmoNode.h"
+#include "nodes/RotationTweak.h"
+#include "nodes/GroupNode.h"
+#include "automation/AutomationTrack.h"
+#include "nodes/FuzzynessTweak.h"
+
+#include <frame.h>
+
+#include "TestGraphs.h"
+
+using namespace gizmotweak2;
+
+class TestFrameCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // FrameCache
+    void testFindMiss();
+    void testInsertFind();
+    void testLruEviction();
+    void testOversizedFrameSkipped();
+    void testZeroBudgetDisables();
+
+    // GraphEvaluator
+    void testDisabledByDefault();
+    void testHitMatchesComputed();
+    void testTimeQuantized();
+    void testPropertyChangeMisses();
+    void testAutomatedTransformHits();
+    void testForeignInputNotCached();
+    void testUnseededNoiseNotCached();
+    void testWorkerSharesCache();
+
+private:
+    InputNode* inputOf(NodeGraph* graph);
+    void fillPoints(PointBuffer& points, int count, qreal value);
+    FrameCache::Key key(qint64 slot);
+};
+
+InputNode* TestFrameCache::inputOf(NodeGraph* graph)
+{
+    for (int i = 0; i < graph->rowCount(); ++i)
+    {
+        if (auto* input = qobject_cast<InputNode*>(graph->nodeAt(i)))
+        {
+            return input;
+        }
+    }
+    return nullptr;
+}
+
+void TestFrameCache::fillPoints(PointBuffer& points, int count, qreal value)
+{
+    points.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        points.append(value, value, 1.0, 1.0, 1.0, 1);
+    }
+}
+
+FrameCache::Key TestFrameCache::key(qint64 slot)
+{
+    FrameCache::Key result;
+    result.revision = 1;
+    result.pattern = 42;
+    result.timeSlot = slot;
+    return result;
+}
+
+// ============================================================================
+// FrameCache
+// ============================================================================
+
+void TestFrameCache::testFindMiss()
+{
+    FrameCache cache;
+    cache.setBudgetBytes(1024 * 1024);
+
+    PointBuffer out;
+    QVERIFY(!cache.find(key(0), out));
+    QCOMPARE(cache.stats().misses, quint64(1));
+    QCOMPARE(cache.stats().hits, quint64(0));
+}
+
+void TestFrameCache::testInsertFind()
+{
+    FrameCache cache;
+    cache.setBudgetBytes(1024 * 1024);
+
+    PointBuffer points;
+    fillPoints(points, 10, 0.25);
+    cache.insert(key(3), points);
+
+    PointBuffer out;
+    QVERIFY(cache.find(key(3), out));
+    QCOMPARE(out.size(), 10);
+    QCOMPARE(out.xs()[9], 0.25);
+    QCOMPARE(cache.stats().hits, quint64(1));
+    QCOMPARE(cache.stats().entries, 1);
+    QCOMPARE(cache.stats().bytes, FrameCache::bytesFor(points));
+}
+
+void TestFrameCache::testLruEviction()
+{
+    PointBuffer points;
+    fillPoints(points, 100, 0.5);
+
+    // Room for exactly two frames
+    FrameCache cache;
+    cache.setBudgetBytes(2 * FrameCache::bytesFor(points));
+    cache.insert(key(0), points);
+    cache.insert(key(1), points);
+
+    // Touch 0: 1 becomes the least recently used and goes first
+    PointBuffer out;
+    QVERIFY(cache.find(key(0), out));
+    cache.insert(key(2), points);
+
+    QVERIFY(cache.find(key(0), out));
+    QVERIFY(!cache.find(key(1), out));
+    QVERIFY(cache.find(key(2), out));
+    QCOMPARE(cache.stats().evictions, quint64(1));
+    QVERIFY(cache.stats().bytes <= cache.stats().budgetBytes);
+}
+
+void TestFrameCache::testOversizedFrameSkipped()
+{
+    PointBuffer points;
+    fillPoints(points, 100, 0.5);
+
+    FrameCache cache;
+    cache.setBudgetBytes(FrameCache::bytesFor(points) - 1);
+    cache.insert(key(0), points);
+
+    QCOMPARE(cache.stats().entries, 0);
+    QCOMPARE(cache.stats().bytes, qint64(0));
+}
+
+void TestFrameCache::testZeroBudgetDisables()
+{
+    PointBuffer points;
+    fillPoints(points, 10, 0.5);
+
+    FrameCache cache;
+    cache.setBudgetBytes(1024 * 1024);
+    cache.insert(key(0), points);
+    QVERIFY(cache.isEnabled());
+
+    cache.setBudgetBytes(0);
+    QVERIFY(!cache.isEnabled());
+    QCOMPARE(cache.stats().entries, 0);
+
+    cache.insert(key(1), points);
+    QCOMPARE(cache.stats().entries, 0);
+}
+
+// ============================================================================
+// GraphEvaluator
+// ============================================================================
+
+void TestFrameCache::testDisabledByDefault()
+{
+    auto* graph = testgraphs::createGizmoRotationGraph(this);
+    auto* evaluator = graph->evaluator();
+    auto* input = inputOf(graph)->currentFrame();
+    QVERIFY(input);
+
+    // No quantization either: times are used as given
+    qreal time = 0.123;
+    FrameCache::Key cacheKey;
+    QVERIFY(!evaluator->frameCacheKey(*input, time, cacheKey));
+    QCOMPARE(time, 0.123);
+
+    xengine::Frame output;
+    QVERIFY(graph->evaluateInto(*input, output, 0.5));
+    QVERIFY(graph->evaluateInto(*input, output, 0.5));
+    QCOMPARE(evaluator->frameCache()->stats().hits, quint64(0));
+    QCOMPARE(evaluator->frameCache()->stats().misses, quint64(0));
+}
+
+void TestFrameCache::testHitMatchesComputed()
+{
+    auto* graph = testgraphs::createGizmoRotationGraph(this);
+    auto* evaluator = graph->evaluator();
+    evaluator->setFrameCacheBudget(16 * 1024 * 1024);
+    auto* input = inputOf(graph)->currentFrame();
+    QVERIFY(input && input->size() > 0);
+
+    xengine::Frame computed;
+    QVERIFY(graph->evaluateInto(*input, computed, 0.48));
+    QCOMPARE(evaluator->frameCache()->stats().misses, quint64(1));
+
+    xengine::Frame cached;
+    QVERIFY(graph->evaluateInto(*input, cached, 0.48));
+    QCOMPARE(evaluator->frameCache()->stats().hits, quint64(1));
+
+    QCOMPARE(cached.size(), computed.size());
+    for (int i = 0; i < computed.size(); ++i)
+    {
+        QVERIFY(cached.at(i).getX() == computed.at(i).getX());
+        QVERIFY(cached.at(i).getY() == computed.at(i).getY());
+    }
+
+    const auto stats = evaluator->frameCacheStats();
+    QCOMPARE(stats.value(QStringLiteral("hitRate")).toReal(), 0.5);
+    QCOMPARE(stats.value(QStringLiteral("entries")).toInt(), 1);
+}
+
+void TestFrameCache::testTimeQuantized()
+{
+    auto* graph = testgraphs::createGizmoRotationGraph(this);
+    auto* evaluator = graph->evaluator();
+    evaluator->setFrameCacheBudget(16 * 1024 * 1024);
+    evaluator->setFramePeriodMs(40.0);
+    auto* input = inputOf(graph)->currentFrame();
+
+    // 1.005 s and 0.990 s both snap to slot 25 (1.0 s)
+    qreal time = 1.005;
+    FrameCache::Key first;
+    QVERIFY(evaluator->frameCacheKey(*input, time, first));
+    QCOMPARE(first.timeSlot, qint64(25));
+    QCOMPARE(time, 1.0);
+
+    time = 0.990;
+    FrameCache::Key second;
+    QVERIFY(evaluator->frameCacheKey(*input, time, second));
+    QVERIFY(first == second);
+
+    // The cached frame is the one of the snapped time
+    xengine::Frame exact;
+    evaluator->setFrameCacheBudget(0);
+    QVERIFY(graph->evaluateInto(*input, exact, 1.0));
+    evaluator->setFrameCacheBudget(16 * 1024 * 1024);
+
+    xengine::Frame snapped;
+    QVERIFY(graph->evaluateInto(*input, snapped, 1.005));
+    QVERIFY(graph->evaluateInto(*input, snapped, 0.990));
+    QCOMPARE(evaluator->frameCache()->stats().hits, quint64(1));
+    QCOMPARE(snapped.size(), exact.size());
+    QVERIFY(snapped.at(0).getX() == exact.at(0).getX());
+}
+
+void TestFrameCache::testPropertyChangeMisses()
+{
+    auto* graph = testgraphs::createGizmoRotationGraph(this);
+    auto* evaluator = graph->evaluator();
+    evaluator->setFrameCacheBudget(16 * 1024 * 1024);
+    auto* input = inputOf(graph)->currentFrame();
+
+    xengine::Frame output;
+    QVERIFY(graph->evaluateInto(*input, output, 0.0));
+    const quint64 revision = evaluator->revision();
+
+    // A parameter edit makes every cached frame stale
+    auto* rotation = qobject_cast<RotationTweak*>(graph->nodeAt(2));
+    QVERIFY(rotation);
+    rotation->setAngle(90.0);
+    QVERIFY(evaluator->revision() > revision);
+
+    QVERIFY(graph->evaluateInto(*input, output, 0.0));
+    QCOMPARE(evaluator->frameCache()->stats().hits, quint64(0));
+    QCOMPARE(evaluator->frameCache()->stats().misses, quint64(2));
+
+    // Topology changes too
+    const quint64 beforeNode = evaluator->revision();
+    graph->createNode("Gizmo", QPointF(0, 0));
+    QVERIFY(evaluator->revision() > beforeNode);
+}
+
+void TestFrameCache::testAutomatedTransformHits()
+{
+    // Gizmo -> automated Transform on the rotation ratio
+    auto* graph = testgraphs::createGizmoRotationGraph(this);
+    auto* rotation = qobject_cast<RotationTweak*>(graph->nodeAt(2));
+    auto* group = qobject_cast<GroupNode*>(graph->createNode("Transform", QPointF(250, 200)));
+    QVERIFY(rotation && group);
+    graph->disconnectPort(rotation->inputAt(1));
+    graph->connect(graph->nodeAt(1)->outputAt(0), group->inputAt(0));
+    graph->connect(group->outputAt(0), rotation->inputAt(1));
+
+    auto* track = group->automationTrack(QStringLiteral("Position"));
+    track->setAutomated(true);
+    track->createKeyFrame(0);
+    track->createKeyFrame(1000);
+    track->updateKeyFrameValue(1000, 0, 0.5);
+
+    auto* evaluator = graph->evaluator();
+    evaluator->setFrameCacheBudget(16 * 1024 * 1024);
+    auto* input = inputOf(graph)->currentFrame();
+
+    // Following playback in the panel is not an edit: the frame stays cached
+    xengine::Frame output;
+    QVERIFY(graph->evaluateInto(*input, output, 0.4));
+    const quint64 revision = evaluator->revision();
+    QVERIFY(group->positionX() > 0.0);
+    QVERIFY(graph->evaluateInto(*input, output, 0.4));
+    QCOMPARE(evaluator->revision(), revision);
+    QCOMPARE(evaluator->frameCache()->stats().hits, quint64(1));
+}
+
+void TestFrameCache::testForeignInputNotCached()
+{
+    auto* graph = testgraphs::createGizmoRotationGraph(this);
+    auto* evaluator = graph->evaluator();
+    evaluator->setFrameCacheBudget(16 * 1024 * 1024);
+
+    // A frame that is not the InputNode pattern has no identity to key on
+    xengine::Frame input;
+    input.addSample(0.1, 0.2, 0.0, 1.0, 1.0, 1.0, 1);
+
+    qreal time = 0.123;
+    FrameCache::Key cacheKey;
+    QVERIFY(!evaluator->frameCacheKey(input, time, cacheKey));
+
+    xengine::Frame output;
+    QVERIFY(graph->evaluateInto(input, output, 0.123));
+    QVERIFY(graph->evaluateInto(input, output, 0.123));
+    QCOMPARE(evaluator->frameCache()->stats().hits + evaluator->frameCache()->stats().misses, quint64(0));
+}
+
+void TestFrameCache::testUnseededNoiseNotCached()
+{
+    auto* graph = new NodeGraph(this);
+    auto* inputNode = graph->createNode("Input", QPointF(100, 100));
+    auto* fuzz = qobject_cast<FuzzynessTweak*>(graph->createNode("FuzzynessTweak", QPointF(250, 100)));
+    auto* outputNode = graph->createNode("Output", QPointF(400, 100));
+    fuzz->setAmount(0.1);
+    fuzz->setFollowGizmo(false);
+    graph->connect(inputNode->outputAt(0), fuzz->inputAt(0));
+    graph->connect(fuzz->outputAt(0), outputNode->inputAt(0));
+
+    auto* evaluator = graph->evaluator();
+    evaluator->setFrameCacheBudget(16 * 1024 * 1024);
+    auto* input = inputOf(graph)->currentFrame();
+    QVERIFY(input && input->size() > 0);
+
+    // Every pass draws new jitter, even at the same time
+    EvaluationSnapshot snapshot;
+    QVERIFY(evaluator->captureSnapshot(snapshot, 0.5));
+    QVERIFY(snapshot.random);
+
+    xengine::Frame first, second;
+    QVERIFY(graph->evaluateInto(*input, first, 0.5));
+    QVERIFY(graph->evaluateInto(*input, second, 0.5));
+    QCOMPARE(evaluator->frameCache()->stats().hits + evaluator->frameCache()->stats().misses, quint64(0));
+    QCOMPARE(evaluator->frameCache()->stats().entries, 0);
+
+    bool moved = false;
+    for (int i = 0; i < first.size() && !moved; ++i)
+    {
+        moved = first.at(i).getX() != second.at(i).getX() || first.at(i).getY() != second.at(i).getY();
+    }
+    QVERIFY(moved);
+
+    // A seed makes it repeatable, and cacheable again
+    fuzz->setUseSeed(true);
+    QVERIFY(evaluator->captureSnapshot(snapshot, 0.5));
+    QVERIFY(!snapshot.random);
+    QVERIFY(graph->evaluateInto(*input, first, 0.5));
+    QVERIFY(graph->evaluateInto(*input, second, 0.5));
+    QCOMPARE(evaluator->frameCache()->stats().hits, quint64(1));
+}
+
+void TestFrameCache::testWorkerSharesCache()
+{
+    auto* graph = testgraphs::createGizmoRotationGraph(this);
+    auto* evaluator = graph->evaluator();
+    evaluator->setFrameCacheBudget(16 * 1024 * 1024);
+    auto* input = inputOf(graph)->currentFrame();
+
+    xengine::Frame expected;
+    QVERIFY(graph->evaluateInto(*input, expected, 0.2));
+
+    // The worker hits the frame the synchronous path cached
+    EvaluationWorker worker;
+    const quint64 sequence = worker.request(graph, *input, 0.2);
+    QVERIFY(sequence > 0);
+
+    QElapsedTimer timer;
+    timer.start();
+    while (worker.latest().sequence != sequence && timer.elapsed() < 5000)
+    {
+        worker.acquireLatest();
+        QTest::qWait(5);
+    }
+    QCOMPARE(worker.latest().sequence, sequence);
+    QCOMPARE(evaluator->frameCache()->stats().hits, quint64(1));
+    QCOMPARE(worker.latest().frame.size(), expected.size());
+    QVERIFY(worker.latest().frame.at(0).getX() == expected.at(0).getX());
+}
+
+QTEST_MAIN(TestFrameCache)
+#include "tst_frame_cache.moc"
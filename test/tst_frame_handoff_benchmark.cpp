@@ -0,0 +1,114 @@
+#include <QtTest>
+#include <QtMath>
+
+#include "ExcaliburEngine.h"
+#include "core/PointBuffer.h"
+
+using namespace gizmotweak2;
+
+// Laser hand-off cost per frame: the QVariantList path FramePreviewItem used
+// (pack every sample into a QVariantMap, engine unpacks it again) against
+// the packed PointBuffer overload.
+class TestFrameHandoffBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void testBothPathsAccepted();
+
+    void benchmarkVariantList_data();
+    void benchmarkVariantList();
+    void benchmarkPointBuffer_data();
+    void benchmarkPointBuffer();
+
+private:
+    void fillPoints(PointBuffer& points, int count);
+
+    ExcaliburEngine _engine;
+};
+
+void TestFrameHandoffBenchmark::initTestCase()
+{
+    QVERIFY(_engine.connect());
+    _engine.setLaserEnabled(0, true);
+}
+
+void TestFrameHandoffBenchmark::fillPoints(PointBuffer& points, int count)
+{
+    points.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        const qreal angle = 2.0 * M_PI * i / count;
+        points.append(qCos(angle), qSin(angle), 1.0, 0.5, 0.25, 1);
+    }
+}
+
+void TestFrameHandoffBenchmark::testBothPathsAccepted()
+{
+    PointBuffer points;
+    fillPoints(points, 100);
+    QVERIFY(_engine.sendFrame(0, points));
+
+    QVariantList variantPoints;
+    QVariantMap point;
+    point[QStringLiteral("x")] = 0.5;
+    point[QStringLiteral("y")] = -0.5;
+    variantPoints.append(point);
+    QVERIFY(_engine.sendFrame(0, variantPoints));
+
+    // Disabled zone rejects both
+    QVERIFY(!_engine.sendFrame(1, points));
+    QVERIFY(!_engine.sendFrame(1, variantPoints));
+}
+
+void TestFrameHandoffBenchmark::benchmarkVariantList_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("1000 points") << 1000;
+    QTest::newRow("10000 points") << 10000;
+}
+
+void TestFrameHandoffBenchmark::benchmarkVariantList()
+{
+    QFETCH(int, count);
+    PointBuffer points;
+    fillPoints(points, count);
+
+    QBENCHMARK
+    {
+        QVariantList variantPoints;
+        for (int i = 0; i < points.size(); ++i)
+        {
+            QVariantMap point;
+            point[QStringLiteral("x")] = points.xs()[i];
+            point[QStringLiteral("y")] = points.ys()[i];
+            point[QStringLiteral("r")] = points.rs()[i];
+            point[QStringLiteral("g")] = points.gs()[i];
+            point[QStringLiteral("b")] = points.bs()[i];
+            variantPoints.append(point);
+        }
+        _engine.sendFrame(0, variantPoints);
+    }
+}
+
+void TestFrameHandoffBenchmark::benchmarkPointBuffer_data()
+{
+    benchmarkVariantList_data();
+}
+
+void TestFrameHandoffBenchmark::benchmarkPointBuffer()
+{
+    QFETCH(int, count);
+    PointBuffer points;
+    fillPoints(points, count);
+
+    QBENCHMARK
+    {
+        _engine.sendFrame(0, points);
+    }
+}
+
+QTEST_MAIN(TestFrameHandoffBenchmark)
+#include "tst_frame_handoff_benchmark.moc"
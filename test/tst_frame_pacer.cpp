@@ -0,0 +1,99 @@
+#include <QtTest>
+
+#include "core/FramePacer.h"
+
+using namespace gizmotweak2;
+using namespace std::chrono_literals;
+
+class TestFramePacer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testStart();
+    void testOnTime();
+    void testNoDrift();
+    void testLateFrameSentImmediately();
+    void testFramesDroppedWhenFarBehind();
+    void testFpsClamped();
+};
+
+void TestFramePacer::testStart()
+{
+    const auto origin = FramePacer::Clock::now();
+    FramePacer pacer;
+    pacer.start(origin, 25.0);
+
+    QCOMPARE(pacer.frameIndex(), qint64(0));
+    QVERIFY(pacer.deadline() == origin);
+    QCOMPARE(pacer.elapsedMs(), 0.0);
+}
+
+void TestFramePacer::testOnTime()
+{
+    const auto origin = FramePacer::Clock::now();
+    FramePacer pacer;
+    pacer.start(origin, 25.0);
+
+    // Frame 0 done well before frame 1 is due
+    QCOMPARE(pacer.advance(origin + 10ms), 0);
+    QCOMPARE(pacer.frameIndex(), qint64(1));
+    QVERIFY(pacer.deadline() == origin + 40ms);
+    QCOMPARE(pacer.elapsedMs(), 40.0);
+}
+
+void TestFramePacer::testNoDrift()
+{
+    const auto origin = FramePacer::Clock::now();
+    FramePacer pacer;
+    pacer.start(origin, 30.0);
+
+    // Each frame finishes just before the next deadline, far from a whole period
+    for (int i = 0; i < 3000; ++i)
+    {
+        QCOMPARE(pacer.advance(pacer.deadline() + 33ms), 0);
+    }
+
+    // Deadlines come from the frame number: 3000 frames at 30 fps is exactly 100 s
+    QCOMPARE(pacer.frameIndex(), qint64(3000));
+    QVERIFY(pacer.deadline() == origin + 100s);
+    QCOMPARE(pacer.elapsedMs(), 100000.0);
+}
+
+void TestFramePacer::testLateFrameSentImmediately()
+{
+    const auto origin = FramePacer::Clock::now();
+    FramePacer pacer;
+    pacer.start(origin, 25.0);
+
+    // Frame 0 overran frame 1's deadline but not frame 2's: frame 1 goes out late
+    QCOMPARE(pacer.advance(origin + 50ms), 1);
+    QCOMPARE(pacer.frameIndex(), qint64(1));
+    QVERIFY(pacer.deadline() < origin + 50ms);
+}
+
+void TestFramePacer::testFramesDroppedWhenFarBehind()
+{
+    const auto origin = FramePacer::Clock::now();
+    FramePacer pacer;
+    pacer.start(origin, 25.0);
+
+    // 130 ms lost: frames 1 and 2 are dropped, frame 3 (due at 120 ms) goes out late
+    QCOMPARE(pacer.advance(origin + 130ms), 3);
+    QCOMPARE(pacer.frameIndex(), qint64(3));
+    QCOMPARE(pacer.elapsedMs(), 120.0);
+
+    // Back on schedule
+    QCOMPARE(pacer.advance(origin + 140ms), 0);
+    QVERIFY(pacer.deadline() == origin + 160ms);
+}
+
+void TestFramePacer::testFpsClamped()
+{
+    FramePacer pacer;
+    pacer.start(FramePacer::Clock::now(), 0.0);
+    QCOMPARE(pacer.fps(), 1.0);
+}
+
+QTEST_MAIN(TestFramePacer)
+#include "tst_frame_pacer.moc"
@@ -6,6 +6,9 @@
 #include "core/Node.h"
 #include "core/Port.h"
 #include "core/Connection.h"
+#include "core/PointBuffer.h"
+#include "core/ParamSnapshot.h"
+#include "core/SnapshotEvaluator.h"
 #include "nodes/InputNode.h"
 #include "nodes/OutputNode.h"
 #include "nodes/GizmoNode.h"
@@ -17,6 +20,8 @@
 #include "nodes/ScaleTweak.h"
 #include "nodes/RotationTweak.h"
 #include "nodes/ColorTweak.h"
+#include "nodes/FuzzynessTweak.h"
+#include "nodes/ColorFuzzynessTweak.h"
 
 #include <frame.h>
 
@@ -78,6 +83,35 @@ private slots:
     void testRotationTweakFollowGizmoNoRatio();
     void testColorTweakFollowGizmoNoRatio();
 
+    // Evaluation plan caching
+    void testPlanReusedAcrossEvaluations();
+    void testPlanInvalidatedOnTopologyChange();
+
+    // Internal point buffer
+    void testPointBufferRoundTrip();
+    void testBuffersReusedAcrossFrameSizes();
+    void testOutputLineBreak();
+
+    // Per-stage invariants
+    void testStageInvariantsReported();
+    void testUniformRatioAppliedToAllSamples();
+
+    // Evaluation epoch syncing
+    void testSnapshotOncePerEvaluation();
+    void testTimeShiftBranchSnapshotPerTime();
+    void testSnapshotDetachedFromNodes();
+
+    // Parallel per-sample evaluation
+    void testParallelMatchesSerial();
+    void testParallelWithTimeShiftFanIn();
+
+    // Time-invariant stage prefix
+    void testInvariantPrefixReused();
+    void testUpstreamEditInvalidatesPrefix();
+    void testDownstreamEditKeepsPrefix();
+    void testAutomationMakesStageTimeVarying();
+    void testUnseededNoiseIsTimeVarying();
+
 private:
     bool fuzzyCompare(qreal a, qreal b, qreal epsilon = 0.0001);
     bool fuzzyComparePoint(qreal x1, qreal y1, qreal x2, qreal y2, qreal epsilon = 0.0001);
@@ -87,6 +121,10 @@ private:
 
     // Helper to create a graph with a single tweak
     NodeGraph* createGraphWithTweak(const QString& tweakType);
+
+    // Input -> RotationTweak (static) -> PositionTweak (follows a SurfaceFactory) -> Output
+    NodeGraph* createPrefixGraph();
+    xengine::Frame prefixInput();
 };
 
 bool TestGraphEvaluator::fuzzyCompare(qreal a, qreal b, qreal epsilon)
@@ -1172,5 +1210,683 @@ void TestGraphEvaluator::testColorTweakFollowGizmoNoRatio()
     delete graph;
 }
 
+// ============================================================================
+// Evaluation plan caching
+// ============================================================================
+
+void TestGraphEvaluator::testPlanReusedAcrossEvaluations()
+{
+    auto* graph = createGraphWithTweak("PositionTweak");
+
+    xengine::Frame inputFrame;
+    inputFrame.addSample(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1);
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        auto* result = evaluator.evaluate(&inputFrame, i * 0.04);
+        QVERIFY(result != nullptr);
+        delete result;
+    }
+
+    // evaluateUpTo shares the same plan
+    auto* tweak = graph->nodeAt(1);
+    auto* partial = evaluator.evaluateUpTo(&inputFrame, tweak, 0.0);
+    QVERIFY(partial != nullptr);
+    delete partial;
+
+    QCOMPARE(evaluator.planBuildCount(), 1);
+
+    delete graph;
+}
+
+void TestGraphEvaluator::testPlanInvalidatedOnTopologyChange()
+{
+    auto* graph = createMinimalGraph();
+    auto* input = graph->nodeAt(0);
+    auto* output = graph->nodeAt(1);
+
+    xengine::Frame inputFrame;
+    inputFrame.addSample(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1);
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    auto* result = evaluator.evaluate(&inputFrame, 0.0);
+    QVERIFY(result != nullptr);
+    QVERIFY(fuzzyCompare(result->at(0).getX(), 0.0));
+    delete result;
+    QCOMPARE(evaluator.planBuildCount(), 1);
+
+    // Insert a PositionTweak between Input and Output
+    auto* tweak = qobject_cast<PositionTweak*>(graph->createNode("PositionTweak", QPointF(250, 100)));
+    QVERIFY(tweak != nullptr);
+    tweak->setOffsetX(0.5);
+    tweak->setFollowGizmo(false);
+
+    graph->disconnect(graph->connectionForPort(input->outputAt(0)));
+    graph->connect(input->outputAt(0), tweak->inputAt(0));
+    graph->connect(tweak->outputAt(0), output->inputAt(0));
+
+    result = evaluator.evaluate(&inputFrame, 0.0);
+    QVERIFY(result != nullptr);
+    QVERIFY(fuzzyCompare(result->at(0).getX(), 0.5));
+    delete result;
+    QCOMPARE(evaluator.planBuildCount(), 2);
+
+    delete graph;
+}
+
+// ============================================================================
+// Internal point buffer
+// ============================================================================
+
+void TestGraphEvaluator::testPointBufferRoundTrip()
+{
+    xengine::Frame frame;
+    frame.addSample(0.1, -0.2, 0.0, 1.0, 0.5, 0.0, 3);
+    frame.addSample(-0.7, 0.4, 0.0, 0.0, 0.0, 0.0, 1);
+
+    PointBuffer buffer;
+    buffer.fromFrame(frame);
+    QCOMPARE(buffer.size(), 2);
+    QVERIFY(buffer.isColored(0));
+    QVERIFY(!buffer.isColored(1));
+    QCOMPARE(buffer.repeats()[0], 3);
+
+    xengine::Frame back;
+    buffer.toFrame(back);
+    QCOMPARE(back.size(), 2);
+    QVERIFY(fuzzyComparePoint(back.at(0).getX(), back.at(0).getY(), 0.1, -0.2));
+    QVERIFY(fuzzyCompare(back.at(0).getG(), 0.5));
+    QCOMPARE(back.at(0).getNb(), 3);
+    QVERIFY(fuzzyComparePoint(back.at(1).getX(), back.at(1).getY(), -0.7, 0.4));
+
+    // Shrinking keeps capacity
+    int capacity = buffer.capacity();
+    buffer.resize(1);
+    QCOMPARE(buffer.size(), 1);
+    QCOMPARE(buffer.capacity(), capacity);
+}
+
+void TestGraphEvaluator::testBuffersReusedAcrossFrameSizes()
+{
+    auto* graph = createGraphWithTweak("PositionTweak");
+    auto* tweak = qobject_cast<PositionTweak*>(graph->nodeAt(1));
+    QVERIFY(tweak != nullptr);
+    tweak->setOffsetX(0.25);
+    tweak->setFollowGizmo(false);
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    xengine::Frame large;
+    for (int i = 0; i < 100; ++i)
+    {
+        large.addSample(i * 0.001, 0.0, 0.0, 1.0, 1.0, 1.0, 1);
+    }
+    auto* result = evaluator.evaluate(&large, 0.0);
+    QVERIFY(result != nullptr);
+    QCOMPARE(result->size(), 100);
+    delete result;
+
+    // A smaller frame after a larger one must not see leftover samples
+    xengine::Frame small;
+    small.addSample(0.5, 0.5, 0.0, 1.0, 1.0, 1.0, 1);
+    result = evaluator.evaluate(&small, 0.0);
+    QVERIFY(result != nullptr);
+    QCOMPARE(result->size(), 1);
+    QVERIFY(fuzzyComparePoint(result->at(0).getX(), result->at(0).getY(), 0.75, 0.5));
+    delete result;
+
+    delete graph;
+}
+
+void TestGraphEvaluator::testOutputLineBreak()
+{
+    auto* graph = createMinimalGraph();
+    auto* output = qobject_cast<OutputNode*>(graph->nodeAt(1));
+    QVERIFY(output != nullptr);
+    output->setLineBreakThreshold(0.5);
+
+    xengine::Frame inputFrame;
+    inputFrame.addSample(-0.9, 0.0, 0.0, 1.0, 1.0, 1.0, 2);
+    inputFrame.addSample(0.9, 0.0, 0.0, 1.0, 1.0, 1.0, 2);
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    auto* result = evaluator.evaluate(&inputFrame, 0.0);
+    QVERIFY(result != nullptr);
+
+    // Two blanks inserted between the distant colored samples
+    QCOMPARE(result->size(), 4);
+    QVERIFY(!result->at(1).isColored());
+    QVERIFY(fuzzyCompare(result->at(1).getX(), -0.9));
+    QVERIFY(!result->at(2).isColored());
+    QVERIFY(fuzzyCompare(result->at(2).getX(), 0.9));
+    QCOMPARE(result->at(2).getNb(), 2);
+    QVERIFY(result->at(3).isColored());
+
+    delete result;
+    delete graph;
+}
+
+// ============================================================================
+// Per-stage invariants
+// ============================================================================
+
+void TestGraphEvaluator::testStageInvariantsReported()
+{
+    NodeGraph graph;
+    auto* input = graph.createNode("Input", QPointF(100, 100));
+    auto* surface = graph.createNode("SurfaceFactory", QPointF(100, 200));
+    auto* gizmo = graph.createNode("Gizmo", QPointF(100, 300));
+    auto* posTweak = graph.createNode("PositionTweak", QPointF(250, 100));
+    auto* scaleTweak = graph.createNode("ScaleTweak", QPointF(400, 100));
+    auto* output = graph.createNode("Output", QPointF(550, 100));
+
+    graph.connect(input->outputAt(0), posTweak->inputAt(0));
+    graph.connect(surface->outputAt(0), posTweak->inputAt(1));
+    graph.connect(posTweak->outputAt(0), scaleTweak->inputAt(0));
+    graph.connect(gizmo->outputAt(0), scaleTweak->inputAt(1));
+    graph.connect(scaleTweak->outputAt(0), output->inputAt(0));
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(&graph);
+
+    // Nothing evaluated yet
+    QVERIFY(evaluator.stageInvariants().isEmpty());
+
+    xengine::Frame output;
+    QVERIFY(evaluator.evaluateInto(prefixInput(), output, 0.0));
+
+    auto stages = evaluator.stageInvariants();
+    QCOMPARE(stages.size(), 2);
+
+    auto first = stages.at(0).toMap();
+    QCOMPARE(first.value("uuid").toString(), posTweak->uuid());
+    QVERIFY(first.value("ratioInvariant").toBool());    // SurfaceFactory: time only
+    QVERIFY(!first.contains("centerInvariant"));
+
+    auto second = stages.at(1).toMap();
+    QCOMPARE(second.value("uuid").toString(), scaleTweak->uuid());
+    QVERIFY(!second.value("ratioInvariant").toBool());  // Gizmo: depends on position
+}
+
+void TestGraphEvaluator::testUniformRatioAppliedToAllSamples()
+{
+    NodeGraph graph;
+    auto* input = graph.createNode("Input", QPointF(100, 100));
+    auto* surface = qobject_cast<SurfaceFactoryNode*>(graph.createNode("SurfaceFactory", QPointF(100, 200)));
+    auto* posTweak = qobject_cast<PositionTweak*>(graph.createNode("PositionTweak", QPointF(350, 100)));
+    auto* output = graph.createNode("Output", QPointF(500, 100));
+
+    surface->setSurfaceType(SurfaceFactoryNode::SurfaceType::Sine);
+    surface->setAmplitude(1.0);
+    surface->setFrequency(1.0);
+    posTweak->setOffsetX(0.5);
+    posTweak->setFollowGizmo(true);
+
+    graph.connect(input->outputAt(0), posTweak->inputAt(0));
+    graph.connect(surface->outputAt(0), posTweak->inputAt(1));
+    graph.connect(posTweak->outputAt(0), output->inputAt(0));
+
+    xengine::Frame inputFrame;
+    inputFrame.addSample(-0.5, 0.0, 0.0, 1.0, 1.0, 1.0, 1);
+    inputFrame.addSample(0.5, 0.3, 0.0, 1.0, 1.0, 1.0, 1);
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(&graph);
+
+    const qreal time = 0.3;
+    auto* result = evaluator.evaluate(&inputFrame, time);
+    QVERIFY(result != nullptr);
+    QCOMPARE(result->size(), 2);
+
+    qreal expectedOffset = 0.5 * surface->computeRatio(time);
+    QVERIFY(fuzzyCompare(result->at(0).getX(), -0.5 + expectedOffset));
+    QVERIFY(fuzzyCompare(result->at(1).getX(), 0.5 + expectedOffset));
+
+    delete result;
+}
+
+// ============================================================================
+// Parameter snapshots
+// ============================================================================
+
+void TestGraphEvaluator::testSnapshotOncePerEvaluation()
+{
+    NodeGraph graph;
+    auto* input = graph.createNode("Input", QPointF(100, 100));
+    auto* gizmo = graph.createNode("Gizmo", QPointF(100, 200));
+    auto* posTweak = qobject_cast<PositionTweak*>(graph.createNode("PositionTweak", QPointF(250, 100)));
+    auto* scaleTweak = qobject_cast<ScaleTweak*>(graph.createNode("ScaleTweak", QPointF(400, 100)));
+    auto* output = graph.createNode("Output", QPointF(550, 100));
+
+    posTweak->setFollowGizmo(true);
+    scaleTweak->setFollowGizmo(true);
+
+    // Same Gizmo drives both tweaks
+    graph.connect(input->outputAt(0), posTweak->inputAt(0));
+    graph.connect(gizmo->outputAt(0), posTweak->inputAt(1));
+    graph.connect(posTweak->outputAt(0), scaleTweak->inputAt(0));
+    graph.connect(gizmo->outputAt(0), scaleTweak->inputAt(1));
+    graph.connect(scaleTweak->outputAt(0), output->inputAt(0));
+
+    xengine::Frame inputFrame;
+    for (int i = 0; i < 50; ++i)
+    {
+        inputFrame.addSample(i * 0.01, 0.0, 0.0, 1.0, 1.0, 1.0, 1);
+    }
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(&graph);
+
+    auto* result = evaluator.evaluate(&inputFrame, 0.0);
+    delete result;
+
+    // 2 tweaks + the shared Gizmo, whatever the sample count
+    QCOMPARE(evaluator.snapshotCount(), 3);
+
+    result = evaluator.evaluate(&inputFrame, 0.04);
+    delete result;
+    QCOMPARE(evaluator.snapshotCount(), 3);
+}
+
+void TestGraphEvaluator::testTimeShiftBranchSnapshotPerTime()
+{
+    NodeGraph graph;
+    auto* input = graph.createNode("Input", QPointF(100, 100));
+    auto* gizmo = graph.createNode("Gizmo", QPointF(100, 200));
+    auto* timeShift = qobject_cast<TimeShiftNode*>(graph.createNode("TimeShift", QPointF(200, 300)));
+    auto* group = graph.createNode("Transform", QPointF(300, 250));
+    auto* posTweak = qobject_cast<PositionTweak*>(graph.createNode("PositionTweak", QPointF(400, 100)));
+    auto* output = graph.createNode("Output", QPointF(550, 100));
+
+    timeShift->setDelay(0.5);
+    timeShift->setScale(1.0);
+    posTweak->setFollowGizmo(true);
+
+    // Gizmo reaches the Transform directly and through a TimeShift
+    graph.connect(gizmo->outputAt(0), group->inputAt(0));
+    graph.connect(gizmo->outputAt(0), timeShift->inputAt(0));
+    graph.connect(timeShift->outputAt(0), group->inputAt(1));
+    graph.connect(input->outputAt(0), posTweak->inputAt(0));
+    graph.connect(group->outputAt(0), posTweak->inputAt(1));
+    graph.connect(posTweak->outputAt(0), output->inputAt(0));
+
+    xengine::Frame inputFrame;
+    for (int i = 0; i < 20; ++i)
+    {
+        inputFrame.addSample(i * 0.01, 0.0, 0.0, 1.0, 1.0, 1.0, 1);
+    }
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(&graph);
+
+    auto* result = evaluator.evaluate(&inputFrame, 1.0);
+    QVERIFY(result != nullptr);
+    delete result;
+
+    // Tweak + Transform + TimeShift + Gizmo at t + Gizmo at the shifted time
+    QCOMPARE(evaluator.snapshotCount(), 5);
+}
+
+void TestGraphEvaluator::testSnapshotDetachedFromNodes()
+{
+    NodeGraph graph;
+    auto* input = graph.createNode("Input", QPointF(100, 100));
+    auto* gizmo = qobject_cast<GizmoNode*>(graph.createNode("Gizmo", QPointF(100, 200)));
+    auto* posTweak = qobject_cast<PositionTweak*>(graph.createNode("PositionTweak", QPointF(250, 100)));
+    auto* output = graph.createNode("Output", QPointF(400, 100));
+
+    gizmo->setHorizontalBorder(0.5);
+    gizmo->setVerticalBorder(0.5);
+    posTweak->setOffsetX(0.25);
+    posTweak->setFollowGizmo(true);
+
+    graph.connect(input->outputAt(0), posTweak->inputAt(0));
+    graph.connect(gizmo->outputAt(0), posTweak->inputAt(1));
+    graph.connect(posTweak->outputAt(0), output->inputAt(0));
+
+    xengine::Frame inputFrame;
+    for (int i = 0; i < 20; ++i)
+    {
+        inputFrame.addSample(i * 0.05 - 0.5, 0.1, 0.0, 1.0, 1.0, 1.0, 1);
+    }
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(&graph);
+
+    xengine::Frame expected;
+    QVERIFY(evaluator.evaluateInto(inputFrame, expected, 0.0));
+
+    // Capture, then edit the live nodes before computing
+    EvaluationSnapshot snapshot;
+    QVERIFY(evaluator.captureSnapshot(snapshot, 0.0));
+    posTweak->setOffsetX(-0.75);
+    gizmo->setCenterX(0.8);
+
+    SnapshotEvaluator compute;
+    compute.input().fromFrame(inputFrame);
+    xengine::Frame detached;
+    compute.run(snapshot).toFrame(detached);
+
+    // The run only sees the captured parameters
+    QCOMPARE(detached.size(), expected.size());
+    for (int i = 0; i < expected.size(); ++i)
+    {
+        QVERIFY(detached.at(i).getX() == expected.at(i).getX());
+        QVERIFY(detached.at(i).getY() == expected.at(i).getY());
+    }
+}
+
+// ============================================================================
+// Parallel per-sample evaluation
+// ============================================================================
+
+void TestGraphEvaluator::testParallelMatchesSerial()
+{
+    NodeGraph graph;
+    auto* input = graph.createNode("Input", QPointF(100, 100));
+    auto* gizmo = qobject_cast<GizmoNode*>(graph.createNode("Gizmo", QPointF(100, 200)));
+    auto* fuzz = qobject_cast<FuzzynessTweak*>(graph.createNode("FuzzynessTweak", QPointF(250, 100)));
+    auto* rotation = qobject_cast<RotationTweak*>(graph.createNode("RotationTweak", QPointF(400, 100)));
+    auto* colorFuzz = qobject_cast<ColorFuzzynessTweak*>(graph.createNode("ColorFuzzynessTweak", QPointF(550, 100)));
+    auto* output = graph.createNode("Output", QPointF(700, 100));
+
+    gizmo->setHorizontalBorder(0.5);
+    gizmo->setVerticalBorder(0.5);
+    fuzz->setAmount(0.05);
+    fuzz->setUseSeed(true);
+    fuzz->setSeed(42);
+    fuzz->setFollowGizmo(false);
+    rotation->setAngle(30.0);
+    rotation->setFollowGizmo(true);
+    colorFuzz->setAmount(0.3);
+    colorFuzz->setUseSeed(true);
+    colorFuzz->setSeed(7);
+    colorFuzz->setFollowGizmo(true);
+
+    graph.connect(input->outputAt(0), fuzz->inputAt(0));
+    graph.connect(fuzz->outputAt(0), rotation->inputAt(0));
+    graph.connect(gizmo->outputAt(0), rotation->inputAt(1));
+    graph.connect(rotation->outputAt(0), colorFuzz->inputAt(0));
+    graph.connect(gizmo->outputAt(0), colorFuzz->inputAt(1));
+    graph.connect(colorFuzz->outputAt(0), output->inputAt(0));
+
+    // Dense raster-like pattern
+    xengine::Frame inputFrame;
+    for (int i = 0; i < 20000; ++i)
+    {
+        inputFrame.addSample((i % 200) / 100.0 - 1.0, (i / 200) / 50.0 - 1.0, 0.0, 1.0, 0.5, 0.25, 1);
+    }
+
+    GraphEvaluator serial;
+    serial.setGraph(&graph);
+
+    GraphEvaluator parallel;
+    parallel.setGraph(&graph);
+    parallel.setParallelEnabled(true);
+    parallel.setParallelThreshold(2048);
+
+    xengine::Frame serialOut, parallelOut;
+    QVERIFY(serial.evaluateInto(inputFrame, serialOut, 0.5));
+    QVERIFY(parallel.evaluateInto(inputFrame, parallelOut, 0.5));
+
+    // Bit-identical, not just close
+    QCOMPARE(parallelOut.size(), serialOut.size());
+    for (int i = 0; i < serialOut.size(); ++i)
+    {
+        QVERIFY(parallelOut.at(i).getX() == serialOut.at(i).getX());
+        QVERIFY(parallelOut.at(i).getY() == serialOut.at(i).getY());
+        QVERIFY(parallelOut.at(i).getR() == serialOut.at(i).getR());
+        QVERIFY(parallelOut.at(i).getG() == serialOut.at(i).getG());
+        QVERIFY(parallelOut.at(i).getB() == serialOut.at(i).getB());
+    }
+}
+
+void TestGraphEvaluator::testParallelWithTimeShiftFanIn()
+{
+    // A node read at two times per evaluation: one snapshot per time, still parallel
+    NodeGraph graph;
+    auto* input = graph.createNode("Input", QPointF(100, 100));
+    auto* gizmo = graph.createNode("Gizmo", QPointF(100, 200));
+    auto* timeShift = qobject_cast<TimeShiftNode*>(graph.createNode("TimeShift", QPointF(200, 300)));
+    auto* group = graph.createNode("Transform", QPointF(300, 250));
+    auto* scaleTweak = qobject_cast<ScaleTweak*>(graph.createNode("ScaleTweak", QPointF(400, 100)));
+    auto* output = graph.createNode("Output", QPointF(550, 100));
+
+    timeShift->setDelay(0.25);
+    scaleTweak->setScaleX(2.0);
+    scaleTweak->setFollowGizmo(true);
+
+    graph.connect(gizmo->outputAt(0), group->inputAt(0));
+    graph.connect(gizmo->outputAt(0), timeShift->inputAt(0));
+    graph.connect(timeShift->outputAt(0), group->inputAt(1));
+    graph.connect(input->outputAt(0), scaleTweak->inputAt(0));
+    graph.connect(group->outputAt(0), scaleTweak->inputAt(1));
+    graph.connect(scaleTweak->outputAt(0), output->inputAt(0));
+
+    xengine::Frame inputFrame;
+    for (int i = 0; i < 5000; ++i)
+    {
+        inputFrame.addSample(i / 2500.0 - 1.0, 0.1, 0.0, 1.0, 1.0, 1.0, 1);
+    }
+
+    GraphEvaluator serial;
+    serial.setGraph(&graph);
+
+    GraphEvaluator parallel;
+    parallel.setGraph(&graph);
+    parallel.setParallelEnabled(true);
+    parallel.setParallelThreshold(1024);
+
+    xengine::Frame serialOut, parallelOut;
+    QVERIFY(serial.evaluateInto(inputFrame, serialOut, 1.0));
+    QVERIFY(parallel.evaluateInto(inputFrame, parallelOut, 1.0));
+
+    QCOMPARE(parallelOut.size(), serialOut.size());
+    for (int i = 0; i < serialOut.size(); ++i)
+    {
+        QVERIFY(parallelOut.at(i).getX() == serialOut.at(i).getX());
+    }
+}
+
+// ============================================================================
+// Time-invariant stage prefix
+// ============================================================================
+
+NodeGraph* TestGraphEvaluator::createPrefixGraph()
+{
+    auto* graph = new NodeGraph(this);
+    auto* input = graph->createNode("Input", QPointF(100, 100));
+    auto* rotation = qobject_cast<RotationTweak*>(graph->createNode("RotationTweak", QPointF(250, 100)));
+    auto* surface = qobject_cast<SurfaceFactoryNode*>(graph->createNode("SurfaceFactory", QPointF(250, 200)));
+    auto* position = qobject_cast<PositionTweak*>(graph->createNode("PositionTweak", QPointF(400, 100)));
+    auto* output = graph->createNode("Output", QPointF(550, 100));
+
+    rotation->setAngle(30.0);
+    rotation->setFollowGizmo(false);
+    surface->setSurfaceType(SurfaceFactoryNode::SurfaceType::Sine);
+    surface->setAmplitude(1.0);
+    surface->setFrequency(1.0);
+    position->setOffsetX(0.5);
+    position->setFollowGizmo(true);
+
+    graph->connect(input->outputAt(0), rotation->inputAt(0));
+    graph->connect(rotation->outputAt(0), position->inputAt(0));
+    graph->connect(surface->outputAt(0), position->inputAt(1));
+    graph->connect(position->outputAt(0), output->inputAt(0));
+    return graph;
+}
+
+xengine::Frame TestGraphEvaluator::prefixInput()
+{
+    xengine::Frame frame;
+    for (int i = 0; i < 100; ++i)
+    {
+        frame.addSample(i / 50.0 - 1.0, 0.25, 0.0, 1.0, 1.0, 1.0, 1);
+    }
+    return frame;
+}
+
+void TestGraphEvaluator::testInvariantPrefixReused()
+{
+    auto* graph = createPrefixGraph();
+    const auto input = prefixInput();
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    xengine::Frame first, second;
+    QVERIFY(evaluator.evaluateInto(input, first, 0.1));
+    QCOMPARE(evaluator.prefixReuseCount(), 0);
+    QVERIFY(evaluator.evaluateInto(input, second, 0.2));
+    QCOMPARE(evaluator.prefixReuseCount(), 1);
+
+    // Only the time-varying stage moved, and exactly as a full evaluation would
+    GraphEvaluator fresh;
+    fresh.setGraph(graph);
+    xengine::Frame expected;
+    QVERIFY(fresh.evaluateInto(input, expected, 0.2));
+
+    QCOMPARE(second.size(), expected.size());
+    for (int i = 0; i < expected.size(); ++i)
+    {
+        QVERIFY(second.at(i).getX() == expected.at(i).getX());
+        QVERIFY(second.at(i).getY() == expected.at(i).getY());
+    }
+}
+
+void TestGraphEvaluator::testUpstreamEditInvalidatesPrefix()
+{
+    auto* graph = createPrefixGraph();
+    const auto input = prefixInput();
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    xengine::Frame output;
+    QVERIFY(evaluator.evaluateInto(input, output, 0.1));
+
+    auto* rotation = qobject_cast<RotationTweak*>(graph->nodeAt(1));
+    QVERIFY(rotation);
+    rotation->setAngle(60.0);
+
+    QVERIFY(evaluator.evaluateInto(input, output, 0.2));
+    QCOMPARE(evaluator.prefixReuseCount(), 0);
+
+    GraphEvaluator fresh;
+    fresh.setGraph(graph);
+    xengine::Frame expected;
+    QVERIFY(fresh.evaluateInto(input, expected, 0.2));
+    QVERIFY(output.at(10).getX() == expected.at(10).getX());
+    QVERIFY(output.at(10).getY() == expected.at(10).getY());
+
+    // A different input frame is not the cached prefix either
+    auto other = prefixInput();
+    other.addSample(0.5, 0.5, 0.0, 1.0, 1.0, 1.0, 1);
+    QVERIFY(evaluator.evaluateInto(other, output, 0.3));
+    QCOMPARE(evaluator.prefixReuseCount(), 0);
+}
+
+void TestGraphEvaluator::testDownstreamEditKeepsPrefix()
+{
+    auto* graph = createPrefixGraph();
+    const auto input = prefixInput();
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    xengine::Frame output;
+    QVERIFY(evaluator.evaluateInto(input, output, 0.1));
+
+    // The time-varying stage is after the prefix: its edits leave the prefix valid
+    auto* position = qobject_cast<PositionTweak*>(graph->nodeAt(3));
+    QVERIFY(position);
+    position->setOffsetX(0.25);
+
+    QVERIFY(evaluator.evaluateInto(input, output, 0.1));
+    QCOMPARE(evaluator.prefixReuseCount(), 1);
+
+    GraphEvaluator fresh;
+    fresh.setGraph(graph);
+    xengine::Frame expected;
+    QVERIFY(fresh.evaluateInto(input, expected, 0.1));
+    QVERIFY(output.at(10).getX() == expected.at(10).getX());
+}
+
+void TestGraphEvaluator::testAutomationMakesStageTimeVarying()
+{
+    auto* graph = createPrefixGraph();
+    auto* rotation = qobject_cast<RotationTweak*>(graph->nodeAt(1));
+    QVERIFY(rotation);
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    const auto input = prefixInput();
+    xengine::Frame output;
+    QVERIFY(evaluator.evaluateInto(input, output, 0.0));
+    auto stages = evaluator.stageInvariants();
+    QCOMPARE(stages.size(), 2);
+    QVERIFY(stages.at(0).toMap().value("timeInvariant").toBool());
+    QVERIFY(!stages.at(1).toMap().value("timeInvariant").toBool());    // SurfaceFactory ratio
+
+    // Automated angle: nothing left to reuse
+    rotation->automationTrack(QStringLiteral("Rotation"))->setAutomated(true);
+    QVERIFY(evaluator.evaluateInto(input, output, 0.1));
+    stages = evaluator.stageInvariants();
+    QVERIFY(!stages.at(0).toMap().value("timeInvariant").toBool());
+
+    QVERIFY(evaluator.evaluateInto(input, output, 0.2));
+    QCOMPARE(evaluator.prefixReuseCount(), 0);
+}
+
+void TestGraphEvaluator::testUnseededNoiseIsTimeVarying()
+{
+    auto* graph = createGraphWithTweak("FuzzynessTweak");
+    auto* fuzz = qobject_cast<FuzzynessTweak*>(graph->nodeAt(1));
+    QVERIFY(fuzz);
+    fuzz->setAmount(0.1);
+    fuzz->setFollowGizmo(false);
+
+    GraphEvaluator evaluator;
+    evaluator.setGraph(graph);
+
+    const auto input = prefixInput();
+    xengine::Frame first, second;
+
+    // A seed makes the jitter a function of the parameters only
+    fuzz->setUseSeed(true);
+    QVERIFY(evaluator.evaluateInto(input, first, 0.0));
+    auto stages = evaluator.stageInvariants();
+    QCOMPARE(stages.size(), 1);
+    QVERIFY(stages.at(0).toMap().value("timeInvariant").toBool());
+
+    // Without one, every evaluation draws new jitter
+    fuzz->setUseSeed(false);
+    QVERIFY(evaluator.evaluateInto(input, first, 0.0));
+    stages = evaluator.stageInvariants();
+    QVERIFY(!stages.at(0).toMap().value("timeInvariant").toBool());
+
+    QVERIFY(evaluator.evaluateInto(input, first, 0.1));
+    QVERIFY(evaluator.evaluateInto(input, second, 0.2));
+    QCOMPARE(evaluator.prefixReuseCount(), 0);
+
+    bool moved = false;
+    for (int i = 0; i < first.size() && !moved; ++i)
+    {
+        moved = first.at(i).getX() != second.at(i).getX() || first.at(i).getY() != second.at(i).getY();
+    }
+    QVERIFY(moved);
+
+    delete graph;
+}
+
 QTEST_MAIN(TestGraphEvaluator)
 #include "tst_graph_evaluator.moc"
@@ -134,6 +134,15 @@ private slots:
     void testSurfaceFactoryClamp();
     void testSurfaceFactoryOffset();
 
+    // Batch kernels must match the per-point formulas
+    void testBatchMatchesApplyGeometric();
+    void testBatchMatchesApplyFuzzynessSeeded();
+
+    // Automation binding tables
+    void testBindingAppliesAutomatedTracks();
+    void testBindingFollowsTrackChanges();
+    void testBindingInitialValuesWhenOff();
+
 private:
     bool fuzzyCompare(qreal a, qreal b, qreal epsilon = 0.0001);
     bool fuzzyComparePoint(QPointF a, QPointF b, qreal epsilon = 0.0001);
@@ -1325,5 +1334,153 @@ void TestNodeFormulas::testSurfaceFactoryOffset()
     QVERIFY(fuzzyCompare(ratio, 1.5));
 }
 
+// ============================================================================
+// Batch kernels
+// ============================================================================
+
+void TestNodeFormulas::testBatchMatchesApplyGeometric()
+{
+    const QVector<qreal> xs{0.0, 0.25, -0.5, 0.8, -0.9, 0.1};
+    const QVector<qreal> ys{0.0, 0.5, 0.3, -0.7, -0.2, 0.9};
+    const QVector<qreal> ratios{1.0, 0.5, 0.5, 0.0, -0.3, 1.0};
+    const int n = xs.size();
+    const qreal gx = 0.1, gy = -0.2;
+
+    RotationTweak rotation;
+    rotation.setAngle(37.0);
+    WaveTweak wave;
+    wave.setAmplitude(0.2);
+    wave.setWavelength(0.5);
+    wave.setAngle(20.0);
+    SqueezeTweak squeeze;
+    squeeze.setIntensity(0.4);
+    squeeze.setAngle(15.0);
+    PolarTweak polar;
+    polar.setExpansion(0.3);
+    polar.setRingScale(0.1);
+    polar.setRingRadius(0.25);
+    RounderTweak rounder;
+    rounder.setAmount(0.6);
+
+    QVector<qreal> outX(n), outY(n);
+
+    rotation.applyBatch(xs.constData(), ys.constData(), ratios.constData(), n, gx, gy, outX.data(), outY.data());
+    for (int i = 0; i < n; ++i)
+        QCOMPARE(QPointF(outX[i], outY[i]), rotation.apply(xs[i], ys[i], ratios[i], gx, gy));
+
+    wave.applyBatch(xs.constData(), ys.constData(), ratios.constData(), n, gx, gy, outX.data(), outY.data());
+    for (int i = 0; i < n; ++i)
+        QCOMPARE(QPointF(outX[i], outY[i]), wave.apply(xs[i], ys[i], ratios[i], gx, gy));
+
+    squeeze.applyBatch(xs.constData(), ys.constData(), ratios.constData(), n, gx, gy, outX.data(), outY.data());
+    for (int i = 0; i < n; ++i)
+        QCOMPARE(QPointF(outX[i], outY[i]), squeeze.apply(xs[i], ys[i], ratios[i], gx, gy));
+
+    polar.applyBatch(xs.constData(), ys.constData(), ratios.constData(), n, gx, gy, outX.data(), outY.data());
+    for (int i = 0; i < n; ++i)
+        QCOMPARE(QPointF(outX[i], outY[i]), polar.apply(xs[i], ys[i], ratios[i], ratios[i], gx, gy));
+
+    rounder.applyBatch(xs.constData(), ys.constData(), ratios.constData(), n, outX.data(), outY.data());
+    for (int i = 0; i < n; ++i)
+        QCOMPARE(QPointF(outX[i], outY[i]), rounder.apply(xs[i], ys[i], ratios[i]));
+
+    // nullptr ratios means full effect, and in-place operation is allowed
+    QVector<qreal> inPlaceX = xs, inPlaceY = ys;
+    rotation.applyBatch(inPlaceX.constData(), inPlaceY.constData(), nullptr, n, gx, gy, inPlaceX.data(), inPlaceY.data());
+    for (int i = 0; i < n; ++i)
+        QCOMPARE(QPointF(inPlaceX[i], inPlaceY[i]), rotation.apply(xs[i], ys[i], 1.0, gx, gy));
+}
+
+void TestNodeFormulas::testBatchMatchesApplyFuzzynessSeeded()
+{
+    FuzzynessTweak fuzz;
+    fuzz.setAmount(0.2);
+    fuzz.setUseSeed(true);
+    fuzz.setSeed(42);
+
+    const QVector<qreal> xs{0.0, 0.1, 0.2, 0.3};
+    const QVector<qreal> ys{0.0, -0.1, -0.2, -0.3};
+    const int n = xs.size();
+    const int firstIndex = 10;
+
+    QVector<qreal> outX(n), outY(n);
+    fuzz.applyBatch(xs.constData(), ys.constData(), nullptr, n, firstIndex, outX.data(), outY.data());
+
+    for (int i = 0; i < n; ++i)
+    {
+        QCOMPARE(QPointF(outX[i], outY[i]), fuzz.apply(QPointF(xs[i], ys[i]), 1.0, firstIndex + i));
+    }
+}
+
+// ============================================================================
+// Automation binding tables
+// ============================================================================
+
+void TestNodeFormulas::testBindingAppliesAutomatedTracks()
+{
+    GizmoNode gizmo;
+    gizmo.setCenterX(0.1);
+
+    // Not automated: the node's own values
+    auto* position = gizmo.automationTrack(QStringLiteral("Position"));
+    position->createKeyFrame(0);
+    position->createKeyFrame(1000);
+    position->updateKeyFrameValue(1000, 0, 0.5);
+    QCOMPARE(gizmo.paramsAt(1000).centerX, 0.1);
+
+    position->setAutomated(true);
+    QVERIFY(fuzzyCompare(gizmo.paramsAt(1000).centerX, 0.5));
+
+    // Multi-parameter and integer members
+    auto* border = gizmo.automationTrack(QStringLiteral("Border"));
+    border->setAutomated(true);
+    border->createKeyFrame(0);
+    border->updateKeyFrameValue(0, 1, -0.4);
+    border->updateKeyFrameValue(0, 3, 0.6);
+    auto* waveCount = gizmo.automationTrack(QStringLiteral("WaveCount"));
+    waveCount->setAutomated(true);
+    waveCount->createKeyFrame(0);
+    waveCount->updateKeyFrameValue(0, 0, 7.0);
+
+    const GizmoNode::Params params = gizmo.paramsAt(0);
+    QVERIFY(fuzzyCompare(params.horizontalBend, -0.4));
+    QVERIFY(fuzzyCompare(params.verticalBend, 0.6));
+    QCOMPARE(params.waveCount, 7);
+}
+
+void TestNodeFormulas::testBindingFollowsTrackChanges()
+{
+    ScaleTweak scale;
+    auto* track = scale.automationTrack(QStringLiteral("Scale"));
+    track->setAutomated(true);
+    track->createKeyFrame(0);
+    track->updateKeyFrameValue(0, 0, 2.5);
+    QVERIFY(fuzzyCompare(scale.paramsAt(0).scaleX, 2.5));
+
+    // Bound by name: a renamed track no longer drives the member, until named back
+    track->setTrackName(QStringLiteral("Other"));
+    QCOMPARE(scale.paramsAt(0).scaleX, scale.scaleX());
+    track->setTrackName(QStringLiteral("Scale"));
+    QVERIFY(fuzzyCompare(scale.paramsAt(0).scaleX, 2.5));
+
+    // Removed, then recreated
+    scale.removeAutomationTrack(QStringLiteral("Scale"));
+    QCOMPARE(scale.paramsAt(0).scaleX, scale.scaleX());
+    auto* recreated = scale.createAutomationTrack(QStringLiteral("Scale"), 2);
+    recreated->setAutomated(true);
+    recreated->createKeyFrame(0);
+    recreated->updateKeyFrameValue(0, 0, 0.5);
+    QVERIFY(fuzzyCompare(scale.paramsAt(0).scaleX, 0.5));
+}
+
+void TestNodeFormulas::testBindingInitialValuesWhenOff()
+{
+    // Transform takes the tracks' initial values even when not automated
+    GroupNode group;
+    group.setRotation(10.0);
+    group.automationTrack(QStringLiteral("Rotation"))->setInitialValue(0, 45.0);
+    QCOMPARE(group.paramsAt(0).rotation, 45.0);
+}
+
 QTEST_MAIN(TestNodeFormulas)
 #include "tst_node_formulas.moc"
@@ -88,12 +88,14 @@ private slots:
     void testCreateNode();
     void testCreateAllNodeTypes();
     void testCreateInvalidType();
+    void testNodeKindsAreDistinct();
 
     // Connection edge cases
     void testDisconnectPort();
     void testConnectionForPort();
     void testConnectionForPortUnconnected();
     void testRemoveNodeRemovesConnections();
+    void testConnectionIndexFollowsUndoRedo();
 
     // Graph validation
     void testIsGraphCompleteEmpty();
@@ -788,6 +790,21 @@ void TestNodeGraph::testCreateInvalidType()
     QVERIFY(node == nullptr);
 }
 
+void TestNodeGraph::testNodeKindsAreDistinct()
+{
+    NodeGraph graph;
+
+    QList<Node::Kind> kinds;
+    for (const auto& typeName : graph.availableNodeTypes())
+    {
+        auto node = graph.createNode(typeName, QPointF(0, 0));
+        QVERIFY(node != nullptr);
+        QVERIFY2(node->kind() != Node::Kind::Unknown, qPrintable(typeName));
+        QVERIFY2(!kinds.contains(node->kind()), qPrintable(typeName));
+        kinds.append(node->kind());
+    }
+}
+
 // --- Connection edge cases ---
 
 void TestNodeGraph::testDisconnectPort()
@@ -844,6 +861,34 @@ void TestNodeGraph::testRemoveNodeRemovesConnections()
     QCOMPARE(graph.connectionCount(), 0);
 }
 
+void TestNodeGraph::testConnectionIndexFollowsUndoRedo()
+{
+    NodeGraph graph;
+
+    auto n1 = graph.createNode("Input", QPointF(0, 0));
+    auto n2 = graph.createNode("PositionTweak", QPointF(200, 0));
+    auto n3 = graph.createNode("Output", QPointF(400, 0));
+
+    graph.connect(n1->outputAt(0), n2->inputAt(0));
+    graph.connect(n2->outputAt(0), n3->inputAt(0));
+
+    QCOMPARE(graph.connectedNode(n2->inputAt(0)), n1);
+    QCOMPARE(graph.connectedNode(n2->outputAt(0)), n3);
+    QCOMPARE(graph.connectionsForPort(n2->outputAt(0)).size(), 1);
+
+    graph.undo();
+    QVERIFY(graph.connectedNode(n2->outputAt(0)) == nullptr);
+    QVERIFY(graph.connectionsForPort(n3->inputAt(0)).isEmpty());
+    QCOMPARE(graph.connectedNode(n2->inputAt(0)), n1);
+
+    graph.redo();
+    QCOMPARE(graph.connectedNode(n3->inputAt(0)), n2);
+
+    graph.disconnectPort(n2->inputAt(0));
+    QVERIFY(graph.connectionForPort(n1->outputAt(0)) == nullptr);
+    QVERIFY(graph.connectionsForPort(n2->inputAt(0)).isEmpty());
+}
+
 // --- Graph validation ---
 
 void TestNodeGraph::testIsGraphCompleteEmpty()
@@ -0,0 +1,197 @@
+#include <QtTest>
+
+#include "core/PreviewQuality.h"
+#include "core/PointBuffer.h"
+
+using namespace gizmotweak2;
+
+class TestPreviewQuality : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // PreviewQuality
+    void testStartsFull();
+    void testOverBudgetStepsDown();
+    void testSingleSlowFrameIgnored();
+    void testIdleReportsKeepLevel();
+    void testCheapFramesStepUp();
+    void testSettleWhenIdle();
+    void testLevelKnobs();
+
+    // PointBuffer::decimate
+    void testDecimateKeepsLast();
+    void testDecimateStrideOne();
+};
+
+// ============================================================================
+// PreviewQuality
+// ============================================================================
+
+void TestPreviewQuality::testStartsFull()
+{
+    PreviewQuality quality(20.0);
+    QCOMPARE(quality.level(), PreviewQuality::Full);
+    QCOMPARE(quality.budgetMs(), 20.0);
+    QVERIFY(!quality.isActive(0));
+}
+
+void TestPreviewQuality::testOverBudgetStepsDown()
+{
+    PreviewQuality quality(20.0);
+    quality.touch(0);
+
+    // Level moves once enough frames were measured, then costs start over
+    QVERIFY(!quality.report(50.0, 10));
+    QVERIFY(!quality.report(50.0, 20));
+    QVERIFY(quality.report(50.0, 30));
+    QCOMPARE(quality.level(), PreviewQuality::Reduced);
+    QCOMPARE(quality.averageCostMs(), 0.0);
+
+    quality.touch(40);
+    QVERIFY(!quality.report(50.0, 50));
+    QVERIFY(!quality.report(50.0, 60));
+    QVERIFY(quality.report(50.0, 70));
+    QCOMPARE(quality.level(), PreviewQuality::Draft);
+
+    // Nothing below draft
+    QVERIFY(!quality.report(50.0, 80));
+    QVERIFY(!quality.report(50.0, 90));
+    QVERIFY(!quality.report(50.0, 100));
+    QCOMPARE(quality.level(), PreviewQuality::Draft);
+}
+
+void TestPreviewQuality::testSingleSlowFrameIgnored()
+{
+    PreviewQuality quality(20.0);
+    quality.touch(0);
+
+    QVERIFY(!quality.report(10.0, 10));
+    QVERIFY(!quality.report(10.0, 20));
+    QVERIFY(!quality.report(40.0, 30));
+    QVERIFY(quality.averageCostMs() < 20.0);
+    QCOMPARE(quality.level(), PreviewQuality::Full);
+}
+
+void TestPreviewQuality::testIdleReportsKeepLevel()
+{
+    PreviewQuality quality(20.0);
+
+    // Never touched: a slow evaluation after loading a file is not scrubbing
+    for (int i = 0; i < 10; ++i)
+    {
+        QVERIFY(!quality.report(100.0, i * 10));
+    }
+    QCOMPARE(quality.level(), PreviewQuality::Full);
+
+    // Touched long ago
+    quality.touch(0);
+    QVERIFY(!quality.report(100.0, PreviewQuality::IDLE_MS + 1));
+    QCOMPARE(quality.level(), PreviewQuality::Full);
+}
+
+void TestPreviewQuality::testCheapFramesStepUp()
+{
+    PreviewQuality quality(20.0);
+    quality.touch(0);
+    for (int i = 0; i < PreviewQuality::MIN_SAMPLES; ++i)
+    {
+        quality.report(50.0, 10);
+    }
+    QCOMPARE(quality.level(), PreviewQuality::Reduced);
+
+    // Between raise ratio and budget: stays
+    for (int i = 0; i < 5; ++i)
+    {
+        QVERIFY(!quality.report(15.0, 20));
+    }
+    QCOMPARE(quality.level(), PreviewQuality::Reduced);
+
+    // Well under budget while still active: back to full without waiting for idle
+    for (int i = 0; i < 10 && quality.level() != PreviewQuality::Full; ++i)
+    {
+        quality.report(2.0, 30);
+    }
+    QCOMPARE(quality.level(), PreviewQuality::Full);
+}
+
+void TestPreviewQuality::testSettleWhenIdle()
+{
+    PreviewQuality quality(20.0);
+    quality.touch(0);
+    for (int i = 0; i < PreviewQuality::MIN_SAMPLES; ++i)
+    {
+        quality.report(50.0, 10);
+    }
+    QCOMPARE(quality.level(), PreviewQuality::Reduced);
+
+    QVERIFY(!quality.settle(PreviewQuality::IDLE_MS - 1));
+    QCOMPARE(quality.level(), PreviewQuality::Reduced);
+
+    QVERIFY(quality.settle(PreviewQuality::IDLE_MS));
+    QCOMPARE(quality.level(), PreviewQuality::Full);
+    QVERIFY(!quality.settle(PreviewQuality::IDLE_MS + 100));
+}
+
+void TestPreviewQuality::testLevelKnobs()
+{
+    QCOMPARE(PreviewQuality::pointStride(PreviewQuality::Full), 1);
+    QCOMPARE(PreviewQuality::heatmapDivisor(PreviewQuality::Full), 1);
+    QCOMPARE(PreviewQuality::frameIntervalMs(PreviewQuality::Full), 0);
+
+    QVERIFY(PreviewQuality::pointStride(PreviewQuality::Draft) > PreviewQuality::pointStride(PreviewQuality::Reduced));
+    QVERIFY(PreviewQuality::heatmapDivisor(PreviewQuality::Draft) > PreviewQuality::heatmapDivisor(PreviewQuality::Reduced));
+    QVERIFY(PreviewQuality::frameIntervalMs(PreviewQuality::Draft) > PreviewQuality::frameIntervalMs(PreviewQuality::Reduced));
+}
+
+// ============================================================================
+// PointBuffer::decimate
+// ============================================================================
+
+void TestPreviewQuality::testDecimateKeepsLast()
+{
+    PointBuffer points;
+    for (int i = 0; i < 10; ++i)
+    {
+        points.append(i, -i, 1.0, 0.5, 0.0, i + 1);
+    }
+
+    // 0, 4, 8, then the last point 9
+    points.decimate(4);
+    QCOMPARE(points.size(), 4);
+    QCOMPARE(points.xs()[0], 0.0);
+    QCOMPARE(points.xs()[1], 4.0);
+    QCOMPARE(points.xs()[2], 8.0);
+    QCOMPARE(points.xs()[3], 9.0);
+    QCOMPARE(points.ys()[3], -9.0);
+    QCOMPARE(points.repeats()[1], 5);
+
+    // Last point already on the stride: not duplicated
+    PointBuffer exact;
+    for (int i = 0; i < 9; ++i)
+    {
+        exact.append(i, 0.0, 1.0, 1.0, 1.0, 1);
+    }
+    exact.decimate(4);
+    QCOMPARE(exact.size(), 3);
+    QCOMPARE(exact.xs()[2], 8.0);
+}
+
+void TestPreviewQuality::testDecimateStrideOne()
+{
+    PointBuffer points;
+    for (int i = 0; i < 5; ++i)
+    {
+        points.append(i, i, 1.0, 1.0, 1.0, 1);
+    }
+    PointBuffer copy;
+    copy.copyFrom(points);
+
+    points.decimate(1);
+    QVERIFY(points.equals(copy));
+    points.decimate(0);
+    QVERIFY(points.equals(copy));
+}
+
+QTEST_MAIN(TestPreviewQuality)
+#include "tst_preview_quality.moc"
@@ -0,0 +1,178 @@
+#include <QtTest>
+
+#include "core/RatioGridCache.h"
+#include "core/GraphEvaluator.h"
+#include "core/NodeGraph.h"
+#include "core/Node.h"
+#include "core/Port.h"
+#include "nodes/GizmoNode.h"
+
+using namespace gizmotweak2;
+
+class TestRatioGridCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // RatioGridCache
+    void testFindMiss();
+    void testInsertFind();
+    void testKeyFields();
+    void testLruEviction();
+    void testZeroBudgetDisables();
+
+    // GraphEvaluator::snapshotRevision
+    void testRevisionFollowsUpstreamEdits();
+    void testRevisionIgnoresUnrelatedEdits();
+
+private:
+    RatioGridCache::Key key(qint64 timeMs);
+    QVector<qreal> grid(int resolution, qreal value);
+};
+
+RatioGridCache::Key TestRatioGridCache::key(qint64 timeMs)
+{
+    RatioGridCache::Key result;
+    result.uuid = QStringLiteral("a3c1e0f2-0000-4000-8000-000000000001");
+    result.revision = 7;
+    result.timeMs = timeMs;
+    result.resolution = 16;
+    return result;
+}
+
+QVector<qreal> TestRatioGridCache::grid(int resolution, qreal value)
+{
+    return QVector<qreal>(resolution * resolution, value);
+}
+
+// ============================================================================
+// RatioGridCache
+// ============================================================================
+
+void TestRatioGridCache::testFindMiss()
+{
+    RatioGridCache cache;
+    QVector<qreal> out;
+    QVERIFY(!cache.find(key(0), out));
+    QCOMPARE(cache.stats().misses, quint64(1));
+    QCOMPARE(cache.stats().hits, quint64(0));
+}
+
+void TestRatioGridCache::testInsertFind()
+{
+    RatioGridCache cache;
+    cache.insert(key(40), grid(16, 0.5));
+
+    QVector<qreal> out;
+    QVERIFY(cache.find(key(40), out));
+    QCOMPARE(out.size(), 256);
+    QCOMPARE(out[255], 0.5);
+    QCOMPARE(cache.stats().hits, quint64(1));
+    QCOMPARE(cache.stats().entries, 1);
+    QCOMPARE(cache.stats().bytes, qint64(256 * sizeof(qreal)));
+}
+
+void TestRatioGridCache::testKeyFields()
+{
+    RatioGridCache cache;
+    cache.insert(key(40), grid(16, 0.5));
+
+    // Any field differing is another grid
+    QVector<qreal> out;
+    auto other = key(40);
+    other.revision = 8;
+    QVERIFY(!cache.find(other, out));
+
+    other = key(40);
+    other.uuid = QStringLiteral("a3c1e0f2-0000-4000-8000-000000000002");
+    QVERIFY(!cache.find(other, out));
+
+    other = key(40);
+    other.resolution = 32;
+    QVERIFY(!cache.find(other, out));
+
+    QVERIFY(!cache.find(key(80), out));
+    QVERIFY(cache.find(key(40), out));
+}
+
+void TestRatioGridCache::testLruEviction()
+{
+    // Room for exactly two grids
+    RatioGridCache cache(2 * RatioGridCache::bytesFor(grid(16, 0.0)));
+    cache.insert(key(0), grid(16, 0.0));
+    cache.insert(key(40), grid(16, 0.1));
+
+    // Touch 0: 40 becomes the least recently used and goes first
+    QVector<qreal> out;
+    QVERIFY(cache.find(key(0), out));
+    cache.insert(key(80), grid(16, 0.2));
+
+    QVERIFY(cache.find(key(0), out));
+    QVERIFY(!cache.find(key(40), out));
+    QVERIFY(cache.find(key(80), out));
+    QCOMPARE(out[0], 0.2);
+    QCOMPARE(cache.stats().evictions, quint64(1));
+    QVERIFY(cache.stats().bytes <= cache.stats().budgetBytes);
+}
+
+void TestRatioGridCache::testZeroBudgetDisables()
+{
+    RatioGridCache cache;
+    cache.insert(key(0), grid(16, 0.0));
+    QCOMPARE(cache.stats().entries, 1);
+
+    cache.setBudgetBytes(0);
+    QCOMPARE(cache.stats().entries, 0);
+
+    cache.insert(key(40), grid(16, 0.0));
+    QCOMPARE(cache.stats().entries, 0);
+}
+
+// ============================================================================
+// GraphEvaluator::snapshotRevision
+// ============================================================================
+
+void TestRatioGridCache::testRevisionFollowsUpstreamEdits()
+{
+    NodeGraph graph;
+    auto* gizmo = qobject_cast<GizmoNode*>(graph.createNode("Gizmo", QPointF(100, 100)));
+    auto* mirror = graph.createNode("Mirror", QPointF(250, 100));
+    for (auto* input : mirror->inputs())
+    {
+        if (input->dataType() == Port::DataType::Ratio2D)
+        {
+            graph.connect(gizmo->outputAt(0), input);
+            break;
+        }
+    }
+
+    auto* evaluator = graph.evaluator();
+    EvaluationSnapshot snapshot;
+    evaluator->captureRatioSnapshot(snapshot, mirror, 0.0);
+    const quint64 before = evaluator->snapshotRevision(snapshot);
+
+    // The Mirror grid depends on the Gizmo feeding it
+    gizmo->setCenterX(0.3);
+    evaluator->captureRatioSnapshot(snapshot, mirror, 0.0);
+    QVERIFY(evaluator->snapshotRevision(snapshot) > before);
+}
+
+void TestRatioGridCache::testRevisionIgnoresUnrelatedEdits()
+{
+    NodeGraph graph;
+    auto* gizmo = graph.createNode("Gizmo", QPointF(100, 100));
+    auto* other = qobject_cast<GizmoNode*>(graph.createNode("Gizmo", QPointF(100, 300)));
+
+    auto* evaluator = graph.evaluator();
+    EvaluationSnapshot snapshot;
+    evaluator->captureRatioSnapshot(snapshot, gizmo, 0.0);
+    const quint64 before = evaluator->snapshotRevision(snapshot);
+
+    // Grids of other nodes stay valid
+    other->setCenterX(0.3);
+    evaluator->captureRatioSnapshot(snapshot, gizmo, 0.0);
+    QCOMPARE(evaluator->snapshotRevision(snapshot), before);
+}
+
+QTEST_MAIN(TestRatioGridCache)
+#include "tst_ratio_grid_cache.moc"
@@ -0,0 +1,136 @@
+#include <QtTest>
+
+#include "core/RatioHeatmap.h"
+#include "core/GraphEvaluator.h"
+#include "core/NodeGraph.h"
+#include "core/Node.h"
+#include "core/Port.h"
+#include "nodes/GizmoNode.h"
+#include "nodes/MirrorNode.h"
+
+using namespace gizmotweak2;
+
+class TestRatioHeatmap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testPassResolutions();
+    void testMatchesGizmoRatio();
+    void testMirroredGizmo();
+    void testCancelledStopsEarly();
+    void testNoGraph();
+
+private:
+    // Normalized coordinate of cell index i (Y up for rows)
+    qreal cellX(int i, int resolution) const { return (qreal(i) / (resolution - 1)) * 2.0 - 1.0; }
+    qreal cellY(int i, int resolution) const { return 1.0 - (qreal(i) / (resolution - 1)) * 2.0; }
+};
+
+void TestRatioHeatmap::testPassResolutions()
+{
+    QCOMPARE(RatioHeatmap::passResolutions(16), QList<int>({4, 8, 16}));
+    QCOMPARE(RatioHeatmap::passResolutions(64), QList<int>({4, 8, 16, 32, 64}));
+    QCOMPARE(RatioHeatmap::passResolutions(12), QList<int>({6, 12}));
+    QCOMPARE(RatioHeatmap::passResolutions(4), QList<int>({4}));
+}
+
+void TestRatioHeatmap::testMatchesGizmoRatio()
+{
+    NodeGraph graph;
+    auto* gizmo = qobject_cast<GizmoNode*>(graph.createNode("Gizmo", QPointF(100, 100)));
+    gizmo->setCenterX(0.2);
+    gizmo->setHorizontalBorder(0.4);
+    gizmo->setVerticalBorder(0.6);
+
+    EvaluationSnapshot snapshot;
+    const int op = graph.evaluator()->captureRatioSnapshot(snapshot, gizmo, 0.5);
+    QVERIFY(op >= 0);
+
+    const int resolution = 16;
+    RatioHeatmap heatmap;
+    QImage image;
+    QVector<qreal> ratios;
+    QVERIFY(heatmap.render(snapshot, op, resolution, image, &ratios));
+    QCOMPARE(image.size(), QSize(resolution, resolution));
+    QCOMPARE(ratios.size(), resolution * resolution);
+
+    // Same cells and values as the live node, pixel colors from the ratios
+    for (int iy = 0; iy < resolution; ++iy)
+    {
+        for (int ix = 0; ix < resolution; ++ix)
+        {
+            const qreal expected = gizmo->computeRatio(cellX(ix, resolution), cellY(iy, resolution), 0.5);
+            QVERIFY(qAbs(ratios[iy * resolution + ix] - expected) < 1e-9);
+            QCOMPARE(image.pixel(ix, iy), RatioHeatmap::colorOf(expected));
+        }
+    }
+}
+
+void TestRatioHeatmap::testMirroredGizmo()
+{
+    NodeGraph graph;
+    auto* gizmo = qobject_cast<GizmoNode*>(graph.createNode("Gizmo", QPointF(100, 100)));
+    auto* mirror = graph.createNode("Mirror", QPointF(250, 100));
+    gizmo->setCenterX(0.5);
+    gizmo->setHorizontalBorder(0.3);
+    gizmo->setVerticalBorder(0.3);
+
+    Port* ratioInput = nullptr;
+    for (auto* input : mirror->inputs())
+    {
+        if (input->dataType() == Port::DataType::Ratio2D)
+        {
+            ratioInput = input;
+            break;
+        }
+    }
+    QVERIFY(ratioInput);
+    graph.connect(gizmo->outputAt(0), ratioInput);
+
+    EvaluationSnapshot snapshot;
+    const int op = graph.evaluator()->captureRatioSnapshot(snapshot, mirror, 0.0);
+
+    RatioHeatmap heatmap;
+    QImage image;
+    QVector<qreal> ratios;
+    QVERIFY(heatmap.render(snapshot, op, 8, image, &ratios));
+
+    auto* mirrorNode = qobject_cast<MirrorNode*>(mirror);
+    for (int iy = 0; iy < 8; ++iy)
+    {
+        for (int ix = 0; ix < 8; ++ix)
+        {
+            const QPointF mirrored = mirrorNode->mirror(cellX(ix, 8), cellY(iy, 8));
+            const qreal expected = gizmo->computeRatio(mirrored.x(), mirrored.y(), 0.0);
+            QVERIFY(qAbs(ratios[iy * 8 + ix] - expected) < 1e-9);
+        }
+    }
+}
+
+void TestRatioHeatmap::testCancelledStopsEarly()
+{
+    NodeGraph graph;
+    auto* gizmo = graph.createNode("Gizmo", QPointF(100, 100));
+
+    EvaluationSnapshot snapshot;
+    const int op = graph.evaluator()->captureRatioSnapshot(snapshot, gizmo, 0.0);
+
+    // Polled once per row: cancel after three rows
+    int polls = 0;
+    RatioHeatmap heatmap;
+    QImage image;
+    QVERIFY(!heatmap.render(snapshot, op, 32, image, nullptr, [&polls]() { return ++polls > 3; }));
+    QCOMPARE(polls, 4);
+}
+
+void TestRatioHeatmap::testNoGraph()
+{
+    GraphEvaluator evaluator;
+    EvaluationSnapshot snapshot;
+    QCOMPARE(evaluator.captureRatioSnapshot(snapshot, nullptr, 0.0), -1);
+    QVERIFY(!snapshot.valid);
+}
+
+QTEST_MAIN(TestRatioHeatmap)
+#include "tst_ratio_heatmap.moc"